@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+
+"""
+Create a binary table file of the CO2 density and specific enthalpy
+for a user-defined temperature and pressure range and resolution,
+to be used with Dumux::BinaryCO2Tables (dumux/material/components/co2binarytables.hh).
+
+The properties are computed with the Span & Wagner (1996) equation of state
+as implemented in CoolProp (http://www.coolprop.org, `pip install CoolProp`).
+The enthalpy is shifted such that it is consistent with the tables shipped with DuMux
+(the reference state of which differs from the one used by CoolProp).
+
+Example:
+    python3 create_co2tables.py --temperature 290 380 100 --pressure 1e5 6e7 600 -o co2tables.bin
+"""
+
+import sys
+import struct
+import argparse
+
+try:
+    from CoolProp.CoolProp import PropsSI
+except ImportError:
+    sys.exit("This script requires CoolProp (pip install CoolProp)")
+
+# the binary format (see co2binarytables.hh)
+MAGIC = b"DUMUXCO2"
+FORMAT_VERSION = 1
+
+# a point of the tables shipped with DuMux (co2tables.inc) fixing the enthalpy reference:
+# temperature [K], pressure [Pa], specific enthalpy [J/kg]
+ENTHALPY_REFERENCE = (280.0, 1e5, 5.700580815972213e03)
+
+
+def sample(minValue, maxValue, numSteps):
+    """Equidistant sampling points including the end points"""
+    return [minValue + i * (maxValue - minValue) / (numSteps - 1) for i in range(numSteps)]
+
+
+def createTables():
+    """Compute the tables and write the binary file"""
+
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument(
+        "-t",
+        "--temperature",
+        nargs=3,
+        type=float,
+        metavar=("MIN", "MAX", "STEPS"),
+        required=True,
+        help="temperature range [K] and number of sampling points",
+    )
+    parser.add_argument(
+        "-p",
+        "--pressure",
+        nargs=3,
+        type=float,
+        metavar=("MIN", "MAX", "STEPS"),
+        required=True,
+        help="pressure range [Pa] and number of sampling points",
+    )
+    parser.add_argument(
+        "-o", "--output", type=str, default="co2tables.bin", help="the name of the output file"
+    )
+    args = vars(parser.parse_args())
+
+    minTemp, maxTemp, numTempSteps = args["temperature"]
+    minPress, maxPress, numPressSteps = args["pressure"]
+    numTempSteps, numPressSteps = int(numTempSteps), int(numPressSteps)
+    if numTempSteps < 2 or numPressSteps < 2:
+        sys.exit("At least two sampling points per direction are required")
+    if minTemp >= maxTemp or minPress >= maxPress:
+        sys.exit("Invalid temperature or pressure range")
+
+    temperatures = sample(minTemp, maxTemp, numTempSteps)
+    pressures = sample(minPress, maxPress, numPressSteps)
+
+    refT, refP, refH = ENTHALPY_REFERENCE
+    enthalpyOffset = refH - PropsSI("H", "T", refT, "P", refP, "CO2")
+
+    density, enthalpy = [], []
+    for temperature in temperatures:
+        for pressure in pressures:
+            density.append(PropsSI("D", "T", temperature, "P", pressure, "CO2"))
+            enthalpy.append(PropsSI("H", "T", temperature, "P", pressure, "CO2") + enthalpyOffset)
+
+    with open(args["output"], "wb") as tableFile:
+        tableFile.write(MAGIC)
+        tableFile.write(struct.pack("=4I", FORMAT_VERSION, numTempSteps, numPressSteps, 0))
+        tableFile.write(struct.pack("=4d", minTemp, maxTemp, minPress, maxPress))
+        tableFile.write(struct.pack(f"={len(density)}d", *density))
+        tableFile.write(struct.pack(f"={len(enthalpy)}d", *enthalpy))
+
+    print(
+        f"Wrote CO2 tables for T = [{minTemp}, {maxTemp}] K ({numTempSteps} points) and "
+        f"p = [{minPress}, {maxPress}] Pa ({numPressSteps} points) to {args['output']}"
+    )
+
+
+if __name__ == "__main__":
+    createTables()
@@ -13,3 +13,8 @@ find_package(NLOPT QUIET)
 find_package(PTScotch QUIET)
 include(AddPTScotchFlags)
 find_package(PVPython QUIET)
+find_package(ZLIB QUIET)
+set(HAVE_ZLIB ${ZLIB_FOUND})
+if(ZLIB_FOUND)
+  dune_register_package_flags(LIBRARIES ZLIB::ZLIB)
+endif()
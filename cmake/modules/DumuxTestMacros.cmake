@@ -199,6 +199,18 @@
 #       Example: Write CMAKE_GUARD dune-foo_FOUND if you want to set a variable
 #       that is only true if the module dune-foo has been found.
 #
+# .. cmake_function:: dumux_add_benchmark
+#
+#    .. cmake_brief::
+#
+#       Adds a micro-benchmark to the Dumux testing suite.
+#
+#    Takes the same arguments as :ref:`dumux_add_test` except :code:`LABELS`.
+#    The test is labeled :code:`benchmark`, so all benchmarks can be built
+#    with :code:`make build_benchmark_tests` and run with :code:`ctest -L benchmark`.
+#    Benchmarks write their results to a json file named after the benchmark suite
+#    in the build directory of the test.
+#
 include_guard(GLOBAL)
 
 # Note: This forwards to dune_add_test but enables another layer in case we need to support
@@ -262,6 +274,16 @@ function(dumux_add_test)
              "{\n  \"name\": \"${ADDTEST_NAME}\",\n  \"target\": \"${ADDTEST_TARGET}\",\n  \"source_dir\": \"${CMAKE_CURRENT_SOURCE_DIR}\"\n}\n")
 endfunction()
 
+# Add a benchmark (a test with the label benchmark)
+function(dumux_add_benchmark)
+  include(CMakeParseArguments)
+  cmake_parse_arguments(ADDBENCHMARK "" "" "LABELS" ${ARGN})
+  if(ADDBENCHMARK_LABELS)
+    message(FATAL_ERROR "dumux_add_benchmark does not accept LABELS (benchmarks are labeled 'benchmark')")
+  endif()
+  dumux_add_test(${ARGN} LABELS benchmark)
+endfunction()
+
 # Evaluate test guards like dune_add_test internally does
 function(dumux_evaluate_cmake_guard GUARD_LETS_YOU_PASS)
   include(CMakeParseArguments)
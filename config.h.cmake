@@ -67,6 +67,9 @@
 /* Define the path to pvpython */
 #define PVPYTHON_EXECUTABLE "${PVPYTHON_EXECUTABLE}"
 
+/* Define to 1 if zlib was found */
+#cmakedefine HAVE_ZLIB 1
+
 /* Define to 1 if quadmath was found */
 #cmakedefine HAVE_QUAD 1
 
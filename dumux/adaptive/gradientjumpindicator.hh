@@ -0,0 +1,343 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Adaptive
+ * \brief A reusable error indicator for grid adaption based on jumps of
+ *        solution-dependent quantities between neighboring elements
+ */
+#ifndef DUMUX_ADAPTIVE_GRADIENT_JUMP_INDICATOR_HH
+#define DUMUX_ADAPTIVE_GRADIENT_JUMP_INDICATOR_HH
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+#include <dune/grid/common/partitionset.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/common/gridcapabilities.hh>
+#include <dumux/parallel/parallel_for.hh>
+#include <dumux/parallel/vectorcommdatahandle.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Adaptive
+ * \brief Error indicator based on the jumps of solution-dependent quantities over element faces
+ *
+ * For each registered quantity q (e.g. a pressure, saturation or mole fraction) the element
+ * averages q_K are computed from the volume variables. The indicator of an element K is
+ * \f[
+ *   \eta_K = \max_q w_q \max_{L \in N(K)} \frac{|q_K - q_L|}{\max q - \min q},
+ * \f]
+ * i.e. the largest jump to a neighbor L, normalized by the global range of q and weighted by w_q.
+ * The jump is the discrete gradient times the element size and is large only along fronts.
+ * Elements are refined if \f$ \eta_K \f$ exceeds the refine tolerance and coarsened if it is below
+ * the (smaller) coarsen tolerance. Elements with an indicator between both tolerances are kept,
+ * which avoids refining and coarsening the same elements in successive adaption steps.
+ * If all registered quantities are constant on the grid, no element is marked.
+ *
+ * The element loops are thread-parallel (see parallelFor) for grids with thread-safe element
+ * access (see Detail::supportsMultithreading) and the element values are communicated to
+ * overlap/ghost elements in parallel runs.
+ *
+ * \note This indicator only uses jumps of element averages. A posteriori estimators based on
+ *       the jumps of the normal fluxes (or on residuals) are not implemented.
+ *
+ * The following parameters are read from the parameter tree
+ *  - Adaptive.MinLevel The minimum refinement level (default 0)
+ *  - Adaptive.MaxLevel The maximum refinement level (default 0)
+ *  - Adaptive.RefineTolerance The default refine tolerance (default 0.05)
+ *  - Adaptive.CoarsenTolerance The default coarsen tolerance (default 0.001)
+ *
+ * \tparam GridVariables the grid variables type
+ */
+template<class GridVariables>
+class GradientJumpIndicator
+{
+    using GridGeometry = typename GridVariables::GridGeometry;
+    using GridView = typename GridGeometry::GridView;
+    using Element = typename GridView::template Codim<0>::Entity;
+    using Scalar = typename GridVariables::Scalar;
+    using VolumeVariables = typename GridVariables::VolumeVariables;
+
+public:
+    //! A quantity evaluated from the volume variables
+    using Quantity = std::function<Scalar(const VolumeVariables&)>;
+
+    /*!
+     * \brief The Constructor
+     * \param gridGeometry The finite volume grid geometry
+     * \param gridVariables The grid variables
+     * \param paramGroup The parameter group in which to look for runtime parameters first (default is "")
+     */
+    GradientJumpIndicator(std::shared_ptr<const GridGeometry> gridGeometry,
+                          std::shared_ptr<const GridVariables> gridVariables,
+                          const std::string& paramGroup = "")
+    : gridGeometry_(gridGeometry)
+    , gridVariables_(gridVariables)
+    , minLevel_(getParamFromGroup<std::size_t>(paramGroup, "Adaptive.MinLevel", 0))
+    , maxLevel_(getParamFromGroup<std::size_t>(paramGroup, "Adaptive.MaxLevel", 0))
+    , refineTol_(getParamFromGroup<Scalar>(paramGroup, "Adaptive.RefineTolerance", 0.05))
+    , coarsenTol_(getParamFromGroup<Scalar>(paramGroup, "Adaptive.CoarsenTolerance", 0.001))
+    {}
+
+    /*!
+     * \brief Register a quantity the indicator is based on
+     * \param quantity a function evaluating the quantity from the volume variables
+     * \param weight a weight for the normalized jumps of this quantity
+     */
+    void addQuantity(const Quantity& quantity, Scalar weight = 1.0)
+    {
+        quantities_.push_back(quantity);
+        weights_.push_back(weight);
+    }
+
+    //! The pressure of a phase
+    static Quantity pressure(int phaseIdx)
+    { return [phaseIdx](const VolumeVariables& v){ return v.pressure(phaseIdx); }; }
+
+    //! The saturation of a phase
+    static Quantity saturation(int phaseIdx)
+    { return [phaseIdx](const VolumeVariables& v){ return v.saturation(phaseIdx); }; }
+
+    //! The mole fraction of a component in a phase
+    static Quantity moleFraction(int phaseIdx, int compIdx)
+    { return [phaseIdx, compIdx](const VolumeVariables& v){ return v.moleFraction(phaseIdx, compIdx); }; }
+
+    //! Function to set the minumum/maximum allowed levels.
+    void setLevels(std::size_t minLevel, std::size_t maxLevel)
+    {
+        minLevel_ = minLevel;
+        maxLevel_ = maxLevel;
+    }
+
+    /*!
+     * \brief Calculates the indicator for each grid cell with the tolerances from the parameter tree
+     * \param sol The solution vector
+     */
+    template<class SolutionVector>
+    void calculate(const SolutionVector& sol)
+    { calculate(sol, refineTol_, coarsenTol_); }
+
+    /*!
+     * \brief Calculates the indicator for each grid cell
+     * \param sol The solution vector
+     * \param refineTol Elements with a (normalized) indicator above this value are refined
+     * \param coarsenTol Elements with a (normalized) indicator below this value are coarsened
+     */
+    template<class SolutionVector>
+    void calculate(const SolutionVector& sol, Scalar refineTol, Scalar coarsenTol)
+    {
+        if (quantities_.empty())
+            DUNE_THROW(Dune::InvalidStateException, "No quantities have been added to the indicator");
+
+        //! Check for inadmissible tolerance combination
+        if (coarsenTol > refineTol)
+            DUNE_THROW(Dune::InvalidStateException, "Refine tolerance must be higher than coarsen tolerance");
+
+        refineBound_ = refineTol;
+        coarsenBound_ = coarsenTol;
+
+        const auto& gridView = gridGeometry_->gridView();
+        const auto numElements = gridView.size(0);
+        indicator_.assign(numElements, 0.0);
+
+        //! maxLevel_ must be higher than minLevel_ to allow for refinement
+        if (minLevel_ >= maxLevel_)
+        {
+            refineBound_ = std::numeric_limits<Scalar>::max();
+            coarsenBound_ = std::numeric_limits<Scalar>::lowest();
+            return;
+        }
+
+        //! Compute the element averages of all quantities
+        values_.resize(quantities_.size());
+        for (auto& v : values_)
+            v.assign(numElements, 0.0);
+
+        forEachElement_(numElements, [&](const std::size_t eIdx)
+        {
+            const auto element = gridGeometry_->element(eIdx);
+            auto fvGeometry = localView(*gridGeometry_);
+            auto elemVolVars = localView(gridVariables_->curGridVolVars());
+            fvGeometry.bindElement(element);
+            elemVolVars.bindElement(element, fvGeometry, sol);
+
+            Scalar volume = 0.0;
+            for (const auto& scv : scvs(fvGeometry))
+            {
+                volume += scv.volume();
+                for (std::size_t q = 0; q < quantities_.size(); ++q)
+                    values_[q][eIdx] += quantities_[q](elemVolVars[scv])*scv.volume();
+            }
+
+            for (std::size_t q = 0; q < quantities_.size(); ++q)
+                values_[q][eIdx] /= volume;
+        });
+
+        //! Make the values available on overlap and ghost elements
+        if (gridView.comm().size() > 1)
+        {
+            using ElementMapper = std::decay_t<decltype(gridGeometry_->elementMapper())>;
+            for (auto& v : values_)
+            {
+                VectorCommDataHandleEqual<ElementMapper, std::vector<Scalar>, 0> dataHandle(gridGeometry_->elementMapper(), v);
+                gridView.communicate(dataHandle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+            }
+        }
+
+        //! Compute the global range of each quantity
+        std::vector<Scalar> range(quantities_.size());
+        for (std::size_t q = 0; q < quantities_.size(); ++q)
+        {
+            const auto [minIt, maxIt] = std::minmax_element(values_[q].begin(), values_[q].end());
+            const auto globalMin = gridView.comm().min(numElements > 0 ? *minIt : std::numeric_limits<Scalar>::max());
+            const auto globalMax = gridView.comm().max(numElements > 0 ? *maxIt : std::numeric_limits<Scalar>::lowest());
+            range[q] = globalMax - globalMin;
+        }
+
+        //! If all quantities are constant, the jumps carry no information and no element is marked
+        if (std::none_of(range.begin(), range.end(), [](const Scalar r){ return r > 0.0; }))
+        {
+            refineBound_ = std::numeric_limits<Scalar>::max();
+            coarsenBound_ = std::numeric_limits<Scalar>::lowest();
+            return;
+        }
+
+        //! Compute the maximum normalized jump for each element
+        forEachElement_(numElements, [&](const std::size_t eIdx)
+        {
+            const auto element = gridGeometry_->element(eIdx);
+            Scalar eta = 0.0;
+            for (const auto& intersection : intersections(gridView, element))
+            {
+                if (!intersection.neighbor())
+                    continue;
+
+                const auto nIdx = gridGeometry_->elementMapper().index(intersection.outside());
+                for (std::size_t q = 0; q < quantities_.size(); ++q)
+                {
+                    if (range[q] <= 0.0)
+                        continue;
+
+                    using std::abs; using std::max;
+                    eta = max(eta, weights_[q]*abs(values_[q][eIdx] - values_[q][nIdx])/range[q]);
+                }
+            }
+
+            indicator_[eIdx] = eta;
+        });
+
+        //! check if neighbors have to be refined too (2:1 refinement ratio)
+        for (const auto& element : elements(gridView, Dune::Partitions::interior))
+            if (this->operator()(element) > 0)
+                checkNeighborsRefine_(element);
+    }
+
+    /*!
+     * \brief function call operator to return mark
+     *
+     * \return  1 if an element should be refined
+     *         -1 if an element should be coarsened
+     *          0 otherwise
+     *
+     * \param element A grid element
+     */
+    int operator() (const Element& element) const
+    {
+        const auto eta = indicator_[gridGeometry_->elementMapper().index(element)];
+        if (element.hasFather() && element.level() > minLevel_ && eta < coarsenBound_)
+            return -1;
+        else if (element.level() < maxLevel_ && eta > refineBound_)
+            return 1;
+        else
+            return 0;
+    }
+
+    //! The indicator value of an element (e.g. for output)
+    const std::vector<Scalar>& indicator() const
+    { return indicator_; }
+
+private:
+    //! call f(eIdx) for all elements (thread-parallel if the grid supports it)
+    template<class F>
+    void forEachElement_(const std::size_t numElements, F&& f) const
+    {
+        if constexpr (Detail::supportsMultithreading<typename GridView::Grid>)
+            parallelFor(numElements, f);
+        else
+            for (std::size_t eIdx = 0; eIdx < numElements; ++eIdx)
+                f(eIdx);
+    }
+
+    /*!
+     * \brief Method ensuring the refinement ratio of 2:1
+     * \param element Element of interest that is to be refined
+     * \param level level of the refined element: it is at least 1
+     */
+    void checkNeighborsRefine_(const Element& element, std::size_t level = 1)
+    {
+        for (const auto& intersection : intersections(gridGeometry_->gridView(), element))
+        {
+            if (!intersection.neighbor())
+                continue;
+
+            // obtain outside element
+            const auto outside = intersection.outside();
+
+            // only mark non-ghost elements
+            if (outside.partitionType() == Dune::GhostEntity)
+                continue;
+
+            if (outside.level() < maxLevel_ && outside.level() < element.level())
+            {
+                // ensure refinement for outside element
+                indicator_[gridGeometry_->elementMapper().index(outside)] = std::numeric_limits<Scalar>::max();
+                if (level < maxLevel_)
+                    checkNeighborsRefine_(outside, ++level);
+            }
+        }
+    }
+
+    std::shared_ptr<const GridGeometry> gridGeometry_;
+    std::shared_ptr<const GridVariables> gridVariables_;
+
+    std::vector<Quantity> quantities_;
+    std::vector<Scalar> weights_;
+    std::vector<std::vector<Scalar>> values_;
+    std::vector<Scalar> indicator_;
+
+    std::size_t minLevel_;
+    std::size_t maxLevel_;
+    Scalar refineTol_;
+    Scalar coarsenTol_;
+    Scalar refineBound_ = std::numeric_limits<Scalar>::max();
+    Scalar coarsenBound_ = std::numeric_limits<Scalar>::lowest();
+};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,299 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Adaptive
+ * \brief Dynamic load balancing of adaptive grids
+ */
+#ifndef DUMUX_ADAPTIVE_LOADBALANCE_HH
+#define DUMUX_ADAPTIVE_LOADBALANCE_HH
+
+#include <map>
+#include <vector>
+#include <memory>
+#include <string>
+#include <iostream>
+#include <functional>
+#include <type_traits>
+
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/partitionset.hh>
+#include <dune/grid/common/rangegenerators.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/discretization/method.hh>
+#include <dumux/parallel/vectorcommdatahandle.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Adaptive
+ * \brief A data handle migrating the primary variables of all dofs of an element
+ *        together with the element during load balancing
+ *
+ * The values are stored per element (identified by the global id) so that only
+ * element data has to be migrated by the grid (supported by all grids with loadBalance).
+ * Vertex dofs (box) are attached to all elements containing the vertex.
+ * Several solution vectors (e.g. the current and the previous solution) are migrated at once.
+ */
+template<class GridGeometry, class SolutionVector>
+class SolutionMigrationDataHandle
+: public Dune::CommDataHandleIF<SolutionMigrationDataHandle<GridGeometry, SolutionVector>,
+                                typename SolutionVector::block_type>
+{
+    using GridView = typename GridGeometry::GridView;
+    using Grid = typename GridView::Grid;
+    using IdSet = typename Grid::GlobalIdSet;
+    using IdType = typename IdSet::IdType;
+
+public:
+    //! export type of data for message buffer
+    using DataType = typename SolutionVector::block_type;
+
+    /*!
+     * \brief Store the values of the given solution vectors for all interior elements
+     * \param gridGeometry the grid geometry (before load balancing)
+     * \param solutions the solution vectors to migrate
+     */
+    SolutionMigrationDataHandle(const GridGeometry& gridGeometry,
+                                std::vector<std::reference_wrapper<SolutionVector>> solutions)
+    : idSet_(gridGeometry.gridView().grid().globalIdSet())
+    , solutions_(std::move(solutions))
+    {
+        auto fvGeometry = localView(gridGeometry);
+        for (const auto& element : elements(gridGeometry.gridView(), Dune::Partitions::interior))
+        {
+            fvGeometry.bindElement(element);
+            auto& elementData = data_[idSet_.id(element)];
+            elementData.resize(fvGeometry.numScv()*solutions_.size());
+            for (const auto& scv : scvs(fvGeometry))
+                for (std::size_t i = 0; i < solutions_.size(); ++i)
+                    elementData[scv.localDofIndex()*solutions_.size() + i] = solutions_[i].get()[scv.dofIndex()];
+        }
+    }
+
+    Dune::CommDataHandleIF<SolutionMigrationDataHandle<GridGeometry, SolutionVector>, DataType>& interface()
+    { return *this; }
+
+    /*!
+     * \brief Write the migrated values into the resized solution vectors
+     * \param gridGeometry the grid geometry (already updated after load balancing)
+     */
+    void restore(const GridGeometry& gridGeometry)
+    {
+        for (auto& sol : solutions_)
+            sol.get().resize(gridGeometry.numDofs());
+
+        auto fvGeometry = localView(gridGeometry);
+        for (const auto& element : elements(gridGeometry.gridView()))
+        {
+            const auto it = data_.find(idSet_.id(element));
+            if (it == data_.end())
+                continue;
+
+            fvGeometry.bindElement(element);
+            for (const auto& scv : scvs(fvGeometry))
+                for (std::size_t i = 0; i < solutions_.size(); ++i)
+                    solutions_[i].get()[scv.dofIndex()] = it->second[scv.localDofIndex()*solutions_.size() + i];
+        }
+
+        // the elements in the overlap/ghost region are not migrated, copy from their owners
+        if constexpr (GridGeometry::discMethod != DiscretizationMethods::box)
+        {
+            const auto& gridView = gridGeometry.gridView();
+            if (gridView.overlapSize(0) + gridView.ghostSize(0) > 0)
+            {
+                using Mapper = std::decay_t<decltype(gridGeometry.dofMapper())>;
+                for (auto& sol : solutions_)
+                {
+                    VectorCommDataHandleEqual<Mapper, SolutionVector, 0> dataHandle(gridGeometry.dofMapper(), sol.get());
+                    gridView.communicate(dataHandle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+                }
+            }
+        }
+
+        data_.clear();
+    }
+
+    //! returns true if data for this codim should be communicated
+    bool contains(int dim, int codim) const
+    { return codim == 0; }
+
+    //! the number of dofs per element may vary
+    bool fixedSize(int dim, int codim) const
+    { return false; }
+
+    //! how many objects of type DataType have to be sent for a given entity
+    template<class Entity>
+    std::size_t size(const Entity& e) const
+    {
+        const auto it = data_.find(idSet_.id(e));
+        return it == data_.end() ? 0 : it->second.size();
+    }
+
+    //! pack data from user to message buffer
+    template<class MessageBuffer, class Entity>
+    void gather(MessageBuffer& buff, const Entity& e) const
+    {
+        const auto it = data_.find(idSet_.id(e));
+        if (it != data_.end())
+            for (const auto& value : it->second)
+                buff.write(value);
+    }
+
+    //! unpack data from message buffer to user
+    template<class MessageBuffer, class Entity>
+    void scatter(MessageBuffer& buff, const Entity& e, std::size_t n)
+    {
+        auto& elementData = data_[idSet_.id(e)];
+        elementData.resize(n);
+        for (auto& value : elementData)
+            buff.read(value);
+    }
+
+private:
+    const IdSet& idSet_;
+    std::vector<std::reference_wrapper<SolutionVector>> solutions_;
+    std::map<IdType, std::vector<DataType>> data_;
+};
+
+/*!
+ * \ingroup Adaptive
+ * \brief Dynamic load balancing for adaptive simulations
+ *
+ * After grid adaption the partitioning may become unbalanced, e.g. when the refined region
+ * moves with a front. The load of each process is estimated by the number of interior elements weighted
+ * by the size of their local Jacobian (stencil size). If the imbalance (maximum load / mean load) exceeds a threshold,
+ * the grid is repartitioned with grid.loadBalance() and the given solution vectors are migrated.
+ *
+ * The following run-time parameters are used
+ *  - LoadBalance.ImbalanceThreshold: rebalance if max/mean load exceeds this value (default 1.2)
+ *  - LoadBalance.Verbose: print the load statistics (default true)
+ *
+ * Usage:
+ * \code
+ * if (loadBalancer.rebalance(gridManager.grid(), x, xOld))
+ * {
+ *     assembler->setJacobianPattern();
+ *     assembler->setResidualSize();
+ *     gridVariables->updateAfterGridAdaption(x);
+ * }
+ * \endcode
+ */
+template<class GridGeometry>
+class LoadBalancer
+{
+    using GridView = typename GridGeometry::GridView;
+    static constexpr bool isBox = GridGeometry::discMethod == DiscretizationMethods::box;
+
+public:
+    /*!
+     * \brief Constructor
+     * \param gridGeometry the grid geometry (updated after load balancing)
+     * \param paramGroup the parameter group for parameter lookup
+     */
+    LoadBalancer(std::shared_ptr<GridGeometry> gridGeometry, const std::string& paramGroup = "")
+    : gridGeometry_(gridGeometry)
+    {
+        threshold_ = getParamFromGroup<double>(paramGroup, "LoadBalance.ImbalanceThreshold", 1.2);
+        verbose_ = getParamFromGroup<bool>(paramGroup, "LoadBalance.Verbose", true);
+    }
+
+    /*!
+     * \brief The estimated load of this process
+     */
+    double localLoad() const
+    {
+        // number of interior elements weighted by their stencil size
+        double load = 0.0;
+        auto fvGeometry = localView(*gridGeometry_);
+        for (const auto& element : elements(gridGeometry_->gridView(), Dune::Partitions::interior))
+        {
+            fvGeometry.bindElement(element);
+            if constexpr (isBox)
+                load += fvGeometry.numScv()*fvGeometry.numScv();
+            else
+                load += fvGeometry.numScvf() + 1;
+        }
+
+        return load;
+    }
+
+    /*!
+     * \brief The load imbalance (maximum load over all processes divided by the mean load)
+     * \note This is a collective operation
+     */
+    double imbalance() const
+    {
+        const auto& comm = gridGeometry_->gridView().comm();
+        const auto load = localLoad();
+        const auto maxLoad = comm.max(load);
+        const auto meanLoad = comm.sum(load)/comm.size();
+        return meanLoad > 0.0 ? maxLoad/meanLoad : 1.0;
+    }
+
+    /*!
+     * \brief Repartition the grid and migrate the solution vectors if the load is unbalanced
+     * \param grid the grid
+     * \param solutions the solution vectors to migrate (e.g. the current and the previous solution)
+     * \return true if the grid has been repartitioned. In that case, the grid geometry has been updated
+     *         and the solution vectors are resized and hold the migrated values. All other objects depending
+     *         on the grid (grid variables, Jacobian pattern, residual, ...) have to be updated by the caller.
+     * \note This is a collective operation
+     */
+    template<class Grid, class SolutionVector, class... SolutionVectors>
+    bool rebalance(Grid& grid, SolutionVector& sol, SolutionVectors&... solutions)
+    {
+        const auto& comm = gridGeometry_->gridView().comm();
+        if (comm.size() == 1)
+            return false;
+
+        const auto currentImbalance = imbalance();
+        const bool balance = currentImbalance > threshold_;
+        if (verbose_ && comm.rank() == 0)
+            std::cout << "Load imbalance (max/mean): " << currentImbalance
+                      << (balance ? " -> rebalancing the grid" : "") << std::endl;
+
+        if (!balance)
+            return false;
+
+        SolutionMigrationDataHandle<GridGeometry, SolutionVector> dataHandle(*gridGeometry_, {std::ref(sol), std::ref(solutions)...});
+        grid.loadBalance(dataHandle.interface());
+        gridGeometry_->update(grid.leafGridView());
+        dataHandle.restore(*gridGeometry_);
+
+        if (verbose_)
+        {
+            const auto newImbalance = imbalance();
+            if (comm.rank() == 0)
+                std::cout << "Load imbalance after rebalancing: " << newImbalance << std::endl;
+        }
+
+        return true;
+    }
+
+private:
+    std::shared_ptr<GridGeometry> gridGeometry_;
+    double threshold_;
+    bool verbose_;
+};
+
+} // end namespace Dumux
+
+#endif
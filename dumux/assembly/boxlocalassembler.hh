@@ -30,6 +30,7 @@
 
 #include <dumux/common/properties.hh>
 #include <dumux/common/parameters.hh>
+#include <dumux/common/instrumentation.hh>
 #include <dumux/common/numericdifferentiation.hh>
 #include <dumux/assembly/numericepsilon.hh>
 #include <dumux/assembly/diffmethod.hh>
@@ -342,19 +343,23 @@ public:
                                                           eps_(elemSol[scv.localDofIndex()][pvIdx], pvIdx), numDiffMethod);
 
                 // update the global stiffness matrix with the current partial derivatives
-                for (auto&& scvJ : scvs(fvGeometry))
                 {
-                    // don't add derivatives for green vertices
-                    if (!partialReassembler
-                        || partialReassembler->vertexColor(scvJ.dofIndex()) != EntityColor::green)
+                    static auto& insertionRecord = Instrumentation::record("Assembly.GlobalInsertion");
+                    Instrumentation::ScopedTimer insertionTimer(insertionRecord);
+                    for (auto&& scvJ : scvs(fvGeometry))
                     {
-                        for (int eqIdx = 0; eqIdx < numEq; eqIdx++)
+                        // don't add derivatives for green vertices
+                        if (!partialReassembler
+                            || partialReassembler->vertexColor(scvJ.dofIndex()) != EntityColor::green)
                         {
-                            // A[i][col][eqIdx][pvIdx] is the rate of change of
-                            // the residual of equation 'eqIdx' at dof 'i'
-                            // depending on the primary variable 'pvIdx' at dof
-                            // 'col'.
-                            A[scvJ.dofIndex()][dofIdx][eqIdx][pvIdx] += partialDerivs[scvJ.localDofIndex()][eqIdx];
+                            for (int eqIdx = 0; eqIdx < numEq; eqIdx++)
+                            {
+                                // A[i][col][eqIdx][pvIdx] is the rate of change of
+                                // the residual of equation 'eqIdx' at dof 'i'
+                                // depending on the primary variable 'pvIdx' at dof
+                                // 'col'.
+                                A[scvJ.dofIndex()][dofIdx][eqIdx][pvIdx] += partialDerivs[scvJ.localDofIndex()][eqIdx];
+                            }
                         }
                     }
                 }
@@ -32,6 +32,7 @@
 #include <dumux/common/reservedblockvector.hh>
 #include <dumux/common/properties.hh>
 #include <dumux/common/parameters.hh>
+#include <dumux/common/instrumentation.hh>
 #include <dumux/common/numericdifferentiation.hh>
 #include <dumux/common/numeqvector.hh>
 #include <dumux/assembly/numericepsilon.hh>
@@ -295,6 +296,8 @@ public:
 
             // add the current partial derivatives to the global jacobian matrix
             // no special treatment is needed if globalJ is a ghost because then derivatives have been assembled to 0 above
+            static auto& insertionRecord = Instrumentation::record("Assembly.GlobalInsertion");
+            Instrumentation::ScopedTimer insertionTimer(insertionRecord);
             if constexpr (Problem::enableInternalDirichletConstraints())
             {
                 // check if own element has internal Dirichlet constraint
@@ -24,12 +24,16 @@
 #ifndef DUMUX_FV_ASSEMBLER_HH
 #define DUMUX_FV_ASSEMBLER_HH
 
+#include <limits>
 #include <type_traits>
 
+#include <dune/common/exceptions.hh>
 #include <dune/istl/matrixindexset.hh>
 
 #include <dumux/common/properties.hh>
 #include <dumux/common/timeloop.hh>
+#include <dumux/common/instrumentation.hh>
+#include <dumux/common/arenaallocator.hh>
 #include <dumux/discretization/method.hh>
 #include <dumux/linear/parallelhelpers.hh>
 
@@ -106,6 +110,14 @@ class FVAssembler
 public:
     using Scalar = GetPropType<TypeTag, Properties::Scalar>;
     using JacobianMatrix = GetPropType<TypeTag, Properties::JacobianMatrix>;
+
+    // With lower-precision blocks, each entry must be written exactly once, so that it is rounded once.
+    // This holds for cell-centered schemes with numeric differentiation. Other schemes sum up the
+    // contributions of several elements (or faces) to an entry, which would accumulate in the lower precision.
+    static_assert(std::is_same_v<typename JacobianMatrix::block_type::field_type, Scalar>
+                  || ((GridGeo::discMethod == DiscretizationMethods::cctpfa || GridGeo::discMethod == DiscretizationMethods::ccmpfa)
+                      && diffMethod == DiffMethod::numeric),
+                  "A JacobianScalar different from Scalar is only supported for cell-centered schemes with numeric differentiation");
     using GridGeometry = GridGeo;
     using Problem = GetPropType<TypeTag, Properties::Problem>;
     using GridVariables = GetPropType<TypeTag, Properties::GridVariables>;
@@ -154,12 +166,16 @@ public:
     template<class PartialReassembler = DefaultPartialReassembler>
     void assembleJacobianAndResidual(const SolutionVector& curSol, const PartialReassembler* partialReassembler = nullptr)
     {
+        Instrumentation::ScopedTimer timer("Assembly.JacobianAndResidual");
+        static auto& localAssemblyRecord = Instrumentation::record("Assembly.LocalAssembly");
+
         checkAssemblerState_();
         resetJacobian_(partialReassembler);
         resetResidual_();
 
         assemble_([&](const Element& element)
         {
+            Instrumentation::ScopedTimer localTimer(localAssemblyRecord);
             LocalAssembler localAssembler(*this, element, curSol);
             localAssembler.assembleJacobianAndResidual(*jacobian_, *residual_, *gridVariables_, partialReassembler);
         });
@@ -192,6 +208,7 @@ public:
     //! assemble a residual r
     void assembleResidual(ResidualType& r, const SolutionVector& curSol) const
     {
+        Instrumentation::ScopedTimer timer("Assembly.Residual");
         checkAssemblerState_();
 
         assemble_([&](const Element& element)
@@ -288,6 +305,21 @@ public:
         // create occupation pattern of the jacobian
         const auto occupationPattern = getJacobianPattern<isImplicit>(gridGeometry());
 
+        // the number of rows and the number of nonzero blocks have to be
+        // representable by the (possibly compact) index type of the jacobian
+        using IndexType = typename JacobianMatrix::size_type;
+        if constexpr (sizeof(IndexType) < sizeof(std::size_t))
+        {
+            std::size_t numNonzeroes = 0;
+            for (std::size_t rowIdx = 0; rowIdx < occupationPattern.rows(); ++rowIdx)
+                numNonzeroes += occupationPattern.size(rowIdx);
+
+            if (numDofs > std::numeric_limits<IndexType>::max()
+                || numNonzeroes > std::numeric_limits<IndexType>::max())
+                DUNE_THROW(Dune::RangeError, "The size or the number of nonzero blocks of the jacobian ("
+                                             << numNonzeroes << ") exceeds the range of the matrix index type");
+        }
+
         // export pattern to jacobian
         occupationPattern.exportIdx(*jacobian_);
     }
@@ -426,8 +458,12 @@ private:
         try
         {
             // let the local assembler add the element contributions
+            // temporaries of the element (local views using an ArenaAllocator) are taken from the arena
             for (const auto& element : elements(gridView()))
+            {
+                ArenaScope arenaScope;
                 assembleElement(element);
+            }
 
             // if we get here, everything worked well on this process
             succeeded = true;
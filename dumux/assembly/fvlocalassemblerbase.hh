@@ -31,6 +31,7 @@
 #include <dumux/common/reservedblockvector.hh>
 #include <dumux/common/properties.hh>
 #include <dumux/common/parameters.hh>
+#include <dumux/common/instrumentation.hh>
 #include <dumux/assembly/diffmethod.hh>
 
 namespace Dumux {
@@ -165,6 +166,8 @@ public:
      */
     ElementResidualVector evalLocalFluxAndSourceResidual(const ElementVolumeVariables& elemVolVars) const
     {
+        static auto& record = Instrumentation::record("Assembly.FluxAndSource");
+        Instrumentation::ScopedTimer timer(record);
         return localResidual_.evalFluxAndSource(element_, fvGeometry_, elemVolVars, elemFluxVarsCache_, elemBcTypes_);
     }
 
@@ -175,6 +178,8 @@ public:
      */
     ElementResidualVector evalLocalStorageResidual() const
     {
+        static auto& record = Instrumentation::record("Assembly.Storage");
+        Instrumentation::ScopedTimer timer(record);
         return localResidual_.evalStorage(element_, fvGeometry_, prevElemVolVars_, curElemVolVars_);
     }
 
@@ -193,20 +198,31 @@ public:
         auto&& prevElemVolVars = this->prevElemVolVars();
         auto&& elemFluxVarsCache = this->elemFluxVarsCache();
 
+        static auto& volVarsRecord = Instrumentation::record("Assembly.VolumeVariables");
+        static auto& fluxVarsCacheRecord = Instrumentation::record("Assembly.FluxVariablesCache");
+
         // bind the caches
         fvGeometry.bind(element);
 
         if (isImplicit())
         {
-            curElemVolVars.bind(element, fvGeometry, curSol);
+            {
+                Instrumentation::ScopedTimer timer(volVarsRecord);
+                curElemVolVars.bind(element, fvGeometry, curSol);
+                if (!this->assembler().isStationaryProblem())
+                    prevElemVolVars.bindElement(element, fvGeometry, this->assembler().prevSol());
+            }
+            Instrumentation::ScopedTimer timer(fluxVarsCacheRecord);
             elemFluxVarsCache.bind(element, fvGeometry, curElemVolVars);
-            if (!this->assembler().isStationaryProblem())
-                prevElemVolVars.bindElement(element, fvGeometry, this->assembler().prevSol());
         }
         else
         {
-            curElemVolVars.bindElement(element, fvGeometry, curSol);
-            prevElemVolVars.bind(element, fvGeometry, prevSol);
+            {
+                Instrumentation::ScopedTimer timer(volVarsRecord);
+                curElemVolVars.bindElement(element, fvGeometry, curSol);
+                prevElemVolVars.bind(element, fvGeometry, prevSol);
+            }
+            Instrumentation::ScopedTimer timer(fluxVarsCacheRecord);
             elemFluxVarsCache.bind(element, fvGeometry, prevElemVolVars);
         }
     }
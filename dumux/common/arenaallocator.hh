@@ -0,0 +1,385 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Common
+ * \brief A per-thread monotonic arena and an allocator for short-lived temporaries (e.g. in the assembly)
+ */
+#ifndef DUMUX_COMMON_ARENA_ALLOCATOR_HH
+#define DUMUX_COMMON_ARENA_ALLOCATOR_HH
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include <dune/common/std/type_traits.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Common
+ * \brief Allocation statistics of arenas
+ */
+struct ArenaStatistics
+{
+    std::size_t numArenaAllocations = 0; //!< allocations served by an arena
+    std::size_t numHeapAllocations = 0;  //!< allocations of arena allocators outside of an arena scope
+    std::size_t numChunkAllocations = 0; //!< memory blocks requested from the heap by the arenas
+    std::size_t bytesAllocated = 0;      //!< bytes served by arenas
+    std::size_t peakUsage = 0;           //!< the maximum number of bytes in use at once (maximum over the arenas)
+    std::size_t capacity = 0;            //!< the number of bytes currently held by the arenas
+};
+
+/*!
+ * \ingroup Common
+ * \brief A monotonic memory arena with scoped release
+ *
+ * Memory is handed out by incrementing an offset into large chunks. Deallocation is
+ * a no-op (except for the most recent allocation) and the memory is released at once
+ * when the enclosing ArenaScope ends. After the outermost scope ended, the chunks are
+ * merged into one, so in the steady state no memory is requested from the heap anymore.
+ *
+ * Each thread has its own arena (see threadLocal()), so allocations never contend.
+ * The statistics of all arenas can be obtained with globalStatistics().
+ */
+class Arena
+{
+    struct Chunk
+    {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    struct Counter
+    {
+        // only the owning thread writes, so relaxed loads and stores suffice
+        void operator+=(std::size_t n) { value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+        void max(std::size_t n) { if (n > get()) value.store(n, std::memory_order_relaxed); }
+        void set(std::size_t n) { value.store(n, std::memory_order_relaxed); }
+        std::size_t get() const { return value.load(std::memory_order_relaxed); }
+        std::atomic<std::size_t> value{0};
+    };
+
+public:
+    //! A position in the arena
+    struct Mark
+    {
+        std::size_t chunk;
+        std::size_t offset;
+        std::size_t usage;
+    };
+
+    explicit Arena(std::size_t initialChunkSize = 64*1024)
+    : chunkSize_(initialChunkSize)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_());
+        registry_().push_back(this);
+    }
+
+    ~Arena()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_());
+        auto& registry = registry_();
+        registry.erase(std::find(registry.begin(), registry.end(), this));
+        accumulate_(retiredStatistics_());
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    //! The arena of the calling thread
+    static Arena& threadLocal()
+    {
+        static thread_local Arena arena;
+        return arena;
+    }
+
+    //! Allocate memory (only valid until the innermost active scope ends)
+    void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+        std::size_t offset = alignUp_(offset_, alignment);
+        if (chunks_.empty() || offset + bytes > chunks_[chunk_].size)
+        {
+            nextChunk_(bytes + alignment);
+            offset = alignUp_(offset_, alignment);
+        }
+
+        void* p = chunks_[chunk_].data.get() + offset;
+        last_ = p;
+        usage_ += offset + bytes - offset_;
+        offset_ = offset + bytes;
+
+        numArenaAllocations_ += 1;
+        bytesAllocated_ += bytes;
+        peakUsage_.max(usage_);
+        return p;
+    }
+
+    //! Deallocate memory (only the most recent allocation is actually freed)
+    void deallocate(void* p, std::size_t)
+    {
+        if (p == last_ && p != nullptr)
+        {
+            const auto offset = static_cast<std::size_t>(static_cast<std::byte*>(p) - chunks_[chunk_].data.get());
+            usage_ -= offset_ - offset;
+            offset_ = offset;
+            last_ = nullptr;
+        }
+    }
+
+    //! The current position (to be released to later)
+    Mark mark() const
+    { return {chunk_, offset_, usage_}; }
+
+    //! Release all memory allocated after the given mark
+    void release(const Mark& m)
+    {
+        chunk_ = m.chunk;
+        offset_ = m.offset;
+        usage_ = m.usage;
+        last_ = nullptr;
+    }
+
+    //! Whether an arena scope is active (only then arena allocators use the arena)
+    bool inScope() const
+    { return scopeDepth_ > 0; }
+
+    //! The statistics of this arena
+    ArenaStatistics statistics() const
+    {
+        ArenaStatistics s;
+        accumulate_(s);
+        return s;
+    }
+
+    //! The accumulated statistics of all arenas (including the ones of finished threads)
+    static ArenaStatistics globalStatistics()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_());
+        ArenaStatistics s = retiredStatistics_();
+        for (const auto* arena : registry_())
+            arena->accumulate_(s);
+        return s;
+    }
+
+private:
+    friend class ArenaScope;
+    template<class T> friend class ArenaAllocator;
+
+    void enterScope_()
+    { ++scopeDepth_; }
+
+    void leaveScope_()
+    {
+        // merge the chunks once nothing is in use anymore
+        if (--scopeDepth_ == 0 && chunks_.size() > 1)
+        {
+            std::size_t size = 0;
+            for (const auto& c : chunks_)
+                size += c.size;
+            chunks_.clear();
+            chunks_.push_back({std::make_unique<std::byte[]>(size), size});
+            numChunkAllocations_ += 1;
+            capacity_.set(size);
+            chunk_ = 0; offset_ = 0; usage_ = 0;
+        }
+    }
+
+    //! continue in the next chunk that has space for the given number of bytes
+    void nextChunk_(std::size_t bytes)
+    {
+        // reuse a following chunk if it is large enough, otherwise insert a new one
+        const std::size_t next = chunks_.empty() ? 0 : chunk_ + 1;
+        if (next >= chunks_.size() || chunks_[next].size < bytes)
+        {
+            const std::size_t size = std::max({bytes, chunkSize_, chunks_.empty() ? 0 : 2*chunks_[chunk_].size});
+            chunks_.insert(chunks_.begin() + next, Chunk{std::make_unique<std::byte[]>(size), size});
+            numChunkAllocations_ += 1;
+            capacity_ += size;
+        }
+
+        // the remainder of the current chunk counts as used until the scope is released
+        if (!chunks_.empty() && next > 0)
+            usage_ += chunks_[chunk_].size - offset_;
+        chunk_ = next;
+        offset_ = 0;
+    }
+
+    static std::size_t alignUp_(std::size_t offset, std::size_t alignment)
+    { return (offset + alignment - 1)/alignment*alignment; }
+
+    void accumulate_(ArenaStatistics& s) const
+    {
+        s.numArenaAllocations += numArenaAllocations_.get();
+        s.numHeapAllocations += numHeapAllocations_.get();
+        s.numChunkAllocations += numChunkAllocations_.get();
+        s.bytesAllocated += bytesAllocated_.get();
+        s.peakUsage = std::max(s.peakUsage, peakUsage_.get());
+        s.capacity += capacity_.get();
+    }
+
+    static std::mutex& registryMutex_()
+    { static std::mutex m; return m; }
+
+    static std::vector<const Arena*>& registry_()
+    { static std::vector<const Arena*> r; return r; }
+
+    static ArenaStatistics& retiredStatistics_()
+    { static ArenaStatistics s; return s; }
+
+    std::vector<Chunk> chunks_;
+    std::size_t chunkSize_;
+    std::size_t chunk_ = 0;
+    std::size_t offset_ = 0;
+    std::size_t usage_ = 0;
+    void* last_ = nullptr;
+    int scopeDepth_ = 0;
+
+    Counter numArenaAllocations_;
+    Counter numHeapAllocations_;
+    Counter numChunkAllocations_;
+    Counter bytesAllocated_;
+    Counter peakUsage_;
+    Counter capacity_;
+};
+
+/*!
+ * \ingroup Common
+ * \brief Activates the arena of the calling thread until the end of the scope.
+ *        All memory allocated from the arena within the scope is released at its end.
+ *
+ * The assembler opens a scope for the assembly of each element, so local views and
+ * other temporaries with arena allocators that are constructed for an element use the arena.
+ */
+class ArenaScope
+{
+public:
+    ArenaScope()
+    : arena_(Arena::threadLocal())
+    , mark_(arena_.mark())
+    { arena_.enterScope_(); }
+
+    ~ArenaScope()
+    {
+        arena_.release(mark_);
+        arena_.leaveScope_();
+    }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena& arena_;
+    Arena::Mark mark_;
+};
+
+/*!
+ * \ingroup Common
+ * \brief An allocator using the arena of the calling thread
+ *
+ * Whether the arena is used is decided when the allocator (i.e. the container using it)
+ * is constructed: within an ArenaScope, memory is taken from the arena, otherwise from the heap.
+ * Copies of containers get a new allocator, so a copy made outside of the scope uses the heap.
+ * \note Containers constructed within a scope must not outlive it (which is given for
+ *       objects with automatic storage duration constructed in the scope).
+ */
+template<class T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    ArenaAllocator()
+    : arena_(Arena::threadLocal().inScope() ? &Arena::threadLocal() : nullptr)
+    {}
+
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+    : arena_(other.arena())
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        if (arena_)
+            return static_cast<T*>(arena_->allocate(n*sizeof(T), alignof(T)));
+
+        Arena::threadLocal().numHeapAllocations_ += 1;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        if (arena_)
+            arena_->deallocate(p, n*sizeof(T));
+        else
+            std::allocator<T>().deallocate(p, n);
+    }
+
+    //! copies of containers decide anew whether to use the arena
+    ArenaAllocator select_on_container_copy_construction() const
+    { return ArenaAllocator(); }
+
+    //! whether this allocator uses an arena
+    bool usesArena() const
+    { return arena_ != nullptr; }
+
+    //! the arena used by this allocator (nullptr if the heap is used)
+    Arena* arena() const
+    { return arena_; }
+
+    template<class U>
+    friend bool operator==(const ArenaAllocator& a, const ArenaAllocator<U>& b)
+    { return a.arena() == b.arena(); }
+
+    template<class U>
+    friend bool operator!=(const ArenaAllocator& a, const ArenaAllocator<U>& b)
+    { return a.arena() != b.arena(); }
+
+private:
+    Arena* arena_;
+};
+
+namespace Detail {
+
+template<class Traits, class T>
+using LocalViewAllocatorDetector = typename Traits::template LocalViewAllocator<T>;
+
+/*!
+ * \ingroup Common
+ * \brief The allocator for temporary storage of local views: components opt into
+ *        e.g. the ArenaAllocator by defining `template<class T> using LocalViewAllocator = ...`
+ *        in their traits, the default is `std::allocator<T>`.
+ */
+template<class Traits, class T>
+using LocalViewAllocator = Dune::Std::detected_or_t<std::allocator<T>, LocalViewAllocatorDetector, Traits, T>;
+
+} // end namespace Detail
+
+} // end namespace Dumux
+
+#endif
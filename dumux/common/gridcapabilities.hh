@@ -64,6 +64,18 @@ static constexpr bool canCommunicate =
     Dune::Capabilities::canCommunicate<Grid, dofCodim>::v
     || Dumux::Temp::Capabilities::canCommunicate<Grid, dofCodim>::v;
 
+/*!
+ * \brief Whether entities of a grid can be obtained and iterated from several threads concurrently
+ * \note UGGrid uses internal state when creating entities and is not thread-safe
+ */
+template<class Grid>
+inline constexpr bool supportsMultithreading = true;
+
+#if HAVE_DUNE_UGGRID
+template<int dim>
+inline constexpr bool supportsMultithreading<Dune::UGGrid<dim>> = false;
+#endif // HAVE_DUNE_UGGRID
+
 } // namespace Dumux
 
 #endif
@@ -0,0 +1,296 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Common
+ * \brief Lightweight instrumentation with scoped timers and counters
+ */
+#ifndef DUMUX_COMMON_INSTRUMENTATION_HH
+#define DUMUX_COMMON_INSTRUMENTATION_HH
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <limits>
+#include <fstream>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/io/format.hh>
+
+namespace Dumux::Instrumentation {
+
+/*!
+ * \ingroup Common
+ * \brief The accumulated time and number of calls (or events) of an instrumented section
+ * \note The values are updated atomically, so records can be used from concurrent threads.
+ *       The times of concurrently executed scopes add up.
+ */
+struct Record
+{
+    std::atomic<std::int64_t> nanoseconds{0};
+    std::atomic<std::int64_t> count{0};
+};
+
+/*!
+ * \ingroup Common
+ * \brief The registry of all records of the program
+ *
+ * Instrumentation is disabled by default and enabled with the parameter `Instrumentation.Enable`
+ * (read on first use) or with setEnabled(). If disabled, timers and counters don't read the clock
+ * and don't touch the records, so the cost is a single branch.
+ */
+class Registry
+{
+public:
+    static Registry& instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    //! Get the record with the given name (created on first access). The reference stays valid.
+    Record& record(std::string_view name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = records_.find(name);
+        if (it == records_.end())
+            it = records_.emplace(std::string(name), std::make_unique<Record>()).first;
+        return *it->second;
+    }
+
+    //! If the instrumentation is enabled
+    bool enabled() const
+    {
+        const int state = state_.load(std::memory_order_relaxed);
+        if (state >= 0)
+            return state;
+
+        static const bool enableFromParams = getParam<bool>("Instrumentation.Enable", false);
+        return enableFromParams;
+    }
+
+    //! Enable or disable the instrumentation (overrides the parameter)
+    void setEnabled(bool enable = true)
+    { state_.store(enable ? 1 : 0, std::memory_order_relaxed); }
+
+    //! Reset all records to zero
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [name, record] : records_)
+        {
+            record->nanoseconds = 0;
+            record->count = 0;
+        }
+    }
+
+    //! Call f(name, seconds, count) for all records that were used, ordered by name
+    template<class F>
+    void forEachRecord(F&& f) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, record] : records_)
+            if (const auto count = record->count.load(); count > 0)
+                f(name, 1e-9*record->nanoseconds.load(), count);
+    }
+
+private:
+    Registry() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<Record>, std::less<>> records_;
+    std::atomic<int> state_{-1};
+};
+
+//! If the instrumentation is enabled
+inline bool enabled()
+{ return Registry::instance().enabled(); }
+
+/*!
+ * \ingroup Common
+ * \brief Get the record with the given name
+ * \note For sections executed very often, keep the reference in a static variable
+ *       to avoid the lookup, e.g. `static auto& record = Instrumentation::record("Assembly.Storage");`
+ */
+inline Record& record(std::string_view name)
+{ return Registry::instance().record(name); }
+
+//! Increment the counter of a record
+inline void count(Record& record, std::int64_t n = 1)
+{
+    if (enabled())
+        record.count.fetch_add(n, std::memory_order_relaxed);
+}
+
+/*!
+ * \ingroup Common
+ * \brief Measures the wall time between construction and destruction and
+ *        adds it to a record (also counting the number of calls)
+ */
+class ScopedTimer
+{
+    using Clock = std::chrono::steady_clock;
+
+public:
+    explicit ScopedTimer(Record& record)
+    : record_(enabled() ? &record : nullptr)
+    {
+        if (record_)
+            start_ = Clock::now();
+    }
+
+    //! Construct from a name (the record lookup is only done if the instrumentation is enabled)
+    explicit ScopedTimer(std::string_view name)
+    : record_(enabled() ? &Instrumentation::record(name) : nullptr)
+    {
+        if (record_)
+            start_ = Clock::now();
+    }
+
+    ~ScopedTimer()
+    {
+        if (record_)
+        {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_);
+            record_->nanoseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+            record_->count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Record* record_;
+    Clock::time_point start_;
+};
+
+/*!
+ * \ingroup Common
+ * \brief Write the report of all records aggregated over all processes
+ *
+ * On rank 0, the file `<Instrumentation.ReportFile>.json` (default `instrumentation.json`)
+ * or, with `Instrumentation.ReportFormat = csv`, `<Instrumentation.ReportFile>.csv` is written.
+ * For each record, the number of calls summed over all processes and the total,
+ * minimum, maximum and mean time per process are reported (min/max/mean only over the
+ * processes that used the record). Nothing is done if the instrumentation is disabled.
+ * \note This is collective, i.e. it has to be called on all processes.
+ */
+template<class Communicator = Dune::CollectiveCommunication<typename Dune::MPIHelper::MPICommunicator>>
+void writeReport(const Communicator& comm = Dune::MPIHelper::getCollectiveCommunication())
+{
+    if (!enabled())
+        return;
+
+    // serialize the local records (names separated by newlines)
+    std::string names;
+    std::vector<double> values;
+    Registry::instance().forEachRecord([&](const std::string& name, double seconds, std::int64_t count)
+    {
+        names += name + '\n';
+        values.push_back(seconds);
+        values.push_back(count);
+    });
+
+    // gather the records of all processes on rank 0
+    const int numProcesses = comm.size();
+    const auto gatherv = [&](const auto& local, auto& global)
+    {
+        int size = local.size();
+        std::vector<int> sizes(numProcesses), offsets(numProcesses, 0);
+        comm.gather(&size, sizes.data(), 1, 0);
+        for (int i = 1; i < numProcesses; ++i)
+            offsets[i] = offsets[i-1] + sizes[i-1];
+        global.resize(offsets.back() + sizes.back());
+        comm.gatherv(local.data(), size, global.data(), sizes.data(), offsets.data(), 0);
+    };
+
+    std::vector<char> allNames;
+    std::vector<double> allValues;
+    gatherv(std::vector<char>(names.begin(), names.end()), allNames);
+    gatherv(values, allValues);
+
+    if (comm.rank() != 0)
+        return;
+
+    struct Stats
+    {
+        double count = 0.0, total = 0.0, min = std::numeric_limits<double>::max(), max = 0.0;
+        int numProcesses = 0;
+    };
+
+    std::map<std::string, Stats> stats;
+    std::size_t valueIdx = 0;
+    auto nameBegin = allNames.begin();
+    while (nameBegin != allNames.end())
+    {
+        const auto nameEnd = std::find(nameBegin, allNames.end(), '\n');
+        auto& s = stats[std::string(nameBegin, nameEnd)];
+        const double seconds = allValues[valueIdx++];
+        s.count += allValues[valueIdx++];
+        s.total += seconds;
+        s.min = std::min(s.min, seconds);
+        s.max = std::max(s.max, seconds);
+        ++s.numProcesses;
+        nameBegin = std::next(nameEnd);
+    }
+
+    const auto fileName = getParam<std::string>("Instrumentation.ReportFile", "instrumentation");
+    const auto format = getParam<std::string>("Instrumentation.ReportFormat", "json");
+    if (format == "json")
+    {
+        std::ofstream file(fileName + ".json");
+        file << Fmt::format("{{\n  \"numProcesses\": {},\n  \"records\": [", numProcesses);
+        bool first = true;
+        for (const auto& [name, s] : stats)
+        {
+            file << Fmt::format("{}\n    {{\"name\": \"{}\", \"count\": {}, \"processes\": {}, "
+                                "\"time\": {{\"total\": {:.9g}, \"min\": {:.9g}, \"max\": {:.9g}, \"mean\": {:.9g}}}}}",
+                                first ? "" : ",", name, static_cast<std::int64_t>(s.count), s.numProcesses,
+                                s.total, s.min, s.max, s.total/s.numProcesses);
+            first = false;
+        }
+        file << "\n  ]\n}\n";
+    }
+    else if (format == "csv")
+    {
+        std::ofstream file(fileName + ".csv");
+        file << "name,count,processes,total,min,max,mean\n";
+        for (const auto& [name, s] : stats)
+            file << Fmt::format("{},{},{},{:.9g},{:.9g},{:.9g},{:.9g}\n",
+                                name, static_cast<std::int64_t>(s.count), s.numProcesses, s.total, s.min, s.max, s.total/s.numProcesses);
+    }
+    else
+        DUNE_THROW(Dune::InvalidStateException, "Unknown instrumentation report format " << format << " (use json or csv)");
+}
+
+} // end namespace Dumux::Instrumentation
+
+#endif
@@ -0,0 +1,137 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Common
+ * \brief Typed handles to run-time parameters that are resolved once
+ */
+#ifndef DUMUX_COMMON_PARAMETER_HANDLE_HH
+#define DUMUX_COMMON_PARAMETER_HANDLE_HH
+
+#include <string>
+#include <utility>
+
+#include <dumux/common/parameters.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Common
+ * \brief A typed handle to a run-time parameter
+ *
+ * The parameter is looked up (including the search in the parameter group, see getParamFromGroup)
+ * once when the handle is created and reading the handle afterwards is as cheap as reading a member variable.
+ * Handles are meant to be stored in the object owning the parameter group (e.g. a problem or a solver),
+ * which replaces function-local `static const` variables in hot code paths. In contrast to those,
+ * handles respect the parameter group, so different objects (e.g. sub-problems in multidomain simulations)
+ * can use different values.
+ *
+ * \code
+ * class MyProblem
+ * {
+ * public:
+ *     MyProblem(const std::string& paramGroup)
+ *     : upwindWeight_(paramHandleFromGroup<double>(paramGroup, "Flux.UpwindWeight"))
+ *     {}
+ *
+ *     double upwindWeight() const { return upwindWeight_; }
+ *
+ * private:
+ *     ParamHandle<double> upwindWeight_;
+ * };
+ * \endcode
+ *
+ * \note Like getParam, creating a handle marks the parameter as used. Later changes of the parameter tree
+ *       are not reflected by existing handles.
+ */
+template<class T>
+class ParamHandle
+{
+public:
+    using value_type = T;
+
+    //! A handle with a value-initialized value (e.g. to be assigned later)
+    ParamHandle() = default;
+
+    //! A handle to the given (already resolved) value of the given key
+    ParamHandle(T value, std::string key)
+    : value_(std::move(value)), key_(std::move(key))
+    {}
+
+    //! The parameter value
+    const T& get() const
+    { return value_; }
+
+    //! The parameter value
+    const T& operator*() const
+    { return value_; }
+
+    //! Access to the members of the parameter value
+    const T* operator->() const
+    { return &value_; }
+
+    //! Implicit conversion to the parameter value
+    operator const T&() const
+    { return value_; }
+
+    //! The key ("group:key" or "key") the handle was created for
+    const std::string& key() const
+    { return key_; }
+
+private:
+    T value_{};
+    std::string key_;
+};
+
+/*!
+ * \ingroup Common
+ * \brief Create a handle to a parameter (throws if the parameter doesn't exist and has no global default)
+ */
+template<class T>
+ParamHandle<T> paramHandle(const std::string& key)
+{ return { getParam<T>(key), key }; }
+
+/*!
+ * \ingroup Common
+ * \brief Create a handle to a parameter with a default value
+ */
+template<class T>
+ParamHandle<T> paramHandle(const std::string& key, const T& defaultValue)
+{ return { getParam<T>(key, defaultValue), key }; }
+
+/*!
+ * \ingroup Common
+ * \brief Create a handle to a parameter in a parameter group
+ *        (throws if the parameter doesn't exist and has no global default)
+ */
+template<class T>
+ParamHandle<T> paramHandleFromGroup(const std::string& paramGroup, const std::string& key)
+{ return { getParamFromGroup<T>(paramGroup, key), paramGroup.empty() ? key : paramGroup + ":" + key }; }
+
+/*!
+ * \ingroup Common
+ * \brief Create a handle to a parameter in a parameter group with a default value
+ */
+template<class T>
+ParamHandle<T> paramHandleFromGroup(const std::string& paramGroup, const std::string& key, const T& defaultValue)
+{ return { getParamFromGroup<T>(paramGroup, key, defaultValue), paramGroup.empty() ? key : paramGroup + ":" + key }; }
+
+} // end namespace Dumux
+
+#endif
@@ -176,6 +176,10 @@ void Parameters::init(const std::string& parameterFileName,
 void Parameters::print()
 {
     getTree().reportAll();
+
+    const auto& lookupRegistry = ParameterLookupRegistry::instance();
+    if (lookupRegistry.enabled())
+        lookupRegistry.report();
 }
 
 // Parse command line arguments into a parameter tree
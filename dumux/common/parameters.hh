@@ -30,6 +30,12 @@
 #include <unordered_map>
 #include <fstream>
 #include <functional>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 #include <dune/common/parametertree.hh>
 
@@ -141,6 +147,105 @@ private:
     static void mergeTreeImpl_(Dune::ParameterTree& target, const Dune::ParameterTree& source, bool overwrite, const std::string& group);
 };
 
+/*!
+ * \ingroup Common
+ * \brief Counts how often parameters are looked up with getParam and getParamFromGroup
+ *
+ * Each lookup concatenates strings and searches the parameter tree(s), so parameters that are
+ * looked up many times (e.g. in flux laws or constitutive relations) should be read once and stored,
+ * preferably in a ParamHandle (see dumux/common/parameterhandle.hh). The registry helps to find such lookups.
+ * Counting is disabled by default and enabled with the parameter `Parameter.CountLookups`
+ * (read on first use) or with setEnabled(). If enabled, Parameters::print() also reports the counts.
+ */
+class ParameterLookupRegistry
+{
+public:
+    static ParameterLookupRegistry& instance()
+    {
+        static ParameterLookupRegistry registry;
+        return registry;
+    }
+
+    //! If the lookups are counted
+    bool enabled() const
+    {
+        const int state = state_.load(std::memory_order_relaxed);
+        if (state >= 0)
+            return state;
+
+        static const bool enableFromParams = Parameters::getTree().get<bool>("Parameter.CountLookups", false);
+        return enableFromParams;
+    }
+
+    //! Enable or disable counting (overrides the parameter)
+    void setEnabled(bool enable = true)
+    { state_.store(enable ? 1 : 0, std::memory_order_relaxed); }
+
+    //! Count a lookup of key in the given group (empty for lookups without group)
+    void count(const std::string& paramGroup, const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++counts_[paramGroup.empty() ? key : paramGroup + ":" + key];
+    }
+
+    //! The number of lookups of key in the given group
+    std::size_t numLookups(const std::string& paramGroup, const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = counts_.find(paramGroup.empty() ? key : paramGroup + ":" + key);
+        return it != counts_.end() ? it->second : 0;
+    }
+
+    //! All counted lookups ("group:key" or "key" and count) sorted by descending count
+    std::vector<std::pair<std::string, std::size_t>> counts() const
+    {
+        std::vector<std::pair<std::string, std::size_t>> result;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            result.assign(counts_.begin(), counts_.end());
+        }
+
+        std::sort(result.begin(), result.end(), [](const auto& a, const auto& b)
+                  { return a.second > b.second || (a.second == b.second && a.first < b.first); });
+        return result;
+    }
+
+    //! Reset all counts
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        counts_.clear();
+    }
+
+    //! Print the counted lookups sorted by descending count
+    void report(std::ostream& stream = std::cout) const
+    {
+        stream << "\n# Parameter lookups (group:key = count):" << std::endl;
+        for (const auto& [key, count] : counts())
+            stream << key << " = " << count << std::endl;
+    }
+
+private:
+    ParameterLookupRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::size_t> counts_;
+    std::atomic<int> state_{-1};
+};
+
+namespace Detail {
+
+//! count a parameter lookup (the first argument after the group is the key)
+template<class Key, class... Args>
+void countParamLookup(const std::string& paramGroup, const Key& key, const Args&...)
+{
+    auto& registry = ParameterLookupRegistry::instance();
+    if (registry.enabled())
+        registry.count(paramGroup, key);
+}
+
+} // end namespace Detail
+
 /*!
  * \ingroup Common
  * \brief A free function to get a parameter from the parameter tree singleton
@@ -149,7 +254,10 @@ private:
  */
 template<typename T, typename... Args>
 T getParam(Args&&... args)
-{ return Parameters::getTree().template get<T>(std::forward<Args>(args)... ); }
+{
+    Detail::countParamLookup("", args...);
+    return Parameters::getTree().template get<T>(std::forward<Args>(args)... );
+}
 
 /*!
  * \ingroup Common
@@ -159,7 +267,10 @@ T getParam(Args&&... args)
  */
 template<typename T, typename... Args>
 T getParamFromGroup(Args&&... args)
-{ return Parameters::getTree().template getFromGroup<T>(std::forward<Args>(args)... ); }
+{
+    Detail::countParamLookup(args...);
+    return Parameters::getTree().template getFromGroup<T>(std::forward<Args>(args)... );
+}
 
 /*!
  * \ingroup Common
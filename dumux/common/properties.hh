@@ -66,6 +66,10 @@ struct BaseLocalResidual { using type = UndefinedProperty; };      //!< The type
 template<class TypeTag, class MyTypeTag>
 struct JacobianMatrix { using type = UndefinedProperty; };         //!< Type of the global jacobian matrix
 template<class TypeTag, class MyTypeTag>
+struct JacobianScalar { using type = UndefinedProperty; };         //!< The scalar type used to store the entries of the global jacobian matrix
+template<class TypeTag, class MyTypeTag>
+struct EnableCompactJacobianIndices { using type = UndefinedProperty; }; //!< Whether to store the column indices of the global jacobian matrix as 32-bit integers
+template<class TypeTag, class MyTypeTag>
 struct SolutionVector { using type = UndefinedProperty; };         //!< Vector containing all primary variable vector of the grid
 
 //! The type of the local residual function, i.e. the equation to be solved. Must inherit
@@ -0,0 +1,190 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Common
+ * \brief A vector with inline storage for a compile-time number of elements
+ */
+#ifndef DUMUX_COMMON_SMALL_VECTOR_HH
+#define DUMUX_COMMON_SMALL_VECTOR_HH
+
+#include <array>
+#include <vector>
+#include <cassert>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Common
+ * \brief A vector with inline storage for up to `capacity` elements
+ *        and a heap-allocated fallback for larger sizes
+ *
+ * Like Dune::ReservedVector, the inline storage is a fixed-size array, so no memory is allocated
+ * as long as the size does not exceed the compile-time capacity. If it does, the elements are moved
+ * to a std::vector. Clearing switches back to the inline storage but keeps the memory of the fallback,
+ * so a reused object allocates at most once. This makes it suitable for local views that are bound
+ * to one element after the other and whose size is known a priori for (most) grids.
+ *
+ * \note As for Dune::ReservedVector, the elements of the inline storage are default-constructed once
+ *       and resize() does not reset them, i.e. after shrinking and growing again the elements
+ *       keep their previous values. Users have to (re-)initialize the elements after resizing.
+ * \tparam T the element type (has to be default-constructible)
+ * \tparam capacity the number of elements stored inline (0 means pure heap storage)
+ */
+template<class T, std::size_t capacity>
+class SmallVector
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    //! the number of elements that can be stored without allocating memory
+    static constexpr std::size_t inlineCapacity = capacity;
+
+    SmallVector() = default;
+
+    //! Construct with n elements
+    explicit SmallVector(size_type n)
+    { resize(n); }
+
+    //! The number of elements
+    size_type size() const
+    { return size_; }
+
+    //! If the vector is empty
+    bool empty() const
+    { return size_ == 0; }
+
+    //! If the elements are stored in the heap-allocated fallback storage
+    bool isOnHeap() const
+    { return onHeap_; }
+
+    //! Remove all elements (the memory of the fallback storage is kept)
+    void clear()
+    {
+        heap_.clear();
+        onHeap_ = false;
+        size_ = 0;
+    }
+
+    //! Reserve memory in the fallback storage if more than `capacity` elements are requested
+    void reserve(size_type n)
+    {
+        if (n > capacity)
+            heap_.reserve(n);
+    }
+
+    //! Change the number of elements
+    void resize(size_type n)
+    {
+        if (onHeap_)
+            heap_.resize(n);
+        else if (n > capacity)
+        {
+            moveToHeap_();
+            heap_.resize(n);
+        }
+
+        size_ = n;
+    }
+
+    //! Append an element
+    void push_back(const T& value)
+    { emplace_back(value); }
+
+    //! Append an element
+    void push_back(T&& value)
+    { emplace_back(std::move(value)); }
+
+    //! Construct an element in place at the end
+    template<class... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (!onHeap_ && size_ == capacity)
+            moveToHeap_();
+
+        ++size_;
+        if (onHeap_)
+            return heap_.emplace_back(std::forward<Args>(args)...);
+
+        auto& element = inline_[size_-1];
+        element = T(std::forward<Args>(args)...);
+        return element;
+    }
+
+    //! Remove the last element
+    void pop_back()
+    {
+        assert(size_ > 0);
+        if (onHeap_)
+            heap_.pop_back();
+        --size_;
+    }
+
+    T& operator[] (size_type i)
+    { assert(i < size_); return data()[i]; }
+
+    const T& operator[] (size_type i) const
+    { assert(i < size_); return data()[i]; }
+
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[size_-1]; }
+    const T& back() const { return (*this)[size_-1]; }
+
+    T* data()
+    { return onHeap_ ? heap_.data() : inline_.data(); }
+
+    const T* data() const
+    { return onHeap_ ? heap_.data() : inline_.data(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size_; }
+    const_iterator cbegin() const { return data(); }
+    const_iterator cend() const { return data() + size_; }
+
+private:
+    //! move the elements of the inline storage to the fallback storage
+    void moveToHeap_()
+    {
+        heap_.clear();
+        heap_.reserve(std::max<size_type>(2*capacity, 1));
+        std::move(inline_.begin(), inline_.begin() + size_, std::back_inserter(heap_));
+        onHeap_ = true;
+    }
+
+    std::array<T, capacity> inline_;
+    std::vector<T> heap_;
+    size_type size_ = 0;
+    bool onHeap_ = false;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -38,6 +38,7 @@
 #include <dune/common/exceptions.hh>
 
 #include <dumux/common/parameters.hh>
+#include <dumux/common/instrumentation.hh>
 #include <dumux/io/format.hh>
 
 namespace Dumux {
@@ -372,6 +373,9 @@ public:
 
         if (verbose_)
             std::cout << Fmt::format("The cumulative CPU time was {:.5g} seconds.\n", cpuTime);
+
+        // write the report of the instrumented sections (if enabled)
+        Instrumentation::writeReport(comm);
     }
 
     //! If the time loop has verbose output
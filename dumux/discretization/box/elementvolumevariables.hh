@@ -27,6 +27,8 @@
 #include <type_traits>
 #include <utility>
 
+#include <dumux/common/smallvector.hh>
+#include <dumux/discretization/localview.hh>
 #include <dumux/discretization/box/elementsolution.hh>
 
 namespace Dumux {
@@ -127,6 +129,7 @@ private:
 /*!
  * \ingroup BoxDiscretization
  * \brief The local (stencil) volume variables class for box models without caching
+ * \note The volume variables are stored inline for up to 2^dim scvs, so binding doesn't allocate memory.
  */
 template<class GVV>
 class BoxElementVolumeVariables<GVV, /*cachingEnabled*/false>
@@ -213,8 +216,11 @@ public:
     { return *gridVolVarsPtr_; }
 
 private:
+    //! one volume variables object per scv (i.e. corner of the element)
+    static constexpr std::size_t maxNumScvs = Detail::maxNumElementScvs<typename GVV::Problem>();
+
     const GridVolumeVariables* gridVolVarsPtr_;
-    std::vector<VolumeVariables> volumeVariables_;
+    SmallVector<VolumeVariables, maxNumScvs> volumeVariables_;
 };
 
 } // end namespace Dumux
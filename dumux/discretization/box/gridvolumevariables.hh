@@ -24,10 +24,13 @@
 #ifndef DUMUX_DISCRETIZATION_BOX_GRID_VOLUMEVARIABLES_HH
 #define DUMUX_DISCRETIZATION_BOX_GRID_VOLUMEVARIABLES_HH
 
+#include <vector>
+#include <numeric>
 #include <type_traits>
 
 // make the local view function available whenever we use this class
 #include <dumux/discretization/localview.hh>
+#include <dumux/discretization/gridvolumevariablesstorage.hh>
 #include <dumux/discretization/box/elementvolumevariables.hh>
 #include <dumux/discretization/box/elementsolution.hh>
 
@@ -77,9 +80,20 @@ public:
     template<class GridGeometry, class SolutionVector>
     void update(const GridGeometry& gridGeometry, const SolutionVector& sol)
     {
-        volumeVariables_.resize(gridGeometry.gridView().size(0));
+        // the volume variables of all elements are stored contiguously,
+        // the volume variables of element eIdx start at offsets_[eIdx]
+        const auto& gridView = gridGeometry.gridView();
         auto fvGeometry = localView(gridGeometry);
-        for (const auto& element : elements(gridGeometry.gridView()))
+        offsets_.assign(gridView.size(0) + 1, 0);
+        for (const auto& element : elements(gridView))
+        {
+            fvGeometry.bindElement(element);
+            offsets_[gridGeometry.elementMapper().index(element) + 1] = fvGeometry.numScv();
+        }
+        std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+        volumeVariables_.resize(offsets_.back());
+        for (const auto& element : elements(gridView))
         {
             auto eIdx = gridGeometry.elementMapper().index(element);
             fvGeometry.bindElement(element);
@@ -88,32 +102,32 @@ public:
             auto elemSol = elementSolution(element, sol, gridGeometry);
 
             // update the volvars of the element
-            volumeVariables_[eIdx].resize(fvGeometry.numScv());
             for (auto&& scv : scvs(fvGeometry))
-                volumeVariables_[eIdx][scv.indexInElement()].update(elemSol, problem(), element, scv);
+                volumeVariables_[offsets_[eIdx] + scv.indexInElement()].update(elemSol, problem(), element, scv);
         }
     }
 
     template<class SubControlVolume, typename std::enable_if_t<!std::is_integral<SubControlVolume>::value, int> = 0>
     const VolumeVariables& volVars(const SubControlVolume& scv) const
-    { return volumeVariables_[scv.elementIndex()][scv.indexInElement()]; }
+    { return volumeVariables_[offsets_[scv.elementIndex()] + scv.indexInElement()]; }
 
     template<class SubControlVolume, typename std::enable_if_t<!std::is_integral<SubControlVolume>::value, int> = 0>
     VolumeVariables& volVars(const SubControlVolume& scv)
-    { return volumeVariables_[scv.elementIndex()][scv.indexInElement()]; }
+    { return volumeVariables_[offsets_[scv.elementIndex()] + scv.indexInElement()]; }
 
     const VolumeVariables& volVars(const std::size_t eIdx, const std::size_t scvIdx) const
-    { return volumeVariables_[eIdx][scvIdx]; }
+    { return volumeVariables_[offsets_[eIdx] + scvIdx]; }
 
     VolumeVariables& volVars(const std::size_t eIdx, const std::size_t scvIdx)
-    { return volumeVariables_[eIdx][scvIdx]; }
+    { return volumeVariables_[offsets_[eIdx] + scvIdx]; }
 
     const Problem& problem() const
     { return *problemPtr_; }
 
 private:
     const Problem* problemPtr_;
-    std::vector<std::vector<VolumeVariables>> volumeVariables_;
+    std::vector<std::size_t> offsets_;
+    Detail::GridVolumeVariablesStorage<VolumeVariables> volumeVariables_;
 };
 
 
@@ -29,6 +29,7 @@
 
 // make the local view function available whenever we use this class
 #include <dumux/discretization/localview.hh>
+#include <dumux/discretization/gridvolumevariablesstorage.hh>
 #include <dumux/discretization/cellcentered/elementsolution.hh>
 
 namespace Dumux {
@@ -109,7 +110,7 @@ public:
 
 private:
     const Problem* problemPtr_;
-    std::vector<VolumeVariables> volumeVariables_;
+    Detail::GridVolumeVariablesStorage<VolumeVariables> volumeVariables_;
 };
 
 
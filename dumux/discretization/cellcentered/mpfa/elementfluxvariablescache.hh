@@ -32,21 +32,25 @@
 
 #include <dune/common/exceptions.hh>
 
+#include <dumux/common/arenaallocator.hh>
+
 namespace Dumux {
 
 /*!
  * \ingroup CCMpfaDiscretization
  * \brief Structure to store interaction volumes and data handles
+ * \tparam Allocator the allocator template used for the containers
  */
 template<class PrimaryIV, class PrimaryIVDataHandle,
-         class SecondaryIV, class SecondaryIVDataHandle>
+         class SecondaryIV, class SecondaryIVDataHandle,
+         template<class> class Allocator = std::allocator>
 struct InteractionVolumeDataStorage
 {
-    std::vector<PrimaryIV> primaryInteractionVolumes;
-    std::vector<SecondaryIV> secondaryInteractionVolumes;
+    std::vector<PrimaryIV, Allocator<PrimaryIV>> primaryInteractionVolumes;
+    std::vector<SecondaryIV, Allocator<SecondaryIV>> secondaryInteractionVolumes;
 
-    std::vector<PrimaryIVDataHandle> primaryDataHandles;
-    std::vector<SecondaryIVDataHandle> secondaryDataHandles;
+    std::vector<PrimaryIVDataHandle, Allocator<PrimaryIVDataHandle>> primaryDataHandles;
+    std::vector<SecondaryIVDataHandle, Allocator<SecondaryIVDataHandle>> secondaryDataHandles;
 };
 
 /*!
@@ -90,6 +94,10 @@ private:
     //! the flux variable cache filler type
     using FluxVariablesCacheFiller = typename GFVC::Traits::FluxVariablesCacheFiller;
 
+    //! the allocator used for the temporary storage (see CCMpfaDefaultGridFluxVariablesCacheTraits)
+    template<class T>
+    using Allocator = Detail::LocalViewAllocator<typename GFVC::Traits, T>;
+
     //! Class to store the flux variables caches related to boundary interaction volumes
     class BoundaryCacheData
     {
@@ -126,14 +134,15 @@ private:
             return std::distance(cacheScvfIndices_.begin(), it);
         }
 
-        std::vector<std::size_t> cacheScvfIndices_;
-        std::vector<FluxVariablesCache> fluxVarCaches_;
+        std::vector<std::size_t, Allocator<std::size_t>> cacheScvfIndices_;
+        std::vector<FluxVariablesCache, Allocator<FluxVariablesCache>> fluxVarCaches_;
 
         // stored boundary interaction volumes and handles
         using IVDataStorage = InteractionVolumeDataStorage<PrimaryInteractionVolume,
                                                            PrimaryIvDataHandle,
                                                            SecondaryInteractionVolume,
-                                                           SecondaryIvDataHandle>;
+                                                           SecondaryIvDataHandle,
+                                                           Allocator>;
         IVDataStorage ivDataStorage_;
     };
 
@@ -414,6 +423,10 @@ class CCMpfaElementFluxVariablesCache<GFVC, false>
     //! the flux variable cache filler type
     using FluxVariablesCacheFiller = typename GFVC::Traits::FluxVariablesCacheFiller;
 
+    //! the allocator used for the temporary storage (see CCMpfaDefaultGridFluxVariablesCacheTraits)
+    template<class T>
+    using Allocator = Detail::LocalViewAllocator<typename GFVC::Traits, T>;
+
 public:
     //! export the interaction volume types
     using PrimaryInteractionVolume = typename GFVC::PrimaryInteractionVolume;
@@ -691,14 +704,15 @@ private:
     }
 
     // the local flux vars caches and corresponding indices
-    std::vector<FluxVariablesCache> fluxVarsCache_;
-    std::vector<std::size_t> globalScvfIndices_;
+    std::vector<FluxVariablesCache, Allocator<FluxVariablesCache>> fluxVarsCache_;
+    std::vector<std::size_t, Allocator<std::size_t>> globalScvfIndices_;
 
     // stored interaction volumes and handles
     using IVDataStorage = InteractionVolumeDataStorage<PrimaryInteractionVolume,
                                                        PrimaryIvDataHandle,
                                                        SecondaryInteractionVolume,
-                                                       SecondaryIvDataHandle>;
+                                                       SecondaryIvDataHandle,
+                                                       Allocator>;
     IVDataStorage ivDataStorage_;
 };
 
@@ -28,8 +28,8 @@
 #include <type_traits>
 #include <utility>
 #include <vector>
-#include <utility>
 
+#include <dumux/common/arenaallocator.hh>
 #include <dumux/discretization/cellcentered/elementsolution.hh>
 
 namespace Dumux {
@@ -78,9 +78,9 @@ namespace CCMpfa {
      * \param fvGeometry    The element finite volume geometry
      * \param nodalIndexSet The dual grid index set around a node
      */
-    template<class VolumeVariables, class IndexType, class Problem, class FVElemGeom, class NodalIndexSet>
-    void addBoundaryVolVarsAtNode(std::vector<VolumeVariables>& volVars,
-                                  std::vector<IndexType>& volVarIndices,
+    template<class VolumeVariables, class VolVarAlloc, class IndexType, class IndexAlloc, class Problem, class FVElemGeom, class NodalIndexSet>
+    void addBoundaryVolVarsAtNode(std::vector<VolumeVariables, VolVarAlloc>& volVars,
+                                  std::vector<IndexType, IndexAlloc>& volVarIndices,
                                   const Problem& problem,
                                   const typename FVElemGeom::GridGeometry::GridView::template Codim<0>::Entity& element,
                                   const FVElemGeom& fvGeometry,
@@ -132,9 +132,9 @@ namespace CCMpfa {
      * \param element        The element to which the finite volume geometry was bound
      * \param fvGeometry    The element finite volume geometry
      */
-    template<class VolumeVariables, class IndexType, class Problem, class FVElemGeom>
-    void addBoundaryVolVars(std::vector<VolumeVariables>& volVars,
-                            std::vector<IndexType>& volVarIndices,
+    template<class VolumeVariables, class VolVarAlloc, class IndexType, class IndexAlloc, class Problem, class FVElemGeom>
+    void addBoundaryVolVars(std::vector<VolumeVariables, VolVarAlloc>& volVars,
+                            std::vector<IndexType, IndexAlloc>& volVarIndices,
                             const Problem& problem,
                             const typename FVElemGeom::GridGeometry::GridView::template Codim<0>::Entity& element,
                             const FVElemGeom& fvGeometry)
@@ -316,8 +316,11 @@ private:
     const GridVolumeVariables* gridVolVarsPtr_;
 
     std::size_t numScv_;
-    std::vector<std::size_t> boundaryVolVarIndices_;
-    std::vector<VolumeVariables> boundaryVolVars_;
+    template<class T>
+    using Allocator = Detail::LocalViewAllocator<GridVolumeVariables, T>;
+
+    std::vector<std::size_t, Allocator<std::size_t>> boundaryVolVarIndices_;
+    std::vector<VolumeVariables, Allocator<VolumeVariables>> boundaryVolVars_;
 };
 
 
@@ -516,8 +519,11 @@ private:
         return std::distance(volVarIndices_.begin(), it);
     }
 
-    std::vector<std::size_t> volVarIndices_;
-    std::vector<VolumeVariables> volumeVariables_;
+    template<class T>
+    using Allocator = Detail::LocalViewAllocator<GridVolumeVariables, T>;
+
+    std::vector<std::size_t, Allocator<std::size_t>> volVarIndices_;
+    std::vector<VolumeVariables, Allocator<VolumeVariables>> volumeVariables_;
 };
 
 } // end namespace Dumux
@@ -67,6 +67,10 @@ struct CCMpfaDefaultGridFluxVariablesCacheTraits
     template<class GridFluxVariablesCache, bool cachingEnabled>
     using LocalView = CCMpfaElementFluxVariablesCache<GridFluxVariablesCache, cachingEnabled>;
 
+    // The local views store their temporaries with std::allocator. Traits deriving from
+    // these may define `template<class T> using LocalViewAllocator = ArenaAllocator<T>;`
+    // to take this memory from the per-thread arena during the assembly instead.
+
     // Reserve memory (over-) estimate for interaction volumes and corresponding data.
     // The overestimate doesn't hurt as we are not in a memory-limited configuration.
     // We need to avoid reallocation because in the caches we store pointers to the data handles.
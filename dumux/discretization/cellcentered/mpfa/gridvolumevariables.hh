@@ -24,6 +24,7 @@
 #ifndef DUMUX_DISCRETIZATION_CC_MPFA_GRID_VOLUMEVARIABLES_HH
 #define DUMUX_DISCRETIZATION_CC_MPFA_GRID_VOLUMEVARIABLES_HH
 
+#include <dumux/common/arenaallocator.hh>
 #include <dumux/discretization/cellcentered/mpfa/elementvolumevariables.hh>
 #include <dumux/discretization/cellcentered/gridvolumevariables.hh>
 
@@ -46,6 +47,7 @@ struct CCMpfaDefaultGridVolumeVariablesTraits
  * \tparam Problem the type of problem we are solving
  * \tparam VolumeVariables the type of volume variables we are using for the model
  * \tparam Traits the traits class injecting the problem, volVar and elemVolVars type
+ *         (and optionally the allocator `LocalViewAllocator<T>` for the storage of the local views)
  * \tparam cachingEnabled if the cache is enabled
  */
 template<class Problem,
@@ -57,6 +59,10 @@ class CCMpfaGridVolumeVariables : public CCGridVolumeVariables<Traits, cachingEn
 public:
     using ParentType = CCGridVolumeVariables<Traits, cachingEnabled>;
     using ParentType::ParentType;
+
+    //! export the allocator used by the local views for temporary storage
+    template<class T>
+    using LocalViewAllocator = Detail::LocalViewAllocator<Traits, T>;
 };
 
 } // end namespace Dumux
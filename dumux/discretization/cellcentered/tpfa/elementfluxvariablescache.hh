@@ -26,11 +26,13 @@
 
 #include <algorithm>
 #include <cassert>
-#include <vector>
 #include <utility>
 
 #include <dune/common/exceptions.hh>
 
+#include <dumux/common/smallvector.hh>
+#include <dumux/discretization/localview.hh>
+
 namespace Dumux {
 
 /*!
@@ -148,6 +150,9 @@ private:
 /*!
  * \ingroup CCTpfaDiscretization
  * \brief The flux variables caches for an element with caching disabled
+ * \note The caches are stored inline for conforming grids (the element faces and one face
+ *       per neighbor), so binding doesn't allocate memory. More caches (e.g. on non-conforming
+ *       grids or network grids) are stored on the heap.
  */
 template<class GFVC>
 class CCTpfaElementFluxVariablesCache<GFVC, false>
@@ -155,6 +160,9 @@ class CCTpfaElementFluxVariablesCache<GFVC, false>
     //! the type of the flux variables cache filler
     using FluxVariablesCacheFiller = typename GFVC::Traits::FluxVariablesCacheFiller;
 
+    //! the faces of the element and the corresponding faces of the neighbors
+    static constexpr std::size_t stencilCapacity = 2*Detail::maxNumElementScvfs<typename GFVC::Problem>();
+
 public:
     //! export the type of the grid flux variables cache
     using GridFluxVariablesCache = GFVC;
@@ -386,8 +394,8 @@ private:
         return std::distance(globalScvfIndices_.begin(), it);
     }
 
-    std::vector<FluxVariablesCache> fluxVarsCache_;
-    std::vector<std::size_t> globalScvfIndices_;
+    SmallVector<FluxVariablesCache, stencilCapacity> fluxVarsCache_;
+    SmallVector<std::size_t, stencilCapacity> globalScvfIndices_;
 };
 
 } // end namespace Dumux
@@ -26,9 +26,10 @@
 
 #include <algorithm>
 #include <type_traits>
-#include <vector>
 #include <utility>
 
+#include <dumux/common/smallvector.hh>
+#include <dumux/discretization/localview.hh>
 #include <dumux/discretization/cellcentered/elementsolution.hh>
 
 namespace Dumux {
@@ -48,10 +49,15 @@ class CCTpfaElementVolumeVariables
  * \ingroup CCTpfaDiscretization
  * \brief The local (stencil) volume variables class for cell centered tpfa models with caching
  * \note the volume variables are stored for the whole grid view in the corresponding GridVolumeVariables class
+ * \note The boundary volume variables are stored inline for up to one per element face,
+ *       so binding doesn't allocate memory.
  */
 template<class GVV>
 class CCTpfaElementVolumeVariables<GVV, /*cachingEnabled*/true>
 {
+    //! at most one boundary volume variables object per element face
+    static constexpr std::size_t maxNumBoundaryVolVars = Detail::maxNumElementScvfs<typename GVV::Problem>();
+
 public:
     //! export type of the grid volume variables
     using GridVolumeVariables = GVV;
@@ -192,18 +198,24 @@ private:
         return std::distance(boundaryVolVarIndices_.begin(), it);
     }
 
-    std::vector<std::size_t> boundaryVolVarIndices_;
-    std::vector<VolumeVariables> boundaryVolumeVariables_;
+    SmallVector<std::size_t, maxNumBoundaryVolVars> boundaryVolVarIndices_;
+    SmallVector<VolumeVariables, maxNumBoundaryVolVars> boundaryVolumeVariables_;
     const std::size_t numScv_;
 };
 
 /*!
  * \ingroup CCTpfaDiscretization
  * \brief The local (stencil) volume variables class for cell centered tpfa models with caching
+ * \note The volume variables of the stencil are stored inline for conforming grids (one neighbor or
+ *       boundary per element face), so binding doesn't allocate memory. Larger stencils
+ *       (e.g. on non-conforming grids) are stored on the heap.
  */
 template<class GVV>
 class CCTpfaElementVolumeVariables<GVV, /*cachingEnabled*/false>
 {
+    //! the element and one neighbor (or boundary) per element face
+    static constexpr std::size_t stencilCapacity = Detail::maxNumElementScvfs<typename GVV::Problem>() + 1;
+
 public:
     //! export type of the grid volume variables
     using GridVolumeVariables = GVV;
@@ -405,8 +417,8 @@ private:
         return std::distance(volVarIndices_.begin(), it);
     }
 
-    std::vector<std::size_t> volVarIndices_;
-    std::vector<VolumeVariables> volumeVariables_;
+    SmallVector<std::size_t, stencilCapacity> volVarIndices_;
+    SmallVector<VolumeVariables, stencilCapacity> volumeVariables_;
 };
 
 } // end namespace Dumux
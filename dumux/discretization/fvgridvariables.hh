@@ -28,6 +28,8 @@
 #include <type_traits>
 #include <memory>
 
+#include <dumux/common/instrumentation.hh>
+
 namespace Dumux {
 
 /*!
@@ -72,6 +74,8 @@ public:
     template<class SolutionVector>
     void init(const SolutionVector& curSol)
     {
+        Instrumentation::ScopedTimer timer("GridVariables.Init");
+
         // resize and update the volVars with the initial solution
         curGridVolVars_.update(*gridGeometry_, curSol);
 
@@ -89,6 +93,8 @@ public:
     template<class SolutionVector>
     void update(const SolutionVector& curSol, bool forceFluxCacheUpdate = false)
     {
+        Instrumentation::ScopedTimer timer("GridVariables.Update");
+
         // resize and update the volVars with the initial solution
         curGridVolVars_.update(*gridGeometry_, curSol);
 
@@ -114,6 +120,8 @@ public:
      */
     void advanceTimeStep()
     {
+        Instrumentation::ScopedTimer timer("GridVariables.AdvanceTimeStep");
+
         prevGridVolVars_ = curGridVolVars_;
     }
 
@@ -121,6 +129,8 @@ public:
     template<class SolutionVector>
     void resetTimeStep(const SolutionVector& solution)
     {
+        Instrumentation::ScopedTimer timer("GridVariables.ResetTimeStep");
+
         // set the new time step vol vars to old vol vars
         curGridVolVars_ = prevGridVolVars_;
 
@@ -25,6 +25,8 @@
 #ifndef DUMUX_FV_PROPERTIES_HH
 #define DUMUX_FV_PROPERTIES_HH
 
+#include <type_traits>
+
 #include <dune/istl/bvector.hh>
 #include <dune/istl/bcrsmatrix.hh>
 
@@ -33,6 +35,7 @@
 #include <dumux/common/boundarytypes.hh>
 
 #include <dumux/discretization/fvgridvariables.hh>
+#include <dumux/linear/compactbcrsmatrix.hh>
 
 namespace Dumux {
 namespace Properties {
@@ -74,16 +77,29 @@ struct EnableGridFluxVariablesCache<TypeTag, TTag::FiniteVolumeModel> { static c
 template<class TypeTag>
 struct SolutionVector<TypeTag, TTag::FiniteVolumeModel> { using type = Dune::BlockVector<GetPropType<TypeTag, Properties::PrimaryVariables>>; };
 
+//! The jacobian entries are stored with the precision of the model by default
+template<class TypeTag>
+struct JacobianScalar<TypeTag, TTag::FiniteVolumeModel> { using type = GetPropType<TypeTag, Properties::Scalar>; };
+
+//! The jacobian uses the default index type of Dune::BCRSMatrix by default
+template<class TypeTag>
+struct EnableCompactJacobianIndices<TypeTag, TTag::FiniteVolumeModel> { static constexpr bool value = false; };
+
 //! Set the type of a global jacobian matrix from the solution types TODO: move to LinearAlgebra traits
+//! \note Setting JacobianScalar to float halves the memory of the matrix blocks. The derivatives are
+//!       still computed in the precision of Scalar and the linear solvers use vectors of type Scalar.
+//!       This is only supported for cell-centered schemes with numeric differentiation, where each
+//!       entry is written once (box would accumulate the element contributions in single precision).
 template<class TypeTag>
 struct JacobianMatrix<TypeTag, TTag::FiniteVolumeModel>
 {
 private:
-    using Scalar = GetPropType<TypeTag, Properties::Scalar>;
+    using BlockScalar = GetPropType<TypeTag, Properties::JacobianScalar>;
     enum { numEq = GetPropType<TypeTag, Properties::ModelTraits>::numEq() };
-    using MatrixBlock = typename Dune::FieldMatrix<Scalar, numEq, numEq>;
+    using MatrixBlock = typename Dune::FieldMatrix<BlockScalar, numEq, numEq>;
+    static constexpr bool compactIndices = getPropValue<TypeTag, Properties::EnableCompactJacobianIndices>();
 public:
-    using type = typename Dune::BCRSMatrix<MatrixBlock>;
+    using type = std::conditional_t<compactIndices, CompactBCRSMatrix<MatrixBlock>, Dune::BCRSMatrix<MatrixBlock>>;
 };
 
 } // namespace Properties
@@ -0,0 +1,411 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Discretization
+ * \brief Snapshots of the grid variables for the rollback of time steps
+ */
+#ifndef DUMUX_DISCRETIZATION_GRID_VARIABLES_SNAPSHOTS_HH
+#define DUMUX_DISCRETIZATION_GRID_VARIABLES_SNAPSHOTS_HH
+
+#include <deque>
+#include <limits>
+#include <vector>
+#include <string>
+#include <cassert>
+#include <cstring>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <type_traits>
+
+#include <dune/common/exceptions.hh>
+#include <dune/grid/common/rangegenerators.hh>
+#include <dune/istl/bvector.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/common/instrumentation.hh>
+#include <dumux/discretization/localview.hh>
+#include <dumux/discretization/gridvolumevariablesstorage.hh>
+
+namespace Dumux {
+
+namespace Detail {
+
+/*!
+ * \ingroup Discretization
+ * \brief A buffer storing an array of trivially copyable objects, optionally compressed
+ *
+ * The compression is lossless: the bytes of each object are combined with the bytes of
+ * the previous object by exclusive or, the resulting bytes are grouped by their position
+ * within the objects (byte shuffling), and runs of zero bytes are run-length encoded.
+ * This is efficient for quantities that are constant (e.g. parameters or phase states)
+ * or vary smoothly (e.g. the leading bytes of floating point numbers) between neighboring entries.
+ *
+ * \tparam T the type of the stored objects
+ * \tparam Count the unsigned integer type storing the run lengths (longer runs are split)
+ */
+template<class T, class Count = std::uint32_t>
+class CompactArray
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be stored as bytes");
+    static_assert(std::is_unsigned_v<Count>, "Run lengths are stored as unsigned integers");
+    using Byte = unsigned char;
+
+    //! zero runs shorter than this are stored as literals (a run costs two counts)
+    static constexpr std::size_t minZeroRun = 4*sizeof(Count);
+    //! the maximum length of a run
+    static constexpr std::size_t maxCount = std::numeric_limits<Count>::max();
+
+public:
+    CompactArray() = default;
+
+    //! Store the given array
+    CompactArray(const T* data, std::size_t size, bool compress)
+    : size_(size)
+    , compressed_(compress)
+    {
+        const std::size_t numBytes = size*sizeof(T);
+        if (!compress)
+        {
+            bytes_.resize(numBytes);
+            if (numBytes > 0)
+                std::memcpy(bytes_.data(), data, numBytes);
+            return;
+        }
+
+        // delta to the previous entry and shuffling
+        const auto* in = reinterpret_cast<const Byte*>(data);
+        std::vector<Byte> shuffled(numBytes);
+        for (std::size_t i = 0; i < size; ++i)
+            for (std::size_t j = 0; j < sizeof(T); ++j)
+                shuffled[j*size + i] = i == 0 ? in[j] : in[i*sizeof(T) + j] ^ in[(i-1)*sizeof(T) + j];
+
+        // run-length encoding of zeros: a sequence of (number of zeros, number of literals, literals)
+        const auto zeroRun = [&](std::size_t pos)
+        {
+            std::size_t end = pos;
+            while (end < numBytes && shuffled[end] == 0)
+                ++end;
+            return end - pos;
+        };
+
+        // runs longer than the maximum count are split (a zero run into runs followed by no literals)
+        std::size_t pos = 0;
+        while (pos < numBytes)
+        {
+            const std::size_t numZeros = std::min(zeroRun(pos), maxCount);
+            const std::size_t literalBegin = pos + numZeros;
+            const std::size_t literalMaxEnd = literalBegin + std::min(numBytes - literalBegin, maxCount);
+            std::size_t literalEnd = literalBegin;
+            while (literalEnd < literalMaxEnd)
+            {
+                if (shuffled[literalEnd] != 0)
+                    ++literalEnd;
+                else
+                {
+                    const auto run = zeroRun(literalEnd);
+                    if (run >= minZeroRun || literalEnd + run == numBytes)
+                        break;
+                    literalEnd = std::min(literalEnd + run, literalMaxEnd);
+                }
+            }
+
+            appendCount_(numZeros);
+            appendCount_(literalEnd - literalBegin);
+            bytes_.insert(bytes_.end(), shuffled.begin() + literalBegin, shuffled.begin() + literalEnd);
+            pos = literalEnd;
+        }
+
+        bytes_.shrink_to_fit();
+    }
+
+    //! Copy the stored array to data (which has to have space for size() entries)
+    void extract(T* data) const
+    {
+        const std::size_t numBytes = size_*sizeof(T);
+        if (!compressed_)
+        {
+            if (numBytes > 0)
+                std::memcpy(data, bytes_.data(), numBytes);
+            return;
+        }
+
+        // decode the zero runs
+        std::vector<Byte> shuffled(numBytes, 0);
+        std::size_t pos = 0, offset = 0;
+        while (offset < bytes_.size())
+        {
+            pos += readCount_(offset);
+            const std::size_t numLiterals = readCount_(offset);
+            std::copy(bytes_.begin() + offset, bytes_.begin() + offset + numLiterals, shuffled.begin() + pos);
+            offset += numLiterals;
+            pos += numLiterals;
+        }
+
+        // undo the shuffling and the delta
+        auto* out = reinterpret_cast<Byte*>(data);
+        for (std::size_t i = 0; i < size_; ++i)
+            for (std::size_t j = 0; j < sizeof(T); ++j)
+                out[i*sizeof(T) + j] = i == 0 ? shuffled[j*size_] : shuffled[j*size_ + i] ^ out[(i-1)*sizeof(T) + j];
+    }
+
+    //! The number of stored entries
+    std::size_t size() const
+    { return size_; }
+
+    //! Whether the array is stored compressed
+    bool compressed() const
+    { return compressed_; }
+
+    //! The number of bytes used to store the array
+    std::size_t memoryUsage() const
+    { return bytes_.size(); }
+
+private:
+    void appendCount_(std::size_t count)
+    {
+        assert(count <= maxCount);
+        const auto c = static_cast<Count>(count);
+        Byte buffer[sizeof(Count)];
+        std::memcpy(buffer, &c, sizeof(Count));
+        bytes_.insert(bytes_.end(), buffer, buffer + sizeof(Count));
+    }
+
+    std::size_t readCount_(std::size_t& offset) const
+    {
+        Count c;
+        std::memcpy(&c, bytes_.data() + offset, sizeof(Count));
+        offset += sizeof(Count);
+        return c;
+    }
+
+    std::size_t size_ = 0;
+    bool compressed_ = false;
+    std::vector<Byte> bytes_;
+};
+
+//! How solution vectors are stored in a snapshot (block vectors of trivially copyable blocks in compact arrays)
+template<class SolutionVector>
+struct SnapshotSolutionStorage
+{ using type = SolutionVector; };
+
+template<class Block, class Alloc>
+struct SnapshotSolutionStorage<Dune::BlockVector<Block, Alloc>>
+{
+    using type = std::conditional_t<std::is_trivially_copyable_v<Block>,
+                                    CompactArray<Block>, Dune::BlockVector<Block, Alloc>>;
+};
+
+} // end namespace Detail
+
+/*!
+ * \ingroup Discretization
+ * \brief Snapshots of the grid variables for the rollback of time steps
+ *
+ * A snapshot contains the solution, the (cached) volume variables and the flux
+ * variables cache at the time it was taken. Restoring a snapshot is a memory copy,
+ * i.e. no volume variables (and thus no fluid system) have to be evaluated. This is
+ * useful if the nonlinear solver fails and the time step has to be repeated with a
+ * smaller time step size, also several time steps back if several snapshots are kept.
+ *
+ * The volume variables of grid volume variables with enabled caching (and the default storage)
+ * and block vector solutions are stored in compact buffers (see Detail::CompactArray)
+ * that may optionally be compressed. Otherwise, the objects are copied.
+ *
+ * Snapshots are meant to be taken at the beginning of a time step, i.e. after
+ * `advanceTimeStep()` was called on the grid variables. Restoring a snapshot
+ * sets both the current and previous volume variables. After grid adaption,
+ * all snapshots have to be cleared.
+ *
+ * The following run-time parameters are used
+ *  - Snapshots.MaxNumSnapshots: the number of snapshots to keep, older ones are discarded (default 1)
+ *  - Snapshots.Compress: whether to compress the compact buffers (default false)
+ *
+ * \tparam GridVariables the (finite volume) grid variables type
+ * \tparam SolutionVector the solution vector type
+ */
+template<class GridVariables, class SolutionVector>
+class GridVariablesSnapshots
+{
+    using GridVolumeVariables = typename GridVariables::GridVolumeVariables;
+    using GridFluxVariablesCache = typename GridVariables::GridFluxVariablesCache;
+    using VolumeVariables = typename GridVolumeVariables::VolumeVariables;
+
+    static constexpr bool compactVolVars = GridVolumeVariables::cachingEnabled
+        && std::is_same_v<Detail::GridVolumeVariablesStorage<VolumeVariables>, std::vector<VolumeVariables>>
+        && std::is_trivially_copyable_v<VolumeVariables>;
+
+    using VolVarsStorage = std::conditional_t<compactVolVars,
+                                              Detail::CompactArray<VolumeVariables>,
+                                              std::optional<GridVolumeVariables>>;
+    using SolutionStorage = typename Detail::SnapshotSolutionStorage<SolutionVector>::type;
+    static constexpr bool compactSolution = !std::is_same_v<SolutionStorage, SolutionVector>;
+
+    struct Snapshot
+    {
+        SolutionStorage solution;
+        VolVarsStorage volVars;
+        std::optional<GridFluxVariablesCache> fluxVarsCache;
+    };
+
+public:
+    explicit GridVariablesSnapshots(const std::string& paramGroup = "")
+    : maxNumSnapshots_(getParamFromGroup<std::size_t>(paramGroup, "Snapshots.MaxNumSnapshots", 1))
+    , compress_(getParamFromGroup<bool>(paramGroup, "Snapshots.Compress", false))
+    {
+        if (maxNumSnapshots_ == 0)
+            DUNE_THROW(Dune::InvalidStateException, "Snapshots.MaxNumSnapshots has to be at least one");
+    }
+
+    /*!
+     * \brief Take a snapshot of the given state (discards the oldest snapshot if the maximum number is reached)
+     * \param x the solution
+     * \param gridVariables the grid variables corresponding to the solution
+     */
+    void save(const SolutionVector& x, const GridVariables& gridVariables)
+    {
+        Instrumentation::ScopedTimer timer("GridVariablesSnapshots.Save");
+
+        if (snapshots_.size() == maxNumSnapshots_)
+            snapshots_.pop_front();
+
+        Snapshot snapshot;
+        if constexpr (compactSolution)
+            snapshot.solution = { x.size() > 0 ? &x[0] : nullptr, x.size(), compress_ };
+        else
+            snapshot.solution = x;
+
+        if constexpr (compactVolVars)
+        {
+            std::vector<VolumeVariables> volVars;
+            volVars.reserve(numVolVars_(gridVariables));
+            forEachScv_(gridVariables, [&](const auto& scv)
+            { volVars.push_back(gridVariables.curGridVolVars().volVars(scv)); });
+            snapshot.volVars = { volVars.data(), volVars.size(), compress_ };
+        }
+        else
+            snapshot.volVars.emplace(gridVariables.curGridVolVars());
+
+        snapshot.fluxVarsCache.emplace(gridVariables.gridFluxVarsCache());
+        snapshots_.push_back(std::move(snapshot));
+    }
+
+    /*!
+     * \brief Restore a snapshot
+     * \param x the solution to be overwritten
+     * \param gridVariables the grid variables to be overwritten
+     * \param numStepsBack restore the latest (1) or an older snapshot (> 1),
+     *        the snapshots taken after the restored one are discarded
+     */
+    void restore(SolutionVector& x, GridVariables& gridVariables, std::size_t numStepsBack = 1)
+    {
+        Instrumentation::ScopedTimer timer("GridVariablesSnapshots.Restore");
+
+        if (numStepsBack == 0 || numStepsBack > snapshots_.size())
+            DUNE_THROW(Dune::InvalidStateException, "Cannot go back " << numStepsBack
+                                                    << " steps with " << snapshots_.size() << " snapshots");
+
+        snapshots_.erase(snapshots_.end() - (numStepsBack - 1), snapshots_.end());
+        const auto& snapshot = snapshots_.back();
+
+        if constexpr (compactSolution)
+        {
+            x.resize(snapshot.solution.size());
+            if (x.size() > 0)
+                snapshot.solution.extract(&x[0]);
+        }
+        else
+            x = snapshot.solution;
+
+        if constexpr (compactVolVars)
+        {
+            if (snapshot.volVars.size() != numVolVars_(gridVariables))
+                DUNE_THROW(Dune::InvalidStateException, "Snapshot does not match the grid (snapshots have to be cleared after grid adaption)");
+
+            std::vector<VolumeVariables> volVars(snapshot.volVars.size());
+            snapshot.volVars.extract(volVars.data());
+            std::size_t i = 0;
+            forEachScv_(gridVariables, [&](const auto& scv)
+            { gridVariables.curGridVolVars().volVars(scv) = volVars[i++]; });
+        }
+        else
+            gridVariables.curGridVolVars() = *snapshot.volVars;
+
+        gridVariables.prevGridVolVars() = gridVariables.curGridVolVars();
+        gridVariables.gridFluxVarsCache() = *snapshot.fluxVarsCache;
+    }
+
+    //! The number of stored snapshots
+    std::size_t size() const
+    { return snapshots_.size(); }
+
+    //! Whether there are no snapshots
+    bool empty() const
+    { return snapshots_.empty(); }
+
+    //! Discard all snapshots
+    void clear()
+    { snapshots_.clear(); }
+
+    //! The number of bytes used by the compact buffers of all snapshots
+    std::size_t memoryUsage() const
+    {
+        std::size_t bytes = 0;
+        for (const auto& snapshot : snapshots_)
+        {
+            if constexpr (compactSolution)
+                bytes += snapshot.solution.memoryUsage();
+            if constexpr (compactVolVars)
+                bytes += snapshot.volVars.memoryUsage();
+        }
+        return bytes;
+    }
+
+private:
+    //! visit all sub-control volumes holding cached volume variables in a fixed order
+    template<class F>
+    void forEachScv_(const GridVariables& gridVariables, F&& f) const
+    {
+        const auto& gridGeometry = gridVariables.gridGeometry();
+        auto fvGeometry = localView(gridGeometry);
+        for (const auto& element : elements(gridGeometry.gridView()))
+        {
+            fvGeometry.bindElement(element);
+            for (const auto& scv : scvs(fvGeometry))
+                f(scv);
+        }
+    }
+
+    //! the number of stored volume variables
+    std::size_t numVolVars_(const GridVariables& gridVariables) const
+    {
+        std::size_t n = 0;
+        forEachScv_(gridVariables, [&](const auto&){ ++n; });
+        return n;
+    }
+
+    std::size_t maxNumSnapshots_;
+    bool compress_;
+    std::deque<Snapshot> snapshots_;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -0,0 +1,51 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Discretization
+ * \brief The container type used by the grid volume variables to store the volume variables
+ */
+#ifndef DUMUX_DISCRETIZATION_GRID_VOLUMEVARIABLES_STORAGE_HH
+#define DUMUX_DISCRETIZATION_GRID_VOLUMEVARIABLES_STORAGE_HH
+
+#include <vector>
+#include <dune/common/std/type_traits.hh>
+
+namespace Dumux::Detail {
+
+template<class VolumeVariables>
+using GridStorageDetector = typename VolumeVariables::GridStorage;
+
+/*!
+ * \ingroup Discretization
+ * \brief The container storing the volume variables of all degrees of freedom in
+ *        the cached grid volume variables. Volume variables may customize the
+ *        storage by exporting a type `GridStorage` (e.g. a structure-of-arrays container),
+ *        the default is `std::vector<VolumeVariables>`.
+ * \note A custom storage has to provide `resize(n)`, `size()` and `operator[]`
+ *       returning references to volume variables.
+ */
+template<class VolumeVariables>
+using GridVolumeVariablesStorage = Dune::Std::detected_or_t<
+    std::vector<VolumeVariables>, GridStorageDetector, VolumeVariables
+>;
+
+} // end namespace Dumux::Detail
+
+#endif
@@ -25,6 +25,12 @@
 #ifndef DUMUX_LOCAL_VIEW_HH
 #define DUMUX_LOCAL_VIEW_HH
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/std/type_traits.hh>
+
 namespace Dumux {
 
 /*!
@@ -38,6 +44,50 @@ template<class GridCache>
 inline typename GridCache::LocalView localView(const GridCache& gridCache)
 { return typename GridCache::LocalView(gridCache); }
 
+namespace Detail {
+
+//! the grid geometry type of a problem
+template<class Problem>
+using ProblemGridGeometry = std::decay_t<decltype(std::declval<const Problem&>().gridGeometry())>;
+
+template<class Problem>
+using MaxNumElementScvfs = decltype(ProblemGridGeometry<Problem>::LocalView::maxNumElementScvfs);
+
+template<class Problem>
+using MaxNumElementScvs = decltype(ProblemGridGeometry<Problem>::LocalView::maxNumElementScvs);
+
+/*!
+ * \ingroup Discretization
+ * \brief The maximum number of scvfs per element of the grid geometry of a problem
+ *        (zero if the grid geometry doesn't specify it)
+ * \note Used to size the inline storage of local views at compile time
+ */
+template<class Problem>
+constexpr std::size_t maxNumElementScvfs()
+{
+    if constexpr (Dune::Std::is_detected_v<MaxNumElementScvfs, Problem>)
+        return ProblemGridGeometry<Problem>::LocalView::maxNumElementScvfs;
+    else
+        return 0;
+}
+
+/*!
+ * \ingroup Discretization
+ * \brief The maximum number of scvs per element of the grid geometry of a problem
+ *        (zero if the grid geometry doesn't specify it)
+ * \note Used to size the inline storage of local views at compile time
+ */
+template<class Problem>
+constexpr std::size_t maxNumElementScvs()
+{
+    if constexpr (Dune::Std::is_detected_v<MaxNumElementScvs, Problem>)
+        return ProblemGridGeometry<Problem>::LocalView::maxNumElementScvs;
+    else
+        return 0;
+}
+
+} // end namespace Detail
+
 } // end namespace Dumux
 
 #endif
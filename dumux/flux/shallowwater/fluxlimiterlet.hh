@@ -27,10 +27,46 @@
 
 #include <algorithm>
 #include <cmath>
+#include <string>
+
+#include <dumux/common/parameterhandle.hh>
 
 namespace Dumux {
 namespace ShallowWater {
 
+/*!
+ * \ingroup ShallowWaterFlux
+ * \brief The parameters of the flux limiter applied to the water flux of the Riemann problem
+ *
+ * The parameters are looked up once, so an object of this class is meant to be stored
+ * by the owner of the parameter group (see ShallowWaterProblem::fluxLimiterLETParams).
+ */
+template<class Scalar>
+struct FluxLimiterLETParams
+{
+    explicit FluxLimiterLETParams(const std::string& paramGroup = "")
+    : upperWaterDepth(paramHandleFromGroup<Scalar>(paramGroup, "FluxLimiterLET.UpperWaterDepth", 1e-3))
+    , lowerWaterDepth(paramHandleFromGroup<Scalar>(paramGroup, "FluxLimiterLET.LowerWaterDepth", 1e-5))
+    , upwindFluxLimiting(paramHandleFromGroup<bool>(paramGroup, "FluxLimiterLET.UpwindFluxLimiting", false))
+    {}
+
+    ParamHandle<Scalar> upperWaterDepth; //!< water depth below which the flux is limited
+    ParamHandle<Scalar> lowerWaterDepth; //!< water depth at which the flux vanishes
+    ParamHandle<bool> upwindFluxLimiting; //!< limit with the upwind instead of the average water depth
+};
+
+namespace Detail {
+
+//! The flux limiter parameters without parameter group (for callers that don't pass their own)
+template<class Scalar>
+const FluxLimiterLETParams<Scalar>& defaultFluxLimiterLETParams()
+{
+    static const FluxLimiterLETParams<Scalar> params;
+    return params;
+}
+
+} // end namespace Detail
+
 /*!
  * \ingroup ShallowWaterFlux
  * \brief Flux limiter function to scale fluxes for small water depths.
@@ -25,59 +25,37 @@
 #ifndef DUMUX_FLUX_SHALLOW_WATER_RIEMANN_PROBLEM_HH
 #define DUMUX_FLUX_SHALLOW_WATER_RIEMANN_PROBLEM_HH
 
-#include <dumux/common/parameters.hh>
+#include <array>
+
 #include <dumux/flux/shallowwater/fluxlimiterlet.hh>
 #include <dumux/flux/shallowwater/exactriemann.hh>
 
 namespace Dumux {
 namespace ShallowWater {
 
-/*!
- * \ingroup ShallowWaterFlux
- * \brief Construct a Riemann problem and solve it
- *
- *
- * Riemann problem applies the hydrostatic reconstruction, uses the
- * Riemann invariants to transform the two-dimensional problem to a
- * one-dimensional problem, solves this new problem, and rotates
- * the problem back. Further it applies a flux limiter for the water
- * flux to handle drying elements.
- * The correction of the bed slope source term leads to a
- * non-symmetric flux term at the interface for the momentum equations.
- * Since DuMuX computes the fluxes twice from each side this does not
- * matter.
- *
- * So far this implements the exact Riemann solver (with reconstruction
- * after Audusse).
- *
- * The computed water flux (localFlux[0]) is given in m^2/s, the
- * momentum fluxes (localFlux[1], localFlux[2]) are given in m^3/s^2.
- * Later this flux will be multiplied by the scvf.area() (given in m
- * for a 2D problem) to get the flux over a face.
- *
- * \param waterDepthLeft water depth on the left side
- * \param waterDepthRight water depth on the right side
- * \param velocityXLeft veloctiyX on the left side
- * \param velocityXRight velocityX on the right side
- * \param velocityYLeft velocityY on the left side
- * \param velocityYRight velocityY on the right side
- * \param bedSurfaceLeft surface of the bed on the left side
- * \param bedSurfaceRight surface of the bed on the right side
- * \param gravity gravity constant
- * \param nxy the normal vector
- *
- */
+namespace Detail {
+
+//! The Riemann flux (with flux limiting) and the hydrostatic reconstruction terms of both sides
+template<class Scalar>
+struct RiemannProblemResult
+{
+    std::array<Scalar, 3> flux;
+    Scalar hydrostaticLeft;
+    Scalar hydrostaticRight;
+};
+
 template<class Scalar, class GlobalPosition>
-std::array<Scalar,3> riemannProblem(const Scalar waterDepthLeft,
-                                    const Scalar waterDepthRight,
-                                    Scalar velocityXLeft,
-                                    Scalar velocityXRight,
-                                    Scalar velocityYLeft,
-                                    Scalar velocityYRight,
-                                    const Scalar bedSurfaceLeft,
-                                    const Scalar bedSurfaceRight,
-                                    const Scalar gravity,
-                                    const GlobalPosition& nxy)
+RiemannProblemResult<Scalar> solveRiemannProblem(const Scalar waterDepthLeft,
+                                                 const Scalar waterDepthRight,
+                                                 Scalar velocityXLeft,
+                                                 Scalar velocityXRight,
+                                                 Scalar velocityYLeft,
+                                                 Scalar velocityYRight,
+                                                 const Scalar bedSurfaceLeft,
+                                                 const Scalar bedSurfaceRight,
+                                                 const Scalar gravity,
+                                                 const GlobalPosition& nxy,
+                                                 const FluxLimiterLETParams<Scalar>& limiterParams)
 {
     using std::max;
 
@@ -109,23 +87,15 @@ std::array<Scalar,3> riemannProblem(const Scalar waterDepthLeft,
     riemannResult.flux[1] = nxy[0] * tempFlux - nxy[1] * riemannResult.flux[2];
     riemannResult.flux[2] = nxy[1] * tempFlux + nxy[0] * riemannResult.flux[2];
 
-    // Add reconstruction flux from Audusse reconstruction
-    const Scalar hgzl = 0.5 * (waterDepthLeftReconstructed + waterDepthLeft) * (waterDepthLeftReconstructed - waterDepthLeft);
-    const Scalar hdxzl = gravity * nxy[0] * hgzl;
-    const Scalar hdyzl = gravity * nxy[1] * hgzl;
-
-    /*Right side is computed from the other side otherwise the
-      following "non-symetric" fluxes are needed:
-
-      Scalar hgzr = 0.5 * (waterDepthRightReconstructed + waterDepthRight) * (waterDepthRightReconstructed - waterDepthRight);
-      Scalar hdxzr = gravity * nxy[0] * hgzr;
-      Scalar hdyzrhdyzr = gravity * nxy[1] * hgzr;
-    */
+    // reconstruction terms from Audusse reconstruction
+    RiemannProblemResult<Scalar> result;
+    result.hydrostaticLeft = 0.5 * (waterDepthLeftReconstructed + waterDepthLeft) * (waterDepthLeftReconstructed - waterDepthLeft);
+    result.hydrostaticRight = 0.5 * (waterDepthRightReconstructed + waterDepthRight) * (waterDepthRightReconstructed - waterDepthRight);
 
     // compute the mobility of the flux with the fluxlimiter
-    static const Scalar upperWaterDepthFluxLimiting = getParam<Scalar>("FluxLimiterLET.UpperWaterDepth", 1e-3);
-    static const Scalar lowerWaterDepthFluxLimiting = getParam<Scalar>("FluxLimiterLET.LowerWaterDepth", 1e-5);
-    static const bool upwindWaterDepthFluxLimiting = getParam<bool>("FluxLimiterLET.UpwindFluxLimiting", false);
+    const Scalar upperWaterDepthFluxLimiting = limiterParams.upperWaterDepth;
+    const Scalar lowerWaterDepthFluxLimiting = limiterParams.lowerWaterDepth;
+    const bool upwindWaterDepthFluxLimiting = limiterParams.upwindFluxLimiting;
 
     Scalar limitingDepth = (waterDepthLeftReconstructed + waterDepthRightReconstructed) * 0.5;
 
@@ -145,10 +115,116 @@ std::array<Scalar,3> riemannProblem(const Scalar waterDepthLeft,
                                                          limitingDepth,
                                                          upperWaterDepthFluxLimiting,
                                                          lowerWaterDepthFluxLimiting);
+    result.flux[0] = riemannResult.flux[0] * mobility;
+    result.flux[1] = riemannResult.flux[1];
+    result.flux[2] = riemannResult.flux[2];
+
+    return result;
+}
+
+} // end namespace Detail
+
+/*!
+ * \ingroup ShallowWaterFlux
+ * \brief Construct a Riemann problem and solve it
+ *
+ *
+ * Riemann problem applies the hydrostatic reconstruction, uses the
+ * Riemann invariants to transform the two-dimensional problem to a
+ * one-dimensional problem, solves this new problem, and rotates
+ * the problem back. Further it applies a flux limiter for the water
+ * flux to handle drying elements.
+ * The correction of the bed slope source term leads to a
+ * non-symmetric flux term at the interface for the momentum equations.
+ * Since DuMuX computes the fluxes twice from each side this does not
+ * matter.
+ *
+ * So far this implements the exact Riemann solver (with reconstruction
+ * after Audusse).
+ *
+ * The computed water flux (localFlux[0]) is given in m^2/s, the
+ * momentum fluxes (localFlux[1], localFlux[2]) are given in m^3/s^2.
+ * Later this flux will be multiplied by the scvf.area() (given in m
+ * for a 2D problem) to get the flux over a face.
+ *
+ * \param waterDepthLeft water depth on the left side
+ * \param waterDepthRight water depth on the right side
+ * \param velocityXLeft veloctiyX on the left side
+ * \param velocityXRight velocityX on the right side
+ * \param velocityYLeft velocityY on the left side
+ * \param velocityYRight velocityY on the right side
+ * \param bedSurfaceLeft surface of the bed on the left side
+ * \param bedSurfaceRight surface of the bed on the right side
+ * \param gravity gravity constant
+ * \param nxy the normal vector
+ * \param limiterParams the parameters of the flux limiter (by default looked up without parameter group)
+ *
+ */
+template<class Scalar, class GlobalPosition>
+std::array<Scalar,3> riemannProblem(const Scalar waterDepthLeft,
+                                    const Scalar waterDepthRight,
+                                    Scalar velocityXLeft,
+                                    Scalar velocityXRight,
+                                    Scalar velocityYLeft,
+                                    Scalar velocityYRight,
+                                    const Scalar bedSurfaceLeft,
+                                    const Scalar bedSurfaceRight,
+                                    const Scalar gravity,
+                                    const GlobalPosition& nxy,
+                                    const FluxLimiterLETParams<Scalar>& limiterParams = Detail::defaultFluxLimiterLETParams<Scalar>())
+{
+    const auto result = Detail::solveRiemannProblem(waterDepthLeft, waterDepthRight,
+                                                    velocityXLeft, velocityXRight,
+                                                    velocityYLeft, velocityYRight,
+                                                    bedSurfaceLeft, bedSurfaceRight,
+                                                    gravity, nxy, limiterParams);
+
+    // Right side is computed from the other side (see riemannProblemBothSides for both sides at once)
     std::array<Scalar, 3> localFlux;
-    localFlux[0] = riemannResult.flux[0] * mobility;
-    localFlux[1] = (riemannResult.flux[1] - hdxzl);
-    localFlux[2] = (riemannResult.flux[2] - hdyzl);
+    localFlux[0] = result.flux[0];
+    localFlux[1] = result.flux[1] - gravity * nxy[0] * result.hydrostaticLeft;
+    localFlux[2] = result.flux[2] - gravity * nxy[1] * result.hydrostaticLeft;
+
+    return localFlux;
+}
+
+/*!
+ * \ingroup ShallowWaterFlux
+ * \brief Construct a Riemann problem and solve it for both sides of a face
+ *
+ * Same as riemannProblem but returns the fluxes seen from both sides of the face,
+ * so that the Riemann problem has to be solved only once per face.
+ * The first flux is the flux over the face with normal nxy (out of the left side),
+ * the second flux is the flux with the normal -nxy (out of the right side).
+ * The Riemann flux is conservative; only the bed slope corrections
+ * of the hydrostatic reconstruction differ between both sides.
+ */
+template<class Scalar, class GlobalPosition>
+std::array<std::array<Scalar,3>, 2> riemannProblemBothSides(const Scalar waterDepthLeft,
+                                                            const Scalar waterDepthRight,
+                                                            const Scalar velocityXLeft,
+                                                            const Scalar velocityXRight,
+                                                            const Scalar velocityYLeft,
+                                                            const Scalar velocityYRight,
+                                                            const Scalar bedSurfaceLeft,
+                                                            const Scalar bedSurfaceRight,
+                                                            const Scalar gravity,
+                                                            const GlobalPosition& nxy,
+                                                            const FluxLimiterLETParams<Scalar>& limiterParams = Detail::defaultFluxLimiterLETParams<Scalar>())
+{
+    const auto result = Detail::solveRiemannProblem(waterDepthLeft, waterDepthRight,
+                                                    velocityXLeft, velocityXRight,
+                                                    velocityYLeft, velocityYRight,
+                                                    bedSurfaceLeft, bedSurfaceRight,
+                                                    gravity, nxy, limiterParams);
+
+    std::array<std::array<Scalar, 3>, 2> localFlux;
+    localFlux[0][0] = result.flux[0];
+    localFlux[0][1] = result.flux[1] - gravity * nxy[0] * result.hydrostaticLeft;
+    localFlux[0][2] = result.flux[2] - gravity * nxy[1] * result.hydrostaticLeft;
+    localFlux[1][0] = -result.flux[0];
+    localFlux[1][1] = -result.flux[1] + gravity * nxy[0] * result.hydrostaticRight;
+    localFlux[1][2] = -result.flux[2] + gravity * nxy[1] * result.hydrostaticRight;
 
     return localFlux;
 }
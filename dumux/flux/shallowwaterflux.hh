@@ -79,7 +79,8 @@ public:
                                                         insideVolVars.bedSurface(),
                                                         outsideVolVars.bedSurface(),
                                                         gravity,
-                                                        nxy);
+                                                        nxy,
+                                                        problem.fluxLimiterLETParams());
 
         NumEqVector localFlux(0.0);
         localFlux[0] = riemannFlux[0] * scvf.area();
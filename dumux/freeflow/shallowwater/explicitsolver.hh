@@ -0,0 +1,728 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup ShallowWaterModel
+ * \brief Explicit, matrix-free time integration of the shallow water equations
+ */
+#ifndef DUMUX_FREEFLOW_SHALLOW_WATER_EXPLICIT_SOLVER_HH
+#define DUMUX_FREEFLOW_SHALLOW_WATER_EXPLICIT_SOLVER_HH
+
+#include <cmath>
+#include <array>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <string>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+#include <dune/grid/common/partitionset.hh>
+
+#include <dumux/common/properties.hh>
+#include <dumux/common/gridcapabilities.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/variables.hh>
+#include <dumux/common/numeqvector.hh>
+#include <dumux/discretization/method.hh>
+#include <dumux/discretization/extrusion.hh>
+#include <dumux/discretization/elementsolution.hh>
+#include <dumux/flux/shallowwater/riemannproblem.hh>
+#include <dumux/parallel/parallel_for.hh>
+#include <dumux/parallel/vectorcommdatahandle.hh>
+#include <dumux/timestepping/multistagetimestepper.hh>
+
+namespace Dumux::Experimental {
+
+/*!
+ * \ingroup ShallowWaterModel
+ * \brief Matrix-free evaluation of the shallow water equations for explicit time integration
+ *
+ * The spatial operator \f$ R(x) \f$ (fluxes minus sources, integrated over the cells) is evaluated
+ * face-wise: the faces are stored in contiguous arrays and the Riemann problem is solved once
+ * per face for both adjacent cells (see ShallowWater::riemannProblemBothSides). Faces and cells are
+ * processed in batches distributed over threads with parallelFor (loops accessing grid entities run sequentially
+ * on grids that are not thread-safe, see Detail::supportsMultithreading). Sources and boundary fluxes are
+ * evaluated with the problem interface, so all problems of the implicit model can be used
+ * (boundary conditions have to be of Neumann type, as usual for the shallow water model).
+ *
+ * The class implements the stage interface of the MultiStageTimeStepper for explicit methods
+ * (use it together with ShallowWaterExplicitSolver) and provides multirate local time stepping
+ * with the explicit Euler method (localTimeStep).
+ *
+ * The following run-time parameters are used
+ *  - ShallowWater.CourantNumber: the CFL number for the time step size (default 0.5)
+ *  - ShallowWater.LocalTimeStepping.MaxLevel: the maximum time step level, the largest local time step
+ *    is 2^MaxLevel times the smallest (default 3)
+ *
+ * \note Only the cell-centered TPFA discretization is supported.
+ *       The viscous momentum flux (ShallowWater.EnableViscousFlux) is not supported.
+ */
+template<class TypeTag>
+class ShallowWaterExplicitAssembler
+{
+    using Scalar = GetPropType<TypeTag, Properties::Scalar>;
+    using GridGeometry = GetPropType<TypeTag, Properties::GridGeometry>;
+    using GridView = typename GridGeometry::GridView;
+    using Problem = GetPropType<TypeTag, Properties::Problem>;
+    using GridVariables = GetPropType<TypeTag, Properties::GridVariables>;
+    using LocalResidual = GetPropType<TypeTag, Properties::LocalResidual>;
+    using PrimaryVariables = GetPropType<TypeTag, Properties::PrimaryVariables>;
+    using NumEqVector = Dumux::NumEqVector<PrimaryVariables>;
+    using Indices = typename GetPropType<TypeTag, Properties::ModelTraits>::Indices;
+    using Extrusion = Extrusion_t<GridGeometry>;
+    using FaceFlux = std::array<std::array<Scalar, 3>, 2>;
+
+    static_assert(GridGeometry::discMethod == DiscretizationMethods::cctpfa,
+                  "The explicit shallow water solver is only implemented for the cell-centered TPFA discretization");
+
+    //! the number of faces/cells processed by a thread at once
+    static constexpr std::size_t batchSize = 256;
+
+public:
+    using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
+    using ResidualType = SolutionVector;
+    using Variables = Experimental::Variables<SolutionVector>;
+    using StageParams = MultiStageParams<Scalar>;
+
+    /*!
+     * \brief The constructor
+     * \param problem the problem
+     * \param gridGeometry the grid geometry
+     * \param gridVariables the grid variables (used to evaluate sources and boundary fluxes)
+     */
+    ShallowWaterExplicitAssembler(std::shared_ptr<const Problem> problem,
+                                  std::shared_ptr<const GridGeometry> gridGeometry,
+                                  std::shared_ptr<GridVariables> gridVariables)
+    : problem_(problem)
+    , gridGeometry_(gridGeometry)
+    , gridVariables_(gridVariables)
+    , localResidual_(problem.get())
+    {
+        courantNumber_ = getParamFromGroup<Scalar>(problem->paramGroup(), "ShallowWater.CourantNumber", 0.5);
+        maxLevel_ = getParamFromGroup<int>(problem->paramGroup(), "ShallowWater.LocalTimeStepping.MaxLevel", 3);
+        dryWaterDepth_ = getParam<Scalar>("FluxLimiterLET.LowerWaterDepth", 1e-5);
+
+        if (getParamFromGroup<bool>(problem->paramGroup(), "ShallowWater.EnableViscousFlux", false))
+            DUNE_THROW(Dune::NotImplemented, "Viscous fluxes in the explicit shallow water solver");
+
+        update();
+    }
+
+    /*!
+     * \brief Update the face connectivity, e.g. after grid adaption
+     */
+    void update()
+    {
+        const auto& gg = *gridGeometry_;
+        const std::size_t numCells = gg.numDofs();
+
+        cellVolume_.assign(numCells, 0.0);
+        cellGravity_.resize(numCells);
+        bedSurface_.resize(numCells);
+        boundaryArea_.assign(numCells, 0.0);
+        faceInside_.clear(); faceOutside_.clear();
+        faceNormal_.clear(); faceArea_.clear(); faceGravity_.clear();
+        copiedCells_.clear();
+
+        auto fvGeometry = localView(gg);
+        for (const auto& element : elements(gg.gridView()))
+        {
+            const auto eIdx = gg.elementMapper().index(element);
+            if (element.partitionType() != Dune::InteriorEntity)
+                copiedCells_.push_back(eIdx);
+
+            fvGeometry.bindElement(element);
+            for (const auto& scv : scvs(fvGeometry))
+            {
+                cellVolume_[eIdx] += Extrusion::volume(scv);
+                bedSurface_[eIdx] = problem_->spatialParams().bedSurface(element, scv);
+            }
+            cellGravity_[eIdx] = problem_->spatialParams().gravity(element.geometry().center());
+
+            for (const auto& scvf : scvfs(fvGeometry))
+            {
+                if (scvf.boundary())
+                {
+                    boundaryArea_[eIdx] += Extrusion::area(scvf);
+                    continue;
+                }
+
+                // each face is stored once, the flux is computed for both sides
+                const auto nIdx = scvf.outsideScvIdx();
+                if (eIdx < nIdx)
+                {
+                    faceInside_.push_back(eIdx);
+                    faceOutside_.push_back(nIdx);
+                    faceNormal_.push_back({scvf.unitOuterNormal()[0], scvf.unitOuterNormal()[1]});
+                    faceArea_.push_back(Extrusion::area(scvf));
+                    faceGravity_.push_back(problem_->spatialParams().gravity(scvf.center()));
+                }
+            }
+        }
+
+        // the faces of each cell in compressed sparse row format (face index * 2 + side)
+        cellFaceOffsets_.assign(numCells + 1, 0);
+        for (std::size_t f = 0; f < faceInside_.size(); ++f)
+        {
+            ++cellFaceOffsets_[faceInside_[f] + 1];
+            ++cellFaceOffsets_[faceOutside_[f] + 1];
+        }
+        std::partial_sum(cellFaceOffsets_.begin(), cellFaceOffsets_.end(), cellFaceOffsets_.begin());
+
+        cellFaces_.resize(cellFaceOffsets_.back());
+        auto pos = cellFaceOffsets_;
+        for (std::size_t f = 0; f < faceInside_.size(); ++f)
+        {
+            cellFaces_[pos[faceInside_[f]]++] = 2*f;
+            cellFaces_[pos[faceOutside_[f]]++] = 2*f + 1;
+        }
+
+        faceFlux_.resize(faceInside_.size());
+        waterDepth_.resize(numCells);
+        velocity_.resize(numCells);
+    }
+
+    /*!
+     * \brief Assemble the conserved quantities \f$ M(x) \f$ integrated over the cells
+     */
+    void assembleStorage(const SolutionVector& x, ResidualType& storage) const
+    {
+        storage.resize(x.size());
+        parallelFor(x.size(), [&](const std::size_t i)
+        {
+            storage[i] = 0.0;
+            storage[i][Indices::massBalanceIdx] = x[i][Indices::waterdepthIdx]*cellVolume_[i];
+            storage[i][Indices::momentumXBalanceIdx] = x[i][Indices::waterdepthIdx]*x[i][Indices::velocityXIdx]*cellVolume_[i];
+            storage[i][Indices::momentumYBalanceIdx] = x[i][Indices::waterdepthIdx]*x[i][Indices::velocityYIdx]*cellVolume_[i];
+        });
+    }
+
+    /*!
+     * \brief Assemble the spatial residual \f$ R(x) \f$ (fluxes minus sources integrated over the cells)
+     */
+    void assembleSpatialResidual(const SolutionVector& x, ResidualType& residual)
+    {
+        residual.resize(x.size());
+        prepareEvaluation_(x);
+
+        const auto numFaces = faceInside_.size();
+        parallelFor(numBatches_(numFaces), [&](const std::size_t batch)
+        {
+            const auto end = std::min(numFaces, (batch+1)*batchSize);
+            for (std::size_t f = batch*batchSize; f < end; ++f)
+                computeFaceFlux_(f);
+        });
+
+        const auto numCells = x.size();
+        forEachWithGridAccess_(numBatches_(numCells), [&](const std::size_t batch)
+        {
+            CellEvaluator evaluator(*this, x);
+            const auto end = std::min(numCells, (batch+1)*batchSize);
+            for (std::size_t i = batch*batchSize; i < end; ++i)
+            {
+                residual[i] = 0.0;
+                addFaceFluxes_(i, residual[i]);
+                evaluator.addSourceAndBoundaryFluxes(i, residual[i]);
+            }
+        });
+    }
+
+    /*!
+     * \brief The largest stable time step size for the given solution (CFL condition)
+     * \note This is a collective operation in parallel
+     */
+    Scalar stableTimeStepSize(const SolutionVector& x) const
+    {
+        Scalar dt = std::numeric_limits<Scalar>::max();
+        for (const auto dtCell : cellTimeStepSizes_(x))
+            dt = std::min(dt, dtCell);
+        return gridGeometry_->gridView().comm().min(dt);
+    }
+
+    /*!
+     * \brief Prepare a stage of an explicit multi-stage method
+     * \param vars The variables at the previous stage (updated to the time of the new stage)
+     * \param params The parameters of the new stage
+     */
+    void prepareStage(Variables& vars, std::shared_ptr<const StageParams> params)
+    {
+        stageParams_ = params;
+        const auto curStage = params->size() - 1;
+
+        // we keep the operators of the previous stages, they are needed for the stage update
+        stageStorage_.emplace_back();
+        assembleStorage(vars.dofs(), stageStorage_.back());
+        stageResidual_.emplace_back();
+        assembleSpatialResidual(vars.dofs(), stageResidual_.back());
+
+        const auto t = params->timeAtStage(curStage);
+        const auto prevT = params->timeAtStage(0);
+        const auto dtFraction = params->timeStepFraction(curStage);
+        vars.updateTime(Experimental::TimeLevel{t, prevT, dtFraction});
+    }
+
+    /*!
+     * \brief Clear the data of previous stages
+     */
+    void clearStages()
+    {
+        stageStorage_.clear();
+        stageResidual_.clear();
+        stageParams_.reset();
+    }
+
+    /*!
+     * \brief Compute the solution of the current stage of an explicit method
+     *
+     * Solves \f$ \alpha_{ii} M(x^{(i)}) = -\sum_{k<i} \left[\alpha_{ik} M(x^{(k)}) + \beta_{ik} \Delta t R(x^{(k)})\right] \f$
+     */
+    void solveStage(Variables& vars)
+    {
+        const auto& params = *stageParams_;
+        const auto curStage = params.size() - 1;
+        if (!params.skipSpatial(curStage))
+            DUNE_THROW(Dune::NotImplemented, "Implicit stages in the explicit shallow water solver");
+
+        auto x = vars.dofs();
+        const auto numCells = x.size();
+        parallelFor(numCells, [&](const std::size_t i)
+        {
+            NumEqVector storage(0.0);
+            for (std::size_t k = 0; k < curStage; ++k)
+            {
+                if (!params.skipTemporal(k))
+                    storage.axpy(-params.temporalWeight(k), stageStorage_[k][i]);
+                if (!params.skipSpatial(k))
+                    storage.axpy(-params.spatialWeight(k), stageResidual_[k][i]);
+            }
+            storage /= params.temporalWeight(curStage);
+            x[i] = primaryVariables_(storage, i);
+        });
+
+        communicate_(x);
+        vars.update(x);
+    }
+
+    /*!
+     * \brief Advance the solution with multirate local time stepping (explicit Euler)
+     *
+     * The cells are assigned to levels such that the time step size of a cell on level l
+     * is \f$ 2^l \Delta t_\mathrm{min} \f$ and satisfies the CFL condition of the cell.
+     * Neighboring cells differ at most by one level. Within a macro step of size \f$ 2^L \Delta t_\mathrm{min} \f$,
+     * a face is evaluated with the time step size of its finer neighbor and the fluxes are accumulated
+     * for both cells, so the scheme is conservative. A cell is updated at the end of each of its time steps.
+     * Only the state of the cells updated in the previous sub step is refreshed before a sub step.
+     *
+     * \param x The solution (updated to the end of the macro step)
+     * \param maxDt The maximum size of the macro step
+     * \return The size of the macro step
+     * \note This is a collective operation in parallel (all processes use the same number of levels)
+     */
+    Scalar localTimeStep(SolutionVector& x, const Scalar maxDt)
+    {
+        const auto& comm = gridGeometry_->gridView().comm();
+        const auto numCells = x.size();
+        const auto numFaces = faceInside_.size();
+
+        // the time step levels of the cells
+        const auto dtCells = cellTimeStepSizes_(x);
+        Scalar dtMin = std::numeric_limits<Scalar>::max();
+        for (const auto dtCell : dtCells)
+            dtMin = std::min(dtMin, dtCell);
+        dtMin = comm.min(dtMin);
+
+        using std::log2; using std::floor;
+        std::vector<int> level(numCells);
+        for (std::size_t i = 0; i < numCells; ++i)
+            level[i] = std::min(maxLevel_, static_cast<int>(floor(log2(dtCells[i]/dtMin))));
+
+        // neighboring cells differ by at most one level
+        for (bool changed = true; changed; )
+        {
+            changed = false;
+            for (std::size_t f = 0; f < numFaces; ++f)
+            {
+                auto& li = level[faceInside_[f]];
+                auto& lj = level[faceOutside_[f]];
+                if (li > lj + 1) { li = lj + 1; changed = true; }
+                if (lj > li + 1) { lj = li + 1; changed = true; }
+            }
+        }
+
+        int numLevels = 0;
+        for (const auto l : level)
+            numLevels = std::max(numLevels, l);
+        numLevels = comm.max(numLevels);
+
+        // the size of the finest time step
+        const auto numSubSteps = static_cast<std::size_t>(1) << numLevels;
+        dtMin = std::min(dtMin, maxDt/numSubSteps);
+
+        std::vector<int> faceLevel(numFaces);
+        for (std::size_t f = 0; f < numFaces; ++f)
+            faceLevel[f] = std::min(level[faceInside_[f]], level[faceOutside_[f]]);
+
+        std::vector<std::vector<std::size_t>> levelCells(numLevels + 1);
+        for (std::size_t i = 0; i < numCells; ++i)
+            levelCells[level[i]].push_back(i);
+
+        // the flux integrated over the current time step of each cell
+        std::vector<NumEqVector> accumulatedFlux(numCells, NumEqVector(0.0));
+
+        // the cells updated in the previous sub step (and the cells copied from other processes)
+        std::vector<std::size_t> updatedCells;
+
+        for (std::size_t subStep = 0; subStep < numSubSteps; ++subStep)
+        {
+            if (subStep == 0)
+                prepareEvaluation_(x);
+            else
+            {
+                updatedCells.clear();
+                for (int l = 0; l <= numLevels && subStep % (static_cast<std::size_t>(1) << l) == 0; ++l)
+                    updatedCells.insert(updatedCells.end(), levelCells[l].begin(), levelCells[l].end());
+                updatedCells.insert(updatedCells.end(), copiedCells_.begin(), copiedCells_.end());
+                prepareEvaluation_(x, updatedCells);
+            }
+
+            // evaluate the faces that start a time step
+            parallelFor(numBatches_(numFaces), [&](const std::size_t batch)
+            {
+                const auto end = std::min(numFaces, (batch+1)*batchSize);
+                for (std::size_t f = batch*batchSize; f < end; ++f)
+                    if (subStep % (static_cast<std::size_t>(1) << faceLevel[f]) == 0)
+                        computeFaceFlux_(f);
+            });
+
+            // accumulate the fluxes and update the cells that finish a time step
+            forEachWithGridAccess_(numBatches_(numCells), [&](const std::size_t batch)
+            {
+                CellEvaluator evaluator(*this, x);
+                const auto end = std::min(numCells, (batch+1)*batchSize);
+                for (std::size_t i = batch*batchSize; i < end; ++i)
+                {
+                    for (auto k = cellFaceOffsets_[i]; k < cellFaceOffsets_[i+1]; ++k)
+                    {
+                        const auto f = cellFaces_[k]/2;
+                        const auto faceSteps = static_cast<std::size_t>(1) << faceLevel[f];
+                        if (subStep % faceSteps == 0)
+                        {
+                            const auto& flux = faceFlux_[f][cellFaces_[k]%2];
+                            for (int eqIdx = 0; eqIdx < 3; ++eqIdx)
+                                accumulatedFlux[i][eqIdx] += flux[eqIdx]*faceArea_[f]*faceSteps*dtMin;
+                        }
+                    }
+
+                    const auto cellSteps = static_cast<std::size_t>(1) << level[i];
+                    if ((subStep + 1) % cellSteps == 0)
+                    {
+                        NumEqVector residual(0.0);
+                        evaluator.addSourceAndBoundaryFluxes(i, residual);
+                        residual *= cellSteps*dtMin;
+                        residual += accumulatedFlux[i];
+
+                        NumEqVector storage(0.0);
+                        storage[Indices::massBalanceIdx] = waterDepth_[i]*cellVolume_[i];
+                        storage[Indices::momentumXBalanceIdx] = waterDepth_[i]*velocity_[i][0]*cellVolume_[i];
+                        storage[Indices::momentumYBalanceIdx] = waterDepth_[i]*velocity_[i][1]*cellVolume_[i];
+                        storage -= residual;
+
+                        x[i] = primaryVariables_(storage, i);
+                        accumulatedFlux[i] = 0.0;
+                    }
+                }
+            });
+
+            communicate_(x);
+        }
+
+        return dtMin*numSubSteps;
+    }
+
+    const Problem& problem() const
+    { return *problem_; }
+
+    const GridGeometry& gridGeometry() const
+    { return *gridGeometry_; }
+
+    const GridVariables& gridVariables() const
+    { return *gridVariables_; }
+
+private:
+    //! evaluates the sources and the boundary fluxes of cells (one instance per thread)
+    class CellEvaluator
+    {
+    public:
+        CellEvaluator(const ShallowWaterExplicitAssembler& assembler, const SolutionVector& x)
+        : assembler_(assembler)
+        , x_(x)
+        , fvGeometry_(localView(assembler.gridGeometry()))
+        , elemVolVars_(localView(assembler.gridVariables().curGridVolVars()))
+        , elemFluxVarsCache_(localView(assembler.gridVariables().gridFluxVarsCache()))
+        {}
+
+        void addSourceAndBoundaryFluxes(const std::size_t eIdx, NumEqVector& residual)
+        {
+            const auto& problem = assembler_.problem();
+            const auto element = assembler_.gridGeometry().element(eIdx);
+            fvGeometry_.bindElement(element);
+            elemVolVars_.bindElement(element, fvGeometry_, x_);
+
+            for (const auto& scv : scvs(fvGeometry_))
+            {
+                auto source = assembler_.localResidual_.computeSource(problem, element, fvGeometry_, elemVolVars_, scv);
+                source *= Extrusion::volume(scv)*elemVolVars_[scv].extrusionFactor();
+                residual -= source;
+            }
+
+            if (assembler_.boundaryArea_[eIdx] > 0.0)
+            {
+                elemFluxVarsCache_.bindElement(element, fvGeometry_, elemVolVars_);
+                for (const auto& scvf : scvfs(fvGeometry_))
+                {
+                    if (!scvf.boundary())
+                        continue;
+
+                    const auto bcTypes = problem.boundaryTypes(element, scvf);
+                    if (bcTypes.hasDirichlet())
+                        DUNE_THROW(Dune::NotImplemented, "Dirichlet boundaries in the explicit shallow water solver");
+
+                    auto flux = problem.neumann(element, fvGeometry_, elemVolVars_, elemFluxVarsCache_, scvf);
+                    const auto& scv = fvGeometry_.scv(scvf.insideScvIdx());
+                    flux *= Extrusion::area(scvf)*elemVolVars_[scv].extrusionFactor();
+                    residual += flux;
+                }
+            }
+        }
+
+    private:
+        const ShallowWaterExplicitAssembler& assembler_;
+        const SolutionVector& x_;
+        typename GridGeometry::LocalView fvGeometry_;
+        typename GridVariables::GridVolumeVariables::LocalView elemVolVars_;
+        typename GridVariables::GridFluxVariablesCache::LocalView elemFluxVarsCache_;
+    };
+
+    std::size_t numBatches_(const std::size_t size) const
+    { return (size + batchSize - 1)/batchSize; }
+
+    //! run f(i) for i < count in parallel if the grid supports concurrent entity access, otherwise sequentially
+    //! (loops that only access the contiguous arrays use parallelFor directly)
+    template<class F>
+    static void forEachWithGridAccess_(const std::size_t count, F&& f)
+    {
+        if constexpr (Detail::supportsMultithreading<typename GridView::Grid>)
+            parallelFor(count, std::forward<F>(f));
+        else
+            for (std::size_t i = 0; i < count; ++i)
+                f(i);
+    }
+
+    //! extract the state of all cells into contiguous arrays
+    void prepareEvaluation_(const SolutionVector& x)
+    {
+        // cached volume variables and flux variables caches have to be up to date for sources and boundary fluxes
+        gridVariables_->update(x);
+
+        parallelFor(x.size(), [&](const std::size_t i)
+        {
+            waterDepth_[i] = x[i][Indices::waterdepthIdx];
+            velocity_[i] = {x[i][Indices::velocityXIdx], x[i][Indices::velocityYIdx]};
+        });
+    }
+
+    //! extract the state of the given cells and update their cached volume variables
+    void prepareEvaluation_(const SolutionVector& x, const std::vector<std::size_t>& cells)
+    {
+        auto& gridVolVars = gridVariables_->curGridVolVars();
+        forEachWithGridAccess_(cells.size(), [&](const std::size_t k)
+        {
+            const auto i = cells[k];
+            waterDepth_[i] = x[i][Indices::waterdepthIdx];
+            velocity_[i] = {x[i][Indices::velocityXIdx], x[i][Indices::velocityYIdx]};
+
+            // the flux variables cache of the shallow water model is empty, only the volume variables are cached
+            if constexpr (GridVariables::GridVolumeVariables::cachingEnabled)
+            {
+                const auto element = gridGeometry_->element(i);
+                auto fvGeometry = localView(*gridGeometry_);
+                fvGeometry.bindElement(element);
+                const auto elemSol = elementSolution(element, x, *gridGeometry_);
+                for (const auto& scv : scvs(fvGeometry))
+                    gridVolVars.volVars(scv).update(elemSol, *problem_, element, scv);
+            }
+        });
+    }
+
+    //! solve the Riemann problem of a face for both sides
+    void computeFaceFlux_(const std::size_t f)
+    {
+        const auto i = faceInside_[f];
+        const auto j = faceOutside_[f];
+        faceFlux_[f] = ShallowWater::riemannProblemBothSides(waterDepth_[i], waterDepth_[j],
+                                                             velocity_[i][0], velocity_[j][0],
+                                                             velocity_[i][1], velocity_[j][1],
+                                                             bedSurface_[i], bedSurface_[j],
+                                                             faceGravity_[f], faceNormal_[f],
+                                                             problem_->fluxLimiterLETParams());
+    }
+
+    //! add the fluxes over all interior faces of a cell
+    void addFaceFluxes_(const std::size_t i, NumEqVector& residual) const
+    {
+        for (auto k = cellFaceOffsets_[i]; k < cellFaceOffsets_[i+1]; ++k)
+        {
+            const auto f = cellFaces_[k]/2;
+            const auto& flux = faceFlux_[f][cellFaces_[k]%2];
+            for (int eqIdx = 0; eqIdx < 3; ++eqIdx)
+                residual[eqIdx] += flux[eqIdx]*faceArea_[f];
+        }
+    }
+
+    //! the time step size of each cell according to the CFL condition
+    std::vector<Scalar> cellTimeStepSizes_(const SolutionVector& x) const
+    {
+        std::vector<Scalar> dt(x.size());
+        parallelFor(x.size(), [&](const std::size_t i)
+        {
+            using std::abs; using std::sqrt; using std::max;
+            const auto h = max(x[i][Indices::waterdepthIdx], 0.0);
+            const auto u = x[i][Indices::velocityXIdx];
+            const auto v = x[i][Indices::velocityYIdx];
+            const auto celerity = sqrt(cellGravity_[i]*h);
+
+            // sum of the maximum wave speeds times the face areas
+            Scalar waveFlux = boundaryArea_[i]*(sqrt(u*u + v*v) + celerity);
+            for (auto k = cellFaceOffsets_[i]; k < cellFaceOffsets_[i+1]; ++k)
+            {
+                const auto f = cellFaces_[k]/2;
+                const auto& n = faceNormal_[f];
+                waveFlux += faceArea_[f]*(abs(u*n[0] + v*n[1]) + celerity);
+            }
+
+            dt[i] = waveFlux > 0.0 ? courantNumber_*cellVolume_[i]/waveFlux : std::numeric_limits<Scalar>::max();
+        });
+
+        return dt;
+    }
+
+    //! the primary variables from the conserved quantities of a cell
+    PrimaryVariables primaryVariables_(const NumEqVector& storage, const std::size_t i) const
+    {
+        using std::max;
+        PrimaryVariables priVars(0.0);
+        const auto h = max(storage[Indices::massBalanceIdx]/cellVolume_[i], 0.0);
+        priVars[Indices::waterdepthIdx] = h;
+        if (h > dryWaterDepth_)
+        {
+            priVars[Indices::velocityXIdx] = storage[Indices::momentumXBalanceIdx]/(h*cellVolume_[i]);
+            priVars[Indices::velocityYIdx] = storage[Indices::momentumYBalanceIdx]/(h*cellVolume_[i]);
+        }
+
+        return priVars;
+    }
+
+    //! copy the values of the overlap/ghost cells from their owners
+    void communicate_(SolutionVector& x) const
+    {
+        const auto& gridView = gridGeometry_->gridView();
+        if (gridView.comm().size() > 1)
+        {
+            using Mapper = std::decay_t<decltype(gridGeometry_->dofMapper())>;
+            VectorCommDataHandleEqual<Mapper, SolutionVector, 0> dataHandle(gridGeometry_->dofMapper(), x);
+            gridView.communicate(dataHandle, Dune::InteriorBorder_All_Interface, Dune::ForwardCommunication);
+        }
+    }
+
+    std::shared_ptr<const Problem> problem_;
+    std::shared_ptr<const GridGeometry> gridGeometry_;
+    std::shared_ptr<GridVariables> gridVariables_;
+    LocalResidual localResidual_;
+
+    Scalar courantNumber_;
+    int maxLevel_;
+    Scalar dryWaterDepth_;
+
+    // cell data
+    std::vector<Scalar> cellVolume_;
+    std::vector<Scalar> cellGravity_;
+    std::vector<Scalar> bedSurface_;
+    std::vector<Scalar> boundaryArea_;
+    std::vector<Scalar> waterDepth_;
+    std::vector<std::array<Scalar, 2>> velocity_;
+    std::vector<std::size_t> copiedCells_; //!< overlap/ghost cells (updated by communication)
+
+    // face data (each interior face once)
+    std::vector<std::size_t> faceInside_;
+    std::vector<std::size_t> faceOutside_;
+    std::vector<std::array<Scalar, 2>> faceNormal_;
+    std::vector<Scalar> faceArea_;
+    std::vector<Scalar> faceGravity_;
+    std::vector<FaceFlux> faceFlux_;
+
+    // the faces of each cell
+    std::vector<std::size_t> cellFaceOffsets_;
+    std::vector<std::size_t> cellFaces_;
+
+    // the operators of the previous stages
+    std::vector<ResidualType> stageStorage_;
+    std::vector<ResidualType> stageResidual_;
+    std::shared_ptr<const StageParams> stageParams_;
+};
+
+/*!
+ * \ingroup ShallowWaterModel
+ * \brief Solver for the stages of explicit multi-stage methods (see MultiStageTimeStepper)
+ *
+ * Usage:
+ * \code
+ * auto assembler = std::make_shared<ShallowWaterExplicitAssembler<TypeTag>>(problem, gridGeometry, gridVariables);
+ * auto solver = std::make_shared<ShallowWaterExplicitSolver<ShallowWaterExplicitAssembler<TypeTag>>>(assembler);
+ * MultiStageTimeStepper<ShallowWaterExplicitSolver<...>> timeStepper(solver, std::make_shared<MultiStage::ExplicitEuler<Scalar>>());
+ * const auto dt = assembler->stableTimeStepSize(vars.dofs());
+ * timeStepper.step(vars, t, dt);
+ * \endcode
+ */
+template<class Assembler>
+class ShallowWaterExplicitSolver
+{
+public:
+    using Variables = typename Assembler::Variables;
+
+    explicit ShallowWaterExplicitSolver(std::shared_ptr<Assembler> assembler)
+    : assembler_(assembler)
+    {}
+
+    //! compute the solution of the current stage
+    void solve(Variables& vars)
+    { assembler_->solveStage(vars); }
+
+    Assembler& assembler()
+    { return *assembler_; }
+
+private:
+    std::shared_ptr<Assembler> assembler_;
+};
+
+} // end namespace Dumux::Experimental
+
+#endif
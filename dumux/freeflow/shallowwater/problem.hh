@@ -26,6 +26,7 @@
 
 #include <dumux/common/fvproblem.hh>
 #include <dumux/common/properties.hh>
+#include <dumux/flux/shallowwater/fluxlimiterlet.hh>
 #include "model.hh"
 
 namespace Dumux {
@@ -39,6 +40,7 @@ class ShallowWaterProblem : public FVProblem<TypeTag>
 {
     using ParentType = FVProblem<TypeTag>;
     using GridGeometry = GetPropType<TypeTag, Properties::GridGeometry>;
+    using Scalar = GetPropType<TypeTag, Properties::Scalar>;
 
 public:
     using SpatialParams = GetPropType<TypeTag, Properties::SpatialParams>;
@@ -55,6 +57,7 @@ public:
                         const std::string& paramGroup = "")
     : ParentType(gridGeometry, paramGroup)
     , spatialParams_(spatialParams)
+    , fluxLimiterLETParams_(paramGroup)
     {}
 
     /*!
@@ -78,11 +81,19 @@ public:
     const SpatialParams &spatialParams() const
     { return *spatialParams_; }
 
+    /*!
+     * \brief Returns the parameters of the flux limiter of the Riemann problem
+     *        (looked up once in the parameter group of the problem)
+     */
+    const ShallowWater::FluxLimiterLETParams<Scalar>& fluxLimiterLETParams() const
+    { return fluxLimiterLETParams_; }
+
     // \}
 
 
 private:
     std::shared_ptr<SpatialParams> spatialParams_; //!< the spatial parameters
+    ShallowWater::FluxLimiterLETParams<Scalar> fluxLimiterLETParams_;
 };
 
 } // end namespace Dumux
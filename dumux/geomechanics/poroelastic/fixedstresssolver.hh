@@ -0,0 +1,390 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup PoroElastic
+ * \brief Sequential fixed-stress solver for porous medium flow problems coupled to a poro-mechanical problem
+ */
+#ifndef DUMUX_POROMECHANICS_FIXED_STRESS_SOLVER_HH
+#define DUMUX_POROMECHANICS_FIXED_STRESS_SOLVER_HH
+
+#include <cmath>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <type_traits>
+
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/exceptions.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/io/format.hh>
+#include <dumux/nonlinear/newtonsolver.hh>
+#include <dumux/nonlinear/andersonacceleration.hh>
+#include <dumux/linear/linearsolvertraits.hh>
+#include <dumux/linear/parallelhelpers.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup PoroElastic
+ * \brief Sequential fixed-stress solver for porous medium flow problems coupled to a poro-mechanical problem
+ *
+ * Instead of solving the monolithic linear system of the Newton method, each iteration solves the flow and
+ * the mechanics sub-problem one after the other, each with its own linear solver (e.g. AMG for the scalar
+ * pressure equation and AMG for the elasticity system). Both linear solvers operate on the diagonal blocks
+ * of the coupled Jacobian only, so no preconditioner for the coupled saddle-point-like system is needed.
+ *  - Flow: \f$ (J_{pp} + L) \delta p = r_p \f$ with the fixed-stress stabilization \f$ L \f$,
+ *  - Mechanics: \f$ J_{uu} \delta u = r_u - J_{up} \delta p \f$,
+ * and the iterate is updated by \f$ x \leftarrow x - \delta x \f$ (same sign convention as the Newton solver).
+ *
+ * The stabilization term accounts for the volumetric deformation caused by the pressure change, which is
+ * what the classical fixed-stress split achieves with the term \f$ \alpha^2/K_\mathrm{dr} \f$. Here, it is
+ * computed algebraically from the coupling blocks as the diagonal of \f$ -J_{pu} \mathrm{diag}(J_{uu})^{-1} J_{up} \f$
+ * (scaled by FixedStress.StabilizationFactor), so no mechanical parameters have to be specified.
+ * The resulting fixed-point iteration is accelerated with Anderson acceleration.
+ *
+ * The following run-time parameters are used
+ *  - FixedStress.MaxIterations: the maximum number of iterations (default 100)
+ *  - FixedStress.MaxRelativeShift: converged if the relative shift of all primary variables is smaller (default 1e-8)
+ *  - FixedStress.ResidualReduction: converged if the residual of both sub-problems is reduced by this factor (default 1e-10)
+ *  - FixedStress.StabilizationFactor: scaling of the fixed-stress stabilization (default 1.0, 0.0 is the drained split)
+ *  - FixedStress.AndersonDepth: the number of previous iterates used for Anderson acceleration (default 5, 0 disables it)
+ *  - FixedStress.MaxTimeStepDivisions: the number of time step reductions for instationary problems (default 10)
+ *  - FixedStress.RetryTimeStepReductionFactor: the factor of the time step reduction (default 0.5)
+ *  - FixedStress.Verbosity: the verbosity level (default 1)
+ *
+ * \tparam Assembler the multidomain assembler
+ * \tparam FlowLinearSolver the linear solver for the porous medium flow sub-problem
+ * \tparam MechanicsLinearSolver the linear solver for the poro-mechanical sub-problem
+ * \tparam CouplingManager the poro-mechanics coupling manager (exports pmFlowId and poroMechId)
+ */
+template<class Assembler, class FlowLinearSolver, class MechanicsLinearSolver, class CouplingManager>
+class PoroMechanicsFixedStressSolver
+{
+    using Scalar = typename Assembler::Scalar;
+    using SolutionVector = typename Assembler::SolutionVector;
+    using JacobianMatrix = typename Assembler::JacobianMatrix;
+
+    static constexpr auto flowId = CouplingManager::pmFlowId;
+    static constexpr auto mechId = CouplingManager::poroMechId;
+
+public:
+    /*!
+     * \brief The constructor
+     * \param assembler the multidomain assembler
+     * \param flowLinearSolver the linear solver for the flow sub-problem
+     * \param mechanicsLinearSolver the linear solver for the mechanics sub-problem
+     * \param couplingManager the coupling manager
+     * \param paramGroup the parameter group for parameter lookup
+     */
+    PoroMechanicsFixedStressSolver(std::shared_ptr<Assembler> assembler,
+                                   std::shared_ptr<FlowLinearSolver> flowLinearSolver,
+                                   std::shared_ptr<MechanicsLinearSolver> mechanicsLinearSolver,
+                                   std::shared_ptr<CouplingManager> couplingManager,
+                                   const std::string& paramGroup = "")
+    : assembler_(assembler)
+    , flowLinearSolver_(flowLinearSolver)
+    , mechanicsLinearSolver_(mechanicsLinearSolver)
+    , couplingManager_(couplingManager)
+    , maxIterations_(getParamFromGroup<std::size_t>(paramGroup, "FixedStress.MaxIterations", 100))
+    , maxRelativeShift_(getParamFromGroup<Scalar>(paramGroup, "FixedStress.MaxRelativeShift", 1e-8))
+    , residualReduction_(getParamFromGroup<Scalar>(paramGroup, "FixedStress.ResidualReduction", 1e-10))
+    , stabilizationFactor_(getParamFromGroup<Scalar>(paramGroup, "FixedStress.StabilizationFactor", 1.0))
+    , maxTimeStepDivisions_(getParamFromGroup<std::size_t>(paramGroup, "FixedStress.MaxTimeStepDivisions", 10))
+    , retryTimeStepReductionFactor_(getParamFromGroup<Scalar>(paramGroup, "FixedStress.RetryTimeStepReductionFactor", 0.5))
+    , verbosity_(getParamFromGroup<int>(paramGroup, "FixedStress.Verbosity", 1))
+    , anderson_(getParamFromGroup<std::size_t>(paramGroup, "FixedStress.AndersonDepth", 5))
+    {
+        assembler_->setLinearSystem();
+        setAndersonWeights_();
+    }
+
+    /*!
+     * \brief Solve the coupled problem with time step control for instationary problems
+     * \param x the solution vector (initial guess on entry)
+     * \param timeLoop the time loop
+     */
+    template<class TimeLoop>
+    void solve(SolutionVector& x, TimeLoop& timeLoop)
+    {
+        if (assembler_->isStationaryProblem())
+            DUNE_THROW(Dune::InvalidStateException, "Using time step control with stationary problem makes no sense!");
+
+        for (std::size_t i = 0; i <= maxTimeStepDivisions_; ++i)
+        {
+            if (apply(x))
+                return;
+
+            else if (i < maxTimeStepDivisions_)
+            {
+                // set solution to previous solution & reset time step
+                x = assembler_->prevSol();
+                assembler_->resetTimeStep(x);
+                couplingManager_->updateSolution(x);
+
+                if (verbosity_ >= 1)
+                {
+                    const auto dt = timeLoop.timeStepSize();
+                    std::cout << Fmt::format("Fixed-stress solver did not converge with dt = {} seconds. ", dt)
+                              << Fmt::format("Retrying with time step of dt = {} seconds.\n", dt*retryTimeStepReductionFactor_);
+                }
+
+                timeLoop.setTimeStepSize(timeLoop.timeStepSize() * retryTimeStepReductionFactor_);
+            }
+        }
+
+        DUNE_THROW(NumericalProblem,
+            Fmt::format("Fixed-stress solver didn't converge after {} time-step divisions; dt = {}.\n",
+                        maxTimeStepDivisions_, timeLoop.timeStepSize()));
+    }
+
+    /*!
+     * \brief Solve the coupled problem
+     * \param x the solution vector (initial guess on entry)
+     */
+    void solve(SolutionVector& x)
+    {
+        if (!apply(x))
+            DUNE_THROW(NumericalProblem,
+                Fmt::format("Fixed-stress solver didn't converge after {} iterations.\n", numIterations_));
+    }
+
+    /*!
+     * \brief Run the fixed-stress iteration
+     * \param x the solution vector (initial guess on entry)
+     * \return whether the iteration converged
+     */
+    bool apply(SolutionVector& x)
+    {
+        try
+        {
+            return apply_(x);
+        }
+        catch (const NumericalProblem& e)
+        {
+            if (verbosity_ >= 1)
+                std::cout << "Fixed-stress solver caught exception: \"" << e.what() << "\"\n";
+            return false;
+        }
+    }
+
+    //! the number of iterations of the last call to solve/apply
+    std::size_t numIterations() const
+    { return numIterations_; }
+
+private:
+    bool apply_(SolutionVector& x)
+    {
+        const auto& comm = assembler_->gridView(flowId).comm();
+
+        anderson_.reset();
+        couplingManager_->updateSolution(x);
+        assembler_->updateGridVariables(x);
+
+        std::array<Scalar, 2> initialResidual = {{0.0, 0.0}};
+        std::vector<Scalar> flatX, flatG;
+        for (numIterations_ = 0; numIterations_ < maxIterations_; ++numIterations_)
+        {
+            assembler_->assembleJacobianAndResidual(x);
+            auto& jac = assembler_->jacobian();
+            auto& res = assembler_->residual();
+
+            const std::array<Scalar, 2> residual = {{ std::sqrt(comm.sum(res[flowId].two_norm2())),
+                                                      std::sqrt(comm.sum(res[mechId].two_norm2())) }};
+            if (numIterations_ == 0)
+                initialResidual = residual;
+
+            Scalar reduction = 0.0;
+            for (int i = 0; i < 2; ++i)
+                if (initialResidual[i] > 0.0)
+                    reduction = std::max(reduction, residual[i]/initialResidual[i]);
+
+            if (numIterations_ > 0 && reduction < residualReduction_)
+            {
+                if (verbosity_ >= 1)
+                    std::cout << Fmt::format("Fixed-stress solver converged after {} iterations (residual reduction {:.5e}).\n",
+                                             numIterations_, reduction);
+                return true;
+            }
+
+            // the flow sub-problem with fixed-stress stabilization
+            stabilize_(jac);
+            SolutionVector delta = x;
+            delta = 0.0;
+            auto flowRhs = res[flowId];
+            if (!flowLinearSolver_->solve(jac[flowId][flowId], delta[flowId], flowRhs))
+                DUNE_THROW(NumericalProblem, "Linear solver for the flow sub-problem did not converge");
+
+            // the mechanics sub-problem for the updated pressure
+            auto mechanicsRhs = res[mechId];
+            jac[mechId][flowId].mmv(delta[flowId], mechanicsRhs);
+            if (!mechanicsLinearSolver_->solve(jac[mechId][mechId], delta[mechId], mechanicsRhs))
+                DUNE_THROW(NumericalProblem, "Linear solver for the mechanics sub-problem did not converge");
+
+            // scale both sub-problems to comparable magnitudes for the least-squares fit of the acceleration
+            if (numIterations_ == 0)
+            {
+                weights_[0] = inverseOrOne_(comm.max(delta[flowId].infinity_norm()));
+                weights_[1] = inverseOrOne_(comm.max(delta[mechId].infinity_norm()));
+            }
+
+            // the accelerated fixed-point update x_new = G(x) = x - delta
+            SolutionVector xNew = x;
+            xNew -= delta;
+            flatten_(x, flatX);
+            flatten_(xNew, flatG);
+            anderson_.update(flatX, flatG, [&](std::vector<Scalar>& v){ comm.sum(v.data(), v.size()); });
+            unflatten_(flatG, xNew);
+
+            const auto shift = comm.max(Detail::maxRelativeShift<Scalar>(x, xNew));
+            x = xNew;
+            couplingManager_->updateSolution(x);
+            assembler_->updateGridVariables(x);
+
+            if (verbosity_ >= 1)
+                std::cout << Fmt::format("Fixed-stress iteration {}: residual reduction {:.5e}, shift {:.5e}\n",
+                                         numIterations_, reduction, shift);
+
+            if (shift < maxRelativeShift_)
+            {
+                ++numIterations_;
+                if (verbosity_ >= 1)
+                    std::cout << Fmt::format("Fixed-stress solver converged after {} iterations.\n", numIterations_);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    //! add the diagonal of -J_pu diag(J_uu)^-1 J_up to the flow block
+    void stabilize_(JacobianMatrix& jac) const
+    {
+        if (stabilizationFactor_ == 0.0)
+            return;
+
+        auto& jpp = jac[flowId][flowId];
+        const auto& jpu = jac[flowId][mechId];
+        const auto& jup = jac[mechId][flowId];
+        const auto& juu = jac[mechId][mechId];
+
+        for (auto rowIt = jpu.begin(); rowIt != jpu.end(); ++rowIt)
+        {
+            const auto i = rowIt.index();
+            auto& diagonal = jpp[i][i];
+            for (auto colIt = rowIt->begin(); colIt != rowIt->end(); ++colIt)
+            {
+                const auto k = colIt.index();
+                const auto it = jup[k].find(i);
+                if (it == jup[k].end())
+                    continue;
+
+                const auto& juuDiagonal = juu[k][k];
+                for (std::size_t r = 0; r < diagonal.N(); ++r)
+                    for (std::size_t q = 0; q < juuDiagonal.N(); ++q)
+                        if (juuDiagonal[q][q] != 0.0)
+                            diagonal[r][r] -= stabilizationFactor_*(*colIt)[r][q]*(*it)[q][r]/juuDiagonal[q][q];
+            }
+        }
+    }
+
+    void flatten_(const SolutionVector& x, std::vector<Scalar>& flat) const
+    {
+        flat.clear();
+        const auto append = [&](const auto& v, const Scalar weight)
+        {
+            for (const auto& block : v)
+                for (const auto& value : block)
+                    flat.push_back(weight*value);
+        };
+
+        append(x[flowId], weights_[0]);
+        append(x[mechId], weights_[1]);
+    }
+
+    void unflatten_(const std::vector<Scalar>& flat, SolutionVector& x) const
+    {
+        std::size_t pos = 0;
+        const auto extract = [&](auto& v, const Scalar weight)
+        {
+            for (auto& block : v)
+                for (auto& value : block)
+                    value = flat[pos++]/weight;
+        };
+
+        extract(x[flowId], weights_[0]);
+        extract(x[mechId], weights_[1]);
+    }
+
+    /*!
+     * \brief Count each dof once in the inner products of the Anderson acceleration
+     * \note In parallel runs, the dofs shared with other processes (overlap, ghost or interface dofs)
+     *       are only weighted on the process owning them.
+     */
+    void setAndersonWeights_()
+    {
+        if (assembler_->gridView(flowId).comm().size() <= 1)
+            return;
+
+        std::vector<Scalar> weights;
+        const auto append = [&](auto id)
+        {
+            const auto& gridGeometry = assembler_->gridGeometry(id);
+            using GridGeometry = std::decay_t<decltype(gridGeometry)>;
+            const ParallelISTLHelper<LinearSolverTraits<GridGeometry>> helper(gridGeometry.gridView(), gridGeometry.dofMapper());
+
+            using Block = std::decay_t<decltype(std::declval<const SolutionVector&>()[id][0])>;
+            for (std::size_t i = 0; i < assembler_->numDofs(id); ++i)
+                weights.insert(weights.end(), Block::dimension, helper.isOwned(i) ? 1.0 : 0.0);
+        };
+
+        append(flowId);
+        append(mechId);
+        anderson_.setInnerProductWeights(std::move(weights));
+    }
+
+    static Scalar inverseOrOne_(const Scalar value)
+    { return value > 0.0 ? 1.0/value : 1.0; }
+
+    std::shared_ptr<Assembler> assembler_;
+    std::shared_ptr<FlowLinearSolver> flowLinearSolver_;
+    std::shared_ptr<MechanicsLinearSolver> mechanicsLinearSolver_;
+    std::shared_ptr<CouplingManager> couplingManager_;
+
+    std::size_t maxIterations_;
+    Scalar maxRelativeShift_;
+    Scalar residualReduction_;
+    Scalar stabilizationFactor_;
+    std::size_t maxTimeStepDivisions_;
+    Scalar retryTimeStepReductionFactor_;
+    int verbosity_;
+
+    AndersonAcceleration<Scalar> anderson_;
+    std::array<Scalar, 2> weights_ = {{1.0, 1.0}};
+    std::size_t numIterations_ = 0;
+};
+
+} // end namespace Dumux
+
+#endif
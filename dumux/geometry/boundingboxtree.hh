@@ -36,13 +36,38 @@
 #include <numeric>
 #include <type_traits>
 #include <iostream>
+#include <cassert>
 
 #include <dune/common/promotiontraits.hh>
 #include <dune/common/timer.hh>
 #include <dune/common/fvector.hh>
+#include <dune/common/std/type_traits.hh>
+
+#include <dumux/parallel/parallel_for.hh>
 
 namespace Dumux {
 
+namespace Detail {
+
+template<class EntitySet>
+using EntitySetMultithreadingDetector = decltype(EntitySet::supportsMultithreading);
+
+/*!
+ * \ingroup Geometry
+ * \brief Whether the entities of a geometric entity set may be accessed concurrently
+ * \note Entity sets based on grids that are not thread-safe export `supportsMultithreading = false`
+ */
+template<class EntitySet>
+constexpr bool entitySetSupportsMultithreading()
+{
+    if constexpr (Dune::Std::is_detected<EntitySetMultithreadingDetector, EntitySet>::value)
+        return EntitySet::supportsMultithreading;
+    else
+        return true;
+}
+
+} // end namespace Detail
+
 /*!
  * \ingroup Geometry
  * \brief An axis-aligned bounding box volume tree implementation
@@ -66,6 +91,7 @@ class BoundingBoxTree
 {
     enum { dimworld = GeometricEntitySet::dimensionworld };
     using ctype = typename GeometricEntitySet::ctype;
+    static constexpr bool multithreaded_ = Detail::entitySetSupportsMultithreading<GeometricEntitySet>();
 
     /*!
      * \brief Bounding box node data structure
@@ -105,23 +131,44 @@ public:
         // Create bounding boxes for all elements
         const auto numLeaves = set->size();
 
-        // reserve enough space for the nodes and the coordinates
+        // allocate the nodes and the coordinates
+        // the node indices are known a priori (post-order numbering of the tree)
+        // so that independent subtrees can be filled concurrently
         const auto numNodes = 2*numLeaves - 1;
-        boundingBoxNodes_.reserve(numNodes);
-        boundingBoxCoordinates_.reserve(numNodes*2*dimworld);
+        boundingBoxNodes_.resize(numNodes);
+        boundingBoxCoordinates_.resize(numNodes*2*dimworld);
 
         // create a vector for leaf boxes (min and max for all dims)
         std::vector<ctype> leafBoxes(2*dimworld*numLeaves);
 
-        for (const auto& geometricEntity : *set)
-            computeEntityBoundingBox_(leafBoxes.data() + 2*dimworld*set->index(geometricEntity), geometricEntity);
+        const auto computeLeafBox = [&](const std::size_t entityIdx)
+        {
+            computeEntityBoundingBox_(leafBoxes.data() + 2*dimworld*entityIdx, set->entity(entityIdx));
+        };
+
+        // entities of grids that are not thread-safe (e.g. UGGrid) are obtained sequentially
+        if constexpr (multithreaded_)
+            parallelFor(numLeaves, computeLeafBox);
+        else
+            for (std::size_t entityIdx = 0; entityIdx < numLeaves; ++entityIdx)
+                computeLeafBox(entityIdx);
 
         // create the leaf partition, the set of available indices (to be sorted)
         std::vector<std::size_t> leafPartition(numLeaves);
         std::iota(leafPartition.begin(), leafPartition.end(), 0);
 
-        // Recursively build the bounding box tree
-        build_(leafBoxes, leafPartition.begin(), leafPartition.end());
+        // Build the top of the tree and collect subtrees that are large enough to be built in parallel.
+        // We use a few more subtrees than threads for better load balance.
+        const std::size_t numThreads = multithreaded_ ? maxNumThreads() : 1;
+        const std::size_t minSubtreeSize = numThreads > 1 ? std::max<std::size_t>(1000, numLeaves/(8*numThreads)) : numLeaves;
+        std::vector<SubtreeRange_> subtrees;
+        buildTopLevels_(leafBoxes, leafPartition.begin(), leafPartition.end(), 0, minSubtreeSize, subtrees);
+
+        // Recursively build the independent subtrees
+        parallelFor(subtrees.size(), [&](const std::size_t i)
+        {
+            build_(leafBoxes, subtrees[i].begin, subtrees[i].end, subtrees[i].nodeOffset);
+        });
 
         // We are done, log output
         std::cout << "Computed bounding box tree with " << numBoundingBoxes()
@@ -195,15 +242,59 @@ private:
         }
     }
 
+    using LeafIterator = std::vector<std::size_t>::iterator;
+
+    //! A range of leaves forming an independent subtree and the index of its first node
+    struct SubtreeRange_
+    {
+        LeafIterator begin;
+        LeafIterator end;
+        std::size_t nodeOffset;
+    };
+
+    /*!
+     * \brief Build the upper part of the tree serially
+     * Subtrees with less than minSubtreeSize leaves are not built but added to subtrees
+     * \return the node index of the root of the range [begin, end)
+     * \note A subtree with n leaves has 2n-1 nodes numbered in post-order starting at nodeOffset,
+     *       i.e. the subtree root has index nodeOffset + 2n - 2
+     */
+    std::size_t buildTopLevels_(const std::vector<ctype>& leafBoxes,
+                                const LeafIterator& begin,
+                                const LeafIterator& end,
+                                std::size_t nodeOffset,
+                                std::size_t minSubtreeSize,
+                                std::vector<SubtreeRange_>& subtrees)
+    {
+        const std::size_t numLeaves = end - begin;
+        if (numLeaves <= minSubtreeSize)
+        {
+            subtrees.push_back(SubtreeRange_{begin, end, nodeOffset});
+            return nodeOffset + 2*numLeaves - 2;
+        }
+
+        const auto bCoords = computeBBoxOfBBoxes_(leafBoxes, begin, end);
+        const auto middle = partition_(leafBoxes, begin, end, bCoords);
+        const std::size_t numLeavesLeft = middle - begin;
+        const auto child0 = buildTopLevels_(leafBoxes, begin, middle, nodeOffset, minSubtreeSize, subtrees);
+        const auto child1 = buildTopLevels_(leafBoxes, middle, end, nodeOffset + 2*numLeavesLeft - 1, minSubtreeSize, subtrees);
+        return setBoundingBox_(nodeOffset + 2*numLeaves - 2, BoundingBoxNode{child0, child1}, bCoords.begin(), bCoords.end());
+    }
+
     //! Build bounding box tree for all entities recursively
     std::size_t build_(const std::vector<ctype>& leafBoxes,
-                       const std::vector<std::size_t>::iterator& begin,
-                       const std::vector<std::size_t>::iterator& end)
+                       const LeafIterator& begin,
+                       const LeafIterator& end,
+                       std::size_t nodeOffset)
     {
         assert(begin < end);
 
+        // the index of the node we are constructing (see buildTopLevels_)
+        const std::size_t numLeaves = end - begin;
+        const std::size_t nodeIdx = nodeOffset + 2*numLeaves - 2;
+
         // If we reached the end of the recursion, i.e. only a leaf box is left
-        if (end - begin == 1)
+        if (numLeaves == 1)
         {
             // Get the bounding box coordinates for the leaf
             const std::size_t leafNodeIdx = *begin;
@@ -213,12 +304,29 @@ private:
             // Store the data in the bounding box
             // leaf nodes are indicated by setting child0 to
             // the node itself and child1 to the index of the entity in the bounding box.
-            return addBoundingBox_(BoundingBoxNode{numBoundingBoxes(), leafNodeIdx}, beginCoords, endCoords);
+            return setBoundingBox_(nodeIdx, BoundingBoxNode{nodeIdx, leafNodeIdx}, beginCoords, endCoords);
         }
 
         // Compute the bounding box of all bounding boxes in the range [begin, end]
         const auto bCoords = computeBBoxOfBBoxes_(leafBoxes, begin, end);
 
+        // split the bounding boxes into two at the median along the longest axis
+        const auto middle = partition_(leafBoxes, begin, end, bCoords);
+
+        // call build recursively for both halves, each call resulting in a new node of this bounding box,
+        // the left subtree occupies the first 2*numLeavesLeft - 1 nodes after nodeOffset
+        const std::size_t numLeavesLeft = middle - begin;
+        const auto child0 = build_(leafBoxes, begin, middle, nodeOffset);
+        const auto child1 = build_(leafBoxes, middle, end, nodeOffset + 2*numLeavesLeft - 1);
+        return setBoundingBox_(nodeIdx, BoundingBoxNode{child0, child1}, bCoords.begin(), bCoords.end());
+    }
+
+    //! Sort the leaves such that the returned iterator points to the median along the longest axis
+    LeafIterator partition_(const std::vector<ctype>& leafBoxes,
+                            const LeafIterator& begin,
+                            const LeafIterator& end,
+                            const std::array<ctype, 2*dimworld>& bCoords) const
+    {
         // sort bounding boxes along the longest axis
         const auto axis = computeLongestAxis_(bCoords);
 
@@ -232,33 +340,31 @@ private:
                              return bi[axis] + bi[axis + dimworld] < bj[axis] + bj[axis + dimworld];
                          });
 
-        // split the bounding boxes into two at the middle iterator and call build recursively, each
-        // call resulting in a new node of this bounding box, i.e. the root will be added at the end of the process.
-        return addBoundingBox_(BoundingBoxNode{build_(leafBoxes, begin, middle), build_(leafBoxes, middle, end)},
-                               bCoords.begin(), bCoords.end());
+        return middle;
     }
 
-    //! Add a new bounding box to the tree
+    //! Set the data of a bounding box node (the node storage has been allocated before)
     template <class Iterator>
-    std::size_t addBoundingBox_(BoundingBoxNode&& node,
+    std::size_t setBoundingBox_(std::size_t nodeIdx,
+                                BoundingBoxNode&& node,
                                 const Iterator& coordBegin,
                                 const Iterator& coordEnd)
     {
-        // Add the bounding box
-        boundingBoxNodes_.emplace_back(node);
+        // Set the bounding box
+        boundingBoxNodes_[nodeIdx] = node;
 
-        // Add the bounding box's coordinates
-        boundingBoxCoordinates_.insert(boundingBoxCoordinates_.end(), coordBegin, coordEnd);
+        // Set the bounding box's coordinates
+        std::copy(coordBegin, coordEnd, boundingBoxCoordinates_.begin() + 2*dimworld*nodeIdx);
 
-        // return the index of the new node
-        return boundingBoxNodes_.size() - 1;
+        // return the index of the node
+        return nodeIdx;
     }
 
     //! Compute the bounding box of a vector of bounding boxes
     std::array<ctype, 2*dimworld>
     computeBBoxOfBBoxes_(const std::vector<ctype>& leafBoxes,
-                         const std::vector<std::size_t>::iterator& begin,
-                         const std::vector<std::size_t>::iterator& end)
+                         const LeafIterator& begin,
+                         const LeafIterator& end) const
     {
         std::array<ctype, 2*dimworld> bBoxCoords;
 
@@ -285,7 +391,7 @@ private:
     }
 
     //! Compute the bounding box of a vector of bounding boxes
-    std::size_t computeLongestAxis_(const std::array<ctype, 2*dimworld>& bCoords)
+    std::size_t computeLongestAxis_(const std::array<ctype, 2*dimworld>& bCoords) const
     {
         std::array<ctype, dimworld> axisLength;
         for (int coordIdx = 0; coordIdx < dimworld; ++coordIdx)
@@ -28,6 +28,7 @@
 #include <dune/grid/common/mcmgmapper.hh>
 #include <dune/geometry/multilineargeometry.hh>
 #include <dumux/common/entitymap.hh>
+#include <dumux/common/gridcapabilities.hh>
 
 namespace Dumux {
 
@@ -72,6 +73,11 @@ public:
      */
     using ctype = typename GridView::ctype;
 
+    /*!
+     * \brief whether entities can be obtained from several threads concurrently
+     */
+    static constexpr bool supportsMultithreading = Detail::supportsMultithreading<typename GridView::Grid>;
+
     /*!
      * \brief the number of entities in this set
      */
@@ -23,14 +23,20 @@
 #define DUMUX_GEOMETRY_INTERSECTING_ENTITIES_HH
 
 #include <cmath>
+#include <cassert>
+#include <cstdint>
+#include <array>
+#include <utility>
 #include <type_traits>
 #include <vector>
 #include <algorithm>
+#include <iterator>
 #include <limits>
 
 #include <dune/common/fvector.hh>
 
 #include <dumux/common/math.hh>
+#include <dumux/parallel/parallel_for.hh>
 #include <dumux/geometry/boundingboxtree.hh>
 #include <dumux/geometry/intersectspointgeometry.hh>
 #include <dumux/geometry/geometryintersection.hh>
@@ -67,7 +73,7 @@ public:
     { return b_; }
 
     //! Get the corners of the intersection geometry
-    std::vector<GlobalPosition> corners() const
+    const std::vector<GlobalPosition>& corners() const
     { return corners_; }
 
     /*!
@@ -161,6 +167,240 @@ void intersectingEntities(const Dune::FieldVector<ctype, dimworld>& point,
     }
 }
 
+namespace Detail {
+
+//! the number of set bits of a lane mask
+inline std::size_t countActiveLanes_(std::uint32_t mask)
+{
+    std::size_t count = 0;
+    for (; mask; mask &= mask - 1)
+        ++count;
+    return count;
+}
+
+//! the index of the lowest set bit of a (non-zero) lane mask
+inline std::size_t lowestActiveLane_(std::uint32_t mask)
+{
+    assert(mask != 0);
+    std::size_t lane = 0;
+    for (; !(mask & 1u); mask >>= 1)
+        ++lane;
+    return lane;
+}
+
+/*!
+ * \ingroup Geometry
+ * \brief A key for sorting points along a Morton (Z-order) space-filling curve
+ * \param p the point
+ * \param b the bounding box (min, max) of all points
+ */
+template<class ctype, int dimworld>
+std::uint64_t mortonKey(const Dune::FieldVector<ctype, dimworld>& p, const ctype* b)
+{
+    static constexpr int bitsPerDim = 63/dimworld;
+    static constexpr std::uint64_t maxCell = (std::uint64_t(1) << bitsPerDim) - 1;
+
+    std::array<std::uint64_t, dimworld> cell;
+    for (int d = 0; d < dimworld; ++d)
+    {
+        const ctype extent = b[d+dimworld] - b[d];
+        const ctype relPos = extent > 0.0 ? (p[d] - b[d])/extent : 0.0;
+        cell[d] = static_cast<std::uint64_t>(std::clamp<ctype>(relPos, 0.0, 1.0)*maxCell);
+    }
+
+    std::uint64_t key = 0;
+    for (int bit = bitsPerDim-1; bit >= 0; --bit)
+        for (int d = 0; d < dimworld; ++d)
+            key = (key << 1) | ((cell[d] >> bit) & 1);
+    return key;
+}
+
+/*!
+ * \ingroup Geometry
+ * \brief Traverse the bounding box tree once for a packet of (at most packetSize) points
+ *
+ * All points of the packet walk the tree together. Each stack entry carries a bit mask
+ * of the lanes (points) still active in that subtree, so a node's bounding box is loaded once
+ * and tested against all active points with a branch-free inner loop over the lanes.
+ * This is most efficient if the points in a packet are spatially close to each other.
+ * The entities are reported per point in the same order as for the single point query.
+ */
+template<std::size_t packetSize, class EntitySet, class ctype, int dimworld, class Callback>
+void intersectingEntitiesPacket(const std::array<Dune::FieldVector<ctype, dimworld>, packetSize>& points,
+                                std::size_t numPoints,
+                                const BoundingBoxTree<EntitySet>& tree,
+                                const Callback& callback,
+                                bool isCartesianGrid)
+{
+    using Mask = std::uint32_t;
+    static_assert(packetSize <= 8*sizeof(Mask), "Packet size exceeds the number of bits of the lane mask");
+    assert(numPoints <= packetSize);
+
+    // copy the coordinates into a structure-of-arrays layout
+    std::array<std::array<ctype, packetSize>, dimworld> x;
+    for (std::size_t lane = 0; lane < packetSize; ++lane)
+        for (int d = 0; d < dimworld; ++d)
+            x[d][lane] = points[lane < numPoints ? lane : 0][d];
+
+    // a median split tree is balanced, 64 levels suffice for any index range
+    struct StackEntry { std::size_t node; Mask mask; };
+    std::array<StackEntry, 128> stack;
+    std::size_t stackSize = 0;
+
+    const Mask fullMask = numPoints == 8*sizeof(Mask) ? ~Mask(0) : (Mask(1) << numPoints) - 1;
+    stack[stackSize++] = StackEntry{tree.numBoundingBoxes() - 1, fullMask};
+
+    while (stackSize > 0)
+    {
+        const auto [node, parentMask] = stack[--stackSize];
+        const ctype* b = tree.getBoundingBoxCoordinates(node);
+
+        // relative tolerance as in intersectsPointBoundingBox
+        ctype eps = b[dimworld] - b[0];
+        for (int d = 1; d < dimworld; ++d)
+            eps = std::max(eps, b[d+dimworld] - b[d]);
+        eps *= 1.0e-7;
+
+        const auto isInside = [&](const std::size_t lane)
+        {
+            bool inside = true;
+            for (int d = 0; d < dimworld; ++d)
+                inside &= (b[d] - eps <= x[d][lane]) & (x[d][lane] <= b[d+dimworld] + eps);
+            return inside;
+        };
+
+        // test all lanes at once (vectorizable) unless only a few lanes are still active
+        Mask mask = 0;
+        if (countActiveLanes_(parentMask) > packetSize/4)
+        {
+            for (std::size_t lane = 0; lane < packetSize; ++lane)
+                mask |= Mask(isInside(lane)) << lane;
+            mask &= parentMask;
+        }
+        else
+        {
+            for (Mask active = parentMask; active; active &= active - 1)
+            {
+                const std::size_t lane = lowestActiveLane_(active);
+                mask |= Mask(isInside(lane)) << lane;
+            }
+        }
+
+        // if none of the points is in the bounding box we can stop
+        if (!mask)
+            continue;
+
+        const auto& bBox = tree.getBoundingBoxNode(node);
+        if (tree.isLeaf(bBox, node))
+        {
+            const std::size_t entityIdx = bBox.child1;
+            // for structured cube grids skip the primitive test
+            if (isCartesianGrid)
+            {
+                for (Mask active = mask; active; active &= active - 1)
+                    callback(lowestActiveLane_(active), entityIdx);
+            }
+            else
+            {
+                const auto geometry = tree.entitySet().entity(entityIdx).geometry();
+                for (Mask active = mask; active; active &= active - 1)
+                {
+                    const std::size_t lane = lowestActiveLane_(active);
+                    if (intersectsPointGeometry(points[lane], geometry))
+                        callback(lane, entityIdx);
+                }
+            }
+        }
+
+        // No leaf. Continue with both children (child0 first, like the recursive algorithm).
+        else
+        {
+            assert(stackSize + 2 <= stack.size());
+            stack[stackSize++] = StackEntry{bBox.child1, mask};
+            stack[stackSize++] = StackEntry{bBox.child0, mask};
+        }
+    }
+}
+
+} // end namespace Detail
+
+/*!
+ * \ingroup Geometry
+ * \brief Compute all intersections between entities and a batch of points
+ *
+ * The points are processed in packets that traverse the tree together (see Detail::intersectingEntitiesPacket)
+ * and the packets are distributed over threads (see parallelFor) if the entity set supports it.
+ * For each found intersection callback(pointIdx, entityIdx) is called.
+ * \note The callback is called concurrently for points of different packets and has to be thread-safe
+ *       in that respect. For a given point, the callback is always called from the same thread.
+ * \note To group nearby points into the same packet, the points are ordered along a Morton curve first.
+ */
+template<class EntitySet, class ctype, int dimworld, class Callback>
+void forEachIntersectingEntity(const std::vector<Dune::FieldVector<ctype, dimworld>>& points,
+                               const BoundingBoxTree<EntitySet>& tree,
+                               const Callback& callback,
+                               bool isCartesianGrid = false)
+{
+    if (points.empty())
+        return;
+
+    // sort the points along a space-filling curve so that the points in a packet are close to each other
+    std::array<ctype, 2*dimworld> bBox;
+    for (int d = 0; d < dimworld; ++d)
+    {
+        const auto [minIt, maxIt] = std::minmax_element(points.begin(), points.end(),
+                                                        [d](const auto& a, const auto& b){ return a[d] < b[d]; });
+        bBox[d] = (*minIt)[d];
+        bBox[d+dimworld] = (*maxIt)[d];
+    }
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> order(points.size());
+    parallelFor(points.size(), [&](const std::size_t i)
+    { order[i] = std::make_pair(Detail::mortonKey(points[i], bBox.data()), i); });
+    std::sort(order.begin(), order.end());
+
+    static constexpr std::size_t packetSize = 16;
+    const std::size_t numPackets = (points.size() + packetSize - 1)/packetSize;
+    const auto processPacket = [&](const std::size_t packetIdx)
+    {
+        const std::size_t offset = packetIdx*packetSize;
+        const std::size_t numPoints = std::min(packetSize, points.size() - offset);
+        std::array<Dune::FieldVector<ctype, dimworld>, packetSize> packet;
+        for (std::size_t lane = 0; lane < numPoints; ++lane)
+            packet[lane] = points[order[offset + lane].second];
+
+        Detail::intersectingEntitiesPacket(packet, numPoints, tree,
+            [&](const std::size_t lane, const std::size_t entityIdx){ callback(order[offset + lane].second, entityIdx); },
+            isCartesianGrid
+        );
+    };
+
+    // the leaf tests access the entities which is not thread-safe for all grids (e.g. UGGrid)
+    if constexpr (Detail::entitySetSupportsMultithreading<EntitySet>())
+        parallelFor(numPackets, processPacket);
+    else
+        for (std::size_t packetIdx = 0; packetIdx < numPackets; ++packetIdx)
+            processPacket(packetIdx);
+}
+
+/*!
+ * \ingroup Geometry
+ * \brief Compute all intersections between entities and a batch of points
+ * \return a vector of intersecting entity indices for each point
+ *         (equivalent to calling intersectingEntities(point, tree) for each point)
+ */
+template<class EntitySet, class ctype, int dimworld>
+inline std::vector<std::vector<std::size_t>>
+intersectingEntities(const std::vector<Dune::FieldVector<ctype, dimworld>>& points,
+                     const BoundingBoxTree<EntitySet>& tree,
+                     bool isCartesianGrid = false)
+{
+    std::vector<std::vector<std::size_t>> entities(points.size());
+    forEachIntersectingEntity(points, tree, [&](const std::size_t pointIdx, const std::size_t entityIdx)
+    { entities[pointIdx].push_back(entityIdx); }, isCartesianGrid);
+    return entities;
+}
+
 /*!
  * \ingroup Geometry
  * \brief Compute all intersections between a geometry and a bounding box tree
@@ -266,9 +506,39 @@ void intersectingEntities(const Geometry& geometry,
     }
 }
 
+namespace Detail {
+
+/*!
+ * \ingroup Geometry
+ * \brief The two pairs of nodes visited after a pair of bounding box tree nodes
+ *        of which at least one is not a leaf (in the order of the recursion)
+ */
+template<class EntitySet0, class EntitySet1>
+std::array<std::pair<std::size_t, std::size_t>, 2>
+childNodePairs(const BoundingBoxTree<EntitySet0>& treeA,
+               const BoundingBoxTree<EntitySet1>& treeB,
+               std::size_t nodeA, std::size_t nodeB)
+{
+    const auto& bBoxA = treeA.getBoundingBoxNode(nodeA);
+    const auto& bBoxB = treeB.getBoundingBoxNode(nodeB);
+
+    // if we reached the leaf in treeA (treeB), just continue in treeB (treeA),
+    // otherwise continue with the larger tree first (bigger node number)
+    if (treeA.isLeaf(bBoxA, nodeA) || (!treeB.isLeaf(bBoxB, nodeB) && nodeA <= nodeB))
+        return {{ {nodeA, bBoxB.child0}, {nodeA, bBoxB.child1} }};
+    else
+        return {{ {bBoxA.child0, nodeB}, {bBoxA.child1, nodeB} }};
+}
+
+} // end namespace Detail
+
 /*!
  * \ingroup Geometry
  * \brief Compute all intersections between two bounding box trees
+ * \note The trees are descended until there are enough independent pairs of nodes
+ *       to distribute the remaining recursion over threads (see parallelFor).
+ *       If one of the entity sets does not support multithreading, the sequential recursion is used.
+ *       The intersections are returned in the order of the sequential recursion.
  */
 template<class EntitySet0, class EntitySet1>
 inline std::vector<IntersectionInfo<EntitySet0::dimensionworld, typename EntitySet0::ctype, typename EntitySet1::ctype>>
@@ -280,13 +550,62 @@ intersectingEntities(const BoundingBoxTree<EntitySet0>& treeA,
         "Can only intersect bounding box trees of same world dimension");
 
     // Create data structure for return type
-    std::vector<IntersectionInfo<EntitySet0::dimensionworld, typename EntitySet0::ctype, typename EntitySet1::ctype>> intersections;
+    using Intersections = std::vector<IntersectionInfo<EntitySet0::dimensionworld, typename EntitySet0::ctype, typename EntitySet1::ctype>>;
+    Intersections intersections;
+
+    // descend the trees level by level (keeping the order of the recursion)
+    // until there are enough pairs of nodes for all threads
+    static constexpr int dimworld = EntitySet0::dimensionworld;
+    std::vector<std::pair<std::size_t, std::size_t>> nodePairs{{treeA.numBoundingBoxes() - 1, treeB.numBoundingBoxes() - 1}};
+    // the leaf tests access the entities, so both entity sets have to support multithreading (not e.g. UGGrid)
+    static constexpr bool multithreaded = Detail::entitySetSupportsMultithreading<EntitySet0>()
+                                          && Detail::entitySetSupportsMultithreading<EntitySet1>();
+    const std::size_t minNumNodePairs = multithreaded && maxNumThreads() > 1 ? 16*maxNumThreads() : 1;
+    while (nodePairs.size() < minNumNodePairs)
+    {
+        bool refined = false;
+        std::vector<std::pair<std::size_t, std::size_t>> nextNodePairs;
+        nextNodePairs.reserve(2*nodePairs.size());
+        for (const auto& [nodeA, nodeB] : nodePairs)
+        {
+            if (!intersectsBoundingBoxBoundingBox<dimworld>(treeA.getBoundingBoxCoordinates(nodeA),
+                                                            treeB.getBoundingBoxCoordinates(nodeB)))
+                refined = true;
+            else if (treeA.isLeaf(treeA.getBoundingBoxNode(nodeA), nodeA) && treeB.isLeaf(treeB.getBoundingBoxNode(nodeB), nodeB))
+                nextNodePairs.emplace_back(nodeA, nodeB);
+            else
+            {
+                for (const auto& childPair : Detail::childNodePairs(treeA, treeB, nodeA, nodeB))
+                    nextNodePairs.push_back(childPair);
+                refined = true;
+            }
+        }
+
+        nodePairs.swap(nextNodePairs);
+        if (!refined)
+            break;
+    }
 
     // Call the recursive find function to find candidates
-    intersectingEntities(treeA, treeB,
-                         treeA.numBoundingBoxes() - 1,
-                         treeB.numBoundingBoxes() - 1,
-                         intersections);
+    if (nodePairs.size() == 1)
+        intersectingEntities(treeA, treeB, nodePairs[0].first, nodePairs[0].second, intersections);
+
+    else if (nodePairs.size() > 1)
+    {
+        std::vector<Intersections> nodePairIntersections(nodePairs.size());
+        parallelFor(nodePairs.size(), [&](const std::size_t i)
+        {
+            intersectingEntities(treeA, treeB, nodePairs[i].first, nodePairs[i].second, nodePairIntersections[i]);
+        });
+
+        std::size_t numIntersections = 0;
+        for (const auto& is : nodePairIntersections)
+            numIntersections += is.size();
+
+        intersections.reserve(numIntersections);
+        for (auto& is : nodePairIntersections)
+            std::move(is.begin(), is.end(), std::back_inserter(intersections));
+    }
 
     return intersections;
 }
@@ -348,32 +667,10 @@ void intersectingEntities(const BoundingBoxTree<EntitySet0>& treeA,
         }
     }
 
-    // if we reached the leaf in treeA, just continue in treeB
-    else if (isLeafA)
-    {
-        intersectingEntities(treeA, treeB, nodeA, bBoxB.child0, intersections);
-        intersectingEntities(treeA, treeB, nodeA, bBoxB.child1, intersections);
-    }
-
-    // if we reached the leaf in treeB, just continue in treeA
-    else if (isLeafB)
-    {
-        intersectingEntities(treeA, treeB, bBoxA.child0, nodeB, intersections);
-        intersectingEntities(treeA, treeB, bBoxA.child1, nodeB, intersections);
-    }
-
-    // we know now that both trees didn't reach the leaf yet so
-    // we continue with the larger tree first (bigger node number)
-    else if (nodeA > nodeB)
-    {
-        intersectingEntities(treeA, treeB, bBoxA.child0, nodeB, intersections);
-        intersectingEntities(treeA, treeB, bBoxA.child1, nodeB, intersections);
-    }
+    // otherwise continue the recursion with the child nodes
     else
-    {
-        intersectingEntities(treeA, treeB, nodeA, bBoxB.child0, intersections);
-        intersectingEntities(treeA, treeB, nodeA, bBoxB.child1, intersections);
-    }
+        for (const auto& [childA, childB] : Detail::childNodePairs(treeA, treeB, nodeA, nodeB))
+            intersectingEntities(treeA, treeB, childA, childB, intersections);
 }
 
 /*!
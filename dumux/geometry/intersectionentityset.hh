@@ -26,10 +26,15 @@
 #define DUMUX_GEOMETRY_INTERSECTION_ENTITY_SET_HH
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -186,63 +191,62 @@ public:
         // compute raw intersections
         const auto rawIntersections = intersectingEntities(domainTree, targetTree);
 
-        // create a map to check whether intersection geometries were already inserted
-        // Note that this can only occur if the grids have different dimensionality.
-        // If this is the case, we keep track of the intersections using the indices of the lower-
-        // dimensional entities which is identical for all geometrically identical intersections.
-        std::vector<std::vector<std::vector<GlobalPosition>>> intersectionMap;
-        std::vector<std::vector<std::size_t>> intersectionIndex;
-        if constexpr (isMixedDimensional)
-        {
-            const auto numLowDimEntities = dimTarget < dimDomain ? targetTree.entitySet().size()
-                                                                 : domainTree.entitySet().size();
-            intersectionMap.resize(numLowDimEntities);
-            intersectionIndex.resize(numLowDimEntities);
-        }
-
         // reserve memory for storing the intersections. In case of grids of
         // different dimensionality this might be an overestimate. We get rid
         // of the overhead memory at the end of this function though.
         intersections_.clear();
         intersections_.reserve(rawIntersections.size());
 
-        for (const auto& rawIntersection : rawIntersections)
+        // Geometrically identical intersections can only occur if the grids have different dimensionality.
+        // In this case, they have the same lower-dimensional neighbor entity and we only add new neighbor
+        // information to the intersection inserted first. To find it, the intersections are hashed by
+        // the index of the lower-dimensional neighbor and the (quantized) centroid of their corners.
+        if constexpr (isMixedDimensional)
         {
-            bool add = true;
-
-            // Check if intersection was already inserted.
-            // In this case we only add new neighbor information as the geometry is identical.
-            if constexpr (isMixedDimensional)
+            // The corners of matching intersections differ at most by 1.5e-7 times the size of the intersection
+            // (see IntersectionInfo::cornersMatch). With a cell size larger than this tolerance, the centroids
+            // of matching intersections are in the same or in neighboring cells.
+            ctype maxSize2 = 0.0;
+            for (const auto& rawIntersection : rawIntersections)
+                maxSize2 = std::max(maxSize2, maxSize2_(rawIntersection.corners()));
+            const ctype cellSize = maxSize2 > 0.0 ? 2.0*1.5e-7*std::sqrt(maxSize2) : 1.0;
+
+            std::unordered_multimap<IntersectionKey, std::size_t, IntersectionKeyHash> intersectionIndices;
+            intersectionIndices.reserve(rawIntersections.size());
+            std::vector<std::size_t> rawIntersectionIndex;
+            rawIntersectionIndex.reserve(rawIntersections.size());
+
+            for (std::size_t i = 0; i < rawIntersections.size(); ++i)
             {
-                const auto lowDimNeighborIdx = getLowDimNeighborIdx_(rawIntersection);
-                for (int i = 0; i < intersectionMap[lowDimNeighborIdx].size(); ++i)
-                {
-                    if (rawIntersection.cornersMatch(intersectionMap[lowDimNeighborIdx][i]))
-                    {
-                        add = false;
-                        // only add the pair of neighbors using the insertionIndex
-                        auto idx = intersectionIndex[lowDimNeighborIdx][i];
-                        intersections_[idx].addNeighbors(rawIntersection.first(), rawIntersection.second());
-                        break;
-                    }
-                }
-            }
+                const auto& rawIntersection = rawIntersections[i];
+                const auto key = makeKey_(rawIntersection, cellSize);
 
-            if(add)
-            {
-                // maybe add to the map
-                if constexpr (isMixedDimensional)
+                // find the first inserted intersection with matching corners in this or a neighboring cell
+                std::size_t match = intersections_.size();
+                forEachNeighborKey_(key, [&](const IntersectionKey& neighborKey)
                 {
-                    intersectionMap[getLowDimNeighborIdx_(rawIntersection)].push_back(rawIntersection.corners());
-                    intersectionIndex[getLowDimNeighborIdx_(rawIntersection)].push_back(intersections_.size());
+                    const auto range = intersectionIndices.equal_range(neighborKey);
+                    for (auto it = range.first; it != range.second; ++it)
+                        if (it->second < match && rawIntersection.cornersMatch(rawIntersections[rawIntersectionIndex[it->second]].corners()))
+                            match = it->second;
+                });
+
+                // only add the pair of neighbors if the intersection was already inserted
+                if (match < intersections_.size())
+                    intersections_[match].addNeighbors(rawIntersection.first(), rawIntersection.second());
+                else
+                {
+                    intersectionIndices.emplace(key, intersections_.size());
+                    rawIntersectionIndex.push_back(i);
+                    addIntersection_(domainTree, targetTree, rawIntersection);
                 }
-
-                // add new intersection and add the neighbors
-                intersections_.emplace_back(domainTree, targetTree);
-                intersections_.back().setCorners(rawIntersection.corners());
-                intersections_.back().addNeighbors(rawIntersection.first(), rawIntersection.second());
             }
         }
+        else
+        {
+            for (const auto& rawIntersection : rawIntersections)
+                addIntersection_(domainTree, targetTree, rawIntersection);
+        }
 
         intersections_.shrink_to_fit();
         std::cout << "Computed " << size() << " intersection entities in " << timer.elapsed() << std::endl;
@@ -269,9 +273,30 @@ public:
     { return {set.ibegin(), set.iend()}; }
 
 private:
+    //! The index of the lower-dimensional neighbor and the cell of the centroid of an intersection
+    struct IntersectionKey
+    {
+        std::size_t lowDimNeighborIdx;
+        std::array<std::int64_t, dimWorld> cell;
+
+        bool operator==(const IntersectionKey& other) const
+        { return lowDimNeighborIdx == other.lowDimNeighborIdx && cell == other.cell; }
+    };
+
+    struct IntersectionKeyHash
+    {
+        std::size_t operator()(const IntersectionKey& key) const
+        {
+            std::size_t seed = std::hash<std::size_t>{}(key.lowDimNeighborIdx);
+            for (const auto c : key.cell)
+                seed ^= std::hash<std::int64_t>{}(c) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
     template<class RawIntersection,
              bool enable = isMixedDimensional, std::enable_if_t<enable, int> = 0>
-    auto getLowDimNeighborIdx_(const RawIntersection& is)
+    auto getLowDimNeighborIdx_(const RawIntersection& is) const
     {
         if constexpr (dimTarget < dimDomain)
             return is.second();
@@ -279,6 +304,55 @@ private:
             return is.first();
     }
 
+    template<class RawIntersection>
+    IntersectionKey makeKey_(const RawIntersection& is, ctype cellSize) const
+    {
+        GlobalPosition centroid(0.0);
+        for (const auto& corner : is.corners())
+            centroid += corner;
+        centroid /= is.corners().size();
+
+        IntersectionKey key{getLowDimNeighborIdx_(is), {}};
+        for (int i = 0; i < dimWorld; ++i)
+            key.cell[i] = static_cast<std::int64_t>(std::floor(centroid[i]/cellSize));
+        return key;
+    }
+
+    //! call f for the key and the keys of all neighboring cells
+    template<class F>
+    static void forEachNeighborKey_(const IntersectionKey& key, const F& f)
+    {
+        IntersectionKey neighborKey = key;
+        std::size_t numNeighbors = 1;
+        for (int i = 0; i < dimWorld; ++i)
+            numNeighbors *= 3;
+
+        for (std::size_t n = 0; n < numNeighbors; ++n)
+        {
+            std::size_t offsets = n;
+            for (int i = 0; i < dimWorld; ++i, offsets /= 3)
+                neighborKey.cell[i] = key.cell[i] + static_cast<std::int64_t>(offsets%3) - 1;
+            f(neighborKey);
+        }
+    }
+
+    //! the maximum squared distance of the corners to the first corner
+    static ctype maxSize2_(const std::vector<GlobalPosition>& corners)
+    {
+        ctype size2 = 0.0;
+        for (std::size_t i = 1; i < corners.size(); ++i)
+            size2 = std::max(size2, (corners[i] - corners[0]).two_norm2());
+        return size2;
+    }
+
+    template<class RawIntersection>
+    void addIntersection_(const DomainTree& domainTree, const TargetTree& targetTree, const RawIntersection& rawIntersection)
+    {
+        intersections_.emplace_back(domainTree, targetTree);
+        intersections_.back().setCorners(rawIntersection.corners());
+        intersections_.back().addNeighbors(rawIntersection.first(), rawIntersection.second());
+    }
+
     Intersections intersections_;
 
     std::shared_ptr<const DomainTree> domainTree_;
@@ -0,0 +1,902 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup InputOutput
+ * \brief A reader for Gmsh mesh files in format version 4.1 (ASCII and binary)
+ */
+#ifndef DUMUX_IO_GRID_GMSHREADER_HH
+#define DUMUX_IO_GRID_GMSHREADER_HH
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/timer.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/geometry/type.hh>
+#include <dune/grid/common/gridfactory.hh>
+#include <dune/grid/io/file/gmshreader.hh>
+
+#include <dumux/parallel/parallel_for.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup InputOutput
+ * \brief The nodes and elements read from a Gmsh file
+ * \note Nodes and elements are stored in the order of the file. The node indices
+ *       in the element connectivity refer to the position in `nodes` (not to the gmsh node tags).
+ */
+struct GmshMeshData
+{
+    //! the node coordinates
+    std::vector<std::array<double, 3>> nodes;
+    //! the gmsh tags of the nodes
+    std::vector<std::size_t> nodeTags;
+
+    //! the gmsh element type of each element
+    std::vector<int> elementTypes;
+    //! the dimension of each element
+    std::vector<int> elementDims;
+    //! the (first) physical tag of the entity an element belongs to (0 if there is none)
+    std::vector<int> physicalTags;
+    //! the partition an element belongs to (0 if the mesh is not partitioned)
+    std::vector<int> partitions;
+    //! the nodes of element i are elementNodes[elementOffsets[i]], ..., elementNodes[elementOffsets[i+1]-1]
+    std::vector<std::size_t> elementOffsets = {0};
+    std::vector<std::size_t> elementNodes;
+
+    //! the number of partitions (0 if the mesh is not partitioned)
+    std::size_t numPartitions = 0;
+
+    std::size_t numNodes() const
+    { return nodes.size(); }
+
+    std::size_t numElements() const
+    { return elementTypes.size(); }
+
+    //! the number of nodes of element i (including higher-order nodes)
+    std::size_t numElementNodes(std::size_t i) const
+    { return elementOffsets[i+1] - elementOffsets[i]; }
+
+    //! the index of the j-th node of element i
+    std::size_t elementNode(std::size_t i, std::size_t j) const
+    { return elementNodes[elementOffsets[i] + j]; }
+};
+
+namespace Detail::Gmsh {
+
+//! The number of nodes of a gmsh element type (0 for unsupported types)
+inline int numNodes(int gmshType)
+{
+    static constexpr std::array<int, 20> n{{0, 2, 3, 4, 4, 8, 6, 5, 3, 6, 9, 10, 27, 18, 14, 1, 8, 20, 15, 13}};
+    return (gmshType > 0 && gmshType < int(n.size())) ? n[gmshType] : 0;
+}
+
+//! The number of corners of a gmsh element type
+inline int numCorners(int gmshType)
+{
+    static constexpr std::array<int, 20> n{{0, 2, 3, 4, 4, 8, 6, 5, 2, 3, 4, 4, 8, 6, 5, 1, 4, 8, 6, 5}};
+    return (gmshType > 0 && gmshType < int(n.size())) ? n[gmshType] : 0;
+}
+
+//! The geometry type of the (linear) reference element of a gmsh element type
+inline Dune::GeometryType geometryType(int gmshType)
+{
+    switch (gmshType)
+    {
+        case 15: return Dune::GeometryTypes::vertex;
+        case 1: case 8: return Dune::GeometryTypes::line;
+        case 2: case 9: return Dune::GeometryTypes::triangle;
+        case 3: case 10: case 16: return Dune::GeometryTypes::quadrilateral;
+        case 4: case 11: return Dune::GeometryTypes::tetrahedron;
+        case 5: case 12: case 17: return Dune::GeometryTypes::hexahedron;
+        case 6: case 13: case 18: return Dune::GeometryTypes::prism;
+        case 7: case 14: case 19: return Dune::GeometryTypes::pyramid;
+        default:
+            DUNE_THROW(Dune::NotImplemented, "Gmsh element type " << gmshType);
+    }
+}
+
+/*!
+ * \brief A read-only view on the content of a file
+ * \note The file is memory-mapped where supported and read into memory otherwise.
+ */
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& fileName)
+    {
+#if __has_include(<sys/mman.h>)
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+            DUNE_THROW(Dune::IOError, "Could not open " << fileName);
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            DUNE_THROW(Dune::IOError, "Could not determine the size of " << fileName);
+        }
+
+        size_ = info.st_size;
+        if (size_ > 0)
+        {
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (data == MAP_FAILED)
+                DUNE_THROW(Dune::IOError, "Could not map " << fileName << " into memory");
+
+            ::madvise(data, size_, MADV_SEQUENTIAL);
+            mapped_ = static_cast<const char*>(data);
+        }
+        else
+            ::close(fd);
+#else
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file)
+            DUNE_THROW(Dune::IOError, "Could not open " << fileName);
+
+        buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        size_ = buffer_.size();
+#endif
+    }
+
+    ~MappedFile()
+    {
+#if __has_include(<sys/mman.h>)
+        if (mapped_)
+            ::munmap(const_cast<char*>(mapped_), size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const
+    { return mapped_ ? mapped_ : buffer_.data(); }
+
+    const char* end() const
+    { return begin() + size_; }
+
+private:
+    const char* mapped_ = nullptr;
+    std::vector<char> buffer_;
+    std::size_t size_ = 0;
+};
+
+/*!
+ * \brief Reads the values of a section of a gmsh file
+ *
+ * In ASCII files, values are separated by whitespace and converted with `std::from_chars`.
+ * In binary files, `int` values have 4 bytes, `size_t` values have the size given
+ * in the header of the file and floating point values have 8 bytes.
+ */
+class Cursor
+{
+public:
+    Cursor(const char* pos, const char* end, bool binary, std::size_t sizeTSize)
+    : pos_(pos), end_(end), binary_(binary), sizeTSize_(sizeTSize)
+    {}
+
+    int readInt()
+    { return binary_ ? readBinary_<std::int32_t>() : readAscii_<int>(); }
+
+    std::size_t readSize()
+    {
+        if (!binary_)
+            return readAscii_<std::size_t>();
+        return sizeTSize_ == 8 ? std::size_t(readBinary_<std::uint64_t>()) : std::size_t(readBinary_<std::uint32_t>());
+    }
+
+    double readDouble()
+    { return binary_ ? readBinary_<double>() : readAscii_<double>(); }
+
+    //! skip n values of the given byte size (binary) or n whitespace-separated values (ASCII)
+    void skip(std::size_t n, std::size_t bytes)
+    {
+        if (binary_)
+            advance_(n*bytes);
+        else
+            for (std::size_t i = 0; i < n; ++i)
+                readAscii_<double>();
+    }
+
+    //! skip n lines (ASCII only)
+    void skipLines(std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto* newLine = static_cast<const char*>(std::memchr(pos_, '\n', end_ - pos_));
+            if (!newLine)
+                DUNE_THROW(Dune::IOError, "Unexpected end of gmsh file");
+            pos_ = newLine + 1;
+        }
+    }
+
+    //! skip the remainder of the current line (ASCII only)
+    void skipLine()
+    { skipLines(1); }
+
+    const char* pos() const
+    { return pos_; }
+
+    void setPos(const char* pos)
+    { pos_ = pos; }
+
+    const char* end() const
+    { return end_; }
+
+    bool binary() const
+    { return binary_; }
+
+    std::size_t sizeTSize() const
+    { return sizeTSize_; }
+
+    //! advance by a number of bytes (binary only)
+    void advance(std::size_t bytes)
+    { advance_(bytes); }
+
+private:
+    template<class T>
+    T readBinary_()
+    {
+        T value;
+        if (end_ - pos_ < std::ptrdiff_t(sizeof(T)))
+            DUNE_THROW(Dune::IOError, "Unexpected end of gmsh file");
+        std::memcpy(&value, pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    template<class T>
+    T readAscii_()
+    {
+        while (pos_ != end_ && (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' || *pos_ == '\t'))
+            ++pos_;
+
+        T value;
+        const char* last = pos_;
+        bool failed = false;
+
+        // floating point support of std::from_chars is not available in all standard libraries
+        // (strtod needs a null-terminated string, so the value is copied to not read beyond the mapped file)
+#if __cpp_lib_to_chars < 201611L
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            std::array<char, 64> buffer;
+            std::size_t length = 0;
+            while (pos_ + length != end_ && length + 1 < buffer.size()
+                   && !std::isspace(static_cast<unsigned char>(pos_[length])))
+            {
+                buffer[length] = pos_[length];
+                ++length;
+            }
+            buffer[length] = '\0';
+
+            char* ptr;
+            value = std::strtod(buffer.data(), &ptr);
+            last = pos_ + (ptr - buffer.data());
+            failed = last == pos_;
+        }
+        else
+#endif
+        {
+            const auto result = std::from_chars(pos_, end_, value);
+            last = result.ptr;
+            failed = result.ec != std::errc{};
+        }
+
+        if (failed)
+            DUNE_THROW(Dune::IOError, "Could not parse value in gmsh file: "
+                                      << std::string_view(pos_, std::min<std::ptrdiff_t>(20, end_ - pos_)));
+        pos_ = last;
+        return value;
+    }
+
+    void advance_(std::size_t bytes)
+    {
+        if (std::size_t(end_ - pos_) < bytes)
+            DUNE_THROW(Dune::IOError, "Unexpected end of gmsh file");
+        pos_ += bytes;
+    }
+
+    const char* pos_;
+    const char* end_;
+    bool binary_;
+    std::size_t sizeTSize_;
+};
+
+//! The number of nodes or elements parsed by a task of the parallel parser
+static constexpr std::size_t chunkSize = 1 << 14;
+
+} // end namespace Detail::Gmsh
+
+/*!
+ * \ingroup InputOutput
+ * \brief A reader for Gmsh mesh files in format version 4.1 (ASCII and binary)
+ *
+ * The file is memory-mapped and the node and element sections are split into chunks
+ * that are parsed concurrently (see Dumux::parallelFor). The physical tags of the
+ * elements are extracted from the `$Entities` section. For partitioned meshes, the
+ * partition of each element and the physical tags are extracted from the
+ * `$PartitionedEntities` section. If a partitioned mesh was split into several files
+ * (one file per partition), each process may read its own file (see partitionFileName()).
+ *
+ * \note Only files written in the byte order of the machine are supported.
+ */
+class Gmsh4Reader
+{
+    struct EntityInfo
+    {
+        int physicalTag = 0;
+        int partition = 0;
+    };
+
+    using EntityMaps = std::array<std::unordered_map<int, EntityInfo>, 4>;
+
+public:
+    //! The (major) version of the format of a gmsh file
+    static int fileVersion(const std::string& fileName)
+    {
+        std::ifstream file(fileName);
+        if (!file)
+            DUNE_THROW(Dune::IOError, "Could not open " << fileName);
+
+        std::string line;
+        std::getline(file, line);
+        if (line.find("$MeshFormat") == std::string::npos)
+            DUNE_THROW(Dune::IOError, "Expected $MeshFormat in the first line of " << fileName);
+
+        double version = 0.0;
+        file >> version;
+        if (!file)
+            DUNE_THROW(Dune::IOError, "Could not read the format version of " << fileName);
+        return static_cast<int>(version);
+    }
+
+    /*!
+     * \brief The name of the file of a partition of a mesh split into one file per
+     *        partition, i.e. `<name>_<partition>.msh` (gmsh option `Mesh.PartitionSplitMeshFiles`)
+     * \param fileName the name of the (unsplit) mesh file, e.g. `mesh.msh`
+     * \param partition the partition (starting from 1)
+     */
+    static std::string partitionFileName(const std::string& fileName, int partition)
+    {
+        const auto pos = fileName.rfind('.');
+        return fileName.substr(0, pos) + "_" + std::to_string(partition) + (pos == std::string::npos ? "" : fileName.substr(pos));
+    }
+
+    //! Read the nodes and elements of a gmsh file in format version 4.1
+    static GmshMeshData read(const std::string& fileName, bool verbose = false)
+    {
+        Dune::Timer watch;
+        if (verbose) std::cout << "Reading gmsh file " << fileName << std::endl;
+
+        const Detail::Gmsh::MappedFile file(fileName);
+        const std::string_view content(file.begin(), file.end() - file.begin());
+
+        // the mesh format
+        const auto pos = sectionBegin_(content, "MeshFormat", 0);
+        if (content.substr(0, 11) != "$MeshFormat" || pos == std::string_view::npos)
+            DUNE_THROW(Dune::IOError, "Expected $MeshFormat in the first line of " << fileName);
+
+        Detail::Gmsh::Cursor formatCursor(file.begin() + pos, file.end(), false, 8);
+        const double version = formatCursor.readDouble();
+        const bool binary = formatCursor.readInt() == 1;
+        const auto sizeTSize = formatCursor.readSize();
+        if (version < 4.1 || version >= 5.0)
+            DUNE_THROW(Dune::NotImplemented, "Gmsh file format version " << version << " (only 4.1 is supported)");
+        if (sizeTSize != 4 && sizeTSize != 8)
+            DUNE_THROW(Dune::IOError, "Unsupported data size " << sizeTSize << " in " << fileName);
+        formatCursor.skipLine();
+
+        if (binary)
+        {
+            Detail::Gmsh::Cursor cursor(formatCursor.pos(), file.end(), true, sizeTSize);
+            if (cursor.readInt() != 1)
+                DUNE_THROW(Dune::NotImplemented, "Gmsh files written with a different byte order");
+        }
+
+        const auto nodesPos = sectionBegin_(content, "Nodes", pos);
+        if (nodesPos == std::string_view::npos)
+            DUNE_THROW(Dune::IOError, "No $Nodes section in " << fileName);
+
+        // the entities are defined before the nodes
+        GmshMeshData data;
+        EntityMaps entities;
+        const auto header = content.substr(0, nodesPos);
+        if (const auto entitiesPos = sectionBegin_(header, "Entities", pos); entitiesPos != std::string_view::npos)
+        {
+            Detail::Gmsh::Cursor cursor(file.begin() + entitiesPos, file.end(), binary, sizeTSize);
+            readEntities_(cursor, entities);
+        }
+
+        if (const auto partitionedPos = sectionBegin_(header, "PartitionedEntities", pos); partitionedPos != std::string_view::npos)
+        {
+            Detail::Gmsh::Cursor cursor(file.begin() + partitionedPos, file.end(), binary, sizeTSize);
+            data.numPartitions = readPartitionedEntities_(cursor, entities);
+        }
+
+        Detail::Gmsh::Cursor nodeCursor(file.begin() + nodesPos, file.end(), binary, sizeTSize);
+        std::vector<std::size_t> tagToIndex;
+        readNodes_(nodeCursor, data, tagToIndex);
+
+        const auto elementsPos = sectionBegin_(content, "Elements", nodeCursor.pos() - file.begin());
+        if (elementsPos == std::string_view::npos)
+            DUNE_THROW(Dune::IOError, "No $Elements section in " << fileName);
+
+        Detail::Gmsh::Cursor elementCursor(file.begin() + elementsPos, file.end(), binary, sizeTSize);
+        readElements_(elementCursor, entities, tagToIndex, data);
+
+        if (verbose)
+            std::cout << "Read " << data.numNodes() << " nodes and " << data.numElements() << " elements"
+                      << (data.numPartitions > 0 ? " in " + std::to_string(data.numPartitions) + " partitions" : "")
+                      << " in " << watch.elapsed() << " seconds." << std::endl;
+
+        return data;
+    }
+
+private:
+    /*!
+     * \brief The position of the first character after the line `$<name>`
+     *        (or npos if the section does not exist)
+     * \note In binary files, the search is restricted to the text between sections.
+     */
+    static std::size_t sectionBegin_(std::string_view content, std::string_view name, std::size_t from)
+    {
+        const std::string key = "$" + std::string(name);
+        std::size_t pos = from;
+        while ((pos = content.find(key, pos)) != std::string_view::npos)
+        {
+            const auto next = pos + key.size();
+            const bool atLineStart = pos == 0 || content[pos-1] == '\n';
+            if (atLineStart && next < content.size() && (content[next] == '\n' || content[next] == '\r'))
+                return content[next] == '\r' ? next + 2 : next + 1;
+            pos = next;
+        }
+        return std::string_view::npos;
+    }
+
+    static void readEntities_(Detail::Gmsh::Cursor& cursor, EntityMaps& entities)
+    {
+        std::array<std::size_t, 4> numEntities;
+        for (auto& n : numEntities)
+            n = cursor.readSize();
+
+        for (int dim = 0; dim < 4; ++dim)
+        {
+            for (std::size_t i = 0; i < numEntities[dim]; ++i)
+            {
+                const int tag = cursor.readInt();
+                cursor.skip(dim == 0 ? 3 : 6, sizeof(double));
+                auto& entity = entities[dim][tag];
+                entity.physicalTag = readPhysicalTags_(cursor);
+                if (dim > 0)
+                    cursor.skip(cursor.readSize(), sizeof(std::int32_t));
+            }
+        }
+    }
+
+    static std::size_t readPartitionedEntities_(Detail::Gmsh::Cursor& cursor, EntityMaps& entities)
+    {
+        const auto numPartitions = cursor.readSize();
+        const auto numGhostEntities = cursor.readSize();
+        cursor.skip(2*numGhostEntities, sizeof(std::int32_t));
+
+        std::array<std::size_t, 4> numEntities;
+        for (auto& n : numEntities)
+            n = cursor.readSize();
+
+        for (int dim = 0; dim < 4; ++dim)
+        {
+            for (std::size_t i = 0; i < numEntities[dim]; ++i)
+            {
+                const int tag = cursor.readInt();
+                const int parentDim = cursor.readInt();
+                const int parentTag = cursor.readInt();
+
+                // entities on partition interfaces belong to several partitions, we use the first one
+                const auto numEntityPartitions = cursor.readSize();
+                int partition = 0;
+                for (std::size_t p = 0; p < numEntityPartitions; ++p)
+                {
+                    const int part = cursor.readInt();
+                    if (p == 0)
+                        partition = part;
+                }
+
+                cursor.skip(dim == 0 ? 3 : 6, sizeof(double));
+                auto& entity = entities[dim][tag];
+                entity.physicalTag = readPhysicalTags_(cursor);
+                entity.partition = partition;
+
+                // inherit the physical tag of the model entity if the partitioned entity has none
+                if (entity.physicalTag == 0 && parentDim >= 0 && parentDim < 4)
+                    if (const auto parent = entities[parentDim].find(parentTag); parent != entities[parentDim].end())
+                        entity.physicalTag = parent->second.physicalTag;
+
+                if (dim > 0)
+                    cursor.skip(cursor.readSize(), sizeof(std::int32_t));
+            }
+        }
+
+        return numPartitions;
+    }
+
+    //! read the physical tags of an entity and return the first one (0 if there is none)
+    static int readPhysicalTags_(Detail::Gmsh::Cursor& cursor)
+    {
+        const auto numPhysicalTags = cursor.readSize();
+        int physicalTag = 0;
+        for (std::size_t i = 0; i < numPhysicalTags; ++i)
+        {
+            const int tag = cursor.readInt();
+            if (i == 0)
+                physicalTag = tag;
+        }
+        return physicalTag;
+    }
+
+    //! A consecutive range of nodes or elements of an entity block that is parsed by one task
+    struct Chunk
+    {
+        const char* begin; // the position of the first node tag or element
+        const char* coordinates; // the position of the coordinates of the first node (nodes only)
+        std::size_t first; // the index of the first node or element
+        std::size_t size; // the number of nodes or elements
+        int dim; // the dimension of the entity
+        int entityTag; // the tag of the entity (elements only)
+        int elementType; // the gmsh element type (elements only)
+        std::size_t numValues; // the number of coordinates per node or nodes per element
+    };
+
+    //! parse the chunks concurrently (errors are recorded per chunk and the first one is thrown after all chunks are parsed)
+    template<class ParseChunk>
+    static void parseChunks_(const std::vector<Chunk>& chunks, ParseChunk&& parseChunk)
+    {
+        std::vector<std::string> errors(chunks.size());
+        parallelFor(chunks.size(), [&](std::size_t c)
+        {
+            try { parseChunk(chunks[c]); }
+            catch (const Dune::Exception& e) { errors[c] = e.what(); }
+        });
+
+        for (const auto& error : errors)
+            if (!error.empty())
+                DUNE_THROW(Dune::IOError, error);
+    }
+
+    static void readNodes_(Detail::Gmsh::Cursor& cursor, GmshMeshData& data, std::vector<std::size_t>& tagToIndex)
+    {
+        using namespace Detail::Gmsh;
+        const auto numBlocks = cursor.readSize();
+        const auto numNodes = cursor.readSize();
+        cursor.readSize(); // minimum node tag
+        const auto maxNodeTag = cursor.readSize();
+
+        // determine the chunks (the node tags of a block precede the coordinates)
+        std::vector<Chunk> chunks;
+        std::size_t nodeOffset = 0;
+        for (std::size_t b = 0; b < numBlocks; ++b)
+        {
+            const int dim = cursor.readInt();
+            cursor.readInt(); // entity tag
+            const bool parametric = cursor.readInt() != 0;
+            const auto blockSize = cursor.readSize();
+            const std::size_t numCoordinates = 3 + (parametric ? dim : 0);
+
+            if (cursor.binary())
+            {
+                const auto* tags = cursor.pos();
+                cursor.advance(blockSize*cursor.sizeTSize());
+                const auto* coordinates = cursor.pos();
+                cursor.advance(blockSize*numCoordinates*sizeof(double));
+                for (std::size_t first = 0; first < blockSize; first += chunkSize)
+                    chunks.push_back({tags + first*cursor.sizeTSize(), coordinates + first*numCoordinates*sizeof(double),
+                                      nodeOffset + first, std::min(chunkSize, blockSize - first), dim, 0, 0, numCoordinates});
+            }
+            else
+            {
+                // one tag per line followed by one line of coordinates per node
+                cursor.skipLine();
+                const auto firstChunk = chunks.size();
+                for (std::size_t first = 0; first < blockSize; first += chunkSize)
+                {
+                    chunks.push_back({cursor.pos(), nullptr, nodeOffset + first, std::min(chunkSize, blockSize - first), dim, 0, 0, numCoordinates});
+                    cursor.skipLines(chunks.back().size);
+                }
+                for (std::size_t c = firstChunk; c < chunks.size(); ++c)
+                {
+                    chunks[c].coordinates = cursor.pos();
+                    cursor.skipLines(chunks[c].size);
+                }
+            }
+
+            nodeOffset += blockSize;
+        }
+
+        if (nodeOffset != numNodes)
+            DUNE_THROW(Dune::IOError, "The node blocks contain " << nodeOffset << " instead of " << numNodes << " nodes");
+
+        data.nodes.resize(numNodes);
+        data.nodeTags.resize(numNodes);
+        parseChunks_(chunks, [&](const Chunk& chunk)
+        {
+            Cursor tagCursor(chunk.begin, cursor.end(), cursor.binary(), cursor.sizeTSize());
+            Cursor coordCursor(chunk.coordinates, cursor.end(), cursor.binary(), cursor.sizeTSize());
+            for (std::size_t i = chunk.first; i < chunk.first + chunk.size; ++i)
+            {
+                data.nodeTags[i] = tagCursor.readSize();
+                for (auto& x : data.nodes[i])
+                    x = coordCursor.readDouble();
+                coordCursor.skip(chunk.numValues - 3, sizeof(double));
+            }
+        });
+
+        // the map from node tags to indices
+        constexpr auto invalid = std::numeric_limits<std::size_t>::max();
+        tagToIndex.assign(maxNodeTag + 1, invalid);
+        std::atomic<bool> validTags(true);
+        parallelFor(chunks.size(), [&](std::size_t c)
+        {
+            for (std::size_t i = chunks[c].first; i < chunks[c].first + chunks[c].size; ++i)
+            {
+                if (data.nodeTags[i] > maxNodeTag)
+                    validTags = false;
+                else
+                    tagToIndex[data.nodeTags[i]] = i;
+            }
+        });
+
+        if (!validTags)
+            DUNE_THROW(Dune::IOError, "Node tag exceeds the maximum node tag " << maxNodeTag);
+    }
+
+    static void readElements_(Detail::Gmsh::Cursor& cursor, const EntityMaps& entities,
+                              const std::vector<std::size_t>& tagToIndex, GmshMeshData& data)
+    {
+        using namespace Detail::Gmsh;
+        const auto numBlocks = cursor.readSize();
+        const auto numElements = cursor.readSize();
+        cursor.readSize(); // minimum element tag
+        cursor.readSize(); // maximum element tag
+
+        data.elementTypes.resize(numElements);
+        data.elementDims.resize(numElements);
+        data.physicalTags.resize(numElements);
+        data.partitions.resize(numElements);
+        data.elementOffsets.resize(numElements + 1);
+        data.elementOffsets[0] = 0;
+
+        // determine the chunks and the element offsets
+        std::vector<Chunk> chunks;
+        std::size_t elementOffset = 0;
+        for (std::size_t b = 0; b < numBlocks; ++b)
+        {
+            const int dim = cursor.readInt();
+            const int entityTag = cursor.readInt();
+            const int elementType = cursor.readInt();
+            const auto blockSize = cursor.readSize();
+
+            const std::size_t numElementNodes = numNodes(elementType);
+            if (numElementNodes == 0)
+                DUNE_THROW(Dune::NotImplemented, "Gmsh element type " << elementType);
+            if (elementOffset + blockSize > numElements)
+                DUNE_THROW(Dune::IOError, "The element blocks contain more than " << numElements << " elements");
+
+            if (!cursor.binary())
+                cursor.skipLine();
+
+            for (std::size_t first = 0; first < blockSize; first += chunkSize)
+            {
+                chunks.push_back({cursor.pos(), nullptr, elementOffset + first, std::min(chunkSize, blockSize - first),
+                                  dim, entityTag, elementType, numElementNodes});
+                if (cursor.binary())
+                    cursor.advance(chunks.back().size*(numElementNodes + 1)*cursor.sizeTSize());
+                else
+                    cursor.skipLines(chunks.back().size);
+            }
+
+            for (std::size_t i = elementOffset; i < elementOffset + blockSize; ++i)
+                data.elementOffsets[i+1] = data.elementOffsets[i] + numElementNodes;
+
+            elementOffset += blockSize;
+        }
+
+        if (elementOffset != numElements)
+            DUNE_THROW(Dune::IOError, "The element blocks contain " << elementOffset << " instead of " << numElements << " elements");
+
+        data.elementNodes.resize(data.elementOffsets.back());
+        std::atomic<bool> validTags(true);
+        parseChunks_(chunks, [&](const Chunk& chunk)
+        {
+            EntityInfo entity;
+            if (chunk.dim >= 0 && chunk.dim < 4)
+                if (const auto it = entities[chunk.dim].find(chunk.entityTag); it != entities[chunk.dim].end())
+                    entity = it->second;
+
+            Cursor elementCursor(chunk.begin, cursor.end(), cursor.binary(), cursor.sizeTSize());
+            for (std::size_t i = chunk.first; i < chunk.first + chunk.size; ++i)
+            {
+                elementCursor.readSize(); // element tag
+                data.elementTypes[i] = chunk.elementType;
+                data.elementDims[i] = chunk.dim;
+                data.physicalTags[i] = entity.physicalTag;
+                data.partitions[i] = entity.partition;
+                for (std::size_t j = data.elementOffsets[i]; j < data.elementOffsets[i+1]; ++j)
+                {
+                    const auto nodeTag = elementCursor.readSize();
+                    if (nodeTag >= tagToIndex.size() || tagToIndex[nodeTag] == std::numeric_limits<std::size_t>::max())
+                        validTags = false;
+                    else
+                        data.elementNodes[j] = tagToIndex[nodeTag];
+                }
+            }
+        });
+
+        if (!validTags)
+            DUNE_THROW(Dune::IOError, "Element refers to a node tag that is not defined in the $Nodes section");
+    }
+};
+
+/*!
+ * \ingroup InputOutput
+ * \brief Fills a grid factory from a gmsh file
+ *
+ * The interface is the one of Dune::GmshReader. Files in format version 4.1 are
+ * read with Dumux::Gmsh4Reader, older versions are forwarded to Dune::GmshReader.
+ * The factory is only filled on the process with rank 0.
+ *
+ * Elements with the dimension of the grid are inserted as elements and elements of
+ * one dimension lower as boundary segments. The element and boundary markers
+ * are the physical tags of the elements, in insertion order.
+ */
+template<class Grid>
+class GmshReader
+{
+    static constexpr int dim = Grid::dimension;
+    static constexpr int dimWorld = Grid::dimensionworld;
+    using GlobalPosition = Dune::FieldVector<typename Grid::ctype, dimWorld>;
+
+public:
+    /*!
+     * \brief Fill the factory and the element and boundary markers
+     * \param factory the grid factory
+     * \param fileName the name of the gmsh file
+     * \param boundaryMarkers the physical tags of the boundary segments
+     * \param elementMarkers the physical tags of the elements
+     * \param verbose if the reader should print information
+     * \param insertBoundarySegments if boundary segments should be inserted into the factory
+     */
+    static void read(Dune::GridFactory<Grid>& factory, const std::string& fileName,
+                     std::vector<int>& boundaryMarkers, std::vector<int>& elementMarkers,
+                     bool verbose = false, bool insertBoundarySegments = true)
+    {
+        if (Gmsh4Reader::fileVersion(fileName) < 4)
+            Dune::GmshReader<Grid>::read(factory, fileName, boundaryMarkers, elementMarkers, verbose, insertBoundarySegments);
+        else
+            fillFactory_(factory, fileName, &boundaryMarkers, &elementMarkers, verbose, insertBoundarySegments);
+    }
+
+    /*!
+     * \brief Fill the factory
+     * \param factory the grid factory
+     * \param fileName the name of the gmsh file
+     * \param verbose if the reader should print information
+     * \param insertBoundarySegments if boundary segments should be inserted into the factory
+     */
+    static void read(Dune::GridFactory<Grid>& factory, const std::string& fileName,
+                     bool verbose = false, bool insertBoundarySegments = true)
+    {
+        if (Gmsh4Reader::fileVersion(fileName) < 4)
+            Dune::GmshReader<Grid>::read(factory, fileName, verbose, insertBoundarySegments);
+        else
+            fillFactory_(factory, fileName, nullptr, nullptr, verbose, insertBoundarySegments);
+    }
+
+private:
+    static void fillFactory_(Dune::GridFactory<Grid>& factory, const std::string& fileName,
+                             std::vector<int>* boundaryMarkers, std::vector<int>* elementMarkers,
+                             bool verbose, bool insertBoundarySegments)
+    {
+        if (Dune::MPIHelper::getCollectiveCommunication().rank() != 0)
+            return;
+
+        const auto data = Gmsh4Reader::read(fileName, verbose);
+
+        for (const auto& node : data.nodes)
+        {
+            GlobalPosition pos;
+            for (int i = 0; i < dimWorld; ++i)
+                pos[i] = node[i];
+            factory.insertVertex(pos);
+        }
+
+        std::vector<unsigned int> corners;
+        for (std::size_t i = 0; i < data.numElements(); ++i)
+        {
+            const int elementDim = data.elementDims[i];
+            if (elementDim != dim && elementDim != dim-1)
+                continue;
+
+            const auto gt = Detail::Gmsh::geometryType(data.elementTypes[i]);
+            corners.resize(Detail::Gmsh::numCorners(data.elementTypes[i]));
+            for (std::size_t j = 0; j < corners.size(); ++j)
+                corners[j] = data.elementNode(i, j);
+            reorder_(gt, corners);
+
+            if (elementDim == dim)
+            {
+                factory.insertElement(gt, corners);
+                if (elementMarkers)
+                    elementMarkers->push_back(data.physicalTags[i]);
+            }
+            else
+            {
+                if (insertBoundarySegments)
+                    factory.insertBoundarySegment(corners);
+                if (boundaryMarkers)
+                    boundaryMarkers->push_back(data.physicalTags[i]);
+            }
+        }
+    }
+
+    //! reorder the corners of an element from gmsh to dune numbering
+    static void reorder_(const Dune::GeometryType& gt, std::vector<unsigned int>& corners)
+    {
+        using std::swap;
+        if (gt.isQuadrilateral() || gt.isPyramid())
+            swap(corners[2], corners[3]);
+        else if (gt.isHexahedron())
+        {
+            swap(corners[2], corners[3]);
+            swap(corners[6], corners[7]);
+        }
+    }
+};
+
+} // end namespace Dumux
+
+#endif
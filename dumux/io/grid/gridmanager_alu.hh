@@ -160,7 +160,7 @@ public:
                 std::vector<int> boundaryMarkersInsertionIndex, boundaryMarkers, faceMarkers, elementMarkers;
                 auto gridFactory = std::make_unique<Dune::GridFactory<Grid>>();
 
-                Dune::GmshReader<Grid>::read(*gridFactory, fileName, boundaryMarkersInsertionIndex, elementMarkers, verbose, boundarySegments);
+                GmshReader<Grid>::read(*gridFactory, fileName, boundaryMarkersInsertionIndex, elementMarkers, verbose, boundarySegments);
                 ParentType::gridPtr() = std::shared_ptr<Grid>(gridFactory->createGrid());
 
                 // reorder boundary markers according to boundarySegmentIndex
@@ -188,7 +188,7 @@ public:
                 auto gridFactory = std::make_unique<Dune::GridFactory<Grid>>();
 
                 if (Dune::MPIHelper::getCollectiveCommunication().rank() == 0)
-                Dune::GmshReader<Grid>::read(*gridFactory, fileName, verbose, boundarySegments);
+                GmshReader<Grid>::read(*gridFactory, fileName, verbose, boundarySegments);
 
                 ParentType::gridPtr() = std::shared_ptr<Grid>(gridFactory->createGrid());
             }
@@ -44,6 +44,7 @@
 #include <dumux/io/vtk/vtkreader.hh>
 
 #include "griddata.hh"
+#include "gmshreader.hh"
 
 namespace Dumux {
 
@@ -180,7 +181,7 @@ protected:
     /*!
      * \brief Makes a grid from a file. We currently support
      *     - dgf (Dune Grid Format)
-     *     - msh (Gmsh mesh format)
+     *     - msh (Gmsh mesh format, versions 2 and 4.1, see Dumux::GmshReader)
      *     - vtp/vtu (VTK file formats)
      */
     void makeGridFromFile(const std::string& fileName,
@@ -215,14 +216,14 @@ protected:
             {
                 std::vector<int> boundaryMarkers, elementMarkers;
                 auto gridFactory = std::make_unique<Dune::GridFactory<Grid>>();
-                Dune::GmshReader<Grid>::read(*gridFactory, fileName, boundaryMarkers, elementMarkers, verbose, boundarySegments);
+                GmshReader<Grid>::read(*gridFactory, fileName, boundaryMarkers, elementMarkers, verbose, boundarySegments);
                 gridPtr() = std::shared_ptr<Grid>(gridFactory->createGrid());
                 gridData_ = std::make_shared<GridData>(gridPtr_, std::move(gridFactory), std::move(elementMarkers), std::move(boundaryMarkers));
             }
             else
             {
                 auto gridFactory = std::make_unique<Dune::GridFactory<Grid>>();
-                Dune::GmshReader<Grid>::read(*gridFactory, fileName, verbose, boundarySegments);
+                GmshReader<Grid>::read(*gridFactory, fileName, verbose, boundarySegments);
                 gridPtr() = std::shared_ptr<Grid>(gridFactory->createGrid());
             }
         }
@@ -42,6 +42,7 @@
 #include <dune/grid/common/partitionset.hh>
 
 #include <dumux/common/parameters.hh>
+#include <dumux/common/instrumentation.hh>
 #include <dumux/io/format.hh>
 #include <dumux/discretization/method.hh>
 
@@ -173,6 +174,7 @@ public:
     void write(double time, Dune::VTK::OutputType type = Dune::VTK::ascii)
     {
         Dune::Timer timer;
+        Instrumentation::ScopedTimer instrumentationTimer("IO.VtkOutput");
 
         // write to file depending on data mode
         if (dm_ == Dune::VTK::conforming)
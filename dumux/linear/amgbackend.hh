@@ -26,6 +26,7 @@
 #define DUMUX_PARALLEL_AMGBACKEND_HH
 
 #include <memory>
+#include <tuple>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/parallel/indexset.hh>
@@ -36,6 +37,7 @@
 #include <dune/istl/paamg/pinfo.hh>
 #include <dune/istl/solvers.hh>
 
+#include <dumux/common/instrumentation.hh>
 #include <dumux/linear/solver.hh>
 #include <dumux/linear/parallelhelpers.hh>
 
@@ -121,6 +123,16 @@ public:
         return result_;
     }
 
+    /*!
+     * \brief Reuse the AMG hierarchy of the last sequential solve in subsequent solves
+     *        with the same matrix object
+     * \note The caller has to make sure that the matrix entries did not change in between,
+     *       e.g. the Newton solver in the frozen Jacobian mode. In parallel runs the setup
+     *       is always recomputed.
+     */
+    void setReuseSetup(bool reuse)
+    { reuseSetup_ = reuse; keepSetup_ = true; }
+
 private:
     //! see https://gitlab.dune-project.org/core/dune-istl/-/issues/62
     void checkAvailabilityOfDirectSolver_()
@@ -175,7 +187,8 @@ private:
 
         using SeqSmoother = Dune::SeqSSOR<Matrix, Vector, Vector>;
         using Smoother = typename ParallelTraits::template Preconditioner<SeqSmoother>;
-        solveWithAmg_<Smoother>(A, x, b, linearOperator, comm, scalarProduct);
+        auto amg = makeAmg_<Smoother, Vector>(*linearOperator, *comm);
+        solveWithAmg_(x, b, *linearOperator, *amg, *comm, *scalarProduct);
     }
 #endif // HAVE_MPI
 
@@ -187,20 +200,33 @@ private:
         using LinearOperator = typename Traits::LinearOperator;
         using ScalarProduct = typename Traits::ScalarProduct;
 
-        auto comm = std::make_shared<Comm>();
-        auto linearOperator = std::make_shared<LinearOperator>(A);
-        auto scalarProduct = std::make_shared<ScalarProduct>();
-
         using Smoother = Dune::SeqSSOR<Matrix, Vector, Vector>;
-        solveWithAmg_<Smoother>(A, x, b, linearOperator, comm, scalarProduct);
+        using Amg = Dune::Amg::AMG<LinearOperator, Vector, Smoother, Comm>;
+
+        // the AMG hierarchy refers to the linear operator and the communication object,
+        // all three are kept for reuse
+        using Setup = std::tuple<std::shared_ptr<Comm>, std::shared_ptr<LinearOperator>, std::shared_ptr<Amg>>;
+        if (!reuseSetup_ || !setup_ || setupMatrix_ != &A)
+        {
+            auto comm = std::make_shared<Comm>();
+            auto linearOperator = std::make_shared<LinearOperator>(A);
+            auto amg = makeAmg_<Smoother, Vector>(*linearOperator, *comm);
+            setup_ = std::make_shared<Setup>(comm, linearOperator, amg);
+            setupMatrix_ = &A;
+        }
+
+        const auto& [comm, linearOperator, amg] = *std::static_pointer_cast<Setup>(setup_);
+        ScalarProduct scalarProduct;
+        solveWithAmg_(x, b, *linearOperator, *amg, *comm, scalarProduct);
+
+        if (!keepSetup_)
+            setup_.reset();
     }
 
-    template<class Smoother, class Matrix, class Vector, class LinearOperator, class Comm, class ScalarProduct>
-    void solveWithAmg_(Matrix& A, Vector& x, Vector& b,
-                       std::shared_ptr<LinearOperator>& linearOperator,
-                       std::shared_ptr<Comm>& comm,
-                       std::shared_ptr<ScalarProduct>& scalarProduct)
+    template<class Smoother, class Vector, class LinearOperator, class Comm>
+    auto makeAmg_(LinearOperator& linearOperator, const Comm& comm) const
     {
+        using Matrix = typename LinearOperator::matrix_type;
         using SmootherArgs = typename Dune::Amg::SmootherTraits<Smoother>::Arguments;
         using Criterion = Dune::Amg::CoarsenCriterion<Dune::Amg::SymmetricCriterion<Matrix, Dune::Amg::FirstDiagonal>>;
 
@@ -215,11 +241,18 @@ private:
         smootherArgs.relaxationFactor = 1;
 
         using Amg = Dune::Amg::AMG<LinearOperator, Vector, Smoother, Comm>;
-        auto amg = std::make_shared<Amg>(*linearOperator, criterion, smootherArgs, *comm);
+        Instrumentation::ScopedTimer timer("LinearSolver.Setup");
+        return std::make_shared<Amg>(linearOperator, criterion, smootherArgs, comm);
+    }
 
-        Dune::BiCGSTABSolver<Vector> solver(*linearOperator, *scalarProduct, *amg, this->residReduction(), this->maxIter(),
-                                            comm->communicator().rank() == 0 ? this->verbosity() : 0);
+    template<class Vector, class LinearOperator, class Amg, class Comm, class ScalarProduct>
+    void solveWithAmg_(Vector& x, Vector& b, LinearOperator& linearOperator,
+                       Amg& amg, const Comm& comm, ScalarProduct& scalarProduct)
+    {
+        Dune::BiCGSTABSolver<Vector> solver(linearOperator, scalarProduct, amg, this->residReduction(), this->maxIter(),
+                                            comm.communicator().rank() == 0 ? this->verbosity() : 0);
 
+        Instrumentation::ScopedTimer timer("LinearSolver.Apply");
         solver.apply(x, b, result_);
     }
 
@@ -228,6 +261,10 @@ private:
 #endif
     Dune::InverseOperatorResult result_;
     bool isParallel_ = false;
+    bool reuseSetup_ = false;
+    bool keepSetup_ = false; //! keep the setup after solving (only if reuse is requested at some point)
+    std::shared_ptr<void> setup_;
+    const void* setupMatrix_ = nullptr;
 };
 
 } // end namespace Dumux
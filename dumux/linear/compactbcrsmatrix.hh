@@ -0,0 +1,133 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Linear
+ * \brief BCRS matrices with 32-bit column indices and conversion between
+ *        BCRS matrices with different block types (e.g. storage precisions)
+ */
+#ifndef DUMUX_LINEAR_COMPACT_BCRS_MATRIX_HH
+#define DUMUX_LINEAR_COMPACT_BCRS_MATRIX_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <dune/common/exceptions.hh>
+#include <dune/istl/bcrsmatrix.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Linear
+ * \brief A standard allocator exporting a custom (smaller) size type
+ *
+ * Dune::BCRSMatrix stores its column indices using the size type of its allocator.
+ * With this allocator the indices take 4 instead of 8 bytes which reduces
+ * the memory traffic of the bandwidth-bound sparse matrix-vector product.
+ * \tparam T the value type
+ * \tparam IndexType the unsigned integer type used as size type
+ */
+template<class T, class IndexType = std::uint32_t>
+class CompactIndexAllocator
+{
+    static_assert(std::is_unsigned_v<IndexType>, "The index type has to be an unsigned integer type");
+
+public:
+    using value_type = T;
+    using size_type = IndexType;
+
+    template<class U>
+    struct rebind { using other = CompactIndexAllocator<U, IndexType>; };
+
+    CompactIndexAllocator() noexcept = default;
+
+    template<class U>
+    CompactIndexAllocator(const CompactIndexAllocator<U, IndexType>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    { return std::allocator<T>{}.allocate(n); }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    { std::allocator<T>{}.deallocate(p, n); }
+};
+
+template<class T, class U, class I>
+bool operator==(const CompactIndexAllocator<T, I>&, const CompactIndexAllocator<U, I>&) noexcept
+{ return true; }
+
+template<class T, class U, class I>
+bool operator!=(const CompactIndexAllocator<T, I>&, const CompactIndexAllocator<U, I>&) noexcept
+{ return false; }
+
+/*!
+ * \ingroup Linear
+ * \brief A BCRS matrix with 32-bit column indices
+ * \note The number of rows and of stored blocks must not exceed \f$2^{32}-1\f$.
+ */
+template<class Block>
+using CompactBCRSMatrix = Dune::BCRSMatrix<Block, CompactIndexAllocator<Block>>;
+
+/*!
+ * \ingroup Linear
+ * \brief Copy a BCRS matrix into a BCRS matrix with the same sparsity pattern but another type
+ *
+ * This can be used to change the block field type (e.g. to hand a matrix stored in single
+ * precision to a direct solver working in double precision) or the index type.
+ * \tparam TargetMatrix the type of the returned matrix
+ */
+template<class TargetMatrix, class Block, class Allocator>
+TargetMatrix copyBCRSMatrix(const Dune::BCRSMatrix<Block, Allocator>& M)
+{
+    using TargetBlock = typename TargetMatrix::block_type;
+    static_assert(TargetBlock::rows == Block::rows && TargetBlock::cols == Block::cols,
+                  "The block sizes of the matrices have to match");
+
+    using IndexType = typename TargetMatrix::size_type;
+    if constexpr (sizeof(IndexType) < sizeof(typename Dune::BCRSMatrix<Block, Allocator>::size_type))
+        if (M.N() > std::numeric_limits<IndexType>::max()
+            || M.M() > std::numeric_limits<IndexType>::max()
+            || M.nonzeroes() > std::numeric_limits<IndexType>::max())
+            DUNE_THROW(Dune::RangeError, "Matrix too large for the index type of the target matrix");
+
+    TargetMatrix result(M.N(), M.M(), M.nonzeroes(), TargetMatrix::row_wise);
+    for (auto row = result.createbegin(); row != result.createend(); ++row)
+        for (auto col = M[row.index()].begin(); col != M[row.index()].end(); ++col)
+            row.insert(col.index());
+
+    for (auto row = M.begin(); row != M.end(); ++row)
+    {
+        auto& targetRow = result[row.index()];
+        for (auto col = row->begin(); col != row->end(); ++col)
+        {
+            auto& targetBlock = targetRow[col.index()];
+            for (int i = 0; i < Block::rows; ++i)
+                for (int j = 0; j < Block::cols; ++j)
+                    targetBlock[i][j] = (*col)[i][j];
+        }
+    }
+
+    return result;
+}
+
+} // end namespace Dumux
+
+#endif
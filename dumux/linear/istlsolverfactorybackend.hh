@@ -43,6 +43,7 @@
 #include <dune/istl/solvers.hh>
 #include <dune/istl/solverfactory.hh>
 
+#include <dumux/common/instrumentation.hh>
 #include <dumux/common/typetraits/matrix.hh>
 #include <dumux/linear/solver.hh>
 #include <dumux/linear/parallelhelpers.hh>
@@ -187,6 +188,15 @@ public:
         return name_;
     }
 
+    /*!
+     * \brief Reuse the solver setup (e.g. the preconditioner or a factorization) of the last
+     *        sequential solve in subsequent solves with the same matrix object
+     * \note The caller has to make sure that the matrix entries did not change in between,
+     *       e.g. the Newton solver in the frozen Jacobian mode.
+     */
+    void setReuseSetup(bool reuse)
+    { reuseSetup_ = reuse; keepSetup_ = true; }
+
 private:
 
     void initializeParameters_()
@@ -234,6 +244,11 @@ private:
         }
         else
         {
+            // the block preconditioners for multi-type matrices only see the local system
+            if constexpr (isMultiTypeBlockMatrix<Matrix>::value)
+                if (isParallel_)
+                    DUNE_THROW(Dune::NotImplemented, "Parallel solvers for multi-type block matrices");
+
             solveSequential_(A, x, b);
         }
     }
@@ -258,6 +273,7 @@ private:
         auto solver = getSolverFromFactory_(linearOperator);
 
         // solve linear system
+        Instrumentation::ScopedTimer timer("LinearSolver.Apply");
         solver->apply(x, b, result_);
 #else
         DUNE_THROW(Dune::NotImplemented, "Parallel solvers only available for dune-istl > 2.7.0");
@@ -268,24 +284,37 @@ private:
     template<class Matrix, class Vector>
     void solveSequential_(Matrix& A, Vector& x, Vector& b)
     {
-        // construct linear operator
-        using Traits = typename LinearSolverTraits::template Sequential<Matrix, Vector>;
-        using LinearOperator = typename Traits::LinearOperator;
-        auto linearOperator = std::make_shared<LinearOperator>(A);
+        // the solver (holding the linear operator and the preconditioner) is kept for reuse
+        using Solver = Dune::InverseOperator<Vector, Vector>;
+        if (!reuseSetup_ || !solver_ || solverMatrix_ != &A)
+        {
+            // construct linear operator
+            using Traits = typename LinearSolverTraits::template Sequential<Matrix, Vector>;
+            using LinearOperator = typename Traits::LinearOperator;
+            auto linearOperator = std::make_shared<LinearOperator>(A);
 
-        if (firstCall_)
-            initSolverFactories<Matrix, LinearOperator>();
+            if (firstCall_)
+                initSolverFactories<Matrix, LinearOperator>();
 
-        // construct solver
-        auto solver = getSolverFromFactory_(linearOperator);
+            // construct solver
+            solver_ = getSolverFromFactory_(linearOperator);
+            solverMatrix_ = &A;
+        }
+
+        auto solver = std::static_pointer_cast<Solver>(solver_);
 
         // solve linear system
+        Instrumentation::ScopedTimer timer("LinearSolver.Apply");
         solver->apply(x, b, result_);
+
+        if (!keepSetup_)
+            solver_.reset();
     }
 
     template<class LinearOperator>
     auto getSolverFromFactory_(std::shared_ptr<LinearOperator>& fop)
     {
+        Instrumentation::ScopedTimer timer("LinearSolver.Setup");
         try { return Dune::getSolverFromFactory(fop, params_); }
         catch(Dune::Exception& e)
         {
@@ -301,6 +330,10 @@ private:
 #endif
     bool isParallel_ = false;
     bool firstCall_;
+    bool reuseSetup_ = false;
+    bool keepSetup_ = false; //! keep the solver after solving (only if reuse is requested at some point)
+    std::shared_ptr<void> solver_;
+    const void* solverMatrix_ = nullptr;
 
     Dune::InverseOperatorResult result_;
     Dune::ParameterTree params_;
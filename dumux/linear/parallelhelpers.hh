@@ -288,6 +288,10 @@ public:
     bool isGhost(std::size_t i) const
     { return isGhost_[i] == ghostMarker_; }
 
+    //! Whether the dof with local index i is owned by this process (each dof is owned by exactly one process)
+    bool isOwned(std::size_t i) const
+    { return isOwned_[i] == 1; }
+
     /*!
      * \brief Creates a parallel index set
      *
@@ -24,10 +24,18 @@
 #ifndef DUMUX_LINEAR_PRECONDITIONERS_HH
 #define DUMUX_LINEAR_PRECONDITIONERS_HH
 
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+
 #include <dune/common/exceptions.hh>
 #include <dune/common/float_cmp.hh>
 #include <dune/common/indices.hh>
 #include <dune/common/version.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/matrixindexset.hh>
 #include <dune/istl/preconditioners.hh>
 #include <dune/istl/paamg/amg.hh>
 
@@ -333,6 +341,528 @@ private:
 
 DUMUX_REGISTER_PRECONDITIONER("uzawa", Dumux::MultiTypeBlockMatrixPreconditionerTag, Dune::defaultPreconditionerBlockLevelCreator<Dumux::SeqUzawa, 1>());
 
+namespace Detail {
+
+/*!
+ * \ingroup Linear
+ * \brief The inverse of a diagonal approximation of a BCRS matrix (one value per scalar row)
+ * \param matrix The matrix
+ * \param useRowSum If true, the absolute row sum is used instead of the diagonal entry (SIMPLEC)
+ */
+template<class Matrix>
+auto approximateInverseDiagonal(const Matrix& matrix, bool useRowSum)
+{
+    using Block = typename Matrix::block_type;
+    using Scalar = typename Matrix::field_type;
+    std::vector<Dune::FieldVector<Scalar, Block::rows>> invDiag(matrix.N());
+    for (auto rowIt = matrix.begin(); rowIt != matrix.end(); ++rowIt)
+    {
+        const auto i = rowIt.index();
+        for (int r = 0; r < Block::rows; ++r)
+        {
+            Scalar value = 0.0;
+            if (useRowSum)
+            {
+                for (auto colIt = rowIt->begin(); colIt != rowIt->end(); ++colIt)
+                    for (int c = 0; c < Block::cols; ++c)
+                        value += std::abs((*colIt)[r][c]);
+            }
+            else
+                value = matrix[i][i][r][r];
+
+            invDiag[i][r] = (value != 0.0) ? 1.0/value : 1.0;
+        }
+    }
+
+    return invDiag;
+}
+
+/*!
+ * \ingroup Linear
+ * \brief Assemble the approximate Schur complement \f$ \hat{S} = D - C Q^{-1} B \f$
+ *        where \f$ Q \f$ is a diagonal approximation of \f$ A \f$
+ * \note The sparsity pattern is the union of the pattern of \f$ D \f$ and \f$ C B \f$.
+ */
+template<class MatrixB, class MatrixC, class MatrixD, class InverseDiagonal>
+MatrixD approximateSchurComplement(const MatrixB& B, const MatrixC& C, const MatrixD& D,
+                                   const InverseDiagonal& invDiag)
+{
+    using BlockB = typename MatrixB::block_type;
+    using BlockC = typename MatrixC::block_type;
+
+    Dune::MatrixIndexSet pattern(D.N(), D.M());
+    pattern.import(D);
+    for (auto rowIt = C.begin(); rowIt != C.end(); ++rowIt)
+        for (auto kIt = rowIt->begin(); kIt != rowIt->end(); ++kIt)
+            for (auto colIt = B[kIt.index()].begin(); colIt != B[kIt.index()].end(); ++colIt)
+                pattern.add(rowIt.index(), colIt.index());
+
+    MatrixD schur;
+    pattern.exportIdx(schur);
+    schur = 0.0;
+
+    for (auto rowIt = D.begin(); rowIt != D.end(); ++rowIt)
+        for (auto colIt = rowIt->begin(); colIt != rowIt->end(); ++colIt)
+            schur[rowIt.index()][colIt.index()] = *colIt;
+
+    for (auto rowIt = C.begin(); rowIt != C.end(); ++rowIt)
+    {
+        auto& schurRow = schur[rowIt.index()];
+        for (auto kIt = rowIt->begin(); kIt != rowIt->end(); ++kIt)
+        {
+            const auto k = kIt.index();
+
+            // the scaled block C_ik Q_k^-1
+            auto cq = *kIt;
+            for (int r = 0; r < BlockC::rows; ++r)
+                for (int q = 0; q < BlockC::cols; ++q)
+                    cq[r][q] *= invDiag[k][q];
+
+            for (auto colIt = B[k].begin(); colIt != B[k].end(); ++colIt)
+            {
+                auto& entry = schurRow[colIt.index()];
+                for (int r = 0; r < BlockC::rows; ++r)
+                    for (int c = 0; c < BlockB::cols; ++c)
+                        for (int q = 0; q < BlockC::cols; ++q)
+                            entry[r][c] -= cq[r][q]*(*colIt)[q][c];
+            }
+        }
+    }
+
+    return schur;
+}
+
+} // end namespace Detail
+
+/*!
+ * \ingroup Linear
+ * \brief A SIMPLE-type block preconditioner for saddle-point problems of the form
+ * \f$
+ \begin{pmatrix}
+    A & B \\
+    C & D
+ \end{pmatrix}
+ \f$
+ *
+ * Each iteration consists of a velocity predictor \f$ A \delta u = f - A u - B p \f$,
+ * a pressure correction with the approximate Schur complement \f$ \hat{S} = D - C Q^{-1} B \f$,
+ * \f$ \hat{S} \delta p = g - C u - D p \f$, and the velocity correction \f$ \delta u = -Q^{-1} B \delta p \f$.
+ * Here, \f$ Q = \mathrm{diag}(A) \f$. Both the velocity block and the assembled Schur complement are
+ * solved approximately with one AMG cycle, so the memory requirement grows linearly with the problem size
+ * (in contrast to direct solvers). The pressure update is under-relaxed with the parameter "relaxation".
+ *
+ * The Schur complement is assembled for the complete pressure block, so the preconditioner can
+ * also be used for compressible or non-isothermal flow where \f$ D \neq 0 \f$.
+ *
+ * \note The preconditioner is sequential. The solver factory backend throws if it is used in parallel.
+ *
+ * See: Patankar, S. V. (1980). Numerical heat transfer and fluid flow. CRC Press and <BR>
+ *      Elman, H., Howle, V. E., Shadid, J., Shuttleworth, R., & Tuminaro, R. (2008). A taxonomy and comparison of parallel
+ *      block multi-level preconditioners for the incompressible Navier–Stokes equations. Journal of Computational Physics, 227(3), 1790-1808
+ *
+ * \tparam M Type of the matrix.
+ * \tparam X Type of the update.
+ * \tparam Y Type of the defect.
+ * \tparam l Preconditioner block level (for compatibility reasons, unused).
+ */
+template<class M, class X, class Y, int l = 1>
+class SeqSIMPLE : public Dune::Preconditioner<X,Y>
+{
+    static_assert(Dumux::isMultiTypeBlockMatrix<M>::value && M::M() == 2 && M::N() == 2, "SeqSIMPLE expects a 2x2 MultiTypeBlockMatrix.");
+    static_assert(l== 1, "SeqSIMPLE expects a block level of 1.");
+
+    using A = std::decay_t<decltype(std::declval<M>()[Dune::Indices::_0][Dune::Indices::_0])>;
+    using S = std::decay_t<decltype(std::declval<M>()[Dune::Indices::_1][Dune::Indices::_1])>;
+    using U = std::decay_t<decltype(std::declval<X>()[Dune::Indices::_0])>;
+    using V = std::decay_t<decltype(std::declval<X>()[Dune::Indices::_1])>;
+
+    using Comm = Dune::Amg::SequentialInformation;
+    using LinearOperatorForA = Dune::MatrixAdapter<A, U, U>;
+    using LinearOperatorForS = Dune::MatrixAdapter<S, V, V>;
+    using AMGSolverForA = Dune::Amg::AMG<LinearOperatorForA, U, Dune::SeqSSOR<A, U, U>, Comm>;
+    using AMGSolverForS = Dune::Amg::AMG<LinearOperatorForS, V, Dune::SeqSSOR<S, V, V>, Comm>;
+
+public:
+    //! \brief The matrix type the preconditioner is for.
+    using matrix_type = M;
+    //! \brief The domain type of the preconditioner.
+    using domain_type = X;
+    //! \brief The range type of the preconditioner.
+    using range_type = Y;
+    //! \brief The field type of the preconditioner.
+    using field_type = typename X::field_type;
+    //! \brief Scalar type underlying the field_type.
+    using scalar_field_type = Dune::Simd::Scalar<field_type>;
+
+    /*!
+     * \brief Constructor
+     *
+     * \param mat The matrix to operate on.
+     * \param params Collection of paramters.
+     */
+#if DUNE_VERSION_GTE(DUNE_ISTL,2,8)
+    SeqSIMPLE(const std::shared_ptr<const Dune::AssembledLinearOperator<M,X,Y>>& op, const Dune::ParameterTree& params)
+    : SeqSIMPLE(op->getmat(), params, false)
+#else
+    SeqSIMPLE(const M& mat, const Dune::ParameterTree& params)
+    : SeqSIMPLE(mat, params, false)
+#endif
+    {}
+
+    /*!
+     * \brief Prepare the preconditioner.
+     */
+    virtual void pre(X& x, Y& b) {}
+
+    /*!
+     * \brief Apply the preconditioner
+     *
+     * \param update The update to be computed.
+     * \param currentDefect The current defect.
+     */
+    virtual void apply(X& update, const Y& currentDefect)
+    {
+        using namespace Dune::Indices;
+
+        auto& A = matrix_[_0][_0];
+        auto& B = matrix_[_0][_1];
+        auto& C = matrix_[_1][_0];
+        auto& D = matrix_[_1][_1];
+
+        const auto& f = currentDefect[_0];
+        const auto& g = currentDefect[_1];
+        auto& u = update[_0];
+        auto& p = update[_1];
+
+        for (std::size_t k = 0; k < numIterations_; ++k)
+        {
+            // velocity predictor: A*du = f - A*u_k - B*p_k
+            auto uRhs = f;
+            A.mmv(u, uRhs);
+            B.mmv(p, uRhs);
+            U uIncrement(u.size());
+            uIncrement = 0.0;
+            applyAMG_(*amgSolverForA_, uIncrement, uRhs);
+            u += uIncrement;
+
+            // pressure correction: S*dp = g - C*u - D*p_k
+            auto pRhs = g;
+            C.mmv(u, pRhs);
+            D.mmv(p, pRhs);
+            V pIncrement(p.size());
+            pIncrement = 0.0;
+            applyAMG_(*amgSolverForS_, pIncrement, pRhs);
+            pIncrement *= relaxationFactor_;
+            p += pIncrement;
+
+            // velocity correction: du = -Q^-1*B*dp
+            U bdp(u.size());
+            B.mv(pIncrement, bdp);
+            for (std::size_t i = 0; i < u.size(); ++i)
+                for (std::size_t j = 0; j < u[i].size(); ++j)
+                    u[i][j] -= invDiag_[i][j]*bdp[i][j];
+
+            if (verbosity_ > 1)
+            {
+                // the residual of the updated iterate
+                auto uRes = f;
+                A.mmv(u, uRes);
+                B.mmv(p, uRes);
+                auto pRes = g;
+                C.mmv(u, pRes);
+                D.mmv(p, pRes);
+                std::cout << name_ << " iteration " << k
+                << ", residual: " << uRes.two_norm() + pRes.two_norm() << std::endl;
+            }
+        }
+    }
+
+    /*!
+     * \brief Clean up.
+     */
+    virtual void post(X& x) {}
+
+    //! Category of the preconditioner (see SolverCategory::Category)
+    virtual Dune::SolverCategory::Category category() const
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+protected:
+    /*!
+     * \brief Constructor
+     *
+     * \param mat The matrix to operate on.
+     * \param params Collection of paramters.
+     * \param useRowSum Approximate A by its absolute row sums (SIMPLEC) instead of its diagonal (SIMPLE)
+     */
+    SeqSIMPLE(const M& mat, const Dune::ParameterTree& params, bool useRowSum)
+    : matrix_(mat)
+    , numIterations_(params.get<std::size_t>("iterations"))
+    , relaxationFactor_(params.get<scalar_field_type>("relaxation"))
+    , verbosity_(params.get<int>("verbosity"))
+    , name_(useRowSum ? "SIMPLEC" : "SIMPLE")
+    {
+        using namespace Dune::Indices;
+        invDiag_ = Detail::approximateInverseDiagonal(matrix_[_0][_0], useRowSum);
+        schur_ = Detail::approximateSchurComplement(matrix_[_0][_1], matrix_[_1][_0], matrix_[_1][_1], invDiag_);
+
+        amgSolverForA_ = std::make_unique<AMGSolverForA>(std::make_shared<LinearOperatorForA>(matrix_[_0][_0]), params);
+        amgSolverForS_ = std::make_unique<AMGSolverForS>(std::make_shared<LinearOperatorForS>(schur_), params);
+
+        if (verbosity_ > 0)
+            std::cout << "\n*** " << name_ << " Preconditioner ***\n"
+                      << "Approximate Schur complement with " << schur_.nonzeroes() << " non-zero blocks" << std::endl;
+    }
+
+private:
+    template<class Solver, class Sol, class Rhs>
+    static void applyAMG_(Solver& solver, Sol& sol, Rhs& rhs)
+    {
+        solver.pre(sol, rhs);
+        solver.apply(sol, rhs);
+        solver.post(sol);
+    }
+
+    //! \brief The matrix we operate on.
+    const M& matrix_;
+    //! \brief The number of steps to do in apply
+    const std::size_t numIterations_;
+    //! \brief The relaxation factor for the pressure update
+    const scalar_field_type relaxationFactor_;
+    //! \brief The verbosity level
+    const int verbosity_;
+    const std::string name_;
+
+    std::vector<Dune::FieldVector<scalar_field_type, A::block_type::rows>> invDiag_;
+    S schur_;
+    std::unique_ptr<AMGSolverForA> amgSolverForA_;
+    std::unique_ptr<AMGSolverForS> amgSolverForS_;
+};
+
+/*!
+ * \ingroup Linear
+ * \brief A SIMPLEC-type block preconditioner for saddle-point problems
+ *
+ * Same as SeqSIMPLE but \f$ Q \f$ is the diagonal matrix of absolute row sums of \f$ A \f$
+ * which typically allows for less under-relaxation of the pressure update.
+ *
+ * See: Van Doormaal, J. P., & Raithby, G. D. (1984). Enhancements of the SIMPLE method for predicting
+ *      incompressible fluid flows. Numerical heat transfer, 7(2), 147-163
+ *
+ * \tparam M Type of the matrix.
+ * \tparam X Type of the update.
+ * \tparam Y Type of the defect.
+ * \tparam l Preconditioner block level (for compatibility reasons, unused).
+ */
+template<class M, class X, class Y, int l = 1>
+class SeqSIMPLEC : public SeqSIMPLE<M, X, Y, l>
+{
+public:
+    /*!
+     * \brief Constructor
+     *
+     * \param mat The matrix to operate on.
+     * \param params Collection of paramters.
+     */
+#if DUNE_VERSION_GTE(DUNE_ISTL,2,8)
+    SeqSIMPLEC(const std::shared_ptr<const Dune::AssembledLinearOperator<M,X,Y>>& op, const Dune::ParameterTree& params)
+    : SeqSIMPLE<M, X, Y, l>(op->getmat(), params, true)
+#else
+    SeqSIMPLEC(const M& mat, const Dune::ParameterTree& params)
+    : SeqSIMPLE<M, X, Y, l>(mat, params, true)
+#endif
+    {}
+};
+
+/*!
+ * \ingroup Linear
+ * \brief A block-triangular preconditioner with a least-squares commutator (LSC) approximation
+ *        of the Schur complement for saddle-point problems of the form
+ * \f$
+ \begin{pmatrix}
+    A & B \\
+    C & D
+ \end{pmatrix}
+ \f$
+ *
+ * The preconditioner is the inverse of the block upper triangular matrix
+ * \f$ \begin{pmatrix} A & B \\ 0 & S \end{pmatrix} \f$ where the inverse of the Schur complement
+ * \f$ S = -C A^{-1} B \f$ is approximated by
+ * \f$ S^{-1} \approx -(C Q^{-1} B)^{-1} C Q^{-1} A Q^{-1} B (C Q^{-1} B)^{-1} \f$ with \f$ Q = \mathrm{diag}(A) \f$.
+ * In contrast to the SIMPLE approximation, the convective part of \f$ A \f$ enters the Schur complement
+ * approximation, which leads to iteration numbers almost independent of the Reynolds number.
+ * Each application requires one AMG cycle for the velocity block and two for the
+ * assembled pressure operator \f$ D - C Q^{-1} B \f$ (\f$ D \f$ is only used for the pressure Dirichlet rows).
+ * The preconditioner is meant to be used with a flexible Krylov method (e.g. restartedflexiblegmressolver).
+ *
+ * \note The preconditioner is sequential. The solver factory backend throws if it is used in parallel.
+ *
+ * See: Elman, H., Howle, V. E., Shadid, J., Shuttleworth, R., & Tuminaro, R. (2006). Block preconditioners based on
+ *      approximate commutators. SIAM Journal on Scientific Computing, 27(5), 1651-1668
+ *
+ * \tparam M Type of the matrix.
+ * \tparam X Type of the update.
+ * \tparam Y Type of the defect.
+ * \tparam l Preconditioner block level (for compatibility reasons, unused).
+ */
+template<class M, class X, class Y, int l = 1>
+class SeqLSC : public Dune::Preconditioner<X,Y>
+{
+    static_assert(Dumux::isMultiTypeBlockMatrix<M>::value && M::M() == 2 && M::N() == 2, "SeqLSC expects a 2x2 MultiTypeBlockMatrix.");
+    static_assert(l== 1, "SeqLSC expects a block level of 1.");
+
+    using A = std::decay_t<decltype(std::declval<M>()[Dune::Indices::_0][Dune::Indices::_0])>;
+    using S = std::decay_t<decltype(std::declval<M>()[Dune::Indices::_1][Dune::Indices::_1])>;
+    using U = std::decay_t<decltype(std::declval<X>()[Dune::Indices::_0])>;
+    using V = std::decay_t<decltype(std::declval<X>()[Dune::Indices::_1])>;
+
+    using Comm = Dune::Amg::SequentialInformation;
+    using LinearOperatorForA = Dune::MatrixAdapter<A, U, U>;
+    using LinearOperatorForS = Dune::MatrixAdapter<S, V, V>;
+    using AMGSolverForA = Dune::Amg::AMG<LinearOperatorForA, U, Dune::SeqSSOR<A, U, U>, Comm>;
+    using AMGSolverForS = Dune::Amg::AMG<LinearOperatorForS, V, Dune::SeqSSOR<S, V, V>, Comm>;
+
+public:
+    //! \brief The matrix type the preconditioner is for.
+    using matrix_type = M;
+    //! \brief The domain type of the preconditioner.
+    using domain_type = X;
+    //! \brief The range type of the preconditioner.
+    using range_type = Y;
+    //! \brief The field type of the preconditioner.
+    using field_type = typename X::field_type;
+    //! \brief Scalar type underlying the field_type.
+    using scalar_field_type = Dune::Simd::Scalar<field_type>;
+
+    /*!
+     * \brief Constructor
+     *
+     * \param mat The matrix to operate on.
+     * \param params Collection of paramters.
+     */
+#if DUNE_VERSION_GTE(DUNE_ISTL,2,8)
+    SeqLSC(const std::shared_ptr<const Dune::AssembledLinearOperator<M,X,Y>>& op, const Dune::ParameterTree& params)
+    : matrix_(op->getmat())
+#else
+    SeqLSC(const M& mat, const Dune::ParameterTree& params)
+    : matrix_(mat)
+#endif
+    , verbosity_(params.get<int>("verbosity"))
+    {
+        using namespace Dune::Indices;
+        invDiag_ = Detail::approximateInverseDiagonal(matrix_[_0][_0], false);
+        schur_ = Detail::approximateSchurComplement(matrix_[_0][_1], matrix_[_1][_0], matrix_[_1][_1], invDiag_);
+
+        amgSolverForA_ = std::make_unique<AMGSolverForA>(std::make_shared<LinearOperatorForA>(matrix_[_0][_0]), params);
+        amgSolverForS_ = std::make_unique<AMGSolverForS>(std::make_shared<LinearOperatorForS>(schur_), params);
+
+        if (verbosity_ > 0)
+            std::cout << "\n*** LSC Preconditioner ***\n"
+                      << "Pressure operator with " << schur_.nonzeroes() << " non-zero blocks" << std::endl;
+    }
+
+    /*!
+     * \brief Prepare the preconditioner.
+     */
+    virtual void pre(X& x, Y& b) {}
+
+    /*!
+     * \brief Apply the preconditioner
+     *
+     * \param update The update to be computed.
+     * \param currentDefect The current defect.
+     */
+    virtual void apply(X& update, const Y& currentDefect)
+    {
+        using namespace Dune::Indices;
+
+        auto& A = matrix_[_0][_0];
+        auto& B = matrix_[_0][_1];
+        auto& C = matrix_[_1][_0];
+        auto& D = matrix_[_1][_1];
+
+        const auto& f = currentDefect[_0];
+        const auto& g = currentDefect[_1];
+        auto& u = update[_0];
+        auto& p = update[_1];
+
+        // p = -L^-1*(C*Q^-1*A*Q^-1*B)*L^-1*g with L^-1 ~ (D - C*Q^-1*B)^-1
+        auto pRhs = g;
+        V y(p.size());
+        y = 0.0;
+        applyAMG_(*amgSolverForS_, y, pRhs);
+
+        U by(u.size());
+        B.mv(y, by);
+        scaleByInverseDiagonal_(by);
+        U aby(u.size());
+        A.mv(by, aby);
+        scaleByInverseDiagonal_(aby);
+        C.mv(aby, pRhs);
+
+        p = 0.0;
+        applyAMG_(*amgSolverForS_, p, pRhs);
+        p *= -1.0;
+
+        // incorporate Dirichlet cell values (their rows of the pressure block are unit rows, cf. SeqUzawa)
+        for (std::size_t i = 0; i < D.N(); ++i)
+        {
+            const auto& block = D[i][i];
+            for (auto rowIt = block.begin(); rowIt != block.end(); ++rowIt)
+                if (Dune::FloatCmp::eq<scalar_field_type>(rowIt->one_norm(), 1.0))
+                    p[i][rowIt.index()] = g[i][rowIt.index()];
+        }
+
+        // u = A^-1*(f - B*p)
+        auto uRhs = f;
+        B.mmv(p, uRhs);
+        u = 0.0;
+        applyAMG_(*amgSolverForA_, u, uRhs);
+    }
+
+    /*!
+     * \brief Clean up.
+     */
+    virtual void post(X& x) {}
+
+    //! Category of the preconditioner (see SolverCategory::Category)
+    virtual Dune::SolverCategory::Category category() const
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+private:
+    template<class Solver, class Sol, class Rhs>
+    static void applyAMG_(Solver& solver, Sol& sol, Rhs& rhs)
+    {
+        solver.pre(sol, rhs);
+        solver.apply(sol, rhs);
+        solver.post(sol);
+    }
+
+    void scaleByInverseDiagonal_(U& v) const
+    {
+        for (std::size_t i = 0; i < v.size(); ++i)
+            for (std::size_t j = 0; j < v[i].size(); ++j)
+                v[i][j] *= invDiag_[i][j];
+    }
+
+    //! \brief The matrix we operate on.
+    const M& matrix_;
+    //! \brief The verbosity level
+    const int verbosity_;
+
+    std::vector<Dune::FieldVector<scalar_field_type, A::block_type::rows>> invDiag_;
+    S schur_;
+    std::unique_ptr<AMGSolverForA> amgSolverForA_;
+    std::unique_ptr<AMGSolverForS> amgSolverForS_;
+};
+
+DUMUX_REGISTER_PRECONDITIONER("simple", Dumux::MultiTypeBlockMatrixPreconditionerTag, Dune::defaultPreconditionerBlockLevelCreator<Dumux::SeqSIMPLE, 1>());
+DUMUX_REGISTER_PRECONDITIONER("simplec", Dumux::MultiTypeBlockMatrixPreconditionerTag, Dune::defaultPreconditionerBlockLevelCreator<Dumux::SeqSIMPLEC, 1>());
+DUMUX_REGISTER_PRECONDITIONER("lsc", Dumux::MultiTypeBlockMatrixPreconditionerTag, Dune::defaultPreconditionerBlockLevelCreator<Dumux::SeqLSC, 1>());
+
 } // end namespace Dumux
 
 #endif
@@ -24,6 +24,7 @@
 #ifndef DUMUX_SEQ_SOLVER_BACKEND_HH
 #define DUMUX_SEQ_SOLVER_BACKEND_HH
 
+#include <memory>
 #include <type_traits>
 #include <tuple>
 #include <utility>
@@ -41,6 +42,7 @@
 #include <dumux/common/typetraits/utility.hh>
 #include <dumux/linear/solver.hh>
 #include <dumux/linear/amgbackend.hh>
+#include <dumux/linear/compactbcrsmatrix.hh>
 #include <dumux/linear/preconditioners.hh>
 #include <dumux/linear/linearsolverparameters.hh>
 
@@ -801,27 +803,35 @@ public:
         static_assert(BlockType::rows == BlockType::cols, "Matrix block must be quadratic!");
         constexpr auto blockSize = BlockType::rows;
 
-        Dune::SuperLU<Matrix> solver(A, this->verbosity() > 0);
+        // the SuperLU interface requires the field type of the matrix to match the one of the vectors
+        // so matrices stored with another precision (or index type) are converted first
+        using DirectSolverMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<typename Vector::field_type, blockSize, blockSize>>;
+        if constexpr (!std::is_same_v<Matrix, DirectSolverMatrix>)
+            return solve(copyBCRSMatrix<DirectSolverMatrix>(A), x, b);
+        else
+        {
+            Dune::SuperLU<Matrix> solver(A, this->verbosity() > 0);
 
-        Vector bTmp(b);
-        solver.apply(x, bTmp, result_);
+            Vector bTmp(b);
+            solver.apply(x, bTmp, result_);
 
-        int size = x.size();
-        for (int i = 0; i < size; i++)
-        {
-            for (int j = 0; j < blockSize; j++)
+            int size = x.size();
+            for (int i = 0; i < size; i++)
             {
-                using std::isnan;
-                using std::isinf;
-                if (isnan(x[i][j]) || isinf(x[i][j]))
+                for (int j = 0; j < blockSize; j++)
                 {
-                    result_.converged = false;
-                    break;
+                    using std::isnan;
+                    using std::isinf;
+                    if (isnan(x[i][j]) || isinf(x[i][j]))
+                    {
+                        result_.converged = false;
+                        break;
+                    }
                 }
             }
-        }
 
-        return result_.converged;
+            return result_.converged;
+        }
     }
 
     std::string name() const
@@ -888,13 +898,33 @@ public:
         static_assert(BlockType::rows == BlockType::cols, "Matrix block must be quadratic!");
         constexpr auto blockSize = BlockType::rows;
 
-        Dune::UMFPack<Matrix> solver;
-        solver.setVerbosity(this->verbosity() > 0);
-        solver.setOption(UMFPACK_ORDERING, ordering_);
-        solver.setMatrix(A);
+        // the UMFPack interface requires the field type of the matrix to match the one of the vectors
+        // so matrices stored with another precision (or index type) are converted first
+        using DirectSolverMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<typename Vector::field_type, blockSize, blockSize>>;
+        using Solver = Dune::UMFPack<DirectSolverMatrix>;
+
+        // the factorization is kept for reuse
+        if (!reuseSetup_ || !solver_ || solverMatrix_ != &A)
+        {
+            auto solver = std::make_shared<Solver>();
+            solver->setVerbosity(this->verbosity() > 0);
+            solver->setOption(UMFPACK_ORDERING, ordering_);
+            if constexpr (!std::is_same_v<Matrix, DirectSolverMatrix>)
+                solver->setMatrix(copyBCRSMatrix<DirectSolverMatrix>(A));
+            else
+                solver->setMatrix(A);
+
+            solver_ = solver;
+            solverMatrix_ = &A;
+        }
+
+        auto solver = std::static_pointer_cast<Solver>(solver_);
 
         Vector bTmp(b);
-        solver.apply(x, bTmp, result_);
+        solver->apply(x, bTmp, result_);
+
+        if (!keepSetup_)
+            solver_.reset();
 
         int size = x.size();
         for (int i = 0; i < size; i++)
@@ -924,9 +954,21 @@ public:
         return result_;
     }
 
+    /*!
+     * \brief Reuse the factorization of the last solve in subsequent solves with the same matrix object
+     * \note The caller has to make sure that the matrix entries did not change in between,
+     *       e.g. the Newton solver in the frozen Jacobian mode.
+     */
+    void setReuseSetup(bool reuse)
+    { reuseSetup_ = reuse; keepSetup_ = true; }
+
 private:
     Dune::InverseOperatorResult result_;
     int ordering_;
+    bool reuseSetup_ = false;
+    bool keepSetup_ = false; //! keep the factorization after solving (only if reuse is requested at some point)
+    std::shared_ptr<void> solver_;
+    const void* solverMatrix_ = nullptr;
 };
 #endif // HAVE_UMFPACK
 
@@ -24,9 +24,12 @@
 #ifndef DUMUX_BINARY_COEFF_BRINE_CO2_HH
 #define DUMUX_BINARY_COEFF_BRINE_CO2_HH
 
+#include <optional>
+
 #include <dune/common/math.hh>
 
 #include <dumux/common/parameters.hh>
+#include <dumux/common/parameterhandle.hh>
 #include <dumux/material/components/brine.hh>
 #include <dumux/material/components/h2o.hh>
 #include <dumux/material/components/co2.hh>
@@ -56,8 +59,8 @@ public:
      */
     static Scalar gasDiffCoeff(Scalar temperature, Scalar pressure)
     {
-        static const bool hasGasDiffCoeff = hasParam("BinaryCoefficients.GasDiffCoeff");
-        if (!hasGasDiffCoeff) //in case one might set that user-specific as e.g. in dumux-lecture/mm/convectivemixing
+        const auto& gasDiffCoeff = diffCoeffParams_().gasDiffCoeff;
+        if (!gasDiffCoeff) //in case one might set that user-specific as e.g. in dumux-lecture/mm/convectivemixing
         {
             //Diffusion coefficient of water in the CO2 phase
             constexpr Scalar PI = 3.141593;
@@ -68,10 +71,7 @@ public:
             return k / (c * PI * R_h) * (temperature / mu);
         }
         else
-        {
-            static const Scalar D = getParam<Scalar>("BinaryCoefficients.GasDiffCoeff");
-            return D;
-        }
+            return **gasDiffCoeff;
     }
 
     /*!
@@ -83,14 +83,11 @@ public:
     static Scalar liquidDiffCoeff(Scalar temperature, Scalar pressure)
     {
         //Diffusion coefficient of CO2 in the brine phase
-        static const bool hasLiquidDiffCoeff = hasParam("BinaryCoefficients.LiquidDiffCoeff");
-        if (!hasLiquidDiffCoeff) //in case one might set that user-specific as e.g. in dumux-lecture/mm/convectivemixing
+        const auto& liquidDiffCoeff = diffCoeffParams_().liquidDiffCoeff;
+        if (!liquidDiffCoeff) //in case one might set that user-specific as e.g. in dumux-lecture/mm/convectivemixing
             return 2e-9;
         else
-        {
-            const Scalar D = getParam<Scalar>("BinaryCoefficients.LiquidDiffCoeff");
-            return D;
-        }
+            return **liquidDiffCoeff;
     }
 
     /*!
@@ -203,6 +200,32 @@ public:
     }
 
 private:
+    //! The user-specific diffusion coefficients (if set)
+    struct DiffCoeffParams
+    {
+        std::optional<ParamHandle<Scalar>> gasDiffCoeff;
+        std::optional<ParamHandle<Scalar>> liquidDiffCoeff;
+    };
+
+    /*!
+     * \brief The user-specific diffusion coefficients, looked up once
+     * \note The binary coefficients are used by fluid systems without an object owning
+     *       a parameter group, so the handles are shared by the whole program.
+     */
+    static const DiffCoeffParams& diffCoeffParams_()
+    {
+        static const DiffCoeffParams params = []
+        {
+            DiffCoeffParams p;
+            if (hasParam("BinaryCoefficients.GasDiffCoeff"))
+                p.gasDiffCoeff = paramHandle<Scalar>("BinaryCoefficients.GasDiffCoeff");
+            if (hasParam("BinaryCoefficients.LiquidDiffCoeff"))
+                p.liquidDiffCoeff = paramHandle<Scalar>("BinaryCoefficients.LiquidDiffCoeff");
+            return p;
+        }();
+        return params;
+    }
+
     /*!
      * \brief Returns the molality of NaCl \f$\mathrm{[mol \ NaCl / kg \ water]}\f$  for a given mole fraction
      * \param salinity the salinity \f$\mathrm{[kg \ NaCl / kg \ solution]}\f$
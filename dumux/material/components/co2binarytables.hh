@@ -0,0 +1,454 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Components
+ * \brief CO2 property tables loaded at runtime from a binary file
+ *
+ * The binary format (native byte order) consists of a header
+ *  - the magic string `DUMUXCO2` (8 bytes)
+ *  - the format version (uint32), the number of temperature and pressure
+ *    sampling points (uint32 each) and 4 bytes padding
+ *  - the temperature and pressure range (4 doubles: minTemp, maxTemp, minPress, maxPress)
+ *
+ * followed by the density \f$\mathrm{[kg/m^3]}\f$ and the specific enthalpy \f$\mathrm{[J/kg]}\f$
+ * values (doubles), each stored temperature-major, i.e. `vals[tempIdx*numPressSteps + pressIdx]`.
+ * Such files are created with `bin/create_co2tables.py` (for user-defined ranges and resolutions)
+ * or with CO2TableFile::write() (e.g. from the compiled-in tables).
+ */
+#ifndef DUMUX_MATERIAL_COMPONENTS_CO2_BINARY_TABLES_HH
+#define DUMUX_MATERIAL_COMPONENTS_CO2_BINARY_TABLES_HH
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <iterator>
+#include <algorithm>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define DUMUX_CO2TABLES_HAVE_MMAP 1
+#else
+#define DUMUX_CO2TABLES_HAVE_MMAP 0
+#endif
+
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/exceptions.hh>
+#include <dumux/common/parameters.hh>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Components
+ * \brief The interpolation between the sampling points of the CO2 tables
+ *  - bilinear: bilinear interpolation (continuous values, discontinuous derivatives)
+ *  - monotoneCubic: tensor product of monotone piecewise cubic Hermite interpolants
+ *    (Steffen 1990), continuously differentiable and free of overshoots
+ */
+enum class CO2TableInterpolation { bilinear, monotoneCubic };
+
+namespace Detail {
+
+/*!
+ * \ingroup Components
+ * \brief A read-only mapping of a file into memory
+ * \note The mapping is shared, so all processes on a node mapping the same file share
+ *       the physical memory (the page cache). Where mmap is not available, the file is read.
+ */
+class ReadOnlyFileMapping
+{
+public:
+    explicit ReadOnlyFileMapping(const std::string& fileName)
+    {
+#if DUMUX_CO2TABLES_HAVE_MMAP
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+            DUNE_THROW(Dune::IOError, "Could not open file " << fileName);
+
+        struct stat fileStatus;
+        if (::fstat(fd, &fileStatus) != 0)
+        {
+            ::close(fd);
+            DUNE_THROW(Dune::IOError, "Could not determine the size of file " << fileName);
+        }
+
+        size_ = fileStatus.st_size;
+        if (size_ > 0)
+        {
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (data == MAP_FAILED)
+                DUNE_THROW(Dune::IOError, "Could not map file " << fileName << " into memory");
+            data_ = static_cast<const char*>(data);
+        }
+        else
+            ::close(fd);
+#else
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file)
+            DUNE_THROW(Dune::IOError, "Could not open file " << fileName);
+        buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+    }
+
+    ~ReadOnlyFileMapping()
+    {
+#if DUMUX_CO2TABLES_HAVE_MMAP
+        if (data_)
+            ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    ReadOnlyFileMapping(const ReadOnlyFileMapping&) = delete;
+    ReadOnlyFileMapping& operator=(const ReadOnlyFileMapping&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if !DUMUX_CO2TABLES_HAVE_MMAP
+    std::vector<char> buffer_;
+#endif
+};
+
+} // end namespace Detail
+
+/*!
+ * \ingroup Components
+ * \brief A CO2 property tabulated on an equidistant temperature-pressure grid
+ * \note The values are not owned by the table (e.g. they are in a memory-mapped file).
+ *       The interface is the same as for the compile-time tables (TabulatedCO2Properties).
+ */
+class CO2PropertyTable
+{
+public:
+    using Scalar = double;
+
+    CO2PropertyTable(const double* values,
+                     int numTempSteps, int numPressSteps,
+                     Scalar minTemp, Scalar maxTemp,
+                     Scalar minPress, Scalar maxPress,
+                     CO2TableInterpolation interpolation = CO2TableInterpolation::bilinear)
+    : values_(values)
+    , numTempSteps_(numTempSteps), numPressSteps_(numPressSteps)
+    , minTemp_(minTemp), maxTemp_(maxTemp)
+    , minPress_(minPress), maxPress_(maxPress)
+    , interpolation_(interpolation)
+    {
+        if (numTempSteps < 2 || numPressSteps < 2)
+            DUNE_THROW(Dune::InvalidStateException, "CO2 tables need at least two sampling points per direction");
+        if (!(minTemp < maxTemp) || !(minPress < maxPress))
+            DUNE_THROW(Dune::InvalidStateException, "Invalid temperature or pressure range of the CO2 tables");
+    }
+
+    Scalar minTemp() const { return minTemp_; }
+    Scalar maxTemp() const { return maxTemp_; }
+    Scalar minPress() const { return minPress_; }
+    Scalar maxPress() const { return maxPress_; }
+
+    int numTempSteps() const { return numTempSteps_; }
+    int numPressSteps() const { return numPressSteps_; }
+
+    bool applies(Scalar temperature, Scalar pressure) const
+    {
+        return minTemp() <= temperature && temperature <= maxTemp() &&
+            minPress() <= pressure && pressure <= maxPress();
+    }
+
+    /*!
+     * \brief The interpolated value at the given temperature and pressure
+     * \note Outside of the tabulated range, the value at the closest point of the range is returned.
+     */
+    Scalar at(Scalar temperature, Scalar pressure) const
+    {
+        using std::clamp;
+        temperature = clamp(temperature, minTemp(), maxTemp());
+        pressure = clamp(pressure, minPress(), maxPress());
+
+        // the index of the interval and the local coordinate in [0, 1]
+        const auto [i, alpha] = locate_(temperature, minTemp(), maxTemp(), numTempSteps_);
+        const auto [j, beta] = locate_(pressure, minPress(), maxPress(), numPressSteps_);
+
+        if (interpolation_ == CO2TableInterpolation::bilinear)
+            return (1-alpha)*(1-beta)*val(i, j)
+                   + (1-alpha)*beta*val(i, j + 1)
+                   + alpha*(1-beta)*val(i + 1, j)
+                   + alpha*beta*val(i + 1, j + 1);
+
+        // interpolate in pressure direction on the (up to) four neighboring temperature rows
+        // and then in temperature direction
+        std::array<Scalar, 4> rowValues;
+        for (int k = -1; k <= 2; ++k)
+        {
+            const int row = std::clamp(i + k, 0, numTempSteps_ - 1);
+            rowValues[k+1] = monotoneCubic_({val(row, std::max(j-1, 0)), val(row, j), val(row, j+1), val(row, std::min(j+2, numPressSteps_-1))},
+                                            j > 0, j + 2 < numPressSteps_, beta);
+        }
+
+        return monotoneCubic_(rowValues, i > 0, i + 2 < numTempSteps_, alpha);
+    }
+
+    //! The tabulated value at the given temperature and pressure indices
+    Scalar val(int i, int j) const
+    {
+#if !defined NDEBUG
+        if (i < 0 || i >= numTempSteps_ || j < 0 || j >= numPressSteps_)
+            DUNE_THROW(NumericalProblem, "Attempt to access element (" << i << ", " << j
+                                          << ") on a CO2 table of size (" << numTempSteps_ << ", " << numPressSteps_ << ")");
+#endif
+        return values_[i*numPressSteps_ + j];
+    }
+
+private:
+    //! the interval index and local coordinate of x on an equidistant grid
+    static std::pair<int, Scalar> locate_(Scalar x, Scalar min, Scalar max, int numSteps)
+    {
+        const Scalar pos = (x - min)/(max - min)*(numSteps - 1);
+        const int idx = std::clamp(static_cast<int>(pos), 0, numSteps - 2);
+        return {idx, pos - idx};
+    }
+
+    /*!
+     * \brief Monotone cubic Hermite interpolation on the interval between f[1] and f[2]
+     *        with the node slopes of Steffen (1990), A simple method for monotonic interpolation
+     *        in one dimension, Astronomy and Astrophysics 239, 443-450
+     * \param f the values at the nodes i-1, i, i+1, i+2 (unit spacing)
+     * \param hasLeft if node i-1 exists (otherwise the slope at node i is the secant)
+     * \param hasRight if node i+2 exists (otherwise the slope at node i+1 is the secant)
+     * \param t the local coordinate in [0, 1]
+     */
+    static Scalar monotoneCubic_(const std::array<Scalar, 4>& f, bool hasLeft, bool hasRight, Scalar t)
+    {
+        const Scalar sLeft = f[1] - f[0];
+        const Scalar s = f[2] - f[1];
+        const Scalar sRight = f[3] - f[2];
+
+        const auto slope = [](Scalar s0, Scalar s1)
+        {
+            using std::abs; using std::min;
+            if (s0*s1 <= 0.0)
+                return 0.0;
+            const Scalar sign = s0 > 0.0 ? 1.0 : -1.0;
+            return sign*min({2.0*abs(s0), 2.0*abs(s1), 0.5*abs(s0 + s1)});
+        };
+
+        const Scalar d0 = hasLeft ? slope(sLeft, s) : s;
+        const Scalar d1 = hasRight ? slope(s, sRight) : s;
+
+        const Scalar t2 = t*t;
+        const Scalar t3 = t2*t;
+        return (2*t3 - 3*t2 + 1)*f[1] + (t3 - 2*t2 + t)*d0 + (-2*t3 + 3*t2)*f[2] + (t3 - t2)*d1;
+    }
+
+    const double* values_;
+    int numTempSteps_, numPressSteps_;
+    Scalar minTemp_, maxTemp_, minPress_, maxPress_;
+    CO2TableInterpolation interpolation_;
+};
+
+/*!
+ * \ingroup Components
+ * \brief The density and enthalpy tables of CO2 in a (memory-mapped) binary file
+ */
+class CO2TableFile
+{
+    static constexpr char magic_[8] = {'D', 'U', 'M', 'U', 'X', 'C', 'O', '2'};
+    static constexpr std::size_t headerSize_ = 8 + 4*sizeof(std::uint32_t) + 4*sizeof(double);
+
+public:
+    //! the version of the binary format
+    static constexpr std::uint32_t formatVersion = 1;
+
+    explicit CO2TableFile(const std::string& fileName,
+                          CO2TableInterpolation interpolation = CO2TableInterpolation::bilinear)
+    : mapping_(fileName)
+    {
+        const char* data = mapping_.data();
+        if (mapping_.size() < headerSize_ || std::memcmp(data, magic_, 8) != 0)
+            DUNE_THROW(Dune::IOError, fileName << " is not a binary CO2 table file");
+
+        std::uint32_t header[4];
+        std::memcpy(header, data + 8, sizeof(header));
+        double range[4];
+        std::memcpy(range, data + 8 + sizeof(header), sizeof(range));
+
+        if (header[0] != formatVersion)
+            DUNE_THROW(Dune::IOError, "Unsupported version " << header[0] << " of the binary CO2 table file " << fileName);
+
+        const std::size_t numValues = std::size_t(header[1])*header[2];
+        if (mapping_.size() != headerSize_ + 2*numValues*sizeof(double))
+            DUNE_THROW(Dune::IOError, "The size of the binary CO2 table file " << fileName << " does not match its header");
+
+        const double* values = reinterpret_cast<const double*>(data + headerSize_);
+        density_.emplace(values, header[1], header[2], range[0], range[1], range[2], range[3], interpolation);
+        enthalpy_.emplace(values + numValues, header[1], header[2], range[0], range[1], range[2], range[3], interpolation);
+    }
+
+    //! The density table \f$\mathrm{[kg/m^3]}\f$
+    const CO2PropertyTable& density() const
+    { return *density_; }
+
+    //! The specific enthalpy table \f$\mathrm{[J/kg]}\f$
+    const CO2PropertyTable& enthalpy() const
+    { return *enthalpy_; }
+
+    /*!
+     * \brief Write a binary CO2 table file
+     * \param fileName the file name
+     * \param numTempSteps number of temperature sampling points
+     * \param numPressSteps number of pressure sampling points
+     * \param tempRange the minimum and maximum temperature \f$\mathrm{[K]}\f$
+     * \param pressRange the minimum and maximum pressure \f$\mathrm{[Pa]}\f$
+     * \param density a function (temperature index, pressure index) returning the density
+     * \param enthalpy a function (temperature index, pressure index) returning the specific enthalpy
+     */
+    template<class Density, class Enthalpy>
+    static void write(const std::string& fileName,
+                      std::uint32_t numTempSteps, std::uint32_t numPressSteps,
+                      const std::array<double, 2>& tempRange, const std::array<double, 2>& pressRange,
+                      const Density& density, const Enthalpy& enthalpy)
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        if (!file)
+            DUNE_THROW(Dune::IOError, "Could not open file " << fileName << " for writing");
+
+        const std::uint32_t header[4] = {formatVersion, numTempSteps, numPressSteps, 0};
+        const double range[4] = {tempRange[0], tempRange[1], pressRange[0], pressRange[1]};
+        file.write(magic_, 8);
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(range), sizeof(range));
+
+        const auto writeValues = [&](const auto& f)
+        {
+            std::vector<double> values(numPressSteps);
+            for (std::uint32_t i = 0; i < numTempSteps; ++i)
+            {
+                for (std::uint32_t j = 0; j < numPressSteps; ++j)
+                    values[j] = f(i, j);
+                file.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(double));
+            }
+        };
+
+        writeValues(density);
+        writeValues(enthalpy);
+    }
+
+    /*!
+     * \brief Write the tables of a CO2Tables class (e.g. the compiled-in tables) to a binary CO2 table file
+     * \note The tables are sampled at the sampling points of the enthalpy table.
+     */
+    template<class CO2Tables>
+    static void write(const std::string& fileName)
+    {
+        const auto& enthalpy = CO2Tables::tabulatedEnthalpy;
+        const auto& density = CO2Tables::tabulatedDensity;
+        write(fileName, enthalpy.numTempSteps, enthalpy.numPressSteps,
+              {enthalpy.minTemp(), enthalpy.maxTemp()}, {enthalpy.minPress(), enthalpy.maxPress()},
+              [&](auto i, auto j){ return density.at(temperature_(enthalpy, i), pressure_(enthalpy, j)); },
+              [&](auto i, auto j){ return enthalpy.val(i, j); });
+    }
+
+private:
+    template<class Table>
+    static double temperature_(const Table& table, int i)
+    { return table.minTemp() + i*(table.maxTemp() - table.minTemp())/(table.numTempSteps - 1); }
+
+    template<class Table>
+    static double pressure_(const Table& table, int j)
+    { return table.minPress() + j*(table.maxPress() - table.minPress())/(table.numPressSteps - 1); }
+
+    Detail::ReadOnlyFileMapping mapping_;
+    std::optional<CO2PropertyTable> density_, enthalpy_;
+};
+
+namespace Detail {
+
+//! A tabulated CO2 property of the BinaryCO2Tables (loaded on first use)
+template<class Tables, bool isDensity>
+struct BinaryCO2TableProperty
+{
+    const CO2PropertyTable& table() const
+    {
+        if constexpr (isDensity)
+            return Tables::file().density();
+        else
+            return Tables::file().enthalpy();
+    }
+
+    double minTemp() const { return table().minTemp(); }
+    double maxTemp() const { return table().maxTemp(); }
+    double minPress() const { return table().minPress(); }
+    double maxPress() const { return table().maxPress(); }
+
+    bool applies(double temperature, double pressure) const
+    { return table().applies(temperature, pressure); }
+
+    double at(double temperature, double pressure) const
+    { return table().at(temperature, pressure); }
+};
+
+} // end namespace Detail
+
+/*!
+ * \ingroup Components
+ * \brief CO2 tables loaded at runtime from a binary CO2 table file, to be used
+ *        as tables of the CO2 component, e.g. `Components::CO2<double, BinaryCO2Tables>`
+ *        or `FluidSystems::BrineCO2<double, BinaryCO2Tables>`
+ *
+ * The file is given by the parameter `CO2Tables.File` and the interpolation by
+ * `CO2Tables.Interpolation` (`bilinear` (default) or `monotonecubic`). The file is mapped
+ * into memory on first use.
+ */
+struct BinaryCO2Tables
+{
+    static const CO2TableFile& file()
+    {
+        static const CO2TableFile file(getParam<std::string>("CO2Tables.File"), [](){
+            const auto interpolation = getParam<std::string>("CO2Tables.Interpolation", "bilinear");
+            if (interpolation == "bilinear")
+                return CO2TableInterpolation::bilinear;
+            else if (interpolation == "monotonecubic")
+                return CO2TableInterpolation::monotoneCubic;
+            else
+                DUNE_THROW(ParameterException, "Unknown CO2 table interpolation " << interpolation
+                                                << " (use bilinear or monotonecubic)");
+        }());
+        return file;
+    }
+
+    static inline const Detail::BinaryCO2TableProperty<BinaryCO2Tables, false> tabulatedEnthalpy{};
+    static inline const Detail::BinaryCO2TableProperty<BinaryCO2Tables, true> tabulatedDensity{};
+};
+
+} // end namespace Dumux
+
+#endif
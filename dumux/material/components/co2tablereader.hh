@@ -38,9 +38,10 @@ template <class Traits>
 class TabulatedCO2Properties
 {
     using Scalar = typename Traits::Scalar;
-    enum { numTempSteps = Traits::numTempSteps, numPressSteps = Traits::numPressSteps };
 
 public:
+    enum { numTempSteps = Traits::numTempSteps, numPressSteps = Traits::numPressSteps };
+
     // user default constructor (we can't use "= default" here to satisfy older clang compilers since this class is used as a static data member)
     TabulatedCO2Properties() {}
 
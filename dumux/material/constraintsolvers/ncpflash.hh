@@ -25,6 +25,9 @@
 #ifndef DUMUX_NCP_FLASH_HH
 #define DUMUX_NCP_FLASH_HH
 
+#include <vector>
+#include <algorithm>
+
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 
@@ -33,6 +36,49 @@
 
 namespace Dumux {
 
+/*!
+ * \ingroup ConstraintSolvers
+ * \brief Stores the last converged fluid state of a flash calculation for each degree of freedom
+ *
+ * The storage is meant to be kept alongside the grid volume variables such that the flash
+ * calculation of a degree of freedom can be started from its last converged state.
+ * Different degrees of freedom may be stored concurrently from several threads.
+ */
+template <class FluidState>
+class FlashWarmStartStorage
+{
+public:
+    //! Resize the storage and invalidate all stored states (e.g. after grid adaption)
+    void resize(std::size_t numDofs)
+    {
+        states_.resize(numDofs);
+        valid_.assign(numDofs, false);
+    }
+
+    //! Invalidate all stored states
+    void clear()
+    { std::fill(valid_.begin(), valid_.end(), false); }
+
+    //! Returns true if a converged state is stored for a degree of freedom
+    bool contains(std::size_t dofIdx) const
+    { return dofIdx < valid_.size() && valid_[dofIdx]; }
+
+    //! The stored state of a degree of freedom
+    const FluidState& operator[](std::size_t dofIdx) const
+    { return states_[dofIdx]; }
+
+    //! Store the converged state of a degree of freedom
+    void store(std::size_t dofIdx, const FluidState& fluidState)
+    {
+        states_[dofIdx] = fluidState;
+        valid_[dofIdx] = true;
+    }
+
+private:
+    std::vector<FluidState> states_;
+    std::vector<char> valid_; // not std::vector<bool> to allow concurrent writes to different entries
+};
+
 /*!
  * \ingroup ConstraintSolvers
  * \brief Determines the phase compositions, pressures and saturations
@@ -73,6 +119,13 @@ namespace Dumux {
  * - 1 pressure
  * - M - 1 saturations
  * - M*N mole fractions
+ *
+ * The derivatives with respect to the mole fractions are assembled analytically for phases
+ * that are ideal mixtures. Only the derivative of the molar density is then approximated numerically.
+ *
+ * If the flash is evaluated repeatedly for the same degree of freedom (e.g. in each Newton iteration
+ * of the outer solver), the last converged fluid state can be used as initial guess, see
+ * guessFromPrevious() and FlashWarmStartStorage.
  */
 template <class Scalar, class FluidSystem>
 class NcpFlash
@@ -138,6 +191,35 @@ public:
         }
     }
 
+    /*!
+     * \brief Use a previously converged fluid state as initial guess (warm start)
+     * \param fluidState Thermodynamic state of the fluids (the temperature has to be set)
+     * \param paramCache  Container for cache parameters
+     * \param previous A fluid state computed by a previous flash calculation
+     */
+    template <class FluidState, class PreviousFluidState>
+    void guessFromPrevious(FluidState &fluidState,
+                           ParameterCache &paramCache,
+                           const PreviousFluidState &previous)
+    {
+        for (int phaseIdx = 0; phaseIdx < numPhases; ++ phaseIdx) {
+            for (int compIdx = 0; compIdx < numComponents; ++ compIdx)
+                fluidState.setMoleFraction(phaseIdx, compIdx, previous.moleFraction(phaseIdx, compIdx));
+
+            fluidState.setPressure(phaseIdx, previous.pressure(phaseIdx));
+            fluidState.setSaturation(phaseIdx, previous.saturation(phaseIdx));
+        }
+
+        // set the fugacity coefficients of all components in all phases
+        paramCache.updateAll(fluidState);
+        for (int phaseIdx = 0; phaseIdx < numPhases; ++ phaseIdx) {
+            for (int compIdx = 0; compIdx < numComponents; ++ compIdx) {
+                Scalar phi = FluidSystem::fugacityCoefficient(fluidState, paramCache, phaseIdx, compIdx);
+                fluidState.setFugacityCoefficient(phaseIdx, compIdx, phi);
+            }
+        }
+    }
+
     /*!
      * \brief Calculates the chemical equilibrium from the component
      *        fugacities in a phase.
@@ -238,7 +320,10 @@ public:
             Scalar relError = update_(fluidState, paramCache, material, deltaX);
 
             if (relError < 1e-9)
+            {
+                numIterations_ = nIdx + 1;
                 return;
+            }
         }
 
         /*
@@ -255,6 +340,47 @@ public:
                    << fluidState.temperature(/*phaseIdx=*/0));
     }
 
+    /*!
+     * \brief Calculates the chemical equilibrium using the last converged state
+     *        of a degree of freedom as initial guess
+     * \param fluidState Thermodynamic state of the fluids (the temperature has to be set)
+     * \param paramCache  Container for cache parameters
+     * \param material The material law object
+     * \param globalMolarities
+     * \param storage The storage for the converged fluid states of all degrees of freedom
+     * \param dofIdx The index of the degree of freedom
+     *
+     * If no converged state is stored or the flash fails to converge from it,
+     * the flash is (re-)started from guessInitial(). The converged state is stored.
+     */
+    template <class MaterialLaw, class FluidState>
+    void solve(FluidState &fluidState,
+               ParameterCache &paramCache,
+               const MaterialLaw& material,
+               const ComponentVector &globalMolarities,
+               FlashWarmStartStorage<FluidState>& storage,
+               std::size_t dofIdx)
+    {
+        if (storage.contains(dofIdx))
+        {
+            try {
+                guessFromPrevious(fluidState, paramCache, storage[dofIdx]);
+                solve(fluidState, paramCache, material, globalMolarities);
+                storage.store(dofIdx, fluidState);
+                return;
+            }
+            catch (const NumericalProblem&) {}
+        }
+
+        guessInitial(fluidState, paramCache, globalMolarities);
+        solve(fluidState, paramCache, material, globalMolarities);
+        storage.store(dofIdx, fluidState);
+    }
+
+    //! The number of Newton iterations of the last successful flash calculation
+    int numIterations() const
+    { return numIterations_; }
+
 
 protected:
     template <class FluidState>
@@ -327,6 +453,14 @@ protected:
 
         // assemble jacobian matrix
         for (int pvIdx = 0; pvIdx < numEq; ++ pvIdx) {
+            if (isMoleFracIdx_(pvIdx)) {
+                const int phaseIdx = (pvIdx - numPhases)/numComponents;
+                if (FluidSystem::isIdealMixture(phaseIdx)) {
+                    linearizeMoleFraction_(J, fluidState, paramCache, origFluidState, origParamCache, pvIdx);
+                    continue;
+                }
+            }
+
             ////////
             // approximately calculate partial derivatives of the
             // fugacity defect of all components in regard to the mole
@@ -356,6 +490,63 @@ protected:
         }
     }
 
+    /*!
+     * \brief Assemble the derivatives with respect to a mole fraction of an ideal mixture
+     *
+     * The fugacity coefficients of an ideal mixture do not depend on the composition,
+     * such that the derivatives of the fugacities (\f$ f^\kappa_\alpha = \Phi^\kappa_\alpha x^\kappa_\alpha p_\alpha \f$)
+     * and the NCP constraints are known analytically. Only the derivative of the molar density
+     * of the phase is approximated by forward differences.
+     */
+    template <class FluidState>
+    void linearizeMoleFraction_(Matrix &J,
+                                FluidState &fluidState,
+                                ParameterCache &paramCache,
+                                const FluidState &origFluidState,
+                                const ParameterCache &origParamCache,
+                                int pvIdx)
+    {
+        const int phaseIdx = (pvIdx - numPhases)/numComponents;
+        const int compIdx = (pvIdx - numPhases)%numComponents;
+
+        // derivative of the molar density
+        const Scalar x_i = fluidState.moleFraction(phaseIdx, compIdx);
+        const Scalar eps = 1e-8/quantityWeight_(fluidState, pvIdx);
+        const Scalar rhoMolar = fluidState.molarDensity(phaseIdx);
+        fluidState.setMoleFraction(phaseIdx, compIdx, x_i + eps);
+        paramCache.updateSingleMoleFraction(fluidState, phaseIdx, compIdx);
+        const Scalar dRhoMolar = (FluidSystem::molarDensity(fluidState, paramCache, phaseIdx) - rhoMolar)/eps;
+        fluidState = origFluidState;
+        paramCache = origParamCache;
+
+        // fugacity of any component must be equal in all phases
+        const Scalar dFugacity = fluidState.fugacityCoefficient(phaseIdx, compIdx)*fluidState.pressure(phaseIdx);
+        for (int otherPhaseIdx = 1; otherPhaseIdx < numPhases; ++otherPhaseIdx) {
+            const int eqIdx = compIdx*(numPhases - 1) + otherPhaseIdx - 1;
+            if (phaseIdx == 0)
+                J[eqIdx][pvIdx] = dFugacity;
+            else if (phaseIdx == otherPhaseIdx)
+                J[eqIdx][pvIdx] = -dFugacity;
+        }
+
+        // global molarities are given
+        const Scalar S = fluidState.saturation(phaseIdx);
+        for (int compJIdx = 0; compJIdx < numComponents; ++compJIdx) {
+            const int eqIdx = numComponents*(numPhases - 1) + compJIdx;
+            J[eqIdx][pvIdx] = S*dRhoMolar*fluidState.moleFraction(phaseIdx, compJIdx);
+            if (compJIdx == compIdx)
+                J[eqIdx][pvIdx] += S*rhoMolar;
+        }
+
+        // non-linear complementarity function of the phase
+        Scalar sumMoleFrac = 0.0;
+        for (int compJIdx = 0; compJIdx < numComponents; ++compJIdx)
+            sumMoleFrac += fluidState.moleFraction(phaseIdx, compJIdx);
+
+        const int eqIdx = numComponents*numPhases + phaseIdx;
+        J[eqIdx][pvIdx] = (1.0 - sumMoleFrac > S) ? 0.0 : -1.0;
+    }
+
     template <class FluidState>
     void calculateDefect_(Vector &b,
                           const FluidState &fluidStateEval,
@@ -695,6 +886,7 @@ protected:
 
 private:
     int wettingPhaseIdx_ = 0; //!< the phase index of the wetting phase
+    int numIterations_ = 0; //!< the number of iterations of the last flash calculation
 };
 
 } // end namespace Dumux
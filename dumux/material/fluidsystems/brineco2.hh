@@ -46,7 +46,9 @@
 namespace Dumux {
 
 // include the default tables for CO2
-#ifndef DOXYGEN // hide tables from doxygen
+// (define DUMUX_NO_DEFAULT_CO2TABLES to save the compile time if other tables,
+// e.g. the runtime-loaded BinaryCO2Tables, are used)
+#if !defined(DOXYGEN) && !defined(DUMUX_NO_DEFAULT_CO2TABLES) // hide tables from doxygen
 #include <dumux/material/components/co2tables.inc>
 #endif
 
@@ -0,0 +1,488 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup SpatialParameters
+ * \brief Element-wise parameter fields (e.g. permeability, porosity) read from memory-mapped binary files
+ *
+ * The binary field format consists of a header (see Detail::BinaryFieldHeader)
+ * followed by the data. Uncompressed fields store the values contiguously,
+ * entry by entry with all components of an entry next to each other.
+ * Compressed fields are split into chunks of a fixed number of entries that are
+ * compressed individually with zlib. The header is followed by a table of numChunks+1
+ * offsets (relative to the beginning of the chunk data) and the compressed chunks.
+ * Values are stored as 32-bit or 64-bit floating point numbers in native byte order.
+ */
+#ifndef DUMUX_MATERIAL_SPATIALPARAMS_MAPPED_ELEMENT_FIELD_HH
+#define DUMUX_MATERIAL_SPATIALPARAMS_MAPPED_ELEMENT_FIELD_HH
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define DUMUX_HAVE_MMAP 1
+#endif
+
+#if HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+
+namespace Dumux {
+
+namespace Detail {
+
+//! The header of a binary field file
+struct BinaryFieldHeader
+{
+    char magic[8] = {'D', 'U', 'M', 'U', 'X', 'F', 'L', 'D'};
+    std::uint32_t version = 1;
+    std::uint32_t valueSize = sizeof(double); //!< 4 (float) or 8 (double)
+    std::uint64_t numEntries = 0; //!< number of entries, e.g. elements of the (global) grid
+    std::uint32_t numComponents = 1; //!< values per entry (e.g. dim*dim for a full permeability tensor)
+    std::uint32_t compression = 0; //!< 0: raw, 1: zlib compressed chunks
+    std::uint64_t chunkSize = 0; //!< number of entries per compressed chunk
+};
+
+static_assert(sizeof(BinaryFieldHeader) == 40, "Unexpected padding in binary field header");
+
+} // end namespace Detail
+
+/*!
+ * \ingroup SpatialParameters
+ * \brief Read-only access to a binary field file
+ *
+ * The file is memory-mapped (if supported by the system) such that only the pages
+ * that are actually accessed are loaded and the page cache is shared by all processes
+ * on a node reading the same file. Raw files are accessed in place without any copy.
+ */
+class BinaryFieldFile
+{
+public:
+    using Header = Detail::BinaryFieldHeader;
+
+    /*!
+     * \brief Open a binary field file
+     * \param fileName the file name
+     */
+    explicit BinaryFieldFile(const std::string& fileName)
+    : fileName_(fileName)
+    {
+        map_();
+
+        if (size_ < sizeof(Header))
+            DUNE_THROW(Dune::IOError, "Binary field file " << fileName_ << " is too small");
+
+        std::memcpy(&header_, data_, sizeof(Header));
+        if (std::memcmp(header_.magic, Header{}.magic, sizeof(header_.magic)) != 0 || header_.version != 1)
+            DUNE_THROW(Dune::IOError, "File " << fileName_ << " is not a binary field file (or has an unsupported version)");
+        if (header_.valueSize != sizeof(float) && header_.valueSize != sizeof(double))
+            DUNE_THROW(Dune::IOError, "Unsupported value size " << header_.valueSize << " in " << fileName_);
+
+        if (isCompressed())
+        {
+#if !HAVE_ZLIB
+            DUNE_THROW(Dune::IOError, "Binary field file " << fileName_ << " is compressed but zlib was not found");
+#endif
+            if (header_.chunkSize == 0)
+                DUNE_THROW(Dune::IOError, "Invalid chunk size in " << fileName_);
+
+            chunkOffsets_ = data_ + sizeof(Header);
+            chunkData_ = chunkOffsets_ + (numChunks() + 1)*sizeof(std::uint64_t);
+            if (chunkData_ > data_ + size_ || chunkData_ + chunkOffset_(numChunks()) > data_ + size_)
+                DUNE_THROW(Dune::IOError, "Binary field file " << fileName_ << " is truncated");
+        }
+        else if (sizeof(Header) + header_.numEntries*header_.numComponents*header_.valueSize > size_)
+            DUNE_THROW(Dune::IOError, "Binary field file " << fileName_ << " is truncated");
+    }
+
+    BinaryFieldFile(const BinaryFieldFile&) = delete;
+    BinaryFieldFile& operator=(const BinaryFieldFile&) = delete;
+
+    ~BinaryFieldFile()
+    {
+#if DUMUX_HAVE_MMAP
+        if (data_)
+            munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    //! the number of entries
+    std::size_t numEntries() const
+    { return header_.numEntries; }
+
+    //! the number of components per entry
+    std::size_t numComponents() const
+    { return header_.numComponents; }
+
+    //! whether the data is compressed
+    bool isCompressed() const
+    { return header_.compression != 0; }
+
+    //! the number of entries per chunk (only compressed files are chunked)
+    std::size_t chunkSize() const
+    { return isCompressed() ? header_.chunkSize : header_.numEntries; }
+
+    //! the number of chunks
+    std::size_t numChunks() const
+    { return header_.numEntries > 0 ? (header_.numEntries + chunkSize() - 1)/chunkSize() : 0; }
+
+    /*!
+     * \brief Read a single value of a raw (uncompressed) file
+     * \param entryIdx the entry index (e.g. the global element index)
+     * \param compIdx the component index
+     */
+    template<class Scalar = double>
+    Scalar value(std::size_t entryIdx, std::size_t compIdx = 0) const
+    {
+        assert(!isCompressed());
+        assert(entryIdx < numEntries() && compIdx < numComponents());
+        return read_<Scalar>(data_ + sizeof(Header), entryIdx*header_.numComponents + compIdx);
+    }
+
+    /*!
+     * \brief Decompress a chunk of a compressed file
+     * \param chunkIdx the chunk index
+     * \param values the values of all entries in the chunk (all components)
+     */
+    template<class Scalar>
+    void readChunk(std::size_t chunkIdx, std::vector<Scalar>& values) const
+    {
+        const std::size_t firstEntry = chunkIdx*chunkSize();
+        const std::size_t numValues = std::min(chunkSize(), numEntries() - firstEntry)*numComponents();
+        values.resize(numValues);
+
+        if (!isCompressed())
+        {
+            for (std::size_t i = 0; i < numValues; ++i)
+                values[i] = read_<Scalar>(data_ + sizeof(Header), firstEntry*numComponents() + i);
+            return;
+        }
+
+#if HAVE_ZLIB
+        std::vector<char> buffer(numValues*header_.valueSize);
+        uLongf bufferSize = buffer.size();
+        const auto compressedSize = chunkOffset_(chunkIdx+1) - chunkOffset_(chunkIdx);
+        const auto* compressed = reinterpret_cast<const Bytef*>(chunkData_ + chunkOffset_(chunkIdx));
+        if (uncompress(reinterpret_cast<Bytef*>(buffer.data()), &bufferSize, compressed, compressedSize) != Z_OK
+            || bufferSize != buffer.size())
+            DUNE_THROW(Dune::IOError, "Decompressing chunk " << chunkIdx << " of " << fileName_ << " failed");
+
+        for (std::size_t i = 0; i < numValues; ++i)
+            values[i] = read_<Scalar>(buffer.data(), i);
+#endif
+    }
+
+private:
+    void map_()
+    {
+#if DUMUX_HAVE_MMAP
+        const int fd = open(fileName_.c_str(), O_RDONLY);
+        if (fd < 0)
+            DUNE_THROW(Dune::IOError, "Could not open binary field file " << fileName_);
+
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo) != 0)
+        {
+            close(fd);
+            DUNE_THROW(Dune::IOError, "Could not determine the size of " << fileName_);
+        }
+
+        size_ = fileInfo.st_size;
+        void* ptr = size_ > 0 ? mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+        close(fd);
+
+        if (ptr == MAP_FAILED)
+            DUNE_THROW(Dune::IOError, "Could not memory-map binary field file " << fileName_);
+
+        data_ = static_cast<const char*>(ptr);
+#else
+        // fallback: read the whole file into memory
+        std::ifstream file(fileName_, std::ios::binary);
+        if (!file)
+            DUNE_THROW(Dune::IOError, "Could not open binary field file " << fileName_);
+        fallbackStorage_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data_ = fallbackStorage_.data();
+        size_ = fallbackStorage_.size();
+#endif
+    }
+
+    std::uint64_t chunkOffset_(std::size_t i) const
+    {
+        std::uint64_t offset;
+        std::memcpy(&offset, chunkOffsets_ + i*sizeof(std::uint64_t), sizeof(std::uint64_t));
+        return offset;
+    }
+
+    template<class Scalar>
+    Scalar read_(const char* begin, std::size_t valueIdx) const
+    {
+        if (header_.valueSize == sizeof(float))
+        {
+            float v;
+            std::memcpy(&v, begin + valueIdx*sizeof(float), sizeof(float));
+            return v;
+        }
+        else
+        {
+            double v;
+            std::memcpy(&v, begin + valueIdx*sizeof(double), sizeof(double));
+            return v;
+        }
+    }
+
+    std::string fileName_;
+    Header header_;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    const char* chunkOffsets_ = nullptr;
+    const char* chunkData_ = nullptr;
+#if !DUMUX_HAVE_MMAP
+    std::vector<char> fallbackStorage_;
+#endif
+};
+
+/*!
+ * \ingroup SpatialParameters
+ * \brief Write a binary field file (see BinaryFieldFile)
+ * \param fileName the file name
+ * \param values the values (numEntries*numComponents values, entry by entry)
+ * \param numComponents the number of components per entry
+ * \param chunkSize if larger than zero, the data is split into chunks of chunkSize entries which are compressed with zlib
+ * \note The values are written with the precision of ValueType (float or double)
+ */
+template<class ValueType>
+void writeBinaryField(const std::string& fileName,
+                      const std::vector<ValueType>& values,
+                      std::size_t numComponents = 1,
+                      std::size_t chunkSize = 0)
+{
+    static_assert(std::is_same_v<ValueType, float> || std::is_same_v<ValueType, double>,
+                  "Binary fields can only store float or double values");
+
+    if (values.size() % numComponents != 0)
+        DUNE_THROW(Dune::InvalidStateException, "Number of values is not a multiple of the number of components");
+
+    Detail::BinaryFieldHeader header;
+    header.valueSize = sizeof(ValueType);
+    header.numEntries = values.size()/numComponents;
+    header.numComponents = numComponents;
+    header.compression = chunkSize > 0 ? 1 : 0;
+    header.chunkSize = chunkSize;
+
+    std::ofstream file(fileName, std::ios::binary);
+    if (!file)
+        DUNE_THROW(Dune::IOError, "Could not open " << fileName << " for writing");
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (chunkSize == 0)
+        file.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(ValueType));
+    else
+    {
+#if HAVE_ZLIB
+        const std::size_t numChunks = (header.numEntries + chunkSize - 1)/chunkSize;
+        std::vector<std::uint64_t> offsets(numChunks + 1, 0);
+        std::vector<std::vector<Bytef>> chunks(numChunks);
+        for (std::size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx)
+        {
+            const std::size_t begin = chunkIdx*chunkSize*numComponents;
+            const std::size_t end = std::min(values.size(), begin + chunkSize*numComponents);
+            const uLong sourceSize = (end - begin)*sizeof(ValueType);
+            uLongf compressedSize = compressBound(sourceSize);
+            chunks[chunkIdx].resize(compressedSize);
+            if (compress(chunks[chunkIdx].data(), &compressedSize,
+                         reinterpret_cast<const Bytef*>(values.data() + begin), sourceSize) != Z_OK)
+                DUNE_THROW(Dune::IOError, "Compressing chunk " << chunkIdx << " failed");
+            chunks[chunkIdx].resize(compressedSize);
+            offsets[chunkIdx+1] = offsets[chunkIdx] + compressedSize;
+        }
+
+        file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size()*sizeof(std::uint64_t));
+        for (const auto& chunk : chunks)
+            file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+#else
+        DUNE_THROW(Dune::IOError, "Writing compressed binary fields requires zlib");
+#endif
+    }
+
+    if (!file)
+        DUNE_THROW(Dune::IOError, "Writing binary field file " << fileName << " failed");
+}
+
+/*!
+ * \ingroup SpatialParameters
+ * \brief An element-wise parameter field (e.g. permeability or porosity) backed by a binary field file
+ *
+ * The entries of the file are indexed by a global element index (e.g. the element index
+ * in the unpartitioned mesh file or the lexicographic index of a structured grid cell)
+ * given by a user-defined function. Each process only stores data for its own elements:
+ *  - for raw files, only the global index of each local element is stored and the values are
+ *    read from the memory-mapped file (shared by all processes on a node),
+ *  - for compressed files, only the chunks containing local elements are decompressed and
+ *    only the values of the local elements are kept.
+ *
+ * Usage in the spatial parameters, e.g.
+ * \code
+ * MappedElementField<GridView> permeability_(fileName, gridView, elementMapper, globalElementIndex);
+ * PermeabilityType permeability(const Element& element, ...) const
+ * { return permeability_.value(element); }
+ * \endcode
+ */
+template<class GridView, class Scalar = double>
+class MappedElementField
+{
+    using Element = typename GridView::template Codim<0>::Entity;
+    using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<GridView>;
+
+public:
+    //! The signature of the function returning the global (file) index of an element
+    using GlobalIndexFunction = std::function<std::size_t(const Element&)>;
+
+    /*!
+     * \brief Constructor
+     * \param fileName the binary field file
+     * \param gridView the grid view
+     * \param elementMapper maps elements of the given grid view
+     * \param globalIndex returns the index of an element's entry in the file
+     */
+    MappedElementField(const std::string& fileName,
+                       const GridView& gridView,
+                       const ElementMapper& elementMapper,
+                       const GlobalIndexFunction& globalIndex)
+    : file_(std::make_shared<BinaryFieldFile>(fileName))
+    , elementMapper_(elementMapper)
+    { update(gridView, globalIndex); }
+
+    /*!
+     * \brief Constructor for sequential runs where the file is indexed by the element mapper
+     */
+    MappedElementField(const std::string& fileName,
+                       const GridView& gridView,
+                       const ElementMapper& elementMapper)
+    : MappedElementField(fileName, gridView, elementMapper,
+                         [&elementMapper](const Element& e){ return elementMapper.index(e); })
+    {
+        if (gridView.comm().size() > 1)
+            DUNE_THROW(Dune::InvalidStateException, "In parallel, a global element index function has to be provided");
+    }
+
+    /*!
+     * \brief Update the local data (e.g. after grid adaption or load balancing)
+     */
+    void update(const GridView& gridView, const GlobalIndexFunction& globalIndex)
+    {
+        const std::size_t numLocalElements = gridView.size(0);
+        std::vector<std::size_t> globalIndices(numLocalElements);
+        for (const auto& element : elements(gridView))
+        {
+            const auto gIdx = globalIndex(element);
+            if (gIdx >= file_->numEntries())
+                DUNE_THROW(Dune::RangeError, "Global element index " << gIdx << " exceeds the size of the binary field");
+            globalIndices[elementMapper_.index(element)] = gIdx;
+        }
+
+        numComponents_ = file_->numComponents();
+        if (!file_->isCompressed())
+        {
+            globalIndices_ = std::move(globalIndices);
+            values_.clear();
+            return;
+        }
+
+        // decompress each chunk containing local elements once and extract the local values
+        std::vector<std::size_t> order(numLocalElements);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](auto i, auto j){ return globalIndices[i] < globalIndices[j]; });
+
+        values_.resize(numLocalElements*numComponents_);
+        const auto chunkSize = file_->chunkSize();
+        std::vector<Scalar> chunk;
+        std::size_t currentChunk = file_->numChunks();
+        for (const auto eIdx : order)
+        {
+            const auto gIdx = globalIndices[eIdx];
+            if (gIdx/chunkSize != currentChunk)
+            {
+                currentChunk = gIdx/chunkSize;
+                file_->readChunk(currentChunk, chunk);
+            }
+
+            const auto offset = (gIdx - currentChunk*chunkSize)*numComponents_;
+            std::copy_n(chunk.begin() + offset, numComponents_, values_.begin() + eIdx*numComponents_);
+        }
+
+        globalIndices_.clear();
+        globalIndices_.shrink_to_fit();
+    }
+
+    //! the value of the given component for an element
+    Scalar value(const Element& element, std::size_t compIdx = 0) const
+    {
+        assert(compIdx < numComponents_);
+        const auto eIdx = elementMapper_.index(element);
+        if (file_->isCompressed())
+            return values_[eIdx*numComponents_ + compIdx];
+        else
+            return file_->template value<Scalar>(globalIndices_[eIdx], compIdx);
+    }
+
+    //! all values for an element (e.g. the entries of a permeability tensor in row-major order)
+    template<int size>
+    Dune::FieldVector<Scalar, size> values(const Element& element) const
+    {
+        assert(size == numComponents_);
+        Dune::FieldVector<Scalar, size> result;
+        for (int i = 0; i < size; ++i)
+            result[i] = value(element, i);
+        return result;
+    }
+
+    //! the number of components per element
+    std::size_t numComponents() const
+    { return numComponents_; }
+
+private:
+    std::shared_ptr<const BinaryFieldFile> file_;
+    const ElementMapper& elementMapper_;
+    std::size_t numComponents_ = 1;
+    std::vector<std::size_t> globalIndices_; //!< file index of each local element (raw files)
+    std::vector<Scalar> values_; //!< values of the local elements (compressed files)
+};
+
+} // end namespace Dumux
+
+#endif
@@ -28,6 +28,7 @@
 #include <memory>
 #include <tuple>
 #include <vector>
+#include <type_traits>
 #include <dune/common/exceptions.hh>
 #include <dune/common/indices.hh>
 #include <dune/common/shared_ptr.hh>
@@ -397,6 +398,18 @@ private:
     ProblemPtrs problems_;
 };
 
+/*!
+ * \ingroup MultiDomain
+ * \brief Trait specifying whether a coupling manager can be used with multithreaded assembly
+ *
+ * During multithreaded assembly, elements that do not share any degree of freedom (including
+ * the dofs of their coupling stencils) are assembled concurrently. A coupling manager supporting
+ * this must not keep element-specific data in a single shared coupling context, i.e. it has to
+ * keep per-thread contexts or only modify the solution entries of the coupling stencil.
+ */
+template<class CouplingManager>
+struct CouplingManagerSupportsMultithreadedAssembly : public std::false_type {};
+
 } // end namespace Dumux
 
 #endif
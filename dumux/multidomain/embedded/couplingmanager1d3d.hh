@@ -43,4 +43,17 @@ class Embedded1d3dCouplingManager;
 #include <dumux/multidomain/embedded/couplingmanager1d3d_kernel.hh>
 #include <dumux/multidomain/embedded/couplingmanager1d3d_projection.hh>
 
+namespace Dumux {
+
+/*!
+ * \ingroup EmbeddedCoupling
+ * \brief The embedded coupling managers have no element coupling context (point sources are
+ *        precomputed), so they can be used with multithreaded assembly.
+ */
+template<class MDTraits, class CouplingMode>
+struct CouplingManagerSupportsMultithreadedAssembly<Embedded1d3dCouplingManager<MDTraits, CouplingMode>>
+: public std::true_type {};
+
+} // end namespace Dumux
+
 #endif
@@ -36,6 +36,7 @@
 #include <dune/geometry/type.hh>
 
 #include <dumux/common/indextraits.hh>
+#include <dumux/io/grid/gmshreader.hh>
 
 namespace Dumux {
 
@@ -91,6 +92,99 @@ public:
     {
         Dune::Timer watch;
         if (verbose) std::cout << "Opening " << fileName << std::endl;
+
+        // files in format version 4.1 are read with the (parallel) gmsh 4 reader
+        if (Gmsh4Reader::fileVersion(fileName) >= 4)
+            readGmsh4_(fileName, boundarySegThresh);
+        else
+            readGmsh2_(fileName, boundarySegThresh);
+
+        if (verbose)
+        {
+            std::cout << "Finished reading gmsh file" << std::endl;
+            for (std::size_t id = 0; id < numGrids; ++id)
+            {
+                std::cout << elementData_[id].size() << " "
+                          << bulkDim-id << "-dimensional elements comprising of "
+                          << vertexIndices_[id].size() << " vertices";
+                if (id < numGrids-1) std::cout << "," << std::endl;
+            }
+            std::cout << " have been read in " << watch.elapsed() << " seconds." << std::endl;
+        }
+    }
+
+    //! Returns the vector with all grid vertices (entire hierarchy)
+    const std::vector<GlobalPosition>& gridVertices() const
+    { return gridVertices_; }
+
+    //! Returns a grid's vertex indices
+    VertexIndexSet& vertexIndices(std::size_t id)
+    {
+        assert(id < numGrids && "Index exceeds number of grids provided");
+        return vertexIndices_[id];
+    }
+
+    //! Returns the vector of read elements for a grid
+    const std::vector<ElementData>& elementData(std::size_t id) const
+    {
+        assert(id < numGrids && "Index exceeds number of grids provided");
+        return elementData_[id];
+    }
+
+    //! Returns the vector of read elements for a grid
+    const std::vector<VertexIndexSet>& boundarySegmentData(std::size_t id) const
+    {
+        assert(id < numGrids && "Index exceeds number of grids provided");
+        return boundarySegments_[id];
+    }
+
+    //! Returns the maps of element markers
+    std::vector<int>& elementMarkerMap(std::size_t id)
+    {
+        assert(id < numGrids && "Index exceeds number of grids provided");
+        return elementMarkerMaps_[id];
+    }
+
+    //! Returns the maps of domain markers
+    std::vector<int>& boundaryMarkerMap(std::size_t id)
+    {
+        assert(id < numGrids && "Index exceeds number of grids provided");
+        return boundaryMarkerMaps_[id];
+    }
+
+    //! Returns the maps of the embedded entities
+    std::unordered_map< GridIndexType, std::vector<GridIndexType> >& embeddedEntityMap(std::size_t id)
+    {
+        assert(id < numGrids && "Index exceeds number of grids provided");
+        return embeddedEntityMaps_[id];
+    }
+
+    //! Returns the maps of the embedments
+    std::unordered_map< GridIndexType, std::vector<GridIndexType> >& adjoinedEntityMap(std::size_t id)
+    {
+        assert(id < numGrids && "Index exceeds number of grids provided");
+        return adjoinedEntityMaps_[id];
+    }
+
+private:
+    //! Maps the indices of the vertices in the file to the vertex indices of the grids
+    struct VertexMaps
+    {
+        explicit VertexMaps(std::size_t numVertices)
+        {
+            std::fill(gridVertexCount.begin(), gridVertexCount.end(), 0);
+            std::fill(gridVertexMap.begin(), gridVertexMap.end(), std::vector<GridIndexType>(numVertices));
+            std::fill(idxIsAssigned.begin(), idxIsAssigned.end(), std::vector<bool>(numVertices, false));
+        }
+
+        std::array<std::size_t, numGrids> gridVertexCount;
+        std::array<std::vector<GridIndexType>, numGrids> gridVertexMap;
+        std::array<std::vector<bool>, numGrids> idxIsAssigned;
+    };
+
+    //! Reads the data from a mesh file in format version 2
+    void readGmsh2_(const std::string& fileName, std::size_t boundarySegThresh)
+    {
         std::ifstream gridFile(fileName);
         if (gridFile.fail())
             DUNE_THROW(Dune::InvalidStateException, "Could not open the given .msh file. Make sure it exists");
@@ -144,19 +238,9 @@ public:
         std::getline(gridFile, line);
         const auto numElements = convertString<std::size_t>(line);
 
-        // keep track of number of elements
-        std::array<std::size_t, numGrids> elementCount;
-        std::fill(elementCount.begin(), elementCount.end(), 0);
-
-        // Construct maps that map bulk grid vertex
-        // indices to lowDim vertex indices. -1 indicates non-initialized status
+        // maps from bulk grid vertex indices to lowDim vertex indices
         std::size_t elemCount = 0;
-        std::array<std::size_t, numGrids> gridVertexCount;
-        std::array<std::vector<GridIndexType>, numGrids> gridVertexMap;
-        std::array<std::vector<bool>, numGrids> idxIsAssigned;
-        std::fill(gridVertexCount.begin(), gridVertexCount.end(), 0);
-        std::fill(gridVertexMap.begin(), gridVertexMap.end(), std::vector<GridIndexType>(vertexCount));
-        std::fill(idxIsAssigned.begin(), idxIsAssigned.end(), std::vector<bool>(vertexCount, false));
+        VertexMaps vertexMaps(vertexCount);
         std::getline(gridFile, line);
         while (line.find("$EndElements") == std::string::npos)
         {
@@ -167,83 +251,11 @@ public:
             while (stream >> buf) lineData.push_back(convertString<std::size_t>(buf));
             assert(lineData.size() >= 4 && "Grid format erroneous or unsupported");
 
-            // obtain geometry type
-            const auto gt = obtainGeometryType( lineData[1] );
-            const std::size_t physicalIndex = lineData[3];
-            const auto geoDim = gt.dim();
-            const bool isBoundarySeg = geoDim != bulkDim && physicalIndex < boundarySegThresh;
-            if (geoDim >= minGridDim-1)
-            {
-                // insert boundary segment
-                if ((isBoundarySeg || geoDim == minGridDim-1))
-                {
-                    const unsigned int nextLevelGridIdx = bulkDim-geoDim-1;
-
-                    VertexIndexSet corners;
-                    auto it = lineData.begin()+2+lineData[2]+1;
-                    for (; it != lineData.end(); ++it)
-                    {
-                        *it -= 1; // gmsh indices start from 1
-
-                        // insert map if vertex is not inserted yet
-                        if (!idxIsAssigned[nextLevelGridIdx][*it])
-                        {
-                            gridVertexMap[nextLevelGridIdx][*it] = gridVertexCount[nextLevelGridIdx]++;
-                            idxIsAssigned[nextLevelGridIdx][*it] = true;
-                            vertexIndices_[nextLevelGridIdx].push_back(*it);
-                        }
-
-                        corners.push_back(gridVertexMap[nextLevelGridIdx][*it]);
-                    }
-
-                    // marker = physical entity index
-                    boundaryMarkerMaps_[nextLevelGridIdx].push_back(physicalIndex);
-                    boundarySegments_[nextLevelGridIdx].push_back(corners);
-                }
-
-                // insert element
-                else
-                {
-                    const unsigned int gridIdx = bulkDim-geoDim;
-
-                    VertexIndexSet corners;
-                    auto it = lineData.begin()+2+lineData[2]+1;
-                    for (; it != lineData.end(); ++it)
-                    {
-                        *it -= 1; // gmsh indices start from 1
-
-                        // insert map if vertex is not inserted yet
-                        if (!idxIsAssigned[gridIdx][*it])
-                        {
-                            gridVertexMap[gridIdx][*it] = gridVertexCount[gridIdx]++;
-                            idxIsAssigned[gridIdx][*it] = true;
-                            vertexIndices_[gridIdx].push_back(*it);
-                        }
-
-                        corners.push_back(gridVertexMap[gridIdx][*it]);
-                    }
-
-                    // add data to embedments/embeddings
-                    if (geoDim > minGridDim)
-                    {
-                        const auto gridElemCount = elementData_[gridIdx].size();
-                        const auto& embeddedVIndices = vertexIndices_[gridIdx+1];
-                        const auto& embeddedIndicesAssigned = idxIsAssigned[gridIdx+1];
-
-                        VertexIndexSet cornerIndicesGlobal(corners.size());
-                        for (unsigned int i = 0; i < corners.size(); ++i)
-                            cornerIndicesGlobal[i] = vertexIndices_[gridIdx][corners[i]];
-                        addEmbeddings(cornerIndicesGlobal, gridIdx, gridElemCount, embeddedVIndices, embeddedIndicesAssigned);
-                    }
-
-                    // ensure dune-specific corner ordering
-                    reorder(gt, corners);
-
-                    // insert element data to grid's container
-                    elementMarkerMaps_[gridIdx].push_back(physicalIndex);
-                    elementData_[gridIdx].emplace_back(ElementData({gt, corners}));
-                }
-            }
+            // insert the element (gmsh indices start from 1)
+            VertexIndexSet vertexIndices(lineData.begin()+2+lineData[2]+1, lineData.end());
+            for (auto& idx : vertexIndices)
+                idx -= 1;
+            insertElement_(obtainGeometryType(lineData[1]), lineData[3], vertexIndices, boundarySegThresh, vertexMaps);
 
             // get next line
             std::getline(gridFile, line);
@@ -253,75 +265,115 @@ public:
         // make sure we read all elements
         if (elemCount != numElements)
             DUNE_THROW(Dune::InvalidStateException, "Didn't read as many elements as stated in the .msh file");
+    }
 
-        if (verbose)
+    //! Reads the data from a mesh file in format version 4.1
+    void readGmsh4_(const std::string& fileName, std::size_t boundarySegThresh)
+    {
+        const auto data = Gmsh4Reader::read(fileName);
+
+        gridVertices_.resize(data.numNodes());
+        for (std::size_t i = 0; i < data.numNodes(); ++i)
+            for (int dir = 0; dir < bulkDimWorld; ++dir)
+                gridVertices_[i][dir] = data.nodes[i][dir];
+
+        // elements are processed in the order of the file, i.e. with ascending dimension
+        VertexMaps vertexMaps(data.numNodes());
+        VertexIndexSet vertexIndices;
+        for (std::size_t i = 0; i < data.numElements(); ++i)
         {
-            std::cout << "Finished reading gmsh file" << std::endl;
-            for (std::size_t id = 0; id < numGrids; ++id)
-            {
-                std::cout << elementData_[id].size() << " "
-                          << bulkDim-id << "-dimensional elements comprising of "
-                          << gridVertexCount[id] << " vertices";
-                if (id < numGrids-1) std::cout << "," << std::endl;
-            }
-            std::cout << " have been read in " << watch.elapsed() << " seconds." << std::endl;
+            vertexIndices.resize(data.numElementNodes(i));
+            for (std::size_t j = 0; j < vertexIndices.size(); ++j)
+                vertexIndices[j] = data.elementNode(i, j);
+            insertElement_(obtainGeometryType(data.elementTypes[i]), data.physicalTags[i], vertexIndices, boundarySegThresh, vertexMaps);
         }
     }
 
-    //! Returns the vector with all grid vertices (entire hierarchy)
-    const std::vector<GlobalPosition>& gridVertices() const
-    { return gridVertices_; }
-
-    //! Returns a grid's vertex indices
-    VertexIndexSet& vertexIndices(std::size_t id)
+    /*!
+     * \brief Inserts an element of the file into the grid it belongs to (or as boundary segment)
+     * \param gt the geometry type of the element
+     * \param physicalIndex the physical entity index of the element
+     * \param vertexIndices the indices of the vertices of the element (starting from 0)
+     * \param boundarySegThresh physical entity indices below this threshold mark boundary segments
+     * \param vertexMaps the maps from the vertex indices in the file to the grid vertex indices
+     */
+    void insertElement_(const Dune::GeometryType& gt, std::size_t physicalIndex, const VertexIndexSet& vertexIndices,
+                        std::size_t boundarySegThresh, VertexMaps& vertexMaps)
     {
-        assert(id < numGrids && "Index exceeds number of grids provided");
-        return vertexIndices_[id];
-    }
+        auto& gridVertexCount = vertexMaps.gridVertexCount;
+        auto& gridVertexMap = vertexMaps.gridVertexMap;
+        auto& idxIsAssigned = vertexMaps.idxIsAssigned;
 
-    //! Returns the vector of read elements for a grid
-    const std::vector<ElementData>& elementData(std::size_t id) const
-    {
-        assert(id < numGrids && "Index exceeds number of grids provided");
-        return elementData_[id];
-    }
+        const auto geoDim = gt.dim();
+        const bool isBoundarySeg = geoDim != bulkDim && physicalIndex < boundarySegThresh;
+        if (geoDim >= minGridDim-1)
+        {
+            // insert boundary segment
+            if ((isBoundarySeg || geoDim == minGridDim-1))
+            {
+                const unsigned int nextLevelGridIdx = bulkDim-geoDim-1;
 
-    //! Returns the vector of read elements for a grid
-    const std::vector<VertexIndexSet>& boundarySegmentData(std::size_t id) const
-    {
-        assert(id < numGrids && "Index exceeds number of grids provided");
-        return boundarySegments_[id];
-    }
+                VertexIndexSet corners;
+                for (const auto vIdx : vertexIndices)
+                {
+                    // insert map if vertex is not inserted yet
+                    if (!idxIsAssigned[nextLevelGridIdx][vIdx])
+                    {
+                        gridVertexMap[nextLevelGridIdx][vIdx] = gridVertexCount[nextLevelGridIdx]++;
+                        idxIsAssigned[nextLevelGridIdx][vIdx] = true;
+                        vertexIndices_[nextLevelGridIdx].push_back(vIdx);
+                    }
 
-    //! Returns the maps of element markers
-    std::vector<int>& elementMarkerMap(std::size_t id)
-    {
-        assert(id < numGrids && "Index exceeds number of grids provided");
-        return elementMarkerMaps_[id];
-    }
+                    corners.push_back(gridVertexMap[nextLevelGridIdx][vIdx]);
+                }
 
-    //! Returns the maps of domain markers
-    std::vector<int>& boundaryMarkerMap(std::size_t id)
-    {
-        assert(id < numGrids && "Index exceeds number of grids provided");
-        return boundaryMarkerMaps_[id];
-    }
+                // marker = physical entity index
+                boundaryMarkerMaps_[nextLevelGridIdx].push_back(physicalIndex);
+                boundarySegments_[nextLevelGridIdx].push_back(corners);
+            }
 
-    //! Returns the maps of the embedded entities
-    std::unordered_map< GridIndexType, std::vector<GridIndexType> >& embeddedEntityMap(std::size_t id)
-    {
-        assert(id < numGrids && "Index exceeds number of grids provided");
-        return embeddedEntityMaps_[id];
-    }
+            // insert element
+            else
+            {
+                const unsigned int gridIdx = bulkDim-geoDim;
 
-    //! Returns the maps of the embedments
-    std::unordered_map< GridIndexType, std::vector<GridIndexType> >& adjoinedEntityMap(std::size_t id)
-    {
-        assert(id < numGrids && "Index exceeds number of grids provided");
-        return adjoinedEntityMaps_[id];
+                VertexIndexSet corners;
+                for (const auto vIdx : vertexIndices)
+                {
+                    // insert map if vertex is not inserted yet
+                    if (!idxIsAssigned[gridIdx][vIdx])
+                    {
+                        gridVertexMap[gridIdx][vIdx] = gridVertexCount[gridIdx]++;
+                        idxIsAssigned[gridIdx][vIdx] = true;
+                        vertexIndices_[gridIdx].push_back(vIdx);
+                    }
+
+                    corners.push_back(gridVertexMap[gridIdx][vIdx]);
+                }
+
+                // add data to embedments/embeddings
+                if (geoDim > minGridDim)
+                {
+                    const auto gridElemCount = elementData_[gridIdx].size();
+                    const auto& embeddedVIndices = vertexIndices_[gridIdx+1];
+                    const auto& embeddedIndicesAssigned = idxIsAssigned[gridIdx+1];
+
+                    VertexIndexSet cornerIndicesGlobal(corners.size());
+                    for (unsigned int i = 0; i < corners.size(); ++i)
+                        cornerIndicesGlobal[i] = vertexIndices_[gridIdx][corners[i]];
+                    addEmbeddings(cornerIndicesGlobal, gridIdx, gridElemCount, embeddedVIndices, embeddedIndicesAssigned);
+                }
+
+                // ensure dune-specific corner ordering
+                reorder(gt, corners);
+
+                // insert element data to grid's container
+                elementMarkerMaps_[gridIdx].push_back(physicalIndex);
+                elementData_[gridIdx].emplace_back(ElementData({gt, corners}));
+            }
+        }
     }
 
-private:
     //! converts a value contained in a string
     template<class T>
     T convertString(const std::string& string) const
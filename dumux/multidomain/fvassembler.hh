@@ -28,18 +28,30 @@
 
 #include <type_traits>
 #include <tuple>
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iostream>
 
+#include <dune/common/exceptions.hh>
 #include <dune/common/hybridutilities.hh>
 #include <dune/istl/matrixindexset.hh>
 
 #include <dumux/common/properties.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/exceptions.hh>
+#include <dumux/common/arenaallocator.hh>
 #include <dumux/common/timeloop.hh>
+#include <dumux/common/gridcapabilities.hh>
 #include <dumux/common/typetraits/utility.hh>
 #include <dumux/discretization/method.hh>
 #include <dumux/assembly/diffmethod.hh>
 #include <dumux/assembly/jacobianpattern.hh>
 #include <dumux/linear/parallelhelpers.hh>
+#include <dumux/parallel/parallel_for.hh>
 
+#include "couplingmanager.hh"
 #include "couplingjacobianpattern.hh"
 #include "subdomaincclocalassembler.hh"
 #include "subdomainboxlocalassembler.hh"
@@ -55,6 +67,18 @@ namespace Dumux {
  * \ingroup Assembly
  * \brief A linear system assembler (residual and Jacobian) for finite volume schemes (box, tpfa, mpfa, ...)
  *        with multiple domains
+ *
+ * If the parameter Assembly.Multithreading is enabled (default: false), all sub-domains are discretized
+ * with box or cctpfa, the coupling manager supports it (see CouplingManagerSupportsMultithreadedAssembly)
+ * and the grids are thread-safe, the elements of all sub-domains are assembled concurrently.
+ * The elements are grouped into colors such that elements of the same color do not share any degree
+ * of freedom of any sub-domain (as given by the sparsity pattern including the coupling blocks).
+ * Elements of one color (possibly of different sub-domains) are assembled in parallel.
+ *
+ * \note Coupling managers that keep a single mutable coupling context bound in bindCouplingContext
+ *       (e.g. the Stokes-Darcy, free-flow and facet coupling managers) do not support this and are
+ *       always assembled serially. Per-thread coupling contexts are not implemented for them.
+ *
  * \tparam MDTraits the multidimension traits
  * \tparam diffMethod the differentiation method to residual compute derivatives
  * \tparam useImplicitAssembly if to use an implicit or explicit time discretization
@@ -140,6 +164,18 @@ private:
     template<std::size_t id>
     using SubDomainAssembler = typename SubDomainAssemblerType<typename GridGeometry<id>::DiscretizationMethod, id>::type;
 
+    static constexpr std::size_t numSubDomains = JacobianMatrix::N();
+
+    // elements can be colored if the local assembly only writes to and deflects dofs in the Jacobian pattern
+    template<std::size_t... i>
+    static constexpr bool supportsMultithreading_(std::index_sequence<i...>)
+    {
+        return ((GridGeometry<i>::discMethod == DiscretizationMethods::cctpfa
+                 || GridGeometry<i>::discMethod == DiscretizationMethods::box) && ...)
+               && (Detail::supportsMultithreading<typename GridGeometry<i>::GridView::Grid> && ...)
+               && CouplingManagerSupportsMultithreadedAssembly<CouplingManager>::value;
+    }
+
 public:
 
 
@@ -162,6 +198,7 @@ public:
     {
         static_assert(isImplicit(), "Explicit assembler for stationary problem doesn't make sense!");
         std::cout << "Instantiated assembler for a stationary problem." << std::endl;
+        setMultithreading_();
     }
 
     /*!
@@ -185,6 +222,7 @@ public:
     , warningIssued_(false)
     {
         std::cout << "Instantiated assembler for an instationary problem." << std::endl;
+        setMultithreading_();
     }
 
     /*!
@@ -198,11 +236,21 @@ public:
         resetResidual_();
 
         using namespace Dune::Hybrid;
+        if (enableMultithreading_)
+        {
+            assembleMultithreaded_([&](const auto domainId, const auto& element)
+            {
+                SubDomainAssembler<domainId> subDomainAssembler(*this, element, curSol, *couplingManager_);
+                subDomainAssembler.assembleJacobianAndResidual((*jacobian_)[domainId], (*residual_)[domainId], gridVariablesTuple_);
+            });
+        }
+
         forEach(std::make_index_sequence<JacobianMatrix::N()>(), [&](const auto domainId)
         {
             auto& jacRow = (*jacobian_)[domainId];
             auto& subRes = (*residual_)[domainId];
-            this->assembleJacobianAndResidual_(domainId, jacRow, subRes, curSol);
+            if (!enableMultithreading_)
+                this->assembleJacobianAndResidual_(domainId, jacRow, subRes, curSol);
 
             const auto gridGeometry = std::get<domainId>(gridGeometryTuple_);
             enforcePeriodicConstraints_(domainId, jacRow, subRes, *gridGeometry, curSol[domainId]);
@@ -226,6 +274,17 @@ public:
         // update the grid variables for the case of active caching
         updateGridVariables(curSol);
 
+        // the coloring requires the Jacobian pattern
+        if (enableMultithreading_ && jacobian_)
+        {
+            assembleMultithreaded_([&](const auto domainId, const auto& element)
+            {
+                SubDomainAssembler<domainId> subDomainAssembler(*this, element, curSol, *couplingManager_);
+                subDomainAssembler.assembleResidual(r[domainId]);
+            });
+            return;
+        }
+
         using namespace Dune::Hybrid;
         forEach(integralRange(Dune::Hybrid::size(r)), [&](const auto domainId)
         {
@@ -351,6 +410,10 @@ public:
                 pattern.exportIdx(jac[domainI][domainJ]);
             });
         });
+
+        // the element coloring depends on the pattern
+        if (enableMultithreading_)
+            computeColoring_(jac);
     }
 
     /*!
@@ -449,6 +512,12 @@ public:
     bool isStationaryProblem() const
     { return isStationaryProblem_; }
 
+    /*!
+     * \brief Whether the elements are assembled concurrently (see the class documentation)
+     */
+    bool isMultithreaded() const
+    { return enableMultithreading_; }
+
     /*!
      * \brief Create a local residual object (used by the local assembler)
      */
@@ -519,18 +588,151 @@ private:
         });
     }
 
+    void setMultithreading_()
+    {
+        enableMultithreading_ = supportsMultithreading_(std::make_index_sequence<numSubDomains>())
+                                && maxNumThreads() > 1
+                                && getParam<bool>("Assembly.Multithreading", false);
+    }
+
+    /*!
+     * \brief Color the elements of all sub-domains such that elements of the same color
+     *        do not share any degree of freedom of any sub-domain
+     *
+     * The degrees of freedom touched by the assembly of an element are the dofs of the element
+     * (the rows of the Jacobian written to) and all dofs these rows depend on (the columns of these rows
+     * in all blocks, i.e. all dofs that are deflected or read including the coupling stencils).
+     * Elements are colored greedily in the order of the sub-domains.
+     */
+    void computeColoring_(const JacobianMatrix& jac) const
+    {
+        using namespace Dune::Hybrid;
+
+        // offsets to number the dofs of all sub-domains consecutively
+        std::array<std::size_t, numSubDomains+1> dofOffset{};
+        forEach(std::make_index_sequence<numSubDomains>(), [&](const auto domainId)
+        { dofOffset[domainId+1] = dofOffset[domainId] + this->numDofs(domainId); });
+
+        std::vector<std::vector<int>> colorsOfDof(dofOffset.back());
+        std::vector<char> colorUsed;
+        std::vector<std::size_t> touchedDofs;
+        elementSets_.clear();
+
+        forEach(std::make_index_sequence<numSubDomains>(), [&](const auto domainI)
+        {
+            const auto& gg = this->gridGeometry(domainI);
+            auto fvGeometry = localView(gg);
+            for (const auto& element : elements(gg.gridView()))
+            {
+                touchedDofs.clear();
+                fvGeometry.bindElement(element);
+                for (const auto& scv : scvs(fvGeometry))
+                {
+                    const auto row = scv.dofIndex();
+                    touchedDofs.push_back(dofOffset[domainI] + row);
+                    forEach(integralRange(Dune::Hybrid::size(jac[domainI])), [&](const auto domainJ)
+                    {
+                        const auto& jacRow = jac[domainI][domainJ][row];
+                        for (auto it = jacRow.begin(); it != jacRow.end(); ++it)
+                            touchedDofs.push_back(dofOffset[domainJ] + it.index());
+                    });
+                }
+
+                std::sort(touchedDofs.begin(), touchedDofs.end());
+                touchedDofs.erase(std::unique(touchedDofs.begin(), touchedDofs.end()), touchedDofs.end());
+
+                // the smallest color not used by any element touching the same dofs
+                std::fill(colorUsed.begin(), colorUsed.end(), false);
+                for (const auto dof : touchedDofs)
+                    for (const auto color : colorsOfDof[dof])
+                        colorUsed[color] = true;
+
+                const std::size_t color = std::distance(colorUsed.begin(), std::find(colorUsed.begin(), colorUsed.end(), false));
+                if (color == elementSets_.size())
+                {
+                    elementSets_.emplace_back();
+                    colorUsed.push_back(false);
+                }
+
+                for (const auto dof : touchedDofs)
+                    colorsOfDof[dof].push_back(color);
+
+                elementSets_[color].emplace_back(domainI, gg.elementMapper().index(element));
+            }
+        });
+    }
+
+    /*!
+     * \brief Assemble all elements of all sub-domains, elements of the same color concurrently
+     * \param assembleElement functor called as assembleElement(domainId, element)
+     * \note Handles exceptions for parallel runs
+     * \throws NumericalProblem on all processes if something throwed during assembly
+     */
+    template<class AssembleElementFunc>
+    void assembleMultithreaded_(AssembleElementFunc&& assembleElement) const
+    {
+        if (elementSets_.empty())
+            computeColoring_(*jacobian_);
+
+        // a state that will be checked on all processes
+        const auto& comm = gridView(Dune::index_constant<0>()).comm();
+        bool succeeded = false;
+
+        // try assembling using the local assembly function
+        // (parallelFor rethrows the first exception thrown on any thread)
+        try
+        {
+            for (const auto& elementSet : elementSets_)
+            {
+                parallelFor(elementSet.size(), [&](const std::size_t k)
+                {
+                    // temporaries of the element are taken from the arena of the executing thread
+                    ArenaScope arenaScope;
+                    const auto [domainIdx, eIdx] = elementSet[k];
+                    Dune::Hybrid::forEach(std::make_index_sequence<numSubDomains>(), [&](const auto domainId)
+                    {
+                        if (domainId == domainIdx)
+                            assembleElement(domainId, this->gridGeometry(domainId).element(eIdx));
+                    });
+                });
+            }
+
+            // if we get here, everything worked well on this process
+            succeeded = true;
+        }
+        // throw exception if a problem ocurred
+        catch (NumericalProblem &e)
+        {
+            std::cout << "rank " << comm.rank()
+                      << " caught an exception while assembling:" << e.what()
+                      << "\n";
+            succeeded = false;
+        }
+
+        // make sure everything worked well on all processes
+        if (comm.size() > 1)
+            succeeded = comm.min(succeeded);
+
+        // if not succeeded rethrow the error on all processes
+        if (!succeeded)
+            DUNE_THROW(NumericalProblem, "A process did not succeed in linearizing the system");
+    }
+
     /*!
      * \brief A method assembling something per element
      * \note Handles exceptions for parallel runs
      * \throws NumericalProblem on all processes if something throwed during assembly
-     * TODO: assemble in parallel
      */
     template<std::size_t i, class AssembleElementFunc>
     void assemble_(Dune::index_constant<i> domainId, AssembleElementFunc&& assembleElement) const
     {
         // let the local assembler add the element contributions
+        // temporaries of the element (local views using an ArenaAllocator) are taken from the arena
         for (const auto& element : elements(gridView(domainId)))
+        {
+            ArenaScope arenaScope;
             assembleElement(element);
+        }
     }
 
     // get diagonal block pattern
@@ -620,6 +822,12 @@ private:
 
     //! Issue a warning if the calculation is used in parallel with overlap. This could be a static local variable if it wasn't for g++7 yielding a linker error.
     bool warningIssued_;
+
+    //! if multithreaded assembly is enabled
+    bool enableMultithreading_ = false;
+
+    //! the elements (sub-domain index and element index) of each color for multithreaded assembly
+    mutable std::vector<std::vector<std::pair<std::size_t, std::size_t>>> elementSets_;
 };
 
 } // end namespace Dumux
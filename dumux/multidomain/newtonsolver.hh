@@ -83,8 +83,9 @@ public:
         forEach(std::make_index_sequence<Assembler::Traits::numSubDomains>{}, [&](auto&& id)
         {
             const int priVarSwitchVerbosity = getParamFromGroup<int>(paramGroup, "PrimaryVariableSwitch.Verbosity", 1);
+            const bool priVarSwitchMultithreading = getParamFromGroup<bool>(paramGroup, "PrimaryVariableSwitch.Multithreading", false);
             using PVSwitch = PrimaryVariableSwitch<std::decay_t<decltype(id)>::value>;
-            elementAt(priVarSwitches_, id) = std::make_unique<PVSwitch>(priVarSwitchVerbosity);
+            elementAt(priVarSwitches_, id) = std::make_unique<PVSwitch>(priVarSwitchVerbosity, priVarSwitchMultithreading);
         });
 
         priVarsSwitchedInLastIteration_.fill(false);
@@ -215,17 +216,10 @@ private:
         // invoke the primary variable switch
         priVarsSwitchedInLastIteration_[i] = priVarSwitch.update(uCurrentIter, subVars, problem, gridGeometry);
 
+        // if the volume variables or flux variables are cached globally,
+        // we need to update those where the primary variables have been switched
         if (priVarsSwitchedInLastIteration_[i])
-        {
-            for (const auto& element : elements(gridGeometry.gridView()))
-            {
-                // if the volume variables are cached globally, we need to update those where the primary variables have been switched
-                priVarSwitch.updateSwitchedVolVars(problem, element, gridGeometry, subVars, uCurrentIter);
-
-                // if the flux variables are cached globally, we need to update those where the primary variables have been switched
-                priVarSwitch.updateSwitchedFluxVarsCache(problem, element, gridGeometry, subVars, uCurrentIter);
-            }
-        }
+            priVarSwitch.updateSwitchedVariables(problem, gridGeometry, subVars, uCurrentIter);
     }
 
     //! the coupling manager
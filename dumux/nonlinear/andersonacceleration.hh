@@ -0,0 +1,236 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Nonlinear
+ * \brief Anderson acceleration of fixed-point iterations
+ */
+#ifndef DUMUX_NONLINEAR_ANDERSON_ACCELERATION_HH
+#define DUMUX_NONLINEAR_ANDERSON_ACCELERATION_HH
+
+#include <cmath>
+#include <cassert>
+#include <deque>
+#include <vector>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+
+namespace Dumux {
+
+/*!
+ * \ingroup Nonlinear
+ * \brief Anderson acceleration (Anderson mixing) of a fixed-point iteration \f$ x_{k+1} = G(x_k) \f$
+ *
+ * Given the current iterate \f$ x_k \f$ and \f$ g_k = G(x_k) \f$, the next iterate is
+ * \f$ x_{k+1} = g_k - \Delta G_k \gamma \f$ where \f$ \gamma \f$ minimizes
+ * \f$ \| f_k - \Delta F_k \gamma \| \f$ with the fixed-point residual \f$ f_k = g_k - x_k \f$.
+ * The columns of \f$ \Delta F_k \f$ and \f$ \Delta G_k \f$ are the differences of the last \f$ m \f$
+ * (depth) residuals and function values. The small least-squares problem is solved with the
+ * regularized normal equations. With depth zero the plain fixed-point iteration is recovered.
+ *
+ * The vectors are flat arrays of scalars, so all degrees of freedom have to be of comparable
+ * magnitude (or scaled accordingly) for a meaningful least-squares fit. For distributed vectors,
+ * the local inner products are reduced with a user-provided global sum. Entries stored on several
+ * processes (e.g. overlap or ghost dofs) have to be excluded on all but one process with
+ * setInnerProductWeights, so that they are counted once.
+ *
+ * See: Walker, H. F., & Ni, P. (2011). Anderson acceleration for fixed-point iterations.
+ *      SIAM Journal on Numerical Analysis, 49(4), 1715-1735
+ *
+ * \tparam Scalar the scalar type
+ */
+template<class Scalar>
+class AndersonAcceleration
+{
+    using Vector = std::vector<Scalar>;
+
+public:
+    /*!
+     * \brief Constructor
+     * \param depth the number of previous iterates used for the extrapolation
+     * \param regularization relative Tikhonov regularization of the normal equations
+     */
+    explicit AndersonAcceleration(std::size_t depth, Scalar regularization = 1e-10)
+    : depth_(depth)
+    , regularization_(regularization)
+    {}
+
+    //! forget all previous iterates (e.g. at the beginning of a new time step)
+    void reset()
+    {
+        deltaF_.clear();
+        deltaG_.clear();
+        fOld_.clear();
+        gOld_.clear();
+    }
+
+    //! the number of previous iterates currently used
+    std::size_t numStoredIterates() const
+    { return deltaF_.size(); }
+
+    /*!
+     * \brief Set the weights of the vector entries in the inner products of the least-squares problem
+     * \param weights one weight per entry (e.g. one for entries owned by this process and zero otherwise),
+     *        an empty vector weights all entries with one (the default)
+     */
+    void setInnerProductWeights(Vector weights)
+    { weights_ = std::move(weights); }
+
+    /*!
+     * \brief Compute the next iterate
+     * \param x the current iterate \f$ x_k \f$
+     * \param g the value of the fixed-point map \f$ G(x_k) \f$, overwritten with the next iterate \f$ x_{k+1} \f$
+     */
+    void update(const Vector& x, Vector& g)
+    { update(x, g, [](Vector&){}); }
+
+    /*!
+     * \brief Compute the next iterate for distributed vectors
+     * \param x the current iterate \f$ x_k \f$ (process-local part)
+     * \param g the value of the fixed-point map \f$ G(x_k) \f$, overwritten with the next iterate \f$ x_{k+1} \f$
+     * \param globalSum a function summing a vector of scalars over all processes in place
+     *        (the local inner products), so that all processes compute the same coefficients
+     */
+    template<class GlobalSum>
+    void update(const Vector& x, Vector& g, GlobalSum&& globalSum)
+    {
+        if (depth_ == 0)
+            return;
+
+        Vector f(g.size());
+        for (std::size_t i = 0; i < g.size(); ++i)
+            f[i] = g[i] - x[i];
+
+        if (!fOld_.empty())
+        {
+            if (deltaF_.size() == depth_)
+            {
+                deltaF_.pop_front();
+                deltaG_.pop_front();
+            }
+
+            deltaF_.emplace_back(f.size());
+            deltaG_.emplace_back(g.size());
+            for (std::size_t i = 0; i < g.size(); ++i)
+            {
+                deltaF_.back()[i] = f[i] - fOld_[i];
+                deltaG_.back()[i] = g[i] - gOld_[i];
+            }
+        }
+
+        fOld_ = f;
+        gOld_ = g;
+
+        const std::size_t m = deltaF_.size();
+        if (m == 0)
+            return;
+
+        // the inner products (dF^T dF and dF^T f) in one buffer for the global reduction
+        Vector dots(m*m + m, 0.0);
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            for (std::size_t j = 0; j <= i; ++j)
+                dots[i*m + j] = dot_(deltaF_[i], deltaF_[j]);
+            dots[m*m + i] = dot_(deltaF_[i], f);
+        }
+        globalSum(dots);
+
+        // normal equations (dF^T dF + eps I) gamma = dF^T f
+        std::vector<Vector> lhs(m, Vector(m, 0.0));
+        Vector rhs(m, 0.0);
+        Scalar trace = 0.0;
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            for (std::size_t j = 0; j <= i; ++j)
+                lhs[i][j] = lhs[j][i] = dots[i*m + j];
+            rhs[i] = dots[m*m + i];
+            trace += lhs[i][i];
+        }
+
+        if (trace <= 0.0)
+            return;
+
+        for (std::size_t i = 0; i < m; ++i)
+            lhs[i][i] += regularization_*trace;
+
+        const auto gamma = solve_(std::move(lhs), std::move(rhs));
+        for (std::size_t k = 0; k < m; ++k)
+            for (std::size_t i = 0; i < g.size(); ++i)
+                g[i] -= gamma[k]*deltaG_[k][i];
+    }
+
+private:
+    Scalar dot_(const Vector& a, const Vector& b) const
+    {
+        if (weights_.empty())
+            return std::inner_product(a.begin(), a.end(), b.begin(), Scalar(0.0));
+
+        assert(weights_.size() == a.size());
+        Scalar result = 0.0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            result += weights_[i]*a[i]*b[i];
+        return result;
+    }
+
+    //! Gaussian elimination with partial pivoting for the small dense system
+    static Vector solve_(std::vector<Vector> a, Vector b)
+    {
+        const std::size_t m = b.size();
+        for (std::size_t k = 0; k < m; ++k)
+        {
+            std::size_t pivot = k;
+            for (std::size_t i = k+1; i < m; ++i)
+                if (std::abs(a[i][k]) > std::abs(a[pivot][k]))
+                    pivot = i;
+
+            std::swap(a[k], a[pivot]);
+            std::swap(b[k], b[pivot]);
+
+            for (std::size_t i = k+1; i < m; ++i)
+            {
+                const Scalar factor = a[i][k]/a[k][k];
+                for (std::size_t j = k; j < m; ++j)
+                    a[i][j] -= factor*a[k][j];
+                b[i] -= factor*b[k];
+            }
+        }
+
+        Vector x(m, 0.0);
+        for (std::size_t k = m; k-- > 0;)
+        {
+            Scalar sum = b[k];
+            for (std::size_t j = k+1; j < m; ++j)
+                sum -= a[k][j]*x[j];
+            x[k] = sum/a[k][k];
+        }
+
+        return x;
+    }
+
+    std::size_t depth_;
+    Scalar regularization_;
+    std::deque<Vector> deltaF_, deltaG_;
+    Vector fOld_, gOld_;
+    Vector weights_;
+};
+
+} // end namespace Dumux
+
+#endif
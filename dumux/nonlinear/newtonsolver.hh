@@ -47,6 +47,7 @@
 #include <dumux/common/typetraits/vector.hh>
 #include <dumux/common/typetraits/isvalid.hh>
 #include <dumux/common/timeloop.hh>
+#include <dumux/common/instrumentation.hh>
 #include <dumux/common/pdesolver.hh>
 #include <dumux/common/variablesbackend.hh>
 
@@ -100,6 +101,14 @@ template<class LinearSolver, class Residual>
 static constexpr bool hasNorm()
 { return Dune::Std::is_detected<NormDetector, LinearSolver, Residual>::value; }
 
+// helper struct and function detecting if the linear solver can reuse its setup for an unchanged matrix
+template <class LinearSolver>
+using SetReuseSetupDetector = decltype(std::declval<LinearSolver>().setReuseSetup(true));
+
+template<class LinearSolver>
+static constexpr bool hasSetReuseSetup()
+{ return Dune::Std::is_detected<SetReuseSetupDetector, LinearSolver>::value; }
+
 // helpers to implement max relative shift
 template<class C> using dynamicIndexAccess = decltype(std::declval<C>()[0]);
 template<class C> using staticIndexAccess = decltype(std::declval<C>()[Dune::Indices::_0]);
@@ -480,11 +489,40 @@ public:
     /*!
      * \brief Assemble the linear system of equations \f$\mathbf{A}x - b = 0\f$.
      *
+     * If the frozen Jacobian mode is enabled and the Jacobian does not need to
+     * be refreshed, only the residual is assembled and the Jacobian of a previous
+     * iteration (or time step) is reused (modified Newton method).
+     *
      * \param vars The current iteration's variables
      */
     virtual void assembleLinearSystem(const Variables& vars)
     {
+        if (enableFrozenJacobian_)
+        {
+            if (Backend::size(this->assembler().residual()) != frozenJacobianNumDofs_)
+                refreshJacobian_ = true;
+
+            usesFrozenJacobian_ = !refreshJacobian_;
+            if (usesFrozenJacobian_)
+            {
+                if constexpr (!assemblerExportsVariables)
+                    this->assembler().assembleResidual(Backend::dofs(vars));
+                else
+                    this->assembler().assembleResidual(vars);
+
+                ++frozenJacobianAge_;
+                ++numFrozenJacobianIterations_;
+                endIterMsgStream_ << ", frozen Jacobian";
+                return;
+            }
+
+            refreshJacobian_ = false;
+            frozenJacobianAge_ = 0;
+            frozenJacobianNumDofs_ = Backend::size(this->assembler().residual());
+        }
+
         assembleLinearSystem_(this->assembler(), vars);
+        ++numJacobianAssemblies_;
 
         if (enablePartialReassembly_)
             partialReassembler_->report(comm_, endIterMsgStream_);
@@ -523,6 +561,12 @@ public:
                 }
             }
 
+            // with a frozen Jacobian the linear solver may reuse its setup (e.g. the preconditioner)
+            // multitype matrices are excluded as they are copied into a temporary matrix for some solvers
+            if constexpr (Detail::hasSetReuseSetup<LinearSolver>() && !isMultiTypeBlockVector<SolutionVector>())
+                if (enableFrozenJacobian_)
+                    this->linearSolver().setReuseSetup(usesFrozenJacobian_);
+
             // solve by calling the appropriate implementation depending on whether the linear solver
             // is capable of handling MultiType matrices or not
             bool converged = solveLinearSystem_(deltaU);
@@ -752,8 +796,14 @@ public:
              << "-- Total wasted Newton iterations:     " << totalWastedIter_ << '\n'
              << "-- Total succeeded Newton iterations:  " << totalSucceededIter_ << '\n'
              << "-- Average iterations per solve:       " << std::setprecision(3) << double(totalSucceededIter_) / double(numConverged_) << '\n'
-             << "-- Number of linear solver breakdowns: " << numLinearSolverBreakdowns_ << '\n'
-             << std::endl;
+             << "-- Number of linear solver breakdowns: " << numLinearSolverBreakdowns_ << '\n';
+
+        if (enableFrozenJacobian_)
+            sout << "-- Jacobian assemblies:                " << numJacobianAssemblies_ << '\n'
+                 << "-- Iterations with frozen Jacobian:    " << numFrozenJacobianIterations_ << '\n'
+                 << "-- Refreshes due to slow contraction:  " << numContractionRefreshes_ << '\n';
+
+        sout << std::endl;
     }
 
     /*!
@@ -765,8 +815,31 @@ public:
         totalSucceededIter_ = 0;
         numConverged_ = 0;
         numLinearSolverBreakdowns_ = 0;
+        numJacobianAssemblies_ = 0;
+        numFrozenJacobianIterations_ = 0;
+        numContractionRefreshes_ = 0;
     }
 
+    /*!
+     * \brief Enforce the assembly of the Jacobian in the next Newton iteration
+     * \note Only relevant in the frozen Jacobian mode, e.g. after a change of the problem
+     *       that the contraction based refresh policy would only detect later.
+     */
+    void resetFrozenJacobian()
+    { refreshJacobian_ = true; }
+
+    /*!
+     * \brief The number of Jacobian assemblies since the last reset of the statistics
+     */
+    std::size_t numJacobianAssemblies() const
+    { return numJacobianAssemblies_; }
+
+    /*!
+     * \brief The number of Newton steps that reused a frozen Jacobian since the last reset of the statistics
+     */
+    std::size_t numFrozenJacobianIterations() const
+    { return numFrozenJacobianIterations_; }
+
     /*!
      * \brief Report the options and parameters this Newton is configured with
      */
@@ -777,6 +850,7 @@ public:
         if (useLineSearch_) sout << " -- Newton.UseLineSearch = true\n";
         if (useChop_) sout << " -- Newton.EnableChop = true\n";
         if (enablePartialReassembly_) sout << " -- Newton.EnablePartialReassembly = true\n";
+        if (enableFrozenJacobian_) sout << " -- Newton.EnableFrozenJacobian = true\n";
         if (enableAbsoluteResidualCriterion_) sout << " -- Newton.EnableAbsoluteResidualCriterion = true\n";
         if (enableShiftCriterion_) sout << " -- Newton.EnableShiftCriterion = true (relative shift convergence criterion)\n";
         if (enableResidualCriterion_) sout << " -- Newton.EnableResidualCriterion = true\n";
@@ -794,6 +868,11 @@ public:
             sout << " -- Newton.ReassemblyMaxThreshold = " << reassemblyMaxThreshold_ << '\n';
             sout << " -- Newton.ReassemblyShiftWeight = " << reassemblyShiftWeight_ << '\n';
         }
+        if (enableFrozenJacobian_)
+        {
+            sout << " -- Newton.FrozenJacobianMaxContraction = " << frozenJacobianMaxContraction_ << '\n';
+            sout << " -- Newton.FrozenJacobianMaxAge = " << frozenJacobianMaxAge_ << '\n';
+        }
         sout << " -- Newton.RetryTimeStepReductionFactor = " << retryTimeStepReductionFactor_ << '\n';
         sout << " -- Newton.MaxTimeStepDivisions = " << maxTimeStepDivisions_ << '\n';
         sout << std::endl;
@@ -938,6 +1017,8 @@ private:
      */
     bool solve_(Variables& vars)
     {
+        Instrumentation::ScopedTimer newtonTimer("Newton.Solve");
+
         try
         {
             // newtonBegin may manipulate the solution
@@ -975,7 +1056,10 @@ private:
 
                 // linearize the problem at the current solution
                 assembleTimer.start();
-                assembleLinearSystem(vars);
+                {
+                    Instrumentation::ScopedTimer timer("Newton.Assemble");
+                    assembleLinearSystem(vars);
+                }
                 assembleTimer.stop();
 
                 ///////////////
@@ -997,7 +1081,10 @@ private:
                 // set the delta vector to zero before solving the linear system!
                 deltaU = 0;
 
-                solveLinearSystem(deltaU);
+                {
+                    Instrumentation::ScopedTimer timer("Newton.SolveLinearSystem");
+                    solveLinearSystem(deltaU);
+                }
                 solveTimer.stop();
 
                 ///////////////
@@ -1008,14 +1095,21 @@ private:
                               << clearRemainingLine << std::flush;
 
                 updateTimer.start();
-                // update the current solution (i.e. uOld) with the delta
-                // (i.e. u). The result is stored in u
-                newtonUpdate(vars, uLastIter, deltaU);
+                {
+                    Instrumentation::ScopedTimer timer("Newton.Update");
+                    // update the current solution (i.e. uOld) with the delta
+                    // (i.e. u). The result is stored in u
+                    newtonUpdate(vars, uLastIter, deltaU);
+                }
                 updateTimer.stop();
 
                 // tell the solver that we're done with this iteration
                 newtonEndStep(vars, uLastIter);
 
+                // decide whether the Jacobian can be reused in the next iteration
+                if (enableFrozenJacobian_)
+                    updateFrozenJacobianState_();
+
                 // if a convergence writer was specified compute residual and write output
                 if (convergenceWriter_)
                 {
@@ -1034,6 +1128,7 @@ private:
             if (!newtonConverged())
             {
                 totalWastedIter_ += numSteps_;
+                refreshJacobian_ = true;
                 newtonFail(vars);
                 return false;
             }
@@ -1060,12 +1155,43 @@ private:
                 std::cout << "Newton: Caught exception: \"" << e.what() << "\"\n";
 
             totalWastedIter_ += numSteps_;
+            refreshJacobian_ = true;
 
             newtonFail(vars);
             return false;
         }
     }
 
+    /*!
+     * \brief Decide whether the Jacobian has to be refreshed in the next iteration
+     *
+     * The Jacobian is refreshed if the primary variable state changed, if it has been
+     * reused for Newton.FrozenJacobianMaxAge iterations, or if the contraction rate
+     * (ratio of two consecutive relative shifts, or residual reductions if the shift
+     * criterion is disabled) of an iteration with a frozen Jacobian exceeds
+     * Newton.FrozenJacobianMaxContraction. The Jacobian of the last iteration of a time step
+     * is kept for the next time step.
+     */
+    void updateFrozenJacobianState_()
+    {
+        if (priVarSwitchAdapter_->switched() || frozenJacobianAge_ >= frozenJacobianMaxAge_)
+        {
+            refreshJacobian_ = true;
+            return;
+        }
+
+        // there is no meaningful contraction rate for the first iteration of a time step
+        if (!usesFrozenJacobian_ || numSteps_ <= 1)
+            return;
+
+        const Scalar contraction = enableShiftCriterion_ ? shift_/lastShift_ : reduction_/lastReduction_;
+        if (!(contraction <= frozenJacobianMaxContraction_))
+        {
+            refreshJacobian_ = true;
+            ++numContractionRefreshes_;
+        }
+    }
+
     //! assembleLinearSystem_ for assemblers that support partial reassembly
     template<class A>
     auto assembleLinearSystem_(const A& assembler, const Variables& vars)
@@ -1281,6 +1407,15 @@ private:
         reassemblyMaxThreshold_ = getParamFromGroup<Scalar>(group, "Newton.ReassemblyMaxThreshold", 1e2*shiftTolerance_);
         reassemblyShiftWeight_ = getParamFromGroup<Scalar>(group, "Newton.ReassemblyShiftWeight", 1e-3);
 
+        enableFrozenJacobian_ = getParamFromGroup<bool>(group, "Newton.EnableFrozenJacobian", false);
+        frozenJacobianMaxContraction_ = getParamFromGroup<Scalar>(group, "Newton.FrozenJacobianMaxContraction", 0.25);
+        frozenJacobianMaxAge_ = getParamFromGroup<int>(group, "Newton.FrozenJacobianMaxAge", 20);
+        if (enableFrozenJacobian_ && enablePartialReassembly_)
+            DUNE_THROW(Dune::InvalidStateException, "Use either partial reassembly OR a frozen Jacobian!");
+        // parallel linear solvers may modify the matrix (e.g. sum up entries of border dofs)
+        if (enableFrozenJacobian_ && comm_.size() > 1)
+            DUNE_THROW(Dune::NotImplemented, "Frozen Jacobian for parallel runs");
+
         maxTimeStepDivisions_ = getParamFromGroup<std::size_t>(group, "Newton.MaxTimeStepDivisions", 10);
         retryTimeStepReductionFactor_ = getParamFromGroup<Scalar>(group, "Newton.RetryTimeStepReductionFactor", 0.5);
 
@@ -1374,11 +1509,23 @@ private:
     Scalar reassemblyMaxThreshold_;
     Scalar reassemblyShiftWeight_;
 
+    // infrastructure for the frozen Jacobian (modified Newton) mode
+    bool enableFrozenJacobian_;
+    Scalar frozenJacobianMaxContraction_;
+    int frozenJacobianMaxAge_;
+    bool refreshJacobian_ = true; //! whether the Jacobian has to be assembled in the next iteration
+    bool usesFrozenJacobian_ = false; //! whether the current iteration reuses a Jacobian
+    int frozenJacobianAge_ = 0; //! number of iterations the current Jacobian has been reused
+    typename Backend::SizeType frozenJacobianNumDofs_{}; //! the system size when the Jacobian was assembled
+
     // statistics for the optional report
     std::size_t totalWastedIter_ = 0; //! Newton steps in solves that didn't converge
     std::size_t totalSucceededIter_ = 0; //! Newton steps in solves that converged
     std::size_t numConverged_ = 0; //! total number of converged solves
     std::size_t numLinearSolverBreakdowns_ = 0; //! total number of linear solves that failed
+    std::size_t numJacobianAssemblies_ = 0; //! total number of Jacobian assemblies
+    std::size_t numFrozenJacobianIterations_ = 0; //! Newton steps that reused a frozen Jacobian
+    std::size_t numContractionRefreshes_ = 0; //! Jacobian refreshes triggered by a slow contraction
 
     //! the class handling the primary variable switch
     std::unique_ptr<PrimaryVariableSwitchAdapter> priVarSwitchAdapter_;
@@ -63,7 +63,8 @@ public:
     PrimaryVariableSwitchAdapter(const std::string& paramGroup = "")
     {
         const int priVarSwitchVerbosity = getParamFromGroup<int>(paramGroup, "PrimaryVariableSwitch.Verbosity", 1);
-        priVarSwitch_ = std::make_unique<PrimaryVariableSwitch>(priVarSwitchVerbosity);
+        const bool priVarSwitchMultithreading = getParamFromGroup<bool>(paramGroup, "PrimaryVariableSwitch.Multithreading", false);
+        priVarSwitch_ = std::make_unique<PrimaryVariableSwitch>(priVarSwitchVerbosity, priVarSwitchMultithreading);
     }
 
     /*!
@@ -92,17 +93,10 @@ public:
 
         // invoke the primary variable switch
         priVarsSwitchedInLastIteration_ = priVarSwitch_->update(uCurrentIter, vars, problem, gridGeometry);
+        // if the volume variables or flux variables are cached globally,
+        // we need to update those where the primary variables have been switched
         if (priVarsSwitchedInLastIteration_)
-        {
-            for (const auto& element : elements(gridGeometry.gridView()))
-            {
-                // if the volume variables are cached globally, we need to update those where the primary variables have been switched
-                priVarSwitch_->updateSwitchedVolVars(problem, element, gridGeometry, vars, uCurrentIter);
-
-                // if the flux variables are cached globally, we need to update those where the primary variables have been switched
-                priVarSwitch_->updateSwitchedFluxVarsCache(problem, element, gridGeometry, vars, uCurrentIter);
-            }
-        }
+            priVarSwitch_->updateSwitchedVariables(problem, gridGeometry, vars, uCurrentIter);
     }
 
     /*!
@@ -0,0 +1,179 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup Parallel
+ * \brief Parallel for loop (multithreading)
+ *
+ * The backend is chosen at compile time. If the macro DUMUX_MULTITHREADING_BACKEND
+ * is not defined by the user, TBB is used if available, then OpenMP, and otherwise
+ * a simple backend based on std::thread. Possible values are
+ *  - DUMUX_MULTITHREADING_BACKEND_SERIAL
+ *  - DUMUX_MULTITHREADING_BACKEND_CPP
+ *  - DUMUX_MULTITHREADING_BACKEND_OPENMP
+ *  - DUMUX_MULTITHREADING_BACKEND_TBB
+ *
+ * The number of threads can be set with the environment variable DUMUX_NUM_THREADS.
+ */
+#ifndef DUMUX_PARALLEL_PARALLEL_FOR_HH
+#define DUMUX_PARALLEL_PARALLEL_FOR_HH
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+#define DUMUX_MULTITHREADING_BACKEND_SERIAL 0
+#define DUMUX_MULTITHREADING_BACKEND_CPP 1
+#define DUMUX_MULTITHREADING_BACKEND_OPENMP 2
+#define DUMUX_MULTITHREADING_BACKEND_TBB 3
+
+#ifndef DUMUX_MULTITHREADING_BACKEND
+#if HAVE_TBB
+#define DUMUX_MULTITHREADING_BACKEND DUMUX_MULTITHREADING_BACKEND_TBB
+#elif defined(_OPENMP)
+#define DUMUX_MULTITHREADING_BACKEND DUMUX_MULTITHREADING_BACKEND_OPENMP
+#else
+#define DUMUX_MULTITHREADING_BACKEND DUMUX_MULTITHREADING_BACKEND_CPP
+#endif
+#endif
+
+#if DUMUX_MULTITHREADING_BACKEND == DUMUX_MULTITHREADING_BACKEND_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#elif DUMUX_MULTITHREADING_BACKEND == DUMUX_MULTITHREADING_BACKEND_OPENMP
+#include <omp.h>
+#endif
+
+namespace Dumux {
+
+/*!
+ * \ingroup Parallel
+ * \brief The maximum number of threads used by parallelFor
+ * \note Can be set with the environment variable DUMUX_NUM_THREADS
+ */
+inline std::size_t maxNumThreads()
+{
+#if DUMUX_MULTITHREADING_BACKEND == DUMUX_MULTITHREADING_BACKEND_SERIAL
+    return 1;
+#else
+    static const std::size_t numThreads = []{
+#if DUMUX_MULTITHREADING_BACKEND == DUMUX_MULTITHREADING_BACKEND_TBB
+        std::size_t n = tbb::this_task_arena::max_concurrency();
+#elif DUMUX_MULTITHREADING_BACKEND == DUMUX_MULTITHREADING_BACKEND_OPENMP
+        std::size_t n = omp_get_max_threads();
+#else
+        std::size_t n = std::max(1u, std::thread::hardware_concurrency());
+#endif
+        if (const char* envNumThreads = std::getenv("DUMUX_NUM_THREADS"))
+            n = std::max<std::size_t>(1, std::stoul(envNumThreads));
+        return n;
+    }();
+    return numThreads;
+#endif
+}
+
+/*!
+ * \ingroup Parallel
+ * \brief A parallel for loop (multithreading)
+ * \param count the number of iterations
+ * \param functor a functor called as functor(i) for i = 0, ..., count-1
+ * \note The functor is called concurrently from several threads and has
+ *       to be thread-safe. The order of evaluation is unspecified.
+ */
+template<class FunctorType>
+void parallelFor(const std::size_t count, const FunctorType& functor)
+{
+    const auto numThreads = std::min(maxNumThreads(), count);
+
+    // avoid any threading overhead if there is nothing to distribute
+    if (numThreads <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            functor(i);
+        return;
+    }
+
+#if DUMUX_MULTITHREADING_BACKEND == DUMUX_MULTITHREADING_BACKEND_TBB
+    tbb::parallel_for(std::size_t(0), count, [&](const std::size_t i){ functor(i); });
+
+#elif DUMUX_MULTITHREADING_BACKEND == DUMUX_MULTITHREADING_BACKEND_OPENMP
+    // exceptions must not leave the parallel region, so the first one is stored
+    // and rethrown after the loop (the remaining iterations are skipped)
+    std::exception_ptr exception;
+    std::atomic<bool> failed(false);
+    #pragma omp parallel for num_threads(numThreads) schedule(guided)
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (failed.load(std::memory_order_relaxed))
+            continue;
+
+        try {
+            functor(i);
+        }
+        catch (...) {
+            #pragma omp critical (DumuxParallelForException)
+            if (!exception)
+                exception = std::current_exception();
+            failed.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+
+#else
+    // static partitioning into contiguous chunks, one per thread
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    threads.reserve(numThreads);
+    const auto chunkSize = count/numThreads;
+    const auto remainder = count%numThreads;
+    std::size_t begin = 0;
+    for (std::size_t t = 0; t < numThreads; ++t)
+    {
+        const auto end = begin + chunkSize + (t < remainder ? 1 : 0);
+        threads.emplace_back([&functor, &exceptions, t, begin, end]{
+            try {
+                for (std::size_t i = begin; i < end; ++i)
+                    functor(i);
+            }
+            catch (...) {
+                exceptions[t] = std::current_exception();
+            }
+        });
+        begin = end;
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    // rethrow the first exception that occurred on any thread
+    for (const auto& e : exceptions)
+        if (e)
+            std::rethrow_exception(e);
+#endif
+}
+
+} // end namespace Dumux
+
+#endif
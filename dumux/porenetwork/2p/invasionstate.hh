@@ -28,6 +28,7 @@
 #include <type_traits>
 #include <dune/common/std/type_traits.hh>
 #include <dumux/common/parameters.hh>
+#include <dumux/common/parameterhandle.hh>
 #include <dumux/porenetwork/common/labels.hh>
 
 namespace Dumux::PoreNetwork {
@@ -68,6 +69,8 @@ public:
         numThroatsInvaded_ = std::count(invadedCurrentIteration_.begin(), invadedCurrentIteration_.end(), true);
         verbose_ = getParamFromGroup<bool>(problem.paramGroup(), "InvasionState.Verbosity", true);
         restrictToGlobalCapillaryPressure_ = getParamFromGroup<bool>(problem.paramGroup(), "InvasionState.RestrictInvasionToGlobalCapillaryPressure", false);
+        accuracyCriterion_ = paramHandleFromGroup<double>(problem.paramGroup(), "InvasionState.AccuracyCriterion", -1.0);
+        blockNonwettingPhase_ = paramHandleFromGroup<std::vector<int>>(problem.paramGroup(), "InvasionState.BlockNonwettingPhaseAtThroatLabel", std::vector<int>{Labels::outlet});
 
         if constexpr (hasGlobalCapillaryPressure<Problem>())
         {
@@ -151,7 +154,7 @@ public:
                                                         const GridFluxVariablesCache& gridFluxVarsCache) const
     {
         using Scalar = typename SolutionVector::block_type::value_type;
-        static const Scalar accuracyCriterion = getParamFromGroup<Scalar>(problem_.paramGroup(), "InvasionState.AccuracyCriterion", -1.0);
+        const Scalar accuracyCriterion = accuracyCriterion_;
 
         if (accuracyCriterion < 0.0)
             return;
@@ -213,7 +216,7 @@ private:
         };
 
         // Block non-wetting phase flux out of the outlet
-        static const auto blockNonwettingPhase = getParamFromGroup<std::vector<int>>(problem_.paramGroup(), "InvasionState.BlockNonwettingPhaseAtThroatLabel", std::vector<int>{Labels::outlet});
+        const auto& blockNonwettingPhase = blockNonwettingPhase_.get();
         if (!blockNonwettingPhase.empty() && std::find(blockNonwettingPhase.begin(), blockNonwettingPhase.end(), gridGeometry.throatLabel(eIdx)) != blockNonwettingPhase.end())
         {
             invadedCurrentIteration_[eIdx] = false;
@@ -298,6 +301,8 @@ private:
     std::size_t numThroatsInvaded_;
     bool verbose_;
     bool restrictToGlobalCapillaryPressure_;
+    ParamHandle<double> accuracyCriterion_;
+    ParamHandle<std::vector<int>> blockNonwettingPhase_;
 
     const Problem& problem_;
 };
@@ -0,0 +1,318 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+
+/*!
+ * \file
+ * \ingroup PNMTwoPModel
+ * \brief Invasion percolation for (quasi-) static drainage of pore networks.
+ */
+#ifndef DUMUX_PNM_TWOP_STATIC_INVASION_PERCOLATION_HH
+#define DUMUX_PNM_TWOP_STATIC_INVASION_PERCOLATION_HH
+
+#include <array>
+#include <limits>
+#include <vector>
+#include <queue>
+#include <numeric>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+namespace Dumux::PoreNetwork {
+
+/*!
+ * \ingroup PNMTwoPModel
+ *
+ * \brief Invasion percolation for (quasi-) static drainage of pore networks.
+ *
+ * Computes the complete drainage sequence of the network in a single pass: the throats are invaded
+ * in the order of increasing entry capillary pressure starting from the inlet throats, using a priority
+ * queue over the throats adjacent to the invaded cluster. The invasion pressure of a throat is the
+ * global capillary pressure at which it is invaded, i.e. the largest entry pressure on the
+ * path through which it is reached. The state for any global capillary pressure can then be read off
+ * without repeating the search.
+ *
+ * If trapping is enabled, throats whose cluster of defending (wetting) phase has lost its
+ * connection to the outlet throats at the time of invasion are never invaded. The trapped throats are
+ * identified in a second pass in reverse invasion order using a union-find structure.
+ *
+ * \note The throats connected by a pore are neighbors. The adjacency is precomputed in compressed
+ *       sparse row format, so the cost is O(N log N) for N throats.
+ * \note The entry pressures are only read on construction.
+ */
+template<class GridGeometry, class Scalar>
+class InvasionPercolation
+{
+    using GridView = typename GridGeometry::GridView;
+
+public:
+    /*!
+     * \brief Compute the invasion sequence of the network
+     *
+     * \param gridGeometry The grid geometry of the pore network
+     * \param pcEntry The entry capillary pressure of each throat
+     * \param throatLabel The label of each throat
+     * \param inletThroatLabel The label of throats at the inlet (the seeds of the invasion)
+     * \param outletThroatLabel The label of throats at the outlet
+     * \param allowDrainageOfOutlet Whether outlet throats can be invaded
+     * \param enableTrapping Whether the defending phase can be trapped
+     */
+    InvasionPercolation(const GridGeometry& gridGeometry,
+                        const std::vector<Scalar>& pcEntry,
+                        const std::vector<int>& throatLabel,
+                        const int inletThroatLabel,
+                        const int outletThroatLabel,
+                        const bool allowDrainageOfOutlet = false,
+                        const bool enableTrapping = false)
+    {
+        buildAdjacency_(gridGeometry.gridView());
+        invade_(pcEntry, throatLabel, inletThroatLabel, outletThroatLabel, allowDrainageOfOutlet);
+
+        isTrapped_.assign(pcEntry.size(), false);
+        if (enableTrapping)
+            trap_(throatLabel, outletThroatLabel);
+    }
+
+    /*!
+     * \brief The indices of the invaded throats in the order of invasion
+     */
+    const std::vector<std::size_t>& invasionOrder() const
+    { return invasionOrder_; }
+
+    /*!
+     * \brief The global capillary pressure at which the throat is invaded
+     *        (infinity if the throat is never invaded)
+     */
+    Scalar invasionPressure(const std::size_t eIdx) const
+    { return invasionPressure_[eIdx]; }
+
+    /*!
+     * \brief The global capillary pressure at which each throat is invaded
+     */
+    const std::vector<Scalar>& invasionPressure() const
+    { return invasionPressure_; }
+
+    /*!
+     * \brief Whether the invasion of the throat is prevented by trapping of the defending phase
+     */
+    bool isTrapped(const std::size_t eIdx) const
+    { return isTrapped_[eIdx]; }
+
+    /*!
+     * \brief Whether the throat is invaded for the given global capillary pressure
+     */
+    bool isInvaded(const std::size_t eIdx, const Scalar pcGlobal) const
+    { return invasionPressure_[eIdx] <= pcGlobal; }
+
+    /*!
+     * \brief The number of invaded throats for the given global capillary pressure
+     */
+    std::size_t numThroatsInvaded(const Scalar pcGlobal) const
+    {
+        // the invasion pressures increase monotonically along the invasion sequence
+        const auto it = std::upper_bound(invasionOrder_.begin(), invasionOrder_.end(), pcGlobal,
+                                         [&](const Scalar pc, const std::size_t eIdx){ return pc < invasionPressure_[eIdx]; });
+        return std::distance(invasionOrder_.begin(), it);
+    }
+
+    /*!
+     * \brief Mark all throats invaded for the given global capillary pressure
+     * \note Throats already marked as invaded stay invaded
+     */
+    void updateInvasionState(std::vector<bool>& elementIsInvaded, const Scalar pcGlobal) const
+    {
+        const auto numInvaded = numThroatsInvaded(pcGlobal);
+        for (std::size_t i = 0; i < numInvaded; ++i)
+            elementIsInvaded[invasionOrder_[i]] = true;
+    }
+
+    /*!
+     * \brief The neighbors of a throat (throats sharing a pore)
+     */
+    auto neighbors(const std::size_t eIdx) const
+    {
+        struct Range
+        {
+            const std::size_t* b; const std::size_t* e;
+            const std::size_t* begin() const { return b; }
+            const std::size_t* end() const { return e; }
+        };
+
+        return Range{neighbors_.data() + offsets_[eIdx], neighbors_.data() + offsets_[eIdx+1]};
+    }
+
+private:
+    //! the throat adjacency (throats sharing a pore) in compressed sparse row format
+    void buildAdjacency_(const GridView& gridView)
+    {
+        const auto& indexSet = gridView.indexSet();
+        const std::size_t numThroats = gridView.size(0);
+        const std::size_t numPores = gridView.size(1);
+
+        // the throats connected to each pore
+        std::vector<std::size_t> poreOffsets(numPores + 1, 0);
+        for (const auto& element : elements(gridView))
+            for (int i = 0; i < 2; ++i)
+                ++poreOffsets[indexSet.subIndex(element, i, 1) + 1];
+        std::partial_sum(poreOffsets.begin(), poreOffsets.end(), poreOffsets.begin());
+
+        std::vector<std::size_t> poreThroats(poreOffsets.back());
+        auto poreFill = poreOffsets;
+        std::vector<std::array<std::size_t, 2>> throatPores(numThroats);
+        for (const auto& element : elements(gridView))
+        {
+            const auto eIdx = indexSet.index(element);
+            for (int i = 0; i < 2; ++i)
+            {
+                const auto vIdx = indexSet.subIndex(element, i, 1);
+                throatPores[eIdx][i] = vIdx;
+                poreThroats[poreFill[vIdx]++] = eIdx;
+            }
+        }
+
+        // the neighbors of a throat are the other throats of both its pores
+        offsets_.assign(numThroats + 1, 0);
+        for (std::size_t eIdx = 0; eIdx < numThroats; ++eIdx)
+            for (const auto vIdx : throatPores[eIdx])
+                offsets_[eIdx + 1] += poreOffsets[vIdx + 1] - poreOffsets[vIdx] - 1;
+        std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+        neighbors_.resize(offsets_.back());
+        for (std::size_t eIdx = 0; eIdx < numThroats; ++eIdx)
+        {
+            auto pos = offsets_[eIdx];
+            for (const auto vIdx : throatPores[eIdx])
+                for (auto k = poreOffsets[vIdx]; k < poreOffsets[vIdx + 1]; ++k)
+                    if (poreThroats[k] != eIdx)
+                        neighbors_[pos++] = poreThroats[k];
+        }
+    }
+
+    //! invasion percolation without trapping
+    void invade_(const std::vector<Scalar>& pcEntry,
+                 const std::vector<int>& throatLabel,
+                 const int inletThroatLabel,
+                 const int outletThroatLabel,
+                 const bool allowDrainageOfOutlet)
+    {
+        const std::size_t numThroats = pcEntry.size();
+        invasionPressure_.assign(numThroats, std::numeric_limits<Scalar>::infinity());
+        invasionOrder_.clear();
+        invasionOrder_.reserve(numThroats);
+
+        using Entry = std::pair<Scalar, std::size_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        std::vector<bool> isQueued(numThroats, false);
+
+        // the invasion starts at the inlet
+        for (std::size_t eIdx = 0; eIdx < numThroats; ++eIdx)
+        {
+            if (throatLabel[eIdx] == inletThroatLabel)
+            {
+                queue.emplace(pcEntry[eIdx], eIdx);
+                isQueued[eIdx] = true;
+            }
+        }
+
+        // always invade the accessible throat with the lowest entry pressure
+        Scalar pcGlobal = std::numeric_limits<Scalar>::lowest();
+        while (!queue.empty())
+        {
+            const auto [pc, eIdx] = queue.top();
+            queue.pop();
+
+            pcGlobal = std::max(pcGlobal, pc);
+            invasionPressure_[eIdx] = pcGlobal;
+            invasionOrder_.push_back(eIdx);
+
+            for (const auto nIdx : neighbors(eIdx))
+            {
+                if (!isQueued[nIdx] && (allowDrainageOfOutlet || throatLabel[nIdx] != outletThroatLabel))
+                {
+                    queue.emplace(pcEntry[nIdx], nIdx);
+                    isQueued[nIdx] = true;
+                }
+            }
+        }
+    }
+
+    //! remove the throats with trapped defending phase from the invasion sequence
+    void trap_(const std::vector<int>& throatLabel, const int outletThroatLabel)
+    {
+        const std::size_t numThroats = invasionPressure_.size();
+        const std::size_t outlet = numThroats;
+
+        // union-find over the throats and the outlet
+        std::vector<std::size_t> parent(numThroats + 1);
+        std::iota(parent.begin(), parent.end(), 0);
+        const auto find = [&](std::size_t i)
+        {
+            while (parent[i] != i)
+            {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        };
+
+        std::vector<bool> isDefending(numThroats, false);
+        const auto addDefending = [&](const std::size_t eIdx)
+        {
+            isDefending[eIdx] = true;
+            if (throatLabel[eIdx] == outletThroatLabel)
+                parent[find(eIdx)] = find(outlet);
+            for (const auto nIdx : neighbors(eIdx))
+                if (isDefending[nIdx])
+                    parent[find(eIdx)] = find(nIdx);
+        };
+
+        // the throats that are never invaded
+        for (std::size_t eIdx = 0; eIdx < numThroats; ++eIdx)
+            if (invasionPressure_[eIdx] == std::numeric_limits<Scalar>::infinity())
+                addDefending(eIdx);
+
+        // undo the invasion in reverse order: a throat is trapped if its
+        // defending cluster is not connected to the outlet when it is invaded
+        for (auto it = invasionOrder_.rbegin(); it != invasionOrder_.rend(); ++it)
+        {
+            addDefending(*it);
+            if (find(*it) != find(outlet))
+                isTrapped_[*it] = true;
+        }
+
+        for (std::size_t eIdx = 0; eIdx < numThroats; ++eIdx)
+            if (isTrapped_[eIdx])
+                invasionPressure_[eIdx] = std::numeric_limits<Scalar>::infinity();
+
+        invasionOrder_.erase(std::remove_if(invasionOrder_.begin(), invasionOrder_.end(),
+                                            [&](const std::size_t eIdx){ return isTrapped_[eIdx]; }),
+                             invasionOrder_.end());
+    }
+
+    std::vector<std::size_t> offsets_;
+    std::vector<std::size_t> neighbors_;
+    std::vector<std::size_t> invasionOrder_;
+    std::vector<Scalar> invasionPressure_;
+    std::vector<bool> isTrapped_;
+};
+
+} // namespace Dumux::PoreNetwork
+
+#endif
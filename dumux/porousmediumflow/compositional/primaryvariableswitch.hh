@@ -26,11 +26,20 @@
 #define DUMUX_PRIMARY_VARIABLE_SWITCH_HH
 
 #include <iostream>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <cstdint>
+#include <exception>
+#include <algorithm>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/fvector.hh>
+#include <dumux/common/gridcapabilities.hh>
 #include <dumux/discretization/method.hh>
 #include <dumux/discretization/elementsolution.hh>
+#include <dumux/parallel/parallel_for.hh>
 
 namespace Dumux {
 
@@ -49,19 +58,33 @@ public:
     template<typename... Args> bool update(Args&&...) { return false; }
     template<typename... Args> void updateSwitchedVolVars(Args&&...) {}
     template<typename... Args> void updateSwitchedFluxVarsCache(Args&&...) {}
+    template<typename... Args> void updateSwitchedVariables(Args&&...) {}
     template<typename... Args> void updateDirichletConstraints(Args&&...) {}
 };
 
 /*!
  * \ingroup PorousmediumflowModels
  * \brief The primary variable switch controlling the phase presence state variable.
+ *
+ * The switch criteria are evaluated per degree of freedom, optionally thread-parallel
+ * (see parallelFor). The degrees of freedom switched in the last call to update() are recorded
+ * such that updateSwitchedVariables() only updates the affected volume variables and flux variables caches.
  */
 template<class Implementation>
 class PrimaryVariableSwitch
 {
 public:
-    PrimaryVariableSwitch(int verbosity = 1)
+    /*!
+     * \brief The constructor
+     * \param verbosity the verbosity level
+     * \param multithreading evaluate the switch criteria and update the volume variables thread-parallel
+     * \note With multithreading, the volume variables and the problem's boundary conditions (box)
+     *       and internal Dirichlet constraints are evaluated concurrently and have to be thread-safe.
+     *       Grids that are not thread-safe (see Detail::supportsMultithreading) are always traversed sequentially.
+     */
+    PrimaryVariableSwitch(int verbosity = 1, bool multithreading = false)
     : verbosity_(verbosity)
+    , multithreading_(multithreading)
     {}
 
     //! If the primary variables were recently switched
@@ -74,11 +97,21 @@ public:
     void reset(const std::size_t numDofs)
     {
         wasSwitched_.assign(numDofs, false);
+        switchedDofs_.clear();
+        dofElementOffsets_.clear(); // the grid may have changed
     }
 
+    //! The degrees of freedom whose primary variables were switched in the last call to update()
+    const std::vector<std::size_t>& switchedDofs() const
+    { return switchedDofs_; }
+
     /*!
      * \brief Updates the variable switch / phase presence.
      *
+     * The switch criteria of each degree of freedom are evaluated in the first element (in grid traversal order)
+     * in which the degree of freedom is not constrained. The switched primary variables are only written to the
+     * solution after all degrees of freedom have been evaluated, so the result does not depend on the order of evaluation.
+     *
      * \param curSol The current solution to be updated / modified
      * \param gridVariables The secondary variables on the grid
      * \param problem The problem
@@ -90,42 +123,67 @@ public:
                 const Problem& problem,
                 const typename GridVariables::GridGeometry& gridGeometry)
     {
-        bool switched = false;
-        visited_.assign(wasSwitched_.size(), false);
-        std::size_t countSwitched = 0;
+        using PrimaryVariables = typename SolutionVector::block_type;
+        using VolumeVariables = typename GridVariables::GridVolumeVariables::VolumeVariables;
 
-        auto fvGeometry = localView(gridGeometry);
-        auto elemVolVars = localView(gridVariables.curGridVolVars());
+        const auto numDofs = curSol.size();
+        if (dofElementOffsets_.size() != numDofs + 1)
+            updateDofElementMap_(gridGeometry, numDofs);
 
-        for (const auto& element : elements(gridGeometry.gridView()))
-        {
-            // make sure FVElementGeometry is bound to the element
-            fvGeometry.bindElement(element);
-            elemVolVars.bindElement(element, fvGeometry, curSol);
+        visited_.assign(numDofs, false);
 
-            const auto curElemSol = elementSolution(element, curSol, gridGeometry);
-            for (auto&& scv : scvs(fvGeometry))
+        // the switched primary variables (the solution is not modified during the evaluation as it is read concurrently)
+        std::vector<std::pair<std::size_t, PrimaryVariables>> switchedPriVars;
+        std::mutex mutex;
+
+        forEachDof_(gridGeometry, numDofs, [&](const std::size_t dofIdxGlobal)
+        {
+            auto fvGeometry = localView(gridGeometry);
+            for (auto k = dofElementOffsets_[dofIdxGlobal]; k < dofElementOffsets_[dofIdxGlobal+1]; ++k)
             {
-                if (!asImp_().skipDof_(element, fvGeometry, scv, problem))
+                const auto element = gridGeometry.element(dofElements_[k]);
+                fvGeometry.bindElement(element);
+                for (auto&& scv : scvs(fvGeometry))
                 {
-                    const auto dofIdxGlobal = scv.dofIndex();
+                    if (scv.dofIndex() != dofIdxGlobal || asImp_().skipDof_(element, fvGeometry, scv, problem))
+                        continue;
+
                     // Note this implies that volume variables don't differ
                     // in any sub control volume associated with the dof!
                     visited_[dofIdxGlobal] = true;
+
                     // Compute volVars on which grounds we decide
                     // if we need to switch the primary variables
-                    auto& volVars = getVolVarAccess_(gridVariables.curGridVolVars(), elemVolVars, scv);
+                    const auto curElemSol = elementSolution(element, curSol, gridGeometry);
+                    VolumeVariables localVolVars;
+                    auto& volVars = volVarsToUpdate_(gridVariables.curGridVolVars(), localVolVars, scv);
                     volVars.update(curElemSol, problem, element, scv);
 
-                    if (asImp_().update_(curSol[dofIdxGlobal], volVars, dofIdxGlobal, scv.dofPosition()))
+                    PrimaryVariables priVars = curSol[dofIdxGlobal];
+                    if (asImp_().update_(priVars, volVars, dofIdxGlobal, scv.dofPosition()))
                     {
-                        switched = true;
-                        ++countSwitched;
+                        std::lock_guard<std::mutex> lock(mutex);
+                        switchedPriVars.emplace_back(dofIdxGlobal, priVars);
                     }
+
+                    return;
                 }
             }
+        });
+
+        // write the switched primary variables and record the switched dofs
+        std::sort(switchedPriVars.begin(), switchedPriVars.end(),
+                  [](const auto& a, const auto& b){ return a.first < b.first; });
+        switchedDofs_.clear();
+        for (const auto& [dofIdxGlobal, priVars] : switchedPriVars)
+        {
+            curSol[dofIdxGlobal] = priVars;
+            switchedDofs_.push_back(dofIdxGlobal);
         }
 
+        const std::size_t countSwitched = switchedDofs_.size();
+        bool switched = countSwitched > 0;
+
         if (verbosity_ > 0 && countSwitched > 0)
             std::cout << "Switched primary variables at " << countSwitched << " dof locations on processor "
                       << gridGeometry.gridView().comm().rank() << "." << std::endl;
@@ -138,6 +196,55 @@ public:
         return switched;
     }
 
+    /*!
+     * \brief Updates the globally cached volume variables and flux variables caches
+     *        affected by the switch of primary variables in the last call to update()
+     *
+     * In contrast to calling updateSwitchedVolVars() and updateSwitchedFluxVarsCache() for all elements,
+     * this only visits the elements adjacent to the switched degrees of freedom.
+     */
+    template<class Problem, class GridVariables, class SolutionVector>
+    void updateSwitchedVariables(const Problem& problem,
+                                 const typename GridVariables::GridGeometry& gridGeometry,
+                                 GridVariables& gridVariables,
+                                 const SolutionVector& sol)
+    {
+        // the volume variables of a dof are stored per element (box) or per dof (cell-centered)
+        if constexpr (GridVariables::GridVolumeVariables::cachingEnabled)
+        {
+            forEachDof_(gridGeometry, switchedDofs_.size(), [&](const std::size_t i)
+            {
+                const auto dofIdxGlobal = switchedDofs_[i];
+                auto fvGeometry = localView(gridGeometry);
+                for (auto k = dofElementOffsets_[dofIdxGlobal]; k < dofElementOffsets_[dofIdxGlobal+1]; ++k)
+                {
+                    const auto element = gridGeometry.element(dofElements_[k]);
+                    fvGeometry.bindElement(element);
+                    const auto elemSol = elementSolution(element, sol, gridGeometry);
+                    for (auto&& scv : scvs(fvGeometry))
+                        if (scv.dofIndex() == dofIdxGlobal)
+                            gridVariables.curGridVolVars().volVars(scv).update(elemSol, problem, element, scv);
+                }
+            });
+        }
+
+        // the caches of neighboring elements share faces, so this is done sequentially
+        // (updateElement also updates the caches of the neighbors' faces in the stencil via the connectivity map)
+        if constexpr (GridVariables::GridFluxVariablesCache::cachingEnabled
+                      && GridVariables::GridGeometry::discMethod != DiscretizationMethods::box)
+        {
+            auto fvGeometry = localView(gridGeometry);
+            auto elemVolVars = localView(gridVariables.curGridVolVars());
+            for (const auto dofIdxGlobal : switchedDofs_)
+            {
+                const auto element = gridGeometry.element(dofIdxGlobal);
+                fvGeometry.bind(element);
+                elemVolVars.bind(element, fvGeometry, sol);
+                gridVariables.gridFluxVarsCache().updateElement(element, fvGeometry, elemVolVars);
+            }
+        }
+    }
+
     /*!
      * \brief Updates the volume variables whose primary variables were
      *        switched.
@@ -442,8 +549,9 @@ protected:
         return changed;
     }
 
-    std::vector<bool> wasSwitched_;
-    std::vector<bool> visited_;
+    // (one byte per dof such that different dofs can be written concurrently)
+    std::vector<std::uint8_t> wasSwitched_;
+    std::vector<std::uint8_t> visited_;
 
 private:
     template<class GridVolumeVariables, class ElementVolumeVariables, class SubControlVolume>
@@ -456,7 +564,87 @@ private:
             return elemVolVars[scv];
     }
 
+    //! the cached volume variables or (if not cached) the given local object
+    template<class GridVolumeVariables, class SubControlVolume>
+    typename GridVolumeVariables::VolumeVariables&
+    volVarsToUpdate_(GridVolumeVariables& gridVolVars, typename GridVolumeVariables::VolumeVariables& volVars, const SubControlVolume& scv) const
+    {
+        if constexpr (GridVolumeVariables::cachingEnabled)
+            return gridVolVars.volVars(scv);
+        else
+            return volVars;
+    }
+
+    /*!
+     * \brief call f(i) for i = 0, ..., count-1 (thread-parallel if enabled and supported by the grid)
+     * \note In parallel, the first exception thrown by f is rethrown after all threads finished
+     */
+    template<class GridGeometry, class F>
+    void forEachDof_(const GridGeometry& gridGeometry, const std::size_t count, F&& f) const
+    {
+        using Grid = typename GridGeometry::GridView::Grid;
+        if (!multithreading_ || !Detail::supportsMultithreading<Grid>)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                f(i);
+            return;
+        }
+
+        std::exception_ptr exception;
+        std::atomic<bool> failed(false);
+        std::mutex mutex;
+        parallelFor(count, [&](const std::size_t i)
+        {
+            if (failed)
+                return;
+
+            try { f(i); }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!exception)
+                    exception = std::current_exception();
+                failed = true;
+            }
+        });
+
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    //! store the elements containing each dof (in grid traversal order)
+    template<class GridGeometry>
+    void updateDofElementMap_(const GridGeometry& gridGeometry, const std::size_t numDofs)
+    {
+        dofElementOffsets_.assign(numDofs + 1, 0);
+        auto fvGeometry = localView(gridGeometry);
+        for (const auto& element : elements(gridGeometry.gridView()))
+        {
+            fvGeometry.bindElement(element);
+            for (auto&& scv : scvs(fvGeometry))
+                ++dofElementOffsets_[scv.dofIndex()+1];
+        }
+
+        for (std::size_t dofIdx = 0; dofIdx < numDofs; ++dofIdx)
+            dofElementOffsets_[dofIdx+1] += dofElementOffsets_[dofIdx];
+
+        dofElements_.resize(dofElementOffsets_.back());
+        auto next = dofElementOffsets_;
+        for (const auto& element : elements(gridGeometry.gridView()))
+        {
+            fvGeometry.bindElement(element);
+            const auto eIdx = gridGeometry.elementMapper().index(element);
+            for (auto&& scv : scvs(fvGeometry))
+                dofElements_[next[scv.dofIndex()]++] = eIdx;
+        }
+    }
+
     int verbosity_; //!< The verbosity level of the primary variable switch
+    bool multithreading_; //!< If the switch criteria are evaluated thread-parallel
+
+    std::vector<std::size_t> dofElementOffsets_; //!< offsets into dofElements_ per dof
+    std::vector<std::size_t> dofElements_; //!< the indices of the elements containing each dof
+    std::vector<std::size_t> switchedDofs_; //!< the dofs switched in the last update
 };
 
 } // end namespace dumux
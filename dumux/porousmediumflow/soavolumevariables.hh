@@ -0,0 +1,652 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup PorousmediumflowModels
+ * \brief Memory-compact structure-of-arrays storage of volume variables for grid-cached models
+ */
+#ifndef DUMUX_POROUSMEDIUMFLOW_SOA_VOLUME_VARIABLES_HH
+#define DUMUX_POROUSMEDIUMFLOW_SOA_VOLUME_VARIABLES_HH
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include <dune/common/std/type_traits.hh>
+
+namespace Dumux {
+
+template<class VolumeVariables>
+class SoAVolumeVariablesContainer;
+
+namespace Detail::SoAVolVars {
+
+// detection of the quantities provided by the volume variables
+template<class VV> using Porosity = decltype(std::declval<const VV&>().porosity());
+template<class VV> using ExtrusionFactor = decltype(std::declval<const VV&>().extrusionFactor());
+template<class VV> using Temperature = decltype(std::declval<const VV&>().temperature());
+template<class VV> using CapillaryPressure = decltype(std::declval<const VV&>().capillaryPressure());
+template<class VV> using EffectiveThermalConductivity = decltype(std::declval<const VV&>().effectiveThermalConductivity());
+template<class VV> using SolidDensity = decltype(std::declval<const VV&>().solidDensity());
+template<class VV> using SolidHeatCapacity = decltype(std::declval<const VV&>().solidHeatCapacity());
+template<class VV> using SolidThermalConductivity = decltype(std::declval<const VV&>().solidThermalConductivity());
+template<class VV> using TemperatureSolid = decltype(std::declval<const VV&>().temperatureSolid());
+template<class VV> using Pressure = decltype(std::declval<const VV&>().pressure(0));
+template<class VV> using Saturation = decltype(std::declval<const VV&>().saturation(0));
+template<class VV> using Density = decltype(std::declval<const VV&>().density(0));
+template<class VV> using MolarDensity = decltype(std::declval<const VV&>().molarDensity(0));
+template<class VV> using Mobility = decltype(std::declval<const VV&>().mobility(0));
+template<class VV> using Viscosity = decltype(std::declval<const VV&>().viscosity(0));
+template<class VV> using RelativePermeability = decltype(std::declval<const VV&>().relativePermeability(0));
+template<class VV> using Enthalpy = decltype(std::declval<const VV&>().enthalpy(0));
+template<class VV> using InternalEnergy = decltype(std::declval<const VV&>().internalEnergy(0));
+template<class VV> using AverageMolarMass = decltype(std::declval<const VV&>().averageMolarMass(0));
+template<class VV> using FluidThermalConductivity = decltype(std::declval<const VV&>().fluidThermalConductivity(0));
+template<class VV> using MoleFraction = decltype(std::declval<const VV&>().moleFraction(0, 0));
+template<class VV> using MassFraction = decltype(std::declval<const VV&>().massFraction(0, 0));
+template<class VV> using EffectiveDiffusionCoefficient = decltype(std::declval<const VV&>().effectiveDiffusionCoefficient(0, 0, 0));
+template<class VV> using Permeability = decltype(std::declval<const VV&>().permeability());
+
+//! The scalar quantities that can be stored
+enum class Quantity : std::size_t
+{
+    // one value per degree of freedom
+    porosity, extrusionFactor, temperature, capillaryPressure, effectiveThermalConductivity,
+    solidDensity, solidHeatCapacity, solidThermalConductivity, temperatureSolid,
+    // one value per phase
+    pressure, saturation, density, molarDensity, mobility, viscosity, relativePermeability,
+    enthalpy, internalEnergy, averageMolarMass, fluidThermalConductivity,
+    // one value per phase and component
+    moleFraction, massFraction,
+    // one value per phase and diffusing component
+    effectiveDiffusionCoefficient,
+    size
+};
+
+/*!
+ * \ingroup PorousmediumflowModels
+ * \brief The quantities provided by the volume variables VV and the number of values per degree of freedom
+ */
+template<class VV>
+struct Layout
+{
+    static constexpr int numPhases = VV::numFluidPhases();
+    static constexpr int numComponents = VV::numFluidComponents();
+
+    template<Quantity q>
+    static constexpr bool isStored()
+    {
+        using namespace Dune::Std;
+        switch (q)
+        {
+            case Quantity::porosity: return is_detected<Porosity, VV>::value;
+            case Quantity::extrusionFactor: return is_detected<ExtrusionFactor, VV>::value;
+            case Quantity::temperature: return is_detected<Temperature, VV>::value;
+            case Quantity::capillaryPressure: return is_detected<CapillaryPressure, VV>::value;
+            case Quantity::effectiveThermalConductivity: return is_detected<EffectiveThermalConductivity, VV>::value;
+            case Quantity::solidDensity: return is_detected<SolidDensity, VV>::value;
+            case Quantity::solidHeatCapacity: return is_detected<SolidHeatCapacity, VV>::value;
+            case Quantity::solidThermalConductivity: return is_detected<SolidThermalConductivity, VV>::value;
+            case Quantity::temperatureSolid: return is_detected<TemperatureSolid, VV>::value;
+            case Quantity::pressure: return is_detected<Pressure, VV>::value;
+            case Quantity::saturation: return is_detected<Saturation, VV>::value;
+            case Quantity::density: return is_detected<Density, VV>::value;
+            case Quantity::molarDensity: return is_detected<MolarDensity, VV>::value;
+            case Quantity::mobility: return is_detected<Mobility, VV>::value;
+            case Quantity::viscosity: return is_detected<Viscosity, VV>::value;
+            case Quantity::relativePermeability: return is_detected<RelativePermeability, VV>::value;
+            case Quantity::enthalpy: return is_detected<Enthalpy, VV>::value;
+            case Quantity::internalEnergy: return is_detected<InternalEnergy, VV>::value;
+            case Quantity::averageMolarMass: return is_detected<AverageMolarMass, VV>::value;
+            case Quantity::fluidThermalConductivity: return is_detected<FluidThermalConductivity, VV>::value;
+            case Quantity::moleFraction: return is_detected<MoleFraction, VV>::value;
+            case Quantity::massFraction: return is_detected<MassFraction, VV>::value;
+            case Quantity::effectiveDiffusionCoefficient: return is_detected<EffectiveDiffusionCoefficient, VV>::value && numComponents > 1;
+            default: return false;
+        }
+    }
+
+    //! the number of values per degree of freedom
+    static constexpr std::size_t width(Quantity q)
+    {
+        if (q < Quantity::pressure)
+            return 1;
+        else if (q < Quantity::moleFraction)
+            return numPhases;
+        else if (q < Quantity::effectiveDiffusionCoefficient)
+            return numPhases*numComponents;
+        else
+            return numPhases*(numComponents > 1 ? numComponents - 1 : 0);
+    }
+
+    //! the position of the values of q in the storage of a single degree of freedom
+    static constexpr std::size_t offset(Quantity q)
+    { return offset_(q, std::make_index_sequence<static_cast<std::size_t>(Quantity::size)>{}); }
+
+private:
+    template<std::size_t... I>
+    static constexpr std::size_t offset_(Quantity q, std::index_sequence<I...>)
+    {
+        return ((I < static_cast<std::size_t>(q) && isStored<static_cast<Quantity>(I)>()
+                 ? width(static_cast<Quantity>(I)) : 0) + ... + 0);
+    }
+};
+
+/*!
+ * \ingroup PorousmediumflowModels
+ * \brief The structure-of-arrays data: one contiguous array per quantity that
+ *        is provided by the volume variables VV, nothing is stored for the others
+ * \tparam singleEntry store the values of a single degree of freedom in one fixed-size array
+ *         (used by standalone volume variables) instead of one resizable array per quantity
+ */
+template<class VV, bool singleEntry = false>
+class Data
+{
+    template<class, bool> friend class Data;
+
+    using Scalar = std::decay_t<decltype(std::declval<const VV&>().extrusionFactor())>;
+    using PrimaryVariables = typename VV::PrimaryVariables;
+    static constexpr bool storePermeability = Dune::Std::is_detected<Permeability, VV>::value;
+    using PermeabilityType = std::decay_t<Dune::Std::detected_or_t<Scalar, Permeability, VV>>;
+
+    using L = Layout<VV>;
+    static constexpr int numPhases = L::numPhases;
+    static constexpr int numComponents = L::numComponents;
+    static constexpr std::size_t numQuantities = static_cast<std::size_t>(Quantity::size);
+
+    template<class T>
+    using Storage = std::conditional_t<singleEntry, T, std::vector<T>>;
+    using Values = std::conditional_t<singleEntry,
+                                      std::array<Scalar, L::offset(Quantity::size)>,
+                                      std::array<std::vector<Scalar>, numQuantities>>;
+
+public:
+    template<Quantity q>
+    static constexpr bool isStored()
+    { return L::template isStored<q>(); }
+
+    static constexpr std::size_t width(Quantity q)
+    { return L::width(q); }
+
+    static constexpr bool hasPermeability()
+    { return storePermeability; }
+
+    void resize(std::size_t n)
+    {
+        if constexpr (!singleEntry)
+        {
+            size_ = n;
+            forEachStored_([&](auto q){ values_[index_(q)].resize(n*width(q)); });
+            priVars_.resize(n);
+            if constexpr (storePermeability)
+                permeability_.resize(n);
+        }
+    }
+
+    std::size_t size() const
+    {
+        if constexpr (singleEntry)
+            return 1;
+        else
+            return size_;
+    }
+
+    //! store the quantities of the volume variables vv in slot i
+    void assign(std::size_t i, const VV& vv)
+    {
+        using Q = Quantity;
+        setScalar_<Q::porosity>(i, vv, [](const auto& v){ return v.porosity(); });
+        setScalar_<Q::extrusionFactor>(i, vv, [](const auto& v){ return v.extrusionFactor(); });
+        setScalar_<Q::temperature>(i, vv, [](const auto& v){ return v.temperature(); });
+        setScalar_<Q::capillaryPressure>(i, vv, [](const auto& v){ return v.capillaryPressure(); });
+        setScalar_<Q::effectiveThermalConductivity>(i, vv, [](const auto& v){ return v.effectiveThermalConductivity(); });
+        setScalar_<Q::solidDensity>(i, vv, [](const auto& v){ return v.solidDensity(); });
+        setScalar_<Q::solidHeatCapacity>(i, vv, [](const auto& v){ return v.solidHeatCapacity(); });
+        setScalar_<Q::solidThermalConductivity>(i, vv, [](const auto& v){ return v.solidThermalConductivity(); });
+        setScalar_<Q::temperatureSolid>(i, vv, [](const auto& v){ return v.temperatureSolid(); });
+
+        setPhase_<Q::pressure>(i, vv, [](const auto& v, int p){ return v.pressure(p); });
+        setPhase_<Q::saturation>(i, vv, [](const auto& v, int p){ return v.saturation(p); });
+        setPhase_<Q::density>(i, vv, [](const auto& v, int p){ return v.density(p); });
+        setPhase_<Q::molarDensity>(i, vv, [](const auto& v, int p){ return v.molarDensity(p); });
+        setPhase_<Q::mobility>(i, vv, [](const auto& v, int p){ return v.mobility(p); });
+        setPhase_<Q::viscosity>(i, vv, [](const auto& v, int p){ return v.viscosity(p); });
+        setPhase_<Q::relativePermeability>(i, vv, [](const auto& v, int p){ return v.relativePermeability(p); });
+        setPhase_<Q::enthalpy>(i, vv, [](const auto& v, int p){ return v.enthalpy(p); });
+        setPhase_<Q::internalEnergy>(i, vv, [](const auto& v, int p){ return v.internalEnergy(p); });
+        setPhase_<Q::averageMolarMass>(i, vv, [](const auto& v, int p){ return v.averageMolarMass(p); });
+        setPhase_<Q::fluidThermalConductivity>(i, vv, [](const auto& v, int p){ return v.fluidThermalConductivity(p); });
+
+        if constexpr (isStored<Q::moleFraction>())
+            for (int p = 0; p < numPhases; ++p)
+                for (int c = 0; c < numComponents; ++c)
+                    entry_(Q::moleFraction, i, p*numComponents + c) = vv.moleFraction(p, c);
+
+        if constexpr (isStored<Q::massFraction>())
+            for (int p = 0; p < numPhases; ++p)
+                for (int c = 0; c < numComponents; ++c)
+                    entry_(Q::massFraction, i, p*numComponents + c) = vv.massFraction(p, c);
+
+        if constexpr (isStored<Q::effectiveDiffusionCoefficient>())
+            for (int p = 0; p < numPhases; ++p)
+                for (int c = 0; c < numComponents; ++c)
+                    if (c != diffusionReferenceComponent_(p))
+                        entry_(Q::effectiveDiffusionCoefficient, i, diffusionIndex_(p, c))
+                            = vv.effectiveDiffusionCoefficient(p, diffusionReferenceComponent_(p), c);
+
+        priVarsAt_(i) = vv.priVars();
+        if constexpr (storePermeability)
+            permeabilityAt_(i) = vv.permeability();
+    }
+
+    //! copy the values of slot j of another data object to slot i
+    template<bool otherSingleEntry>
+    void copy(std::size_t i, const Data<VV, otherSingleEntry>& other, std::size_t j)
+    {
+        forEachStored_([&](auto q)
+        {
+            std::copy_n(&other.entry_(q, j, 0), width(q), &entry_(q, i, 0));
+        });
+        priVarsAt_(i) = other.priVarsAt_(j);
+        if constexpr (storePermeability)
+            permeabilityAt_(i) = other.permeabilityAt_(j);
+    }
+
+    template<Quantity q>
+    Scalar value(std::size_t i, std::size_t j = 0) const
+    { return entry_(q, i, j); }
+
+    Scalar moleFraction(std::size_t i, int phaseIdx, int compIdx) const
+    { return value<Quantity::moleFraction>(i, phaseIdx*numComponents + compIdx); }
+
+    Scalar massFraction(std::size_t i, int phaseIdx, int compIdx) const
+    { return value<Quantity::massFraction>(i, phaseIdx*numComponents + compIdx); }
+
+    Scalar effectiveDiffusionCoefficient(std::size_t i, int phaseIdx, int compIIdx, int compJIdx) const
+    {
+        if (compIIdx != diffusionReferenceComponent_(phaseIdx))
+            std::swap(compIIdx, compJIdx);
+        return value<Quantity::effectiveDiffusionCoefficient>(i, diffusionIndex_(phaseIdx, compJIdx));
+    }
+
+    const PrimaryVariables& priVars(std::size_t i) const
+    { return priVarsAt_(i); }
+
+    const PermeabilityType& permeability(std::size_t i) const
+    { return permeabilityAt_(i); }
+
+private:
+    static constexpr std::size_t index_(Quantity q)
+    { return static_cast<std::size_t>(q); }
+
+    // the j-th value of quantity q of slot i
+    Scalar& entry_(Quantity q, std::size_t i, std::size_t j)
+    {
+        if constexpr (singleEntry)
+            return values_[L::offset(q) + j];
+        else
+            return values_[index_(q)][i*width(q) + j];
+    }
+
+    const Scalar& entry_(Quantity q, std::size_t i, std::size_t j) const
+    {
+        if constexpr (singleEntry)
+            return values_[L::offset(q) + j];
+        else
+            return values_[index_(q)][i*width(q) + j];
+    }
+
+    PrimaryVariables& priVarsAt_(std::size_t i)
+    {
+        if constexpr (singleEntry)
+            return priVars_;
+        else
+            return priVars_[i];
+    }
+
+    const PrimaryVariables& priVarsAt_(std::size_t i) const
+    {
+        if constexpr (singleEntry)
+            return priVars_;
+        else
+            return priVars_[i];
+    }
+
+    PermeabilityType& permeabilityAt_(std::size_t i)
+    {
+        if constexpr (singleEntry)
+            return permeability_;
+        else
+            return permeability_[i];
+    }
+
+    const PermeabilityType& permeabilityAt_(std::size_t i) const
+    {
+        if constexpr (singleEntry)
+            return permeability_;
+        else
+            return permeability_[i];
+    }
+
+    // the diffusion coefficients are stored with respect to the main component
+    // of each phase (cf. FickianDiffusionCoefficients)
+    static constexpr int diffusionReferenceComponent_(int phaseIdx)
+    { return std::min<int>(phaseIdx, numComponents-1); }
+
+    static constexpr std::size_t diffusionIndex_(int phaseIdx, int compJIdx)
+    { return phaseIdx*(numComponents-1) + compJIdx - (phaseIdx < compJIdx ? 1 : 0); }
+
+    template<class F>
+    static void forEachStored_(F&& f)
+    {
+        forEachStoredImpl_(std::forward<F>(f), std::make_index_sequence<numQuantities>{});
+    }
+
+    template<class F, std::size_t... I>
+    static void forEachStoredImpl_(F&& f, std::index_sequence<I...>)
+    {
+        ([&]{
+            constexpr auto q = static_cast<Quantity>(I);
+            if constexpr (isStored<q>())
+                f(std::integral_constant<Quantity, q>{});
+        }(), ...);
+    }
+
+    // the accessors are generic lambdas which are only instantiated for the stored quantities
+    template<Quantity q, class F>
+    void setScalar_(std::size_t i, const VV& vv, F&& f)
+    {
+        if constexpr (isStored<q>())
+            entry_(q, i, 0) = f(vv);
+    }
+
+    template<Quantity q, class F>
+    void setPhase_(std::size_t i, const VV& vv, F&& f)
+    {
+        if constexpr (isStored<q>())
+            for (int p = 0; p < numPhases; ++p)
+                entry_(q, i, p) = f(vv, p);
+    }
+
+    std::size_t size_ = 0;
+    Values values_;
+    Storage<PrimaryVariables> priVars_;
+    Storage<PermeabilityType> permeability_;
+};
+
+template<class VV>
+using PVSwitch = typename VV::PrimaryVariableSwitch;
+
+//! the types exported by the volume variables
+template<class VV, bool hasPrimaryVariableSwitch = Dune::Std::is_detected<PVSwitch, VV>::value>
+struct Types
+{
+    using Indices = typename VV::Indices;
+    using FluidSystem = typename VV::FluidSystem;
+    using FluidState = typename VV::FluidState;
+    using SolidSystem = typename VV::SolidSystem;
+    using SolidState = typename VV::SolidState;
+};
+
+template<class VV>
+struct Types<VV, true> : public Types<VV, false>
+{
+    using PrimaryVariableSwitch = typename VV::PrimaryVariableSwitch;
+};
+
+} // end namespace Detail::SoAVolVars
+
+/*!
+ * \ingroup PorousmediumflowModels
+ * \brief Volume variables backed by a structure-of-arrays storage
+ *
+ * Wraps the volume variables VV of a porous medium flow model. Instead of the full object,
+ * which contains the complete fluid and solid states, only the quantities accessed by the
+ * local residuals, the flux laws, the primary variable switch and the output are kept: one
+ * contiguous array per quantity (e.g. all phase densities, all mole fractions) for all
+ * degrees of freedom. On update, a temporary VV is updated and its values are scattered into
+ * the arrays. This reduces the memory footprint and the memory traffic for large grid-cached
+ * simulations, in particular for compositional and non-isothermal models.
+ *
+ * Objects of this class are lightweight proxies to a slot of a SoAVolumeVariablesContainer
+ * with value semantics: copies are independent volume variables and assigning to a proxy
+ * overwrites the values of its slot. The cached grid volume variables use the container
+ * exported as `GridStorage`. Use it by setting the VolumeVariables property to
+ * `SoAVolumeVariables<VV>` and enabling the grid volume variables cache.
+ *
+ * \note The fluid and solid states (fluidState(), solidState()) are not available.
+ *       Accessing a quantity that VV doesn't provide results in a compile-time error.
+ */
+template<class VV>
+class SoAVolumeVariables : public Detail::SoAVolVars::Types<VV>
+{
+    using Data = Detail::SoAVolVars::Data<VV>;
+    using SingleData = Detail::SoAVolVars::Data<VV, true>;
+    using Q = Detail::SoAVolVars::Quantity;
+    using Scalar = std::decay_t<decltype(std::declval<const VV&>().extrusionFactor())>;
+
+    template<Q q>
+    static constexpr bool isStored = Data::template isStored<q>();
+
+public:
+    //! export the underlying (full) volume variables type
+    using FullVolumeVariables = VV;
+    //! export the storage used by the cached grid volume variables
+    using GridStorage = SoAVolumeVariablesContainer<VV>;
+    //! export the type used for the primary variables
+    using PrimaryVariables = typename VV::PrimaryVariables;
+
+    //! Construct independent volume variables (the values are stored in one fixed-size block)
+    SoAVolumeVariables()
+    : owned_(std::make_unique<SingleData>())
+    {}
+
+    //! Construct a proxy to slot i of the given data
+    SoAVolumeVariables(Data& data, std::size_t i)
+    : storage_(&data), idx_(i)
+    {}
+
+    //! A copy holds its own values
+    SoAVolumeVariables(const SoAVolumeVariables& other)
+    : SoAVolumeVariables()
+    { other.visit_([&](const auto& data, std::size_t i){ owned_->copy(0, data, i); }); }
+
+    SoAVolumeVariables(SoAVolumeVariables&& other) noexcept = default;
+
+    //! Assignment copies the values into the slot of this proxy
+    SoAVolumeVariables& operator=(const SoAVolumeVariables& other)
+    {
+        if (this != &other)
+            visit_([&](auto& data, std::size_t i){
+                other.visit_([&](const auto& otherData, std::size_t j){ data.copy(i, otherData, j); });
+            });
+        return *this;
+    }
+
+    SoAVolumeVariables& operator=(SoAVolumeVariables&& other)
+    { return *this = static_cast<const SoAVolumeVariables&>(other); }
+
+    //! Update all quantities for a given control volume
+    template<class... Args>
+    void update(Args&&... args)
+    {
+        VV volVars;
+        volVars.update(std::forward<Args>(args)...);
+        visit_([&](auto& data, std::size_t i){ data.assign(i, volVars); });
+    }
+
+    static constexpr auto numFluidPhases() { return VV::numFluidPhases(); }
+    static constexpr auto numFluidComponents() { return VV::numFluidComponents(); }
+    static constexpr auto useMoles() { return VV::useMoles(); }
+    static constexpr auto priVarFormulation() { return VV::priVarFormulation(); }
+
+    const PrimaryVariables& priVars() const
+    { return visit_([](const auto& data, std::size_t i) -> const PrimaryVariables& { return data.priVars(i); }); }
+
+    Scalar priVar(int pvIdx) const
+    { return priVars()[pvIdx]; }
+
+    const auto& permeability() const
+    {
+        static_assert(Data::hasPermeability(), "VolumeVariables have no permeability");
+        return visit_([](const auto& data, std::size_t i) -> const auto& { return data.permeability(i); });
+    }
+
+    Scalar porosity() const { return scalar_<Q::porosity>(); }
+    Scalar extrusionFactor() const { return scalar_<Q::extrusionFactor>(); }
+    Scalar temperature() const { return scalar_<Q::temperature>(); }
+    Scalar capillaryPressure() const { return scalar_<Q::capillaryPressure>(); }
+    Scalar effectiveThermalConductivity() const { return scalar_<Q::effectiveThermalConductivity>(); }
+    Scalar solidDensity() const { return scalar_<Q::solidDensity>(); }
+    Scalar solidHeatCapacity() const { return scalar_<Q::solidHeatCapacity>(); }
+    Scalar solidThermalConductivity() const { return scalar_<Q::solidThermalConductivity>(); }
+    Scalar temperatureSolid() const { return scalar_<Q::temperatureSolid>(); }
+
+    Scalar pressure(int phaseIdx = 0) const { return scalar_<Q::pressure>(phaseIdx); }
+    Scalar saturation(int phaseIdx = 0) const { return scalar_<Q::saturation>(phaseIdx); }
+    Scalar density(int phaseIdx = 0) const { return scalar_<Q::density>(phaseIdx); }
+    Scalar molarDensity(int phaseIdx = 0) const { return scalar_<Q::molarDensity>(phaseIdx); }
+    Scalar mobility(int phaseIdx = 0) const { return scalar_<Q::mobility>(phaseIdx); }
+    Scalar viscosity(int phaseIdx = 0) const { return scalar_<Q::viscosity>(phaseIdx); }
+    Scalar relativePermeability(int phaseIdx = 0) const { return scalar_<Q::relativePermeability>(phaseIdx); }
+    Scalar enthalpy(int phaseIdx = 0) const { return scalar_<Q::enthalpy>(phaseIdx); }
+    Scalar internalEnergy(int phaseIdx = 0) const { return scalar_<Q::internalEnergy>(phaseIdx); }
+    Scalar averageMolarMass(int phaseIdx = 0) const { return scalar_<Q::averageMolarMass>(phaseIdx); }
+    Scalar fluidThermalConductivity(int phaseIdx = 0) const { return scalar_<Q::fluidThermalConductivity>(phaseIdx); }
+
+    Scalar moleFraction(int phaseIdx, int compIdx) const
+    {
+        static_assert(isStored<Q::moleFraction>, "VolumeVariables have no moleFraction");
+        return visit_([&](const auto& data, std::size_t i){ return data.moleFraction(i, phaseIdx, compIdx); });
+    }
+
+    Scalar massFraction(int phaseIdx, int compIdx) const
+    {
+        static_assert(isStored<Q::massFraction>, "VolumeVariables have no massFraction");
+        return visit_([&](const auto& data, std::size_t i){ return data.massFraction(i, phaseIdx, compIdx); });
+    }
+
+    Scalar effectiveDiffusionCoefficient(int phaseIdx, int compIIdx, int compJIdx) const
+    {
+        static_assert(isStored<Q::effectiveDiffusionCoefficient>, "VolumeVariables have no effectiveDiffusionCoefficient");
+        return visit_([&](const auto& data, std::size_t i){ return data.effectiveDiffusionCoefficient(i, phaseIdx, compIIdx, compJIdx); });
+    }
+
+private:
+    template<Q q>
+    Scalar scalar_(int j = 0) const
+    {
+        static_assert(isStored<q>, "Quantity is not provided by the underlying volume variables");
+        return visit_([&](const auto& data, std::size_t i){ return data.template value<q>(i, j); });
+    }
+
+    //! call f(data, slot) with the own values or the slot of the grid storage
+    template<class F>
+    decltype(auto) visit_(F&& f) const
+    {
+        if (owned_)
+            return f(static_cast<const SingleData&>(*owned_), std::size_t(0));
+        else
+            return f(static_cast<const Data&>(*storage_), idx_);
+    }
+
+    template<class F>
+    decltype(auto) visit_(F&& f)
+    {
+        if (owned_)
+            return f(*owned_, std::size_t(0));
+        else
+            return f(*storage_, idx_);
+    }
+
+    // proxies of the grid storage only hold a pointer to it (the container stores one proxy per dof),
+    // standalone volume variables own a single fixed-size block of values
+    Data* storage_ = nullptr;
+    std::size_t idx_ = 0;
+    std::unique_ptr<SingleData> owned_;
+};
+
+/*!
+ * \ingroup PorousmediumflowModels
+ * \brief Container of volume variables with structure-of-arrays layout
+ *        (the grid storage of SoAVolumeVariables)
+ */
+template<class VV>
+class SoAVolumeVariablesContainer
+{
+    using Data = Detail::SoAVolVars::Data<VV>;
+
+public:
+    using value_type = SoAVolumeVariables<VV>;
+
+    SoAVolumeVariablesContainer() = default;
+
+    SoAVolumeVariablesContainer(const SoAVolumeVariablesContainer& other)
+    : data_(other.data_)
+    { bind_(); }
+
+    SoAVolumeVariablesContainer& operator=(const SoAVolumeVariablesContainer& other)
+    {
+        data_ = other.data_;
+        bind_();
+        return *this;
+    }
+
+    // the proxies point to the data of this object
+    SoAVolumeVariablesContainer(SoAVolumeVariablesContainer&& other)
+    : SoAVolumeVariablesContainer(static_cast<const SoAVolumeVariablesContainer&>(other))
+    {}
+
+    SoAVolumeVariablesContainer& operator=(SoAVolumeVariablesContainer&& other)
+    { return *this = static_cast<const SoAVolumeVariablesContainer&>(other); }
+
+    void resize(std::size_t n)
+    {
+        data_.resize(n);
+        bind_();
+    }
+
+    std::size_t size() const
+    { return data_.size(); }
+
+    value_type& operator[](std::size_t i)
+    { return proxies_[i]; }
+
+    const value_type& operator[](std::size_t i) const
+    { return proxies_[i]; }
+
+private:
+    void bind_()
+    {
+        proxies_.clear();
+        proxies_.reserve(data_.size());
+        for (std::size_t i = 0; i < data_.size(); ++i)
+            proxies_.emplace_back(data_, i);
+    }
+
+    Data data_;
+    std::vector<value_type> proxies_;
+};
+
+} // end namespace Dumux
+
+#endif
@@ -24,11 +24,73 @@
 #ifndef DUMUX_PYTHON_COMMON_FVASSEMBLER_HH
 #define DUMUX_PYTHON_COMMON_FVASSEMBLER_HH
 
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/std/type_traits.hh>
 #include <dune/python/pybind11/pybind11.h>
 #include <dune/python/pybind11/stl.h>
+#include <dune/python/pybind11/numpy.h>
 
 namespace Dumux::Python {
 
+namespace Detail {
+
+// a NumPy array of shape (size, blockSize) sharing the memory of a block vector
+// the owner is kept alive as long as the array exists
+template<class BlockVector>
+auto blockVectorArray(BlockVector& v, pybind11::handle owner)
+{
+    using Scalar = typename BlockVector::field_type;
+    using Block = typename BlockVector::block_type;
+    constexpr std::size_t blockSize = Block::dimension;
+    static_assert(sizeof(Block) == blockSize*sizeof(Scalar), "Blocks have to be stored contiguously");
+
+    Scalar* data = v.size() > 0 ? &v[0][0] : nullptr;
+    return pybind11::array_t<Scalar>({v.size(), blockSize},
+                                     {blockSize*sizeof(Scalar), sizeof(Scalar)},
+                                     data, owner);
+}
+
+// a NumPy array of shape (nnz, rows, cols) sharing the memory of the blocks of a BCRS matrix
+template<class Matrix>
+auto matrixValuesArray(Matrix& m, pybind11::handle owner)
+{
+    using Scalar = typename Matrix::field_type;
+    using Block = typename Matrix::block_type;
+    constexpr std::size_t rows = Block::rows;
+    constexpr std::size_t cols = Block::cols;
+    static_assert(sizeof(Block) == rows*cols*sizeof(Scalar), "Blocks have to be stored contiguously");
+
+    const std::size_t nnz = m.nonzeroes();
+    Scalar* data = nnz > 0 ? &(*m[0].begin())[0][0] : nullptr;
+
+    // the blocks of all rows are stored in one contiguous array in row order
+    std::size_t offset = 0;
+    for (auto row = m.begin(); row != m.end(); offset += row->size(), ++row)
+        if (row->size() > 0 && &(*row->begin())[0][0] != data + offset*rows*cols)
+            DUNE_THROW(Dune::InvalidStateException, "The matrix blocks are not stored contiguously");
+
+    return pybind11::array_t<Scalar>({nnz, rows, cols},
+                                     {rows*cols*sizeof(Scalar), cols*sizeof(Scalar), sizeof(Scalar)},
+                                     data, owner);
+}
+
+template<class Problem>
+using AtPosCacheDetector = decltype(std::declval<const Problem&>().updateAtPosCache());
+
+// update the values of batched Python functions cached by the problem (they may depend on time)
+template<class Problem>
+void updateAtPosCache(const Problem& problem)
+{
+    if constexpr (Dune::Std::is_detected<AtPosCacheDetector, Problem>::value)
+        problem.updateAtPosCache();
+}
+
+} // end namespace Detail
+
 // Python wrapper for the FVAssembler C++ class
 template<class FVAssembler, class... options>
 void registerFVAssembler(pybind11::handle scope, pybind11::class_<FVAssembler, options...> cls)
@@ -59,15 +121,45 @@ void registerFVAssembler(pybind11::handle scope, pybind11::class_<FVAssembler, o
     cls.def_property_readonly("isStationaryProblem", &FVAssembler::isStationaryProblem);
     cls.def_property_readonly("gridVariables", [](FVAssembler& self) { return self.gridVariables(); });
 
+    // zero-copy NumPy views (valid as long as the data is not resized, e.g. after grid adaption)
+    cls.def("residualArray", [](pybind11::object self){
+        return Detail::blockVectorArray(self.template cast<FVAssembler&>().residual(), self);
+    }, "the residual as NumPy array of shape (numDofs, numEq) sharing memory with the assembler");
+
+    cls.def("jacobianValues", [](pybind11::object self){
+        return Detail::matrixValuesArray(self.template cast<FVAssembler&>().jacobian(), self);
+    }, "the nonzero blocks of the Jacobian as NumPy array of shape (nnz, numEq, numEq) sharing memory with the assembler");
+
+    cls.def("jacobianPattern", [](FVAssembler& self){
+        const auto& jac = self.jacobian();
+        std::vector<std::size_t> rowOffsets(jac.N() + 1, 0), columnIndices;
+        columnIndices.reserve(jac.nonzeroes());
+        for (auto row = jac.begin(); row != jac.end(); ++row)
+        {
+            for (auto col = row->begin(); col != row->end(); ++col)
+                columnIndices.push_back(col.index());
+            rowOffsets[row.index() + 1] = columnIndices.size();
+        }
+
+        return std::make_tuple(pybind11::array_t<std::size_t>(rowOffsets.size(), rowOffsets.data()),
+                               pybind11::array_t<std::size_t>(columnIndices.size(), columnIndices.data()));
+    }, "the sparsity pattern of the Jacobian (row offsets, column indices) in compressed sparse row format");
+
+    cls.def_static("asArray", [](pybind11::object sol){
+        return Detail::blockVectorArray(sol.template cast<SolutionVector&>(), sol);
+    }, "a solution vector as NumPy array of shape (numDofs, numEq) sharing memory with the vector");
+
     cls.def("updateGridVariables", [](FVAssembler& self, const SolutionVector& curSol){
         self.updateGridVariables(curSol);
     });
 
     cls.def("assembleResidual", [](FVAssembler& self, const SolutionVector& curSol){
+        Detail::updateAtPosCache(self.problem());
         self.assembleResidual(curSol);
     });
 
     cls.def("assembleJacobianAndResidual", [](FVAssembler& self, const SolutionVector& curSol){
+        Detail::updateAtPosCache(self.problem());
         self.assembleJacobianAndResidual(curSol);
     });
 }
@@ -27,10 +27,12 @@
 #include <string>
 #include <memory>
 #include <tuple>
+#include <vector>
 
 #include <dune/common/fvector.hh>
 #include <dune/common/exceptions.hh>
 #include <dune/python/pybind11/pybind11.h>
+#include <dune/python/pybind11/numpy.h>
 
 #include <dumux/common/boundarytypes.hh>
 #include <dumux/discretization/method.hh>
@@ -41,6 +43,14 @@ namespace Dumux::Python {
 /*!
  * \ingroup Common
  * \brief A C++ wrapper for a Python problem
+ *
+ * If the Python problem has the attribute `batchedAtPos = True`, the functions
+ * `sourceAtPos`, `dirichletAtPos` and `neumannAtPos` are called only once with a
+ * NumPy array of all positions (shape (numPositions, dimWorld)) and have to return
+ * the values for all positions (shape (numPositions, numEq), or a single value for all positions).
+ * The values are cached. The Python assembler updates the cache before each assembly
+ * (e.g. for time-dependent values), otherwise call updateAtPosCache() if the values change.
+ * Functions evaluated per entity (e.g. `source(element, fvGeometry, scv)`) take precedence.
  */
 template<class GridGeometry_, class PrimaryVariables, bool enableInternalDirichletConstraints_>
 class FVProblem
@@ -71,6 +81,117 @@ public:
 
         if (pybind11::hasattr(pyProblem_, "paramGroup"))
             paramGroup_ = pyProblem.attr("paramGroup")().template cast<std::string>();
+
+        // look up the interface of the Python problem only once
+        hasBoundaryTypes_ = pybind11::hasattr(pyProblem_, "boundaryTypes");
+        hasDirichlet_ = pybind11::hasattr(pyProblem_, "dirichlet");
+        hasNeumann_ = pybind11::hasattr(pyProblem_, "neumann");
+        hasSource_ = pybind11::hasattr(pyProblem_, "source");
+        hasScvPointSources_ = pybind11::hasattr(pyProblem_, "scvPointSources");
+        hasAddSourceDerivatives_ = pybind11::hasattr(pyProblem_, "addSourceDerivatives");
+
+        if (pybind11::hasattr(pyProblem_, "batchedAtPos"))
+            batchedAtPos_ = pyProblem_.attr("batchedAtPos").template cast<bool>();
+
+        updateAtPosCache();
+    }
+
+    /*!
+     * \brief Evaluate the batched sourceAtPos, dirichletAtPos and neumannAtPos
+     *        of the Python problem for all positions at once and cache the values
+     * \note Does nothing if the Python problem does not use batched functions
+     */
+    void updateAtPosCache() const
+    {
+        if (!batchedAtPos_)
+            return;
+
+        const auto& gg = *gridGeometry_;
+        auto fvGeometry = localView(gg);
+
+        // the source at all dof positions
+        if (!hasSource_ && pybind11::hasattr(pyProblem_, "sourceAtPos"))
+        {
+            std::vector<GlobalPosition> positions(gg.numDofs());
+            for (const auto& element : elements(gg.gridView()))
+            {
+                fvGeometry.bindElement(element);
+                for (const auto& scv : scvs(fvGeometry))
+                    positions[scv.dofIndex()] = scv.dofPosition();
+            }
+
+            sourceCache_ = evalAtPositions_<NumEqVector>("sourceAtPos", positions);
+        }
+
+        // the Dirichlet values at boundary dofs (box) or boundary faces (cc)
+        // and the Neumann fluxes at all boundary faces
+        const bool cacheDirichlet = !hasDirichlet_ && pybind11::hasattr(pyProblem_, "dirichletAtPos");
+        const bool cacheNeumann = !hasNeumann_ && pybind11::hasattr(pyProblem_, "neumannAtPos");
+
+        std::size_t numFaceKeys = 0;
+        if constexpr (isBox)
+        {
+            faceKeyOffset_.resize(gg.gridView().size(0));
+            for (const auto& element : elements(gg.gridView()))
+            {
+                fvGeometry.bindElement(element);
+                faceKeyOffset_[gg.elementMapper().index(element)] = numFaceKeys;
+                numFaceKeys += fvGeometry.numScvf();
+            }
+        }
+        else
+            numFaceKeys = gg.numScvf();
+
+        std::vector<std::size_t> dirichletKeys, neumannKeys;
+        std::vector<GlobalPosition> dirichletPositions, neumannPositions;
+        std::vector<bool> dofVisited(isBox ? gg.numDofs() : 0, false);
+        for (const auto& element : elements(gg.gridView()))
+        {
+            if (!element.hasBoundaryIntersections())
+                continue;
+
+            fvGeometry.bindElement(element);
+            for (const auto& scvf : scvfs(fvGeometry))
+            {
+                if (!scvf.boundary())
+                    continue;
+
+                neumannKeys.push_back(faceKey_(element, scvf));
+                neumannPositions.push_back(scvf.ipGlobal());
+
+                if constexpr (isBox)
+                {
+                    const auto& scv = fvGeometry.scv(scvf.insideScvIdx());
+                    if (!dofVisited[scv.dofIndex()])
+                    {
+                        dofVisited[scv.dofIndex()] = true;
+                        dirichletKeys.push_back(scv.dofIndex());
+                        dirichletPositions.push_back(scv.dofPosition());
+                    }
+                }
+                else
+                {
+                    dirichletKeys.push_back(scvf.index());
+                    dirichletPositions.push_back(scvf.ipGlobal());
+                }
+            }
+        }
+
+        if (cacheDirichlet)
+        {
+            const auto values = evalAtPositions_<PrimaryVariables>("dirichletAtPos", dirichletPositions);
+            dirichletCache_.assign(isBox ? gg.numDofs() : numFaceKeys, PrimaryVariables(0.0));
+            for (std::size_t i = 0; i < values.size(); ++i)
+                dirichletCache_[dirichletKeys[i]] = values[i];
+        }
+
+        if (cacheNeumann)
+        {
+            const auto values = evalAtPositions_<NumEqVector>("neumannAtPos", neumannPositions);
+            neumannCache_.assign(numFaceKeys, NumEqVector(0.0));
+            for (std::size_t i = 0; i < values.size(); ++i)
+                neumannCache_[neumannKeys[i]] = values[i];
+        }
     }
 
     const std::string& name() const
@@ -86,7 +207,7 @@ public:
             DUNE_THROW(Dune::InvalidStateException, "boundaryTypes(..., scv) called for cell-centered method.");
         else
         {
-            if (pybind11::hasattr(pyProblem_, "boundaryTypes"))
+            if (hasBoundaryTypes_)
                 return pyProblem_.attr("boundaryTypes")(element, scv).template cast<BoundaryTypes>();
             else
                 return pyProblem_.attr("boundaryTypesAtPos")(scv.dofPosition()).template cast<BoundaryTypes>();
@@ -100,7 +221,7 @@ public:
             DUNE_THROW(Dune::InvalidStateException, "boundaryTypes(..., scvf) called for box method.");
         else
         {
-            if (pybind11::hasattr(pyProblem_, "boundaryTypes"))
+            if (hasBoundaryTypes_)
                 return pyProblem_.attr("boundaryTypes")(element, scvf).template cast<BoundaryTypes>();
             else
                 return pyProblem_.attr("boundaryTypesAtPos")(scvf.ipGlobal()).template cast<BoundaryTypes>();
@@ -114,8 +235,10 @@ public:
             DUNE_THROW(Dune::InvalidStateException, "dirichlet(scv) called for cell-centered method.");
         else
         {
-            if (pybind11::hasattr(pyProblem_, "dirichlet"))
+            if (hasDirichlet_)
                 return pyProblem_.attr("dirichlet")(element, scv).template cast<PrimaryVariables>();
+            else if (!dirichletCache_.empty())
+                return dirichletCache_[scv.dofIndex()];
             else
                 return pyProblem_.attr("dirichletAtPos")(scv.dofPosition()).template cast<PrimaryVariables>();
         }
@@ -128,8 +251,10 @@ public:
             DUNE_THROW(Dune::InvalidStateException, "dirichlet(scvf) called for box method.");
         else
         {
-            if (pybind11::hasattr(pyProblem_, "dirichlet"))
+            if (hasDirichlet_)
                 return pyProblem_.attr("dirichlet")(element, scvf).template cast<PrimaryVariables>();
+            else if (!dirichletCache_.empty())
+                return dirichletCache_[scvf.index()];
             else
                 return pyProblem_.attr("dirichletAtPos")(scvf.ipGlobal()).template cast<PrimaryVariables>();
         }
@@ -142,8 +267,10 @@ public:
                         const ElementFluxVariablesCache& elemFluxVarsCache,
                         const SubControlVolumeFace& scvf) const
     {
-        if (pybind11::hasattr(pyProblem_, "neumann"))
+        if (hasNeumann_)
             return pyProblem_.attr("neumann")(element, fvGeometry, scvf).template cast<NumEqVector>();
+        else if (!neumannCache_.empty())
+            return neumannCache_[faceKey_(element, scvf)];
         else
             return pyProblem_.attr("neumannAtPos")(scvf.ipGlobal()).template cast<NumEqVector>();
     }
@@ -154,15 +281,20 @@ public:
                        const ElementVolumeVariables& elemVolVars,
                        const SubControlVolume &scv) const
     {
-        if (pybind11::hasattr(pyProblem_, "source"))
+        if (hasSource_)
             return pyProblem_.attr("source")(element, fvGeometry, scv).template cast<NumEqVector>();
+        else if (!sourceCache_.empty())
+            return sourceCache_[scv.dofIndex()];
         else
-            return pyProblem_.attr("sourceAtPos")(scv.dofPosition()).template cast<NumEqVector>();
+            return sourceAtPos(scv.dofPosition());
     }
 
     NumEqVector sourceAtPos(const GlobalPosition &globalPos) const
     {
-        return pyProblem_.attr("sourceAtPos")(globalPos).template cast<NumEqVector>();
+        if (batchedAtPos_)
+            return evalAtPositions_<NumEqVector>("sourceAtPos", std::vector<GlobalPosition>{globalPos})[0];
+        else
+            return pyProblem_.attr("sourceAtPos")(globalPos).template cast<NumEqVector>();
     }
 
     template<class ElementVolumeVariables>
@@ -171,7 +303,7 @@ public:
                                 const ElementVolumeVariables& elemVolVars,
                                 const SubControlVolume& scv) const
     {
-        if (pybind11::hasattr(pyProblem_, "scvPointSources"))
+        if (hasScvPointSources_)
             return pyProblem_.attr("scvPointSources")(element, fvGeometry, scv).template cast<NumEqVector>();
         else
             return NumEqVector(0.0);
@@ -210,7 +342,7 @@ public:
                               const VolumeVariables& volVars,
                               const SubControlVolume& scv) const
     {
-        if (pybind11::hasattr(pyProblem_, "addSourceDerivatives"))
+        if (hasAddSourceDerivatives_)
             pyProblem_.attr("addSourceDerivatives")(block, element, fvGeometry, scv);
     }
 
@@ -218,10 +350,65 @@ public:
     { return *gridGeometry_; }
 
 private:
+    // the index of a boundary face in the caches (box scvf indices are element-local)
+    std::size_t faceKey_(const Element& element, const SubControlVolumeFace& scvf) const
+    {
+        if constexpr (isBox)
+            return faceKeyOffset_[gridGeometry_->elementMapper().index(element)] + scvf.index();
+        else
+            return scvf.index();
+    }
+
+    // call a batched function of the Python problem with all positions at once
+    template<class Value>
+    std::vector<Value> evalAtPositions_(const char* name, const std::vector<GlobalPosition>& positions) const
+    {
+        constexpr std::size_t dimWorld = GlobalPosition::dimension;
+        constexpr std::size_t size = Value::dimension;
+
+        pybind11::array_t<Scalar> pyPositions({positions.size(), dimWorld});
+        auto p = pyPositions.template mutable_unchecked<2>();
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            for (std::size_t d = 0; d < dimWorld; ++d)
+                p(i, d) = positions[i][d];
+
+        using Array = pybind11::array_t<Scalar, pybind11::array::c_style | pybind11::array::forcecast>;
+        const auto result = Array::ensure(pyProblem_.attr(name)(pyPositions));
+        if (!result)
+            DUNE_THROW(Dune::InvalidStateException, "Batched " << name << " has to return an array of numbers");
+
+        // a single value is used for all positions
+        const bool broadcast = static_cast<std::size_t>(result.size()) == size;
+        if (!broadcast && static_cast<std::size_t>(result.size()) != positions.size()*size)
+            DUNE_THROW(Dune::InvalidStateException, "Batched " << name << " returned " << result.size()
+                                                    << " values, expected " << positions.size()*size);
+
+        const Scalar* data = result.data();
+        std::vector<Value> values(positions.size(), Value(0.0));
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            for (std::size_t k = 0; k < size; ++k)
+                values[i][k] = data[(broadcast ? 0 : i*size) + k];
+
+        return values;
+    }
+
     std::shared_ptr<const GridGeometry> gridGeometry_;
     pybind11::object pyProblem_;
     std::string name_;
     std::string paramGroup_;
+
+    bool hasBoundaryTypes_ = false;
+    bool hasDirichlet_ = false;
+    bool hasNeumann_ = false;
+    bool hasSource_ = false;
+    bool hasScvPointSources_ = false;
+    bool hasAddSourceDerivatives_ = false;
+
+    bool batchedAtPos_ = false;
+    mutable std::vector<NumEqVector> sourceCache_;
+    mutable std::vector<PrimaryVariables> dirichletCache_;
+    mutable std::vector<NumEqVector> neumannCache_;
+    mutable std::vector<std::size_t> faceKeyOffset_;
 };
 
 // Python wrapper for the above FVProblem C++ class
@@ -261,6 +448,7 @@ void registerFVProblem(pybind11::handle scope, pybind11::class_<Problem, options
     cls.def("neumann", &Problem::template neumann<decltype(std::ignore), decltype(std::ignore)>);
     cls.def("source", &Problem::template source<decltype(std::ignore)>);
     cls.def("sourceAtPos", &Problem::sourceAtPos);
+    cls.def("updateAtPosCache", &Problem::updateAtPosCache);
     cls.def("initial", &Problem::template initial<Element>);
     cls.def("initial", &Problem::template initial<Vertex>);
     cls.def("extrusionFactor", &Problem::template extrusionFactor<decltype(std::ignore)>);
@@ -107,6 +107,7 @@ void registerPorousMediumFlowProblem(pybind11::handle scope, pybind11::class_<Pr
     cls.def("neumann", &Problem::template neumann<decltype(std::ignore), decltype(std::ignore)>);
     cls.def("source", &Problem::template source<decltype(std::ignore)>);
     cls.def("sourceAtPos", &Problem::sourceAtPos);
+    cls.def("updateAtPosCache", &Problem::updateAtPosCache);
     cls.def("initial", &Problem::template initial<Element>);
     cls.def("initial", &Problem::template initial<Vertex>);
     cls.def("extrusionFactor", &Problem::template extrusionFactor<decltype(std::ignore)>);
@@ -0,0 +1,260 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup TimeStepping
+ * \brief A time stepper with error-based time step size control for embedded multi-stage methods
+ */
+#ifndef DUMUX_TIMESTEPPING_ADAPTIVE_MULTISTAGE_TIMESTEPPER_HH
+#define DUMUX_TIMESTEPPING_ADAPTIVE_MULTISTAGE_TIMESTEPPER_HH
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <iostream>
+#include <utility>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/typetraits.hh>
+#include <dune/common/std/type_traits.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/common/exceptions.hh>
+#include <dumux/io/format.hh>
+
+#include <dumux/timestepping/multistagemethods.hh>
+#include <dumux/timestepping/multistagetimestepper.hh>
+#include <dumux/timestepping/stepsizecontroller.hh>
+
+namespace Dumux::Experimental {
+
+namespace Detail {
+
+//! The maximum over all entries of |x - xHat|/(atol + rtol*max(|x|, |xOld|)) for (nested) vectors
+template<class Scalar, class V>
+Scalar maxScaledDifference(const V& x, const V& xHat, const V& xOld, const Scalar atol, const Scalar rtol)
+{
+    using std::abs; using std::max;
+    if constexpr (Dune::IsNumber<V>::value)
+        return abs(x - xHat)/(atol + rtol*max(abs(x), abs(xOld)));
+    else
+    {
+        Scalar result = 0.0;
+        Dune::Hybrid::forEach(Dune::Hybrid::integralRange(Dune::Hybrid::size(x)), [&](auto i)
+        { result = max(result, maxScaledDifference<Scalar>(x[i], xHat[i], xOld[i], atol, rtol)); });
+        return result;
+    }
+}
+
+//! Whether the PDE solver exports a communication object
+template<class PDESolver>
+using CommDetector = decltype(std::declval<const PDESolver&>().comm());
+
+template<class PDESolver>
+static constexpr bool hasComm()
+{ return Dune::Std::is_detected<CommDetector, PDESolver>::value; }
+
+} // end namespace Detail
+
+/*!
+ * \ingroup TimeStepping
+ * \brief Time stepping with an embedded multi-stage method and error-based time step size control
+ *
+ * Each step computes the solution \f$ x^{n+1} \f$ of the method and the embedded
+ * solution \f$ \hat{x}^{n+1} \f$ of lower order (see EmbeddedMultiStageMethod). The local error
+ * is estimated by the scaled maximum norm
+ *
+ * \f[
+ *   e = \max_j \frac{|x^{n+1}_j - \hat{x}^{n+1}_j|}{a + r \max(|x^{n+1}_j|, |x^n_j|)}
+ * \f]
+ *
+ * with the absolute and relative tolerances \f$ a, r\f$. Steps with \f$ e \leq 1 \f$ are accepted
+ * and the size of the next step is suggested by a PIStepSizeController, otherwise (and if the
+ * PDE solver fails to converge) the step is repeated with a smaller time step size.
+ * This way, the time step size is determined by the accuracy of the solution and not
+ * by the number of iterations the nonlinear solver needs to converge.
+ *
+ * The following run-time parameters are used (in addition to the ones of the PIStepSizeController)
+ *  - TimeStepping.AbsoluteTolerance: the absolute tolerance \f$ a \f$ (default 1e-6)
+ *  - TimeStepping.RelativeTolerance: the relative tolerance \f$ r \f$ (default 1e-4)
+ *  - TimeStepping.MaxTimeStepDivisions: the number of retries of a time step (default 10)
+ *  - TimeStepping.RetryTimeStepReductionFactor: the time step reduction if the PDE solver failed (default 0.5)
+ *  - TimeStepping.Verbosity: the verbosity level (default 1)
+ *
+ * \note The solution of the embedded stage requires an additional solve per time step. For
+ *       explicit methods with the first-same-as-last property (e.g. MultiStage::DormandPrince)
+ *       this is a mass matrix solve only.
+ */
+template<class PDESolver>
+class AdaptiveMultiStageTimeStepper
+{
+    using Variables = typename PDESolver::Variables;
+    using Scalar = typename Variables::Scalar;
+    using SolutionVector = typename Variables::SolutionVector;
+    using StageParams = MultiStageParams<Scalar>;
+
+public:
+    /*!
+     * \brief The constructor
+     * \param pdeSolver Solver class for solving a PDE in each stage
+     * \param msMethod The embedded multi-stage method which is to be used for time integration
+     * \param paramGroup The parameter group for parameter lookup
+     */
+    AdaptiveMultiStageTimeStepper(std::shared_ptr<PDESolver> pdeSolver,
+                                  std::shared_ptr<const EmbeddedMultiStageMethod<Scalar>> msMethod,
+                                  const std::string& paramGroup = "")
+    : pdeSolver_(pdeSolver)
+    , msMethod_(msMethod)
+    , controller_(paramGroup)
+    , absTolerance_(getParamFromGroup<Scalar>(paramGroup, "TimeStepping.AbsoluteTolerance", 1e-6))
+    , relTolerance_(getParamFromGroup<Scalar>(paramGroup, "TimeStepping.RelativeTolerance", 1e-4))
+    , maxTimeStepDivisions_(getParamFromGroup<std::size_t>(paramGroup, "TimeStepping.MaxTimeStepDivisions", 10))
+    , retryTimeStepReductionFactor_(getParamFromGroup<Scalar>(paramGroup, "TimeStepping.RetryTimeStepReductionFactor", 0.5))
+    , verbosity_(getParamFromGroup<int>(paramGroup, "TimeStepping.Verbosity", 1))
+    {
+        if (absTolerance_ <= 0.0 && relTolerance_ <= 0.0)
+            DUNE_THROW(Dune::InvalidStateException, "At least one of the tolerances has to be positive");
+    }
+
+    /*!
+     * \brief Advance one time step, reducing the time step size until the error estimate is small enough
+     * \param vars The variables object at the current time level.
+     * \param t The current time level
+     * \param dt The time step size to be tried first
+     * \return The size of the accepted time step (<= dt)
+     * \note We expect the time level in vars to correspond to the given time `t`.
+     *       The size of the next time step is given by suggestTimeStepSize().
+     */
+    Scalar step(Variables& vars, const Scalar t, const Scalar dt)
+    {
+        const SolutionVector xOld = vars.dofs();
+        const auto timeLevelOld = vars.timeLevel();
+
+        Scalar dtTry = dt;
+        for (std::size_t i = 0; i <= maxTimeStepDivisions_; ++i)
+        {
+            bool converged = true;
+            Scalar error = 0.0;
+            try {
+                error = step_(vars, t, dtTry, xOld);
+            }
+            catch (const NumericalProblem& e)
+            {
+                if (verbosity_ >= 1)
+                    std::cout << "Time stepper caught exception: \"" << e.what() << "\"\n";
+                converged = false;
+            }
+
+            if (converged && error <= 1.0)
+            {
+                ++numAcceptedSteps_;
+                dtSuggestion_ = controller_.accept(dtTry, error, msMethod_->embeddedOrder() + 1);
+                return dtTry;
+            }
+
+            // reset the variables and retry with a smaller time step size
+            ++numRejectedSteps_;
+            pdeSolver_->assembler().clearStages();
+            vars.update(xOld, timeLevelOld);
+
+            const Scalar dtOld = dtTry;
+            dtTry = converged ? controller_.reject(dtTry, error, msMethod_->embeddedOrder() + 1)
+                              : dtTry*retryTimeStepReductionFactor_;
+
+            if (verbosity_ >= 1)
+                std::cout << Fmt::format("Rejected time step of size {:.5g} ({}). Retrying with time step size {:.5g}\n",
+                                         dtOld, converged ? Fmt::format("error estimate {:.3g}", error)
+                                                          : std::string("no convergence"), dtTry);
+        }
+
+        DUNE_THROW(NumericalProblem, "Time step failed after " << maxTimeStepDivisions_ << " time-step divisions; dt = " << dtTry);
+    }
+
+    //! The suggested size of the next time step (based on the error estimate of the last accepted step)
+    Scalar suggestTimeStepSize() const
+    { return dtSuggestion_; }
+
+    //! The number of accepted time steps
+    std::size_t numAcceptedSteps() const
+    { return numAcceptedSteps_; }
+
+    //! The number of rejected time steps
+    std::size_t numRejectedSteps() const
+    { return numRejectedSteps_; }
+
+    /*!
+     * \brief Set/change the time step method
+     */
+    void setMethod(std::shared_ptr<const EmbeddedMultiStageMethod<Scalar>> msMethod)
+    {
+        msMethod_ = msMethod;
+        controller_.reset();
+    }
+
+private:
+    //! run all stages including the embedded one and return the normalized error estimate
+    Scalar step_(Variables& vars, const Scalar t, const Scalar dt, const SolutionVector& xOld)
+    {
+        // make sure there are no traces of previous stages
+        pdeSolver_->assembler().clearStages();
+
+        const auto numStages = msMethod_->numStages();
+        SolutionVector x;
+        for (auto stageIdx = 1UL; stageIdx <= numStages + 1; ++stageIdx)
+        {
+            // keep the solution of the method before computing the embedded solution
+            if (stageIdx == numStages + 1)
+                x = vars.dofs();
+
+            auto stageParams = std::make_shared<StageParams>(*msMethod_, stageIdx, t, dt);
+            pdeSolver_->assembler().prepareStage(vars, stageParams);
+            pdeSolver_->solve(vars);
+        }
+
+        pdeSolver_->assembler().clearStages();
+
+        Scalar error = Detail::maxScaledDifference<Scalar>(x, vars.dofs(), xOld, absTolerance_, relTolerance_);
+        if constexpr (Detail::hasComm<PDESolver>())
+            error = pdeSolver_->comm().max(error);
+
+        // the embedded stage has the same time level as the last stage of the method
+        vars.update(x, vars.timeLevel());
+        return error;
+    }
+
+    std::shared_ptr<PDESolver> pdeSolver_;
+    std::shared_ptr<const EmbeddedMultiStageMethod<Scalar>> msMethod_;
+    PIStepSizeController<Scalar> controller_;
+
+    Scalar absTolerance_;
+    Scalar relTolerance_;
+    std::size_t maxTimeStepDivisions_;
+    Scalar retryTimeStepReductionFactor_;
+    int verbosity_;
+
+    Scalar dtSuggestion_ = 0.0;
+    std::size_t numAcceptedSteps_ = 0;
+    std::size_t numRejectedSteps_ = 0;
+};
+
+} // end namespace Dumux::Experimental
+
+#endif
@@ -88,9 +88,79 @@ public:
     virtual ~MultiStageMethod() = default;
 };
 
+/*!
+ * \brief Abstract interface for embedded one-step multi-stage methods in Shu/Osher form.
+ *
+ * In addition to the \f$ m \f$ stages of the method, an embedded method defines the
+ * weights of an additional stage \f$ i = m+1 \f$ computing a solution \f$ \hat{x}^{n+1} = x^{(m+1)} \f$
+ * of lower order (with \f$ d_{m+1} = 1 \f$). The difference \f$ x^{(m)} - x^{(m+1)} \f$
+ * is an estimate of the local error of the embedded solution which can be used to control
+ * the time step size (see AdaptiveMultiStageTimeStepper). The additional stage may be implicit.
+ */
+template<class Scalar>
+class EmbeddedMultiStageMethod : public MultiStageMethod<Scalar>
+{
+public:
+    //! the order of accuracy of the solution \f$ x^{(m)} \f$
+    virtual std::size_t order () const = 0;
+
+    //! the order of accuracy of the embedded solution \f$ x^{(m+1)} \f$
+    virtual std::size_t embeddedOrder () const = 0;
+};
+
 //! Multi-stage time stepping scheme implementations
 namespace MultiStage {
 
+namespace Detail {
+
+/*!
+ * \brief Embedded methods given by a (diagonally implicit) Butcher tableau
+ * \tparam m the number of stages (without the embedded stage)
+ *
+ * In Shu/Osher form, all stages of these methods only depend on \f$ x^{(0)} \f$
+ * in the temporal operator, i.e. \f$ \alpha_{i0} = -1 \f$, \f$ \alpha_{ii} = 1 \f$
+ * and all other \f$ \alpha_{ik} = 0 \f$. The spatial weights \f$ \beta_{ik} \f$
+ * are given for the stages \f$ i = 1,\ldots,m+1 \f$.
+ */
+template<class Scalar, std::size_t m>
+class EmbeddedButcherMethod : public EmbeddedMultiStageMethod<Scalar>
+{
+public:
+    using SpatialWeights = std::array<std::array<Scalar, m+2>, m+1>;
+    using TimeStepWeights = std::array<Scalar, m+2>;
+
+    EmbeddedButcherMethod(const SpatialWeights& paramBeta, const TimeStepWeights& paramD)
+    : paramBeta_(paramBeta)
+    , paramD_(paramD)
+    {}
+
+    bool implicit () const final
+    {
+        for (std::size_t i = 1; i <= m+1; ++i)
+            if (paramBeta_[i-1][i] != 0.0)
+                return true;
+        return false;
+    }
+
+    std::size_t numStages () const final
+    { return m; }
+
+    Scalar temporalWeight (std::size_t i, std::size_t k) const final
+    { return k == 0 ? -1.0 : (k == i ? 1.0 : 0.0); }
+
+    Scalar spatialWeight (std::size_t i, std::size_t k) const final
+    { return paramBeta_[i-1][k]; }
+
+    Scalar timeStepWeight (std::size_t k) const final
+    { return paramD_[k]; }
+
+private:
+    SpatialWeights paramBeta_;
+    TimeStepWeights paramD_;
+};
+
+} // end namespace Detail
+
 /*!
  * \brief A theta time stepping scheme
  * theta=1.0 is an implicit Euler scheme,
@@ -200,6 +270,129 @@ private:
     std::array<Scalar, 5> paramD_;
 };
 
+/*!
+ * \brief Explicit third order Runge-Kutta scheme of Bogacki and Shampine with embedded second order solution
+ * \note P. Bogacki and L.F. Shampine. A 3(2) pair of Runge-Kutta formulas.
+ *       Appl. Math. Lett., 2(4):321-325, 1989. https://doi.org/10.1016/0893-9659(89)90079-7
+ */
+template<class Scalar>
+class BogackiShampine final : public Detail::EmbeddedButcherMethod<Scalar, 3>
+{
+    using ParentType = Detail::EmbeddedButcherMethod<Scalar, 3>;
+public:
+    BogackiShampine()
+    : ParentType({{{1.0/2.0, 0.0, 0.0, 0.0, 0.0},
+                   {0.0, 3.0/4.0, 0.0, 0.0, 0.0},
+                   {2.0/9.0, 1.0/3.0, 4.0/9.0, 0.0, 0.0},
+                   {7.0/24.0, 1.0/4.0, 1.0/3.0, 1.0/8.0, 0.0}}},
+                 {{0.0, 1.0/2.0, 3.0/4.0, 1.0, 1.0}})
+    {}
+
+    std::size_t order () const final
+    { return 3; }
+
+    std::size_t embeddedOrder () const final
+    { return 2; }
+
+    std::string name () const final
+    { return "explicit Runge-Kutta 3(2) (Bogacki-Shampine)"; }
+};
+
+/*!
+ * \brief Explicit fifth order Runge-Kutta scheme of Dormand and Prince with embedded fourth order solution
+ * \note J.R. Dormand and P.J. Prince. A family of embedded Runge-Kutta formulae.
+ *       J. Comput. Appl. Math., 6(1):19-26, 1980. https://doi.org/10.1016/0771-050X(80)90013-3
+ */
+template<class Scalar>
+class DormandPrince final : public Detail::EmbeddedButcherMethod<Scalar, 6>
+{
+    using ParentType = Detail::EmbeddedButcherMethod<Scalar, 6>;
+public:
+    DormandPrince()
+    : ParentType({{{1.0/5.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+                   {3.0/40.0, 9.0/40.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+                   {44.0/45.0, -56.0/15.0, 32.0/9.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+                   {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0, 0.0, 0.0, 0.0, 0.0},
+                   {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0, 0.0, 0.0, 0.0},
+                   {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0, 0.0, 0.0},
+                   {5179.0/57600.0, 0.0, 7571.0/16695.0, 393.0/640.0, -92097.0/339200.0, 187.0/2100.0, 1.0/40.0, 0.0}}},
+                 {{0.0, 1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0, 1.0}})
+    {}
+
+    std::size_t order () const final
+    { return 5; }
+
+    std::size_t embeddedOrder () const final
+    { return 4; }
+
+    std::string name () const final
+    { return "explicit Runge-Kutta 5(4) (Dormand-Prince)"; }
+};
+
+/*!
+ * \brief Two-stage, second order, L-stable singly diagonally implicit Runge-Kutta scheme
+ *        with embedded implicit Euler solution
+ * \note R. Alexander. Diagonally implicit Runge-Kutta methods for stiff O.D.E.'s.
+ *       SIAM J. Numer. Anal., 14(6):1006-1021, 1977. https://doi.org/10.1137/0714068
+ */
+template<class Scalar>
+class SDIRKSecondOrder final : public Detail::EmbeddedButcherMethod<Scalar, 2>
+{
+    using ParentType = Detail::EmbeddedButcherMethod<Scalar, 2>;
+    static constexpr Scalar gamma = 0.29289321881345247559915563789515; // 1 - 1/sqrt(2)
+public:
+    SDIRKSecondOrder()
+    : ParentType({{{0.0, gamma, 0.0, 0.0},
+                   {0.0, 1.0 - gamma, gamma, 0.0},
+                   {0.0, 0.0, 0.0, 1.0}}},
+                 {{0.0, gamma, 1.0, 1.0}})
+    {}
+
+    std::size_t order () const final
+    { return 2; }
+
+    std::size_t embeddedOrder () const final
+    { return 1; }
+
+    std::string name () const final
+    { return "singly diagonally implicit Runge-Kutta 2(1)"; }
+};
+
+/*!
+ * \brief Three-stage, third order, L-stable singly diagonally implicit Runge-Kutta scheme
+ *        with embedded second order solution
+ * \note R. Alexander. Diagonally implicit Runge-Kutta methods for stiff O.D.E.'s.
+ *       SIAM J. Numer. Anal., 14(6):1006-1021, 1977. https://doi.org/10.1137/0714068
+ *       The embedded solution is the stiffly accurate two-stage method using the first
+ *       stage of the main method and an additional implicit stage.
+ */
+template<class Scalar>
+class SDIRKThirdOrder final : public Detail::EmbeddedButcherMethod<Scalar, 3>
+{
+    using ParentType = Detail::EmbeddedButcherMethod<Scalar, 3>;
+    static constexpr Scalar gamma = 0.43586652150845899941601945; // root of x^3 - 3x^2 + 3x/2 - 1/6
+    static constexpr Scalar b1 = -(6.0*gamma*gamma - 16.0*gamma + 1.0)/4.0;
+    static constexpr Scalar b2 = (6.0*gamma*gamma - 20.0*gamma + 5.0)/4.0;
+    static constexpr Scalar bHat1 = 1.0/(2.0*(1.0 - gamma));
+public:
+    SDIRKThirdOrder()
+    : ParentType({{{0.0, gamma, 0.0, 0.0, 0.0},
+                   {0.0, 0.5*(1.0 - gamma), gamma, 0.0, 0.0},
+                   {0.0, b1, b2, gamma, 0.0},
+                   {0.0, bHat1, 0.0, 0.0, 1.0 - bHat1}}},
+                 {{0.0, gamma, 0.5*(1.0 + gamma), 1.0, 1.0}})
+    {}
+
+    std::size_t order () const final
+    { return 3; }
+
+    std::size_t embeddedOrder () const final
+    { return 2; }
+
+    std::string name () const final
+    { return "singly diagonally implicit Runge-Kutta 3(2)"; }
+};
+
 } // end namespace MultiStage
 } // end namespace Dumux::Experimental
 
@@ -56,9 +56,10 @@ public:
             p.timeAtStage = t + m.timeStepWeight(k)*dt;
             p.dtFraction = m.timeStepWeight(k);
 
+            // decide based on the weights only (small time step sizes must not skip terms)
             using std::abs;
             p.skipTemporal = (abs(p.alpha) < 1e-6);
-            p.skipSpatial = (abs(p.betaDt) < 1e-6);
+            p.skipSpatial = (abs(m.spatialWeight(i, k)) < 1e-6);
         }
     }
 
@@ -0,0 +1,126 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup TimeStepping
+ * \brief Time step size control based on local error estimates
+ */
+#ifndef DUMUX_TIMESTEPPING_STEP_SIZE_CONTROLLER_HH
+#define DUMUX_TIMESTEPPING_STEP_SIZE_CONTROLLER_HH
+
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+#include <dumux/common/parameters.hh>
+
+namespace Dumux::Experimental {
+
+/*!
+ * \ingroup TimeStepping
+ * \brief A proportional-integral (PI) time step size controller
+ *
+ * Given the (normalized) error estimate \f$ e_n \f$ of the current step, the error estimate
+ * \f$ e_{n-1} \f$ of the previously accepted step and the order \f$ k \f$ of the error estimate
+ * (the local error behaves like \f$ \Delta t^{k} \f$), the new time step size is
+ *
+ * \f[
+ *   \Delta t^{n+1} = \Delta t^n \, s \, e_n^{-\beta_I/k} \, e_{n-1}^{\beta_P/k},
+ * \f]
+ *
+ * limited to the interval \f$ [f_\text{min} \Delta t^n, f_\text{max} \Delta t^n] \f$.
+ * Steps with \f$ e_n > 1 \f$ are rejected and retried with the step size of a pure integral
+ * controller (without increase). Compared to the integral controller (\f$ \beta_P = 0 \f$),
+ * the PI controller leads to a smoother step size sequence with fewer rejected steps.
+ *
+ * \note G. Söderlind. Automatic control and adaptive time-stepping.
+ *       Numer. Algorithms, 31:281-310, 2002. https://doi.org/10.1023/A:1021160023092
+ *
+ * The following run-time parameters are used
+ *  - TimeStepping.SafetyFactor: the safety factor \f$ s \f$ (default 0.9)
+ *  - TimeStepping.MinTimeStepFactor: the smallest allowed factor \f$ f_\text{min} \f$ (default 0.2)
+ *  - TimeStepping.MaxTimeStepFactor: the largest allowed factor \f$ f_\text{max} \f$ (default 5.0)
+ *  - TimeStepping.IntegralGain: the integral gain \f$ \beta_I \f$ (default 0.7)
+ *  - TimeStepping.ProportionalGain: the proportional gain \f$ \beta_P \f$ (default 0.4)
+ */
+template<class Scalar>
+class PIStepSizeController
+{
+public:
+    explicit PIStepSizeController(const std::string& paramGroup = "")
+    : safetyFactor_(getParamFromGroup<Scalar>(paramGroup, "TimeStepping.SafetyFactor", 0.9))
+    , minFactor_(getParamFromGroup<Scalar>(paramGroup, "TimeStepping.MinTimeStepFactor", 0.2))
+    , maxFactor_(getParamFromGroup<Scalar>(paramGroup, "TimeStepping.MaxTimeStepFactor", 5.0))
+    , integralGain_(getParamFromGroup<Scalar>(paramGroup, "TimeStepping.IntegralGain", 0.7))
+    , proportionalGain_(getParamFromGroup<Scalar>(paramGroup, "TimeStepping.ProportionalGain", 0.4))
+    {
+        if (safetyFactor_ <= 0.0 || safetyFactor_ > 1.0)
+            DUNE_THROW(Dune::InvalidStateException, "TimeStepping.SafetyFactor has to be in (0, 1]");
+        if (minFactor_ <= 0.0 || minFactor_ >= 1.0 || maxFactor_ <= 1.0)
+            DUNE_THROW(Dune::InvalidStateException, "TimeStepping.MinTimeStepFactor has to be in (0, 1)"
+                                                    " and TimeStepping.MaxTimeStepFactor larger than 1");
+    }
+
+    /*!
+     * \brief The time step size after an accepted step
+     * \param dt the size of the accepted time step
+     * \param error the normalized error estimate of the accepted step (<= 1)
+     * \param k the order of the error estimate
+     */
+    Scalar accept(const Scalar dt, const Scalar error, const std::size_t k)
+    {
+        using std::pow; using std::max; using std::min;
+        const Scalar e = max(error, minError_);
+        const Scalar factor = safetyFactor_*pow(e, -integralGain_/k)*pow(previousError_, proportionalGain_/k);
+        previousError_ = e;
+        return dt*min(maxFactor_, max(minFactor_, factor));
+    }
+
+    /*!
+     * \brief The time step size to retry a rejected step with
+     * \param dt the size of the rejected time step
+     * \param error the normalized error estimate of the rejected step (> 1)
+     * \param k the order of the error estimate
+     */
+    Scalar reject(const Scalar dt, const Scalar error, const std::size_t k) const
+    {
+        using std::pow; using std::max; using std::min;
+        const Scalar factor = safetyFactor_*pow(error, -1.0/k);
+        return dt*min(safetyFactor_, max(minFactor_, factor));
+    }
+
+    //! Forget the error history (e.g. after discontinuous changes of the problem)
+    void reset()
+    { previousError_ = 1.0; }
+
+private:
+    static constexpr Scalar minError_ = 1e-4;
+
+    Scalar safetyFactor_;
+    Scalar minFactor_;
+    Scalar maxFactor_;
+    Scalar integralGain_;
+    Scalar proportionalGain_;
+    Scalar previousError_ = 1.0;
+};
+
+} // end namespace Dumux::Experimental
+
+#endif
@@ -0,0 +1,152 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Benchmarks of the assembly, the flux laws and the vtk output of a porous medium flow model
+ *
+ * The problem is set up like in the corresponding test from the initial solution.
+ * The following benchmarks are run (prefixed with the value of `Problem.Name`):
+ *  - `jacobian`: assembly of the Jacobian and the residual (per element)
+ *  - `residual`: assembly of the residual (per element)
+ *  - `darcyslaw`: advective flux of the first phase (per sub-control-volume face)
+ *  - `fickslaw`: diffusive flux of the first phase (per sub-control-volume face),
+ *                only for models with molecular diffusion
+ *  - `vtkoutput`: vtk output of the primary and secondary variables (per element)
+ */
+#ifndef DUMUX_TEST_BENCHMARK_ASSEMBLY_HH
+#define DUMUX_TEST_BENCHMARK_ASSEMBLY_HH
+
+#include <memory>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dumux/common/properties.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/timeloop.hh>
+
+#include <dumux/assembly/fvassembler.hh>
+#include <dumux/assembly/diffmethod.hh>
+
+#include <dumux/io/vtkoutputmodule.hh>
+#include <dumux/io/grid/gridmanager_yasp.hh>
+
+#include <test/benchmarks/benchmark.hh>
+
+namespace Dumux::Benchmark {
+
+template<class TypeTag>
+int runAssemblyBenchmarks(int argc, char** argv)
+{
+    const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+    if (mpiHelper.size() > 1)
+        DUNE_THROW(Dune::NotImplemented, "The benchmarks are meant to be run sequentially");
+
+    Parameters::init(argc, argv);
+
+    GridManager<GetPropType<TypeTag, Properties::Grid>> gridManager;
+    gridManager.init();
+    const auto& leafGridView = gridManager.grid().leafGridView();
+
+    using GridGeometry = GetPropType<TypeTag, Properties::GridGeometry>;
+    auto gridGeometry = std::make_shared<GridGeometry>(leafGridView);
+
+    using Problem = GetPropType<TypeTag, Properties::Problem>;
+    auto problem = std::make_shared<Problem>(gridGeometry);
+
+    using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
+    SolutionVector x(gridGeometry->numDofs());
+    problem->applyInitialSolution(x);
+    auto xOld = x;
+
+    using GridVariables = GetPropType<TypeTag, Properties::GridVariables>;
+    auto gridVariables = std::make_shared<GridVariables>(problem, gridGeometry);
+    gridVariables->init(x);
+
+    using Scalar = GetPropType<TypeTag, Properties::Scalar>;
+    auto timeLoop = std::make_shared<TimeLoop<Scalar>>(0.0, 1.0, 1.0, /*verbose=*/false);
+
+    using Assembler = FVAssembler<TypeTag, DiffMethod::numeric>;
+    Assembler assembler(problem, gridGeometry, gridVariables, timeLoop, xOld);
+
+    const auto name = getParam<std::string>("Problem.Name");
+    const double numElements = leafGridView.size(0);
+    Runner runner(name);
+
+    // global assembly, reported per element
+    runner.run(name + "/jacobian", [&]{ assembler.assembleJacobianAndResidual(x); }, numElements, "element");
+    runner.run(name + "/residual", [&]{ assembler.assembleResidual(x); }, numElements, "element");
+
+    // flux laws evaluated on the inner faces of an element in the interior of the domain
+    auto fvGeometry = localView(*gridGeometry);
+    auto elemVolVars = localView(gridVariables->curGridVolVars());
+    auto elemFluxVarsCache = localView(gridVariables->gridFluxVarsCache());
+    auto element = *elements(leafGridView).begin();
+    for (const auto& e : elements(leafGridView))
+    {
+        fvGeometry.bindElement(e);
+        if (!fvGeometry.hasBoundaryScvf())
+        {
+            element = e;
+            break;
+        }
+    }
+
+    fvGeometry.bind(element);
+    elemVolVars.bind(element, fvGeometry, x);
+    elemFluxVarsCache.bind(element, fvGeometry, elemVolVars);
+
+    double numInnerScvfs = 0;
+    for (const auto& scvf : scvfs(fvGeometry))
+        if (!scvf.boundary())
+            ++numInnerScvfs;
+
+    using AdvectionType = GetPropType<TypeTag, Properties::AdvectionType>;
+    runner.run(name + "/darcyslaw", [&]{
+        for (const auto& scvf : scvfs(fvGeometry))
+            if (!scvf.boundary())
+                doNotOptimize(AdvectionType::flux(*problem, element, fvGeometry, elemVolVars, scvf, 0, elemFluxVarsCache));
+    }, numInnerScvfs, "face");
+
+    using ModelTraits = GetPropType<TypeTag, Properties::ModelTraits>;
+    if constexpr (ModelTraits::enableMolecularDiffusion())
+    {
+        using MolecularDiffusionType = GetPropType<TypeTag, Properties::MolecularDiffusionType>;
+        runner.run(name + "/fickslaw", [&]{
+            for (const auto& scvf : scvfs(fvGeometry))
+                if (!scvf.boundary())
+                    doNotOptimize(MolecularDiffusionType::flux(*problem, element, fvGeometry, elemVolVars, scvf, 0, elemFluxVarsCache));
+        }, numInnerScvfs, "face");
+    }
+
+    // vtk output (writes a file per call)
+    using IOFields = GetPropType<TypeTag, Properties::IOFields>;
+    VtkOutputModule<GridVariables, SolutionVector> vtkWriter(*gridVariables, x, name, "", Dune::VTK::conforming, /*verbose=*/false);
+    IOFields::initOutputModule(vtkWriter);
+    double time = 0.0;
+    runner.run(name + "/vtkoutput", [&]{ vtkWriter.write(time += 1.0); }, numElements, "element");
+
+    runner.writeReport();
+    return 0;
+}
+
+} // end namespace Dumux::Benchmark
+
+#endif
@@ -0,0 +1,183 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief A minimal harness for micro-benchmarks
+ *
+ * A benchmark is a callable that performs a known number of operations
+ * (e.g. local assemblies, flux evaluations, law evaluations). The callable is
+ * executed repeatedly until the measured time exceeds `Benchmark.MinTime` seconds
+ * (default 0.1), and the fastest of `Benchmark.Repetitions` (default 3) such
+ * measurements is reported. The results are printed to the terminal and written to
+ * `<Benchmark.ReportFile>.json` (default: the suite name) in the format
+ *
+ * \code{.json}
+ * {
+ *   "format": 1,
+ *   "suite": "<suite name>",
+ *   "results": [
+ *     {"name": "<benchmark>", "unit": "<operation>", "operations": <n>,
+ *      "seconds": <t>, "nsPerOperation": <t/n>, "operationsPerSecond": <n/t>},
+ *     ...
+ *   ]
+ * }
+ * \endcode
+ *
+ * The `format` number is only increased on incompatible changes, so reports
+ * of different versions can be compared by benchmark name.
+ */
+#ifndef DUMUX_TEST_BENCHMARK_HH
+#define DUMUX_TEST_BENCHMARK_HH
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/io/format.hh>
+
+namespace Dumux::Benchmark {
+
+/*!
+ * \brief Prevent the compiler from optimizing away the computation of a value
+ */
+template<class T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/*!
+ * \brief The result of a benchmark
+ */
+struct Result
+{
+    std::string name;
+    std::string unit;
+    double operations;
+    double seconds;
+
+    double nsPerOperation() const { return 1e9*seconds/operations; }
+    double operationsPerSecond() const { return operations/seconds; }
+};
+
+/*!
+ * \brief Runs the benchmarks of a suite and writes the report
+ */
+class Runner
+{
+    using Clock = std::chrono::steady_clock;
+
+public:
+    explicit Runner(const std::string& suite)
+    : suite_(suite)
+    , minTime_(getParam<double>("Benchmark.MinTime", 0.1))
+    , repetitions_(getParam<int>("Benchmark.Repetitions", 3))
+    , filter_(getParam<std::string>("Benchmark.Filter", ""))
+    {
+        if (minTime_ <= 0.0 || repetitions_ < 1)
+            DUNE_THROW(Dune::InvalidStateException, "Benchmark.MinTime has to be positive and Benchmark.Repetitions at least one");
+    }
+
+    /*!
+     * \brief Run a benchmark
+     * \param name the (stable) name of the benchmark used in the report
+     * \param f the callable to measure
+     * \param operationsPerCall the number of operations performed by one call of f
+     * \param unit what an operation is (e.g. "element", "evaluation")
+     * \note Benchmarks whose name does not contain `Benchmark.Filter` are skipped.
+     */
+    template<class F>
+    void run(const std::string& name, F&& f, double operationsPerCall = 1.0, const std::string& unit = "call")
+    {
+        if (name.find(filter_) == std::string::npos)
+            return;
+
+        // warm up and calibrate the number of calls per measurement
+        f();
+        std::size_t calls = 1;
+        double seconds = measure_(f, calls);
+        while (seconds < minTime_)
+        {
+            const double factor = seconds > 0.0 ? std::min(10.0, 1.2*minTime_/seconds) : 10.0;
+            calls = std::max<std::size_t>(calls + 1, static_cast<std::size_t>(calls*factor));
+            seconds = measure_(f, calls);
+        }
+
+        for (int i = 1; i < repetitions_; ++i)
+            seconds = std::min(seconds, measure_(f, calls));
+
+        results_.push_back({name, unit, calls*operationsPerCall, seconds});
+        const auto& r = results_.back();
+        std::cout << Fmt::format("{:<50} {:>14.6g} ns/{:<12} {:>14.6g} {}/s\n",
+                                 r.name, r.nsPerOperation(), r.unit, r.operationsPerSecond(), r.unit);
+    }
+
+    //! The results of all benchmarks run so far
+    const std::vector<Result>& results() const
+    { return results_; }
+
+    //! Write the report file
+    void writeReport() const
+    {
+        const auto fileName = getParam<std::string>("Benchmark.ReportFile", suite_) + ".json";
+        std::ofstream file(fileName);
+        file << Fmt::format("{{\n  \"format\": 1,\n  \"suite\": \"{}\",\n  \"results\": [", suite_);
+        for (std::size_t i = 0; i < results_.size(); ++i)
+        {
+            const auto& r = results_[i];
+            file << Fmt::format("{}\n    {{\"name\": \"{}\", \"unit\": \"{}\", \"operations\": {:.0f}, \"seconds\": {:.9g}, "
+                                "\"nsPerOperation\": {:.9g}, \"operationsPerSecond\": {:.9g}}}",
+                                i == 0 ? "" : ",", r.name, r.unit, r.operations, r.seconds,
+                                r.nsPerOperation(), r.operationsPerSecond());
+        }
+        file << "\n  ]\n}\n";
+        std::cout << "Benchmark report written to " << fileName << std::endl;
+    }
+
+private:
+    template<class F>
+    static double measure_(F& f, std::size_t calls)
+    {
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < calls; ++i)
+            f();
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    std::string suite_;
+    double minTime_;
+    int repetitions_;
+    std::string filter_;
+    std::vector<Result> results_;
+};
+
+} // end namespace Dumux::Benchmark
+
+#endif
@@ -0,0 +1,110 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Benchmarks of the bounding box tree construction and queries
+ */
+#include <config.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/geometry/multilineargeometry.hh>
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/geometry/boundingboxtree.hh>
+#include <dumux/geometry/geometricentityset.hh>
+#include <dumux/geometry/intersectingentities.hh>
+
+#include <test/benchmarks/benchmark.hh>
+
+namespace Dumux::Benchmark {
+
+template<int dim>
+void runBoundingBoxTreeBenchmarks(Runner& runner, int numCellsX)
+{
+    using Grid = Dune::YaspGrid<dim>;
+    using GridView = typename Grid::LeafGridView;
+    using GlobalPosition = Dune::FieldVector<double, dim>;
+    using EntitySet = GridViewGeometricEntitySet<GridView, 0>;
+
+    std::array<unsigned int, dim> cells; cells.fill(numCellsX);
+    const auto grid = Dune::StructuredGridFactory<Grid>::createCubeGrid(GlobalPosition(0.0), GlobalPosition(1.0), cells);
+    const auto& gridView = grid->leafGridView();
+    const auto entitySet = std::make_shared<EntitySet>(gridView);
+
+    const auto name = "bboxtree/dim" + std::to_string(dim);
+    runner.run(name + "/build", [&]{ BoundingBoxTree<EntitySet> tree(entitySet); doNotOptimize(tree); }, gridView.size(0), "entity");
+
+    const BoundingBoxTree<EntitySet> tree(entitySet);
+
+    // points on a lattice not aligned with the grid (including points outside the domain)
+    const int numPointsX = dim == 3 ? 20 : 100;
+    std::vector<GlobalPosition> points(static_cast<std::size_t>(std::pow(numPointsX, dim)));
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        auto index = i;
+        for (int d = 0; d < dim; ++d)
+        {
+            points[i][d] = -0.05 + 1.1*(index % numPointsX)/(numPointsX - 1.0);
+            index /= numPointsX;
+        }
+    }
+
+    runner.run(name + "/points", [&]{ for (const auto& p : points) doNotOptimize(intersectingEntities(p, tree)); }, points.size(), "query");
+    runner.run(name + "/pointsBatched", [&]{ doNotOptimize(intersectingEntities(points, tree)); }, points.size(), "query");
+
+    // a bundle of lines through the domain (e.g. a network embedded in the grid)
+    using LineGeometry = Dune::MultiLinearGeometry<double, 1, dim>;
+    using LineEntitySet = GeometriesEntitySet<LineGeometry>;
+    std::vector<LineGeometry> lines;
+    const int numLines = 100;
+    for (int i = 0; i < numLines; ++i)
+    {
+        GlobalPosition a(0.0), b(1.0);
+        a[0] = static_cast<double>(i)/numLines;
+        b[dim-1] = 1.0 - static_cast<double>(i)/numLines;
+        lines.emplace_back(Dune::GeometryTypes::line, std::vector<GlobalPosition>{a, b});
+    }
+    const BoundingBoxTree<LineEntitySet> lineTree(std::make_shared<LineEntitySet>(std::move(lines)));
+    runner.run(name + "/lines", [&]{ doNotOptimize(intersectingEntities(lineTree, tree)); }, numLines, "line");
+}
+
+} // end namespace Dumux::Benchmark
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+
+    Dune::MPIHelper::instance(argc, argv);
+    Parameters::init(argc, argv);
+
+    Benchmark::Runner runner("benchmark_bboxtree");
+    Benchmark::runBoundingBoxTreeBenchmarks<2>(runner, getParam<int>("Benchmark.CellsPerDirection2D", 200));
+    Benchmark::runBoundingBoxTreeBenchmarks<3>(runner, getParam<int>("Benchmark.CellsPerDirection3D", 40));
+    runner.writeReport();
+
+    return 0;
+}
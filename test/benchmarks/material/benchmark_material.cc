@@ -0,0 +1,139 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Benchmarks of the evaluation of fluid-matrix interaction laws, components and fluid systems
+ *
+ * Each benchmark evaluates a function for a range of saturations (or pressures and temperatures)
+ * and the rate is reported per evaluation.
+ */
+#include <config.h>
+
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dumux/common/math.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/material/fluidmatrixinteractions/2p/vangenuchten.hh>
+#include <dumux/material/fluidmatrixinteractions/2p/brookscorey.hh>
+#include <dumux/material/components/h2o.hh>
+#include <dumux/material/fluidsystems/brineco2.hh>
+#include <dumux/material/fluidstates/compositional.hh>
+
+#include <test/porousmediumflow/co2/co2tables.hh>
+#include <test/benchmarks/benchmark.hh>
+
+namespace Dumux::Benchmark {
+
+//! evaluate the capillary pressure and relative permeability functions of a law
+template<class Law>
+void runMaterialLawBenchmarks(Runner& runner, const std::string& name, const Law& law)
+{
+    const auto sw = linspace(0.0, 1.0, 1000);
+    std::vector<double> pc(sw.size());
+    for (std::size_t i = 0; i < sw.size(); ++i)
+        pc[i] = law.pc(sw[i]);
+
+    const double n = sw.size();
+    runner.run(name + "/pc", [&]{ for (auto s : sw) doNotOptimize(law.pc(s)); }, n, "evaluation");
+    runner.run(name + "/sw", [&]{ for (auto p : pc) doNotOptimize(law.sw(p)); }, n, "evaluation");
+    runner.run(name + "/krw", [&]{ for (auto s : sw) doNotOptimize(law.krw(s)); }, n, "evaluation");
+    runner.run(name + "/krn", [&]{ for (auto s : sw) doNotOptimize(law.krn(s)); }, n, "evaluation");
+}
+
+} // end namespace Dumux::Benchmark
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+    using namespace Dumux::Benchmark;
+
+    Dune::MPIHelper::instance(argc, argv);
+    Parameters::init(argc, argv, [](auto& params){ params["Brine.Salinity"] = "0.1"; });
+
+    Runner runner("benchmark_material");
+
+    // fluid-matrix interactions
+    {
+        using VanGenuchten = FluidMatrix::VanGenuchtenDefault<double>;
+        VanGenuchten::EffToAbsParams eaParams;
+        eaParams.setSwr(0.1);
+        eaParams.setSnr(0.1);
+        runMaterialLawBenchmarks(runner, "vangenuchten", VanGenuchten(VanGenuchten::BasicParams(6.66e-5, 3.652, 0.5), eaParams));
+
+        using BrooksCorey = FluidMatrix::BrooksCoreyDefault<double>;
+        runMaterialLawBenchmarks(runner, "brookscorey", BrooksCorey(BrooksCorey::BasicParams(1e4, 2.0), eaParams));
+    }
+
+    // pressure and temperature samples within the range of the CO2 tables
+    const auto temperature = linspace(290.0, 340.0, 30);
+    const auto pressure = linspace(1e5, 3e7, 30);
+    const double numSamples = temperature.size()*pressure.size();
+    const auto forAllStates = [&](auto&& f)
+    {
+        for (auto t : temperature)
+            for (auto p : pressure)
+                f(t, p);
+    };
+
+    // components
+    {
+        using H2O = Components::H2O<double>;
+        runner.run("h2o/liquidDensity", [&]{ forAllStates([](double t, double p){ doNotOptimize(H2O::liquidDensity(t, p)); }); }, numSamples, "evaluation");
+        runner.run("h2o/liquidViscosity", [&]{ forAllStates([](double t, double p){ doNotOptimize(H2O::liquidViscosity(t, p)); }); }, numSamples, "evaluation");
+        runner.run("h2o/liquidEnthalpy", [&]{ forAllStates([](double t, double p){ doNotOptimize(H2O::liquidEnthalpy(t, p)); }); }, numSamples, "evaluation");
+        runner.run("h2o/vaporPressure", [&]{ for (auto t : temperature) doNotOptimize(H2O::vaporPressure(t)); }, temperature.size(), "evaluation");
+    }
+
+    // fluid systems
+    {
+        using FluidSystem = FluidSystems::BrineCO2<double, HeterogeneousCO2Tables::CO2Tables,
+                                                   Components::H2O<double>,
+                                                   FluidSystems::BrineCO2DefaultPolicy</*useConstantSalinity=*/true>>;
+        FluidSystem::init();
+
+        using FluidState = CompositionalFluidState<double, FluidSystem>;
+        std::vector<FluidState> fluidStates;
+        forAllStates([&](double t, double p)
+        {
+            FluidState fs;
+            fs.setTemperature(t);
+            for (int phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx)
+                fs.setPressure(phaseIdx, p);
+            fs.setMoleFraction(FluidSystem::liquidPhaseIdx, FluidSystem::comp0Idx, 0.99);
+            fs.setMoleFraction(FluidSystem::liquidPhaseIdx, FluidSystem::CO2Idx, 0.01);
+            fs.setMoleFraction(FluidSystem::gasPhaseIdx, FluidSystem::comp0Idx, 0.01);
+            fs.setMoleFraction(FluidSystem::gasPhaseIdx, FluidSystem::CO2Idx, 0.99);
+            fluidStates.push_back(fs);
+        });
+
+        for (int phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx)
+        {
+            const auto name = "brineco2/" + FluidSystem::phaseName(phaseIdx);
+            runner.run(name + "/density", [&]{ for (const auto& fs : fluidStates) doNotOptimize(FluidSystem::density(fs, phaseIdx)); }, numSamples, "evaluation");
+            runner.run(name + "/viscosity", [&]{ for (const auto& fs : fluidStates) doNotOptimize(FluidSystem::viscosity(fs, phaseIdx)); }, numSamples, "evaluation");
+            runner.run(name + "/enthalpy", [&]{ for (const auto& fs : fluidStates) doNotOptimize(FluidSystem::enthalpy(fs, phaseIdx)); }, numSamples, "evaluation");
+            runner.run(name + "/fugacityCoefficientCO2", [&]{ for (const auto& fs : fluidStates) doNotOptimize(FluidSystem::fugacityCoefficient(fs, phaseIdx, FluidSystem::CO2Idx)); }, numSamples, "evaluation");
+        }
+    }
+
+    runner.writeReport();
+    return 0;
+}
@@ -0,0 +1,117 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test for the instrumentation (scoped timers, counters and the report)
+ */
+#include <config.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/common/instrumentation.hh>
+
+namespace {
+std::string readFile(const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    using namespace Dumux;
+
+    const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+    Parameters::init([](auto& params){
+        params["Instrumentation.Enable"] = "true";
+        params["Instrumentation.ReportFile"] = "test_instrumentation";
+    });
+
+    if (!Instrumentation::enabled())
+        DUNE_THROW(Dune::InvalidStateException, "Instrumentation should be enabled by the parameter");
+
+    // nothing is recorded if disabled
+    Instrumentation::Registry::instance().setEnabled(false);
+    {
+        Instrumentation::ScopedTimer timer("Disabled");
+    }
+    Instrumentation::count(Instrumentation::record("Disabled"));
+    if (Instrumentation::record("Disabled").count != 0)
+        DUNE_THROW(Dune::InvalidStateException, "Disabled instrumentation recorded something");
+    Instrumentation::Registry::instance().setEnabled(true);
+
+    // a timer used concurrently by several threads
+    auto& record = Instrumentation::record("Test.Concurrent");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&]{
+            for (int i = 0; i < 1000; ++i)
+                Instrumentation::ScopedTimer timer(record);
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    if (record.count != 4000)
+        DUNE_THROW(Dune::InvalidStateException, "Wrong number of calls: " << record.count << " (expected 4000)");
+
+    {
+        Instrumentation::ScopedTimer timer("Test.Sleep");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    if (Instrumentation::record("Test.Sleep").nanoseconds < 10'000'000)
+        DUNE_THROW(Dune::InvalidStateException, "Measured time is too short");
+
+    Instrumentation::count(Instrumentation::record("Test.Counter"), 42);
+
+    Instrumentation::writeReport();
+    if (mpiHelper.rank() == 0)
+    {
+        const auto report = readFile("test_instrumentation.json");
+        std::cout << report;
+        for (const auto& expected : {std::string("\"name\": \"Test.Concurrent\", \"count\": ") + std::to_string(4000*mpiHelper.size()),
+                                     std::string("\"name\": \"Test.Counter\", \"count\": ") + std::to_string(42*mpiHelper.size()),
+                                     std::string("\"name\": \"Test.Sleep\"")})
+            if (report.find(expected) == std::string::npos)
+                DUNE_THROW(Dune::InvalidStateException, "Report doesn't contain " << expected);
+
+        if (report.find("Disabled") != std::string::npos)
+            DUNE_THROW(Dune::InvalidStateException, "Report contains unused records");
+    }
+
+    // reset all records
+    Instrumentation::Registry::instance().reset();
+    if (record.count != 0 || record.nanoseconds != 0)
+        DUNE_THROW(Dune::InvalidStateException, "Records have not been reset");
+
+    return 0;
+}
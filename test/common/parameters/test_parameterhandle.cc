@@ -0,0 +1,73 @@
+#include <config.h>
+#include <array>
+#include <string>
+#include <iostream>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/common/parameterhandle.hh>
+
+int main (int argc, char *argv[])
+{
+    using namespace Dumux;
+
+    // maybe initialize mpi
+    Dune::MPIHelper::instance(argc, argv);
+
+    // initialize parameter tree
+    Parameters::init(argc, argv, "params.input");
+
+    auto& lookupRegistry = ParameterLookupRegistry::instance();
+    lookupRegistry.setEnabled();
+
+    // handles resolve the key with the same rules as getParam/getParamFromGroup
+    const auto tEnd = paramHandle<double>("TimeLoop.TEnd");
+    const auto tEndBulk = paramHandleFromGroup<double>("Bulk", "TimeLoop.TEnd");
+    const auto tEndHulk = paramHandleFromGroup<double>("Hulk", "TimeLoop.TEnd", 1.0);
+    const auto enableGravity = paramHandle<bool>("Problem.EnableGravity"); // uses the Dumux default value
+    const auto cells = paramHandle<std::array<int, 2>>("Grid.Cells", std::array<int, 2>{{1, 1}});
+    const auto name = paramHandleFromGroup<std::string>("Bulk", "Problem.Name", "bulk");
+
+    if (tEnd != 1e6) DUNE_THROW(Dune::InvalidStateException, "TEnd should be 1e6!");
+    if (tEndBulk.get() != 1e5) DUNE_THROW(Dune::InvalidStateException, "Bulk TEnd should be 1e5!");
+    if (*tEndHulk != 1e6) DUNE_THROW(Dune::InvalidStateException, "Hulk TEnd should be 1e6!");
+    if (!enableGravity) DUNE_THROW(Dune::InvalidStateException, "Gravity should be true!");
+    if ((*cells)[0] != 100 || (*cells)[1] != 100) DUNE_THROW(Dune::InvalidStateException, "Cells should be 100 100!");
+    if (name->size() != 4 || name.get() != "bulk") DUNE_THROW(Dune::InvalidStateException, "Name should be bulk!");
+    if (tEndBulk.key() != "Bulk:TimeLoop.TEnd") DUNE_THROW(Dune::InvalidStateException, "Wrong key " << tEndBulk.key());
+
+    // reading handles doesn't look up the parameter again
+    double sum = 0.0;
+    for (int i = 0; i < 10; ++i)
+        sum += tEndBulk;
+    if (sum != 1e6) DUNE_THROW(Dune::InvalidStateException, "Wrong sum");
+    if (lookupRegistry.numLookups("Bulk", "TimeLoop.TEnd") != 1)
+        DUNE_THROW(Dune::InvalidStateException, "Expected one lookup of Bulk:TimeLoop.TEnd");
+
+    // getParam looks up the parameter on every call
+    for (int i = 0; i < 10; ++i)
+        sum += getParam<double>("TimeLoop.TEnd");
+    if (lookupRegistry.numLookups("", "TimeLoop.TEnd") != 11)
+        DUNE_THROW(Dune::InvalidStateException, "Expected 11 lookups of TimeLoop.TEnd, got "
+                                                << lookupRegistry.numLookups("", "TimeLoop.TEnd"));
+
+    const auto counts = lookupRegistry.counts();
+    if (counts.empty() || counts.front().first != "TimeLoop.TEnd" || counts.front().second != 11)
+        DUNE_THROW(Dune::InvalidStateException, "The most frequent lookup should be TimeLoop.TEnd");
+
+    // handles can be assigned (e.g. if the parameter group is only known later)
+    ParamHandle<double> handle;
+    if (handle != 0.0) DUNE_THROW(Dune::InvalidStateException, "Default handle should be zero");
+    handle = paramHandleFromGroup<double>("Bulk", "TimeLoop.TEnd");
+    if (handle != 1e5) DUNE_THROW(Dune::InvalidStateException, "Assigned handle should be 1e5");
+
+    Parameters::print();
+
+    lookupRegistry.reset();
+    if (!lookupRegistry.counts().empty())
+        DUNE_THROW(Dune::InvalidStateException, "Counts should be empty after reset");
+
+    return 0;
+}
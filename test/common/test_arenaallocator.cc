@@ -0,0 +1,111 @@
+#include <config.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+#include <numeric>
+#include <iostream>
+#include <type_traits>
+
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/arenaallocator.hh>
+
+template<class T>
+using ArenaVector = std::vector<T, Dumux::ArenaAllocator<T>>;
+
+struct DefaultTraits {};
+struct ArenaTraits { template<class T> using LocalViewAllocator = Dumux::ArenaAllocator<T>; };
+
+int main()
+{
+    using namespace Dumux;
+
+    // the allocator is selected from the traits
+    static_assert(std::is_same_v<Detail::LocalViewAllocator<DefaultTraits, int>, std::allocator<int>>);
+    static_assert(std::is_same_v<Detail::LocalViewAllocator<ArenaTraits, int>, ArenaAllocator<int>>);
+
+    // outside of a scope the heap is used
+    const auto heapAllocations = Arena::threadLocal().statistics().numHeapAllocations;
+    {
+        ArenaVector<double> v(10, 1.0);
+        if (v.get_allocator().usesArena())
+            DUNE_THROW(Dune::Exception, "Vectors constructed outside of a scope should not use the arena");
+    }
+    if (Arena::threadLocal().statistics().numHeapAllocations != heapAllocations + 1)
+        DUNE_THROW(Dune::Exception, "Expected one heap allocation");
+
+    // within a scope the arena is used and everything is released at its end
+    const auto mark = Arena::threadLocal().mark();
+    ArenaVector<int> copy;
+    {
+        ArenaScope scope;
+        ArenaVector<int> v;
+        for (int i = 0; i < 100000; ++i)
+            v.push_back(i);
+        if (!v.get_allocator().usesArena())
+            DUNE_THROW(Dune::Exception, "Vectors constructed within a scope should use the arena");
+
+        {
+            // nested scopes release only their own memory
+            ArenaScope nestedScope;
+            ArenaVector<double> w(1000, 2.0);
+            if (w.get_allocator() != v.get_allocator())
+                DUNE_THROW(Dune::Exception, "Expected the same arena");
+        }
+
+        if (v.back() != 99999 || std::accumulate(v.begin(), v.begin() + 10, 0) != 45)
+            DUNE_THROW(Dune::Exception, "Wrong content");
+
+        // copies may outlive the scope if they are constructed outside of it
+        copy = v;
+        if (copy.get_allocator().usesArena())
+            DUNE_THROW(Dune::Exception, "Copy assignment should not propagate the arena allocator");
+    }
+    if (copy.size() != 100000 || copy.back() != 99999)
+        DUNE_THROW(Dune::Exception, "Wrong content of the copy");
+
+    const auto afterScope = Arena::threadLocal().mark();
+    if (afterScope.usage != mark.usage)
+        DUNE_THROW(Dune::Exception, "Arena memory was not released at the end of the scope");
+
+    // the chunks have been merged, so repeating the allocations needs no new memory
+    const auto stats = Arena::threadLocal().statistics();
+    {
+        ArenaScope scope;
+        ArenaVector<int> v;
+        for (int i = 0; i < 100000; ++i)
+            v.push_back(i);
+    }
+    const auto statsRepeated = Arena::threadLocal().statistics();
+    if (statsRepeated.numChunkAllocations != stats.numChunkAllocations)
+        DUNE_THROW(Dune::Exception, "Expected no new chunk allocations but got "
+                                    << statsRepeated.numChunkAllocations - stats.numChunkAllocations);
+    if (statsRepeated.numArenaAllocations <= stats.numArenaAllocations)
+        DUNE_THROW(Dune::Exception, "Expected allocations from the arena");
+
+    // each thread has its own arena and the global statistics include finished threads
+    const auto globalStats = Arena::globalStatistics();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([]{
+            for (int i = 0; i < 100; ++i)
+            {
+                ArenaScope scope;
+                ArenaVector<double> v(100, 1.0);
+                if (!v.get_allocator().usesArena())
+                    DUNE_THROW(Dune::Exception, "Expected the arena to be used");
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    const auto globalStatsAfter = Arena::globalStatistics();
+    if (globalStatsAfter.numArenaAllocations != globalStats.numArenaAllocations + 400)
+        DUNE_THROW(Dune::Exception, "Expected 400 arena allocations, got "
+                                    << globalStatsAfter.numArenaAllocations - globalStats.numArenaAllocations);
+
+    std::cout << "Arena allocator test passed (peak usage " << globalStatsAfter.peakUsage
+              << " bytes, capacity " << globalStatsAfter.capacity << " bytes)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <config.h>
+
+#include <string>
+#include <vector>
+#include <numeric>
+#include <iostream>
+#include <algorithm>
+
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/smallvector.hh>
+
+template<class V, class T>
+void checkContent(const V& v, const std::vector<T>& expected, bool onHeap)
+{
+    if (v.size() != expected.size())
+        DUNE_THROW(Dune::Exception, "Wrong size " << v.size() << ", expected " << expected.size());
+    if (!std::equal(v.begin(), v.end(), expected.begin()))
+        DUNE_THROW(Dune::Exception, "Wrong content");
+    if (v.isOnHeap() != onHeap)
+        DUNE_THROW(Dune::Exception, "Expected the elements to be stored " << (onHeap ? "on the heap" : "inline"));
+}
+
+int main()
+{
+    using namespace Dumux;
+
+    // inline storage up to the capacity
+    SmallVector<int, 4> v;
+    if (!v.empty())
+        DUNE_THROW(Dune::Exception, "Default-constructed vector should be empty");
+
+    v.resize(3);
+    std::iota(v.begin(), v.end(), 0);
+    v.push_back(3);
+    checkContent(v, std::vector<int>{0, 1, 2, 3}, false);
+
+    // fallback to the heap beyond the capacity
+    v.emplace_back(4);
+    checkContent(v, std::vector<int>{0, 1, 2, 3, 4}, true);
+    v.resize(7);
+    v[5] = 5; v.back() = 6;
+    checkContent(v, std::vector<int>{0, 1, 2, 3, 4, 5, 6}, true);
+    if (std::find(v.begin(), v.end(), 5) - v.begin() != 5)
+        DUNE_THROW(Dune::Exception, "Element not found");
+
+    // shrinking stays on the heap, clearing switches back to inline storage
+    v.pop_back();
+    v.resize(2);
+    checkContent(v, std::vector<int>{0, 1}, true);
+    // (the inline elements keep their values)
+    v.clear();
+    v.resize(2);
+    checkContent(v, std::vector<int>{0, 1}, false);
+
+    // copy and move
+    SmallVector<std::string, 2> s;
+    s.push_back("a");
+    auto sCopy = s;
+    s.emplace_back("b");
+    s.emplace_back("c");
+    checkContent(sCopy, std::vector<std::string>{"a"}, false);
+    checkContent(s, std::vector<std::string>{"a", "b", "c"}, true);
+    auto sMoved = std::move(s);
+    checkContent(sMoved, std::vector<std::string>{"a", "b", "c"}, true);
+    sCopy = sMoved;
+    checkContent(sCopy, std::vector<std::string>{"a", "b", "c"}, true);
+
+    // zero capacity means pure heap storage
+    SmallVector<double, 0> h;
+    h.push_back(1.0);
+    checkContent(h, std::vector<double>{1.0}, true);
+
+    std::cout << "SmallVector test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,222 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test for the snapshots of the grid variables used for the rollback of time steps.
+ */
+#include <config.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/properties.hh>
+#include <dumux/common/parameters.hh>
+
+#include <dumux/discretization/cctpfa.hh>
+#include <dumux/discretization/gridvariablessnapshots.hh>
+
+#include <dumux/porousmediumflow/problem.hh>
+#include <dumux/porousmediumflow/1p/model.hh>
+#include <dumux/material/components/simpleh2o.hh>
+#include <dumux/material/fluidsystems/1pliquid.hh>
+#include <dumux/material/spatialparams/fv1pconstant.hh>
+
+namespace Dumux {
+
+template<class TypeTag>
+class SnapshotTestProblem : public PorousMediumFlowProblem<TypeTag>
+{
+    using ParentType = PorousMediumFlowProblem<TypeTag>;
+    using Scalar = GetPropType<TypeTag, Properties::Scalar>;
+public:
+    using ParentType::ParentType;
+
+    Scalar temperature() const
+    { return 283.15; }
+};
+
+} // end namespace Dumux
+
+namespace Dumux::Properties {
+
+namespace TTag {
+struct SnapshotTest { using InheritsFrom = std::tuple<OneP, CCTpfaModel>; };
+} // end namespace TTag
+
+template<class TypeTag>
+struct Grid<TypeTag, TTag::SnapshotTest>
+{ using type = Dune::YaspGrid<2>; };
+
+template<class TypeTag>
+struct Problem<TypeTag, TTag::SnapshotTest>
+{ using type = SnapshotTestProblem<TypeTag>; };
+
+template<class TypeTag>
+struct SpatialParams<TypeTag, TTag::SnapshotTest>
+{
+private:
+    using Scalar = GetPropType<TypeTag, Scalar>;
+    using GG = GetPropType<TypeTag, GridGeometry>;
+public:
+    using type = FVSpatialParamsOnePConstant<GG, Scalar>;
+};
+
+template<class TypeTag>
+struct FluidSystem<TypeTag, TTag::SnapshotTest>
+{
+private:
+    using Scalar = GetPropType<TypeTag, Scalar>;
+public:
+    using type = FluidSystems::OnePLiquid<Scalar, Components::SimpleH2O<Scalar>>;
+};
+
+template<class TypeTag>
+struct EnableGridVolumeVariablesCache<TypeTag, TTag::SnapshotTest> { static constexpr bool value = true; };
+template<class TypeTag>
+struct EnableGridFluxVariablesCache<TypeTag, TTag::SnapshotTest> { static constexpr bool value = true; };
+
+} // end namespace Dumux::Properties
+
+int main (int argc, char *argv[])
+{
+    Dune::MPIHelper::instance(argc, argv);
+
+    using namespace Dumux;
+    Parameters::init(argc, argv, [](auto& params){
+        params["Problem.Name"] = "snapshots";
+        params["Problem.EnableGravity"] = "false";
+        params["SpatialParams.Porosity"] = "0.3";
+        params["SpatialParams.Permeability"] = "1e-12";
+        params["Snapshots.MaxNumSnapshots"] = "3";
+        params["Compressed.Snapshots.Compress"] = "true";
+    });
+
+    using TypeTag = Properties::TTag::SnapshotTest;
+    using Grid = GetPropType<TypeTag, Properties::Grid>;
+    auto grid = Dune::StructuredGridFactory<Grid>::createCubeGrid({0.0, 0.0}, {1.0, 1.0}, {20, 20});
+
+    using GridGeometry = GetPropType<TypeTag, Properties::GridGeometry>;
+    auto gridGeometry = std::make_shared<GridGeometry>(grid->leafGridView());
+
+    using Problem = GetPropType<TypeTag, Properties::Problem>;
+    auto problem = std::make_shared<Problem>(gridGeometry);
+
+    using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
+    using GridVariables = GetPropType<TypeTag, Properties::GridVariables>;
+
+    // check that the volume variables correspond to the given solution
+    const auto checkState = [&](const SolutionVector& x, const GridVariables& gridVariables)
+    {
+        auto fvGeometry = localView(*gridGeometry);
+        for (const auto& element : elements(gridGeometry->gridView()))
+        {
+            fvGeometry.bindElement(element);
+            for (const auto& scv : scvs(fvGeometry))
+            {
+                const auto p = x[scv.dofIndex()][0];
+                if (gridVariables.curGridVolVars().volVars(scv).pressure(0) != p
+                    || gridVariables.prevGridVolVars().volVars(scv).pressure(0) != p)
+                    DUNE_THROW(Dune::Exception, "Volume variables do not match the restored solution");
+            }
+        }
+    };
+
+    const auto checkSolution = [](const SolutionVector& x, const SolutionVector& expected)
+    {
+        if (x.size() != expected.size())
+            DUNE_THROW(Dune::Exception, "Restored solution has wrong size");
+        for (std::size_t i = 0; i < x.size(); ++i)
+            if (x[i] != expected[i])
+                DUNE_THROW(Dune::Exception, "Restored solution does not match");
+    };
+
+    for (const std::string paramGroup : {"", "Compressed"})
+    {
+        SolutionVector x(gridGeometry->numDofs());
+        for (std::size_t i = 0; i < x.size(); ++i)
+            x[i] = 1e5 + 10.0*i;
+
+        auto gridVariables = std::make_shared<GridVariables>(problem, gridGeometry);
+        gridVariables->init(x);
+
+        // take a snapshot at the beginning of four time steps (only the last three are kept)
+        GridVariablesSnapshots<GridVariables, SolutionVector> snapshots(paramGroup);
+        std::vector<SolutionVector> solutions;
+        for (int step = 0; step < 4; ++step)
+        {
+            snapshots.save(x, *gridVariables);
+            solutions.push_back(x);
+
+            for (auto& priVars : x)
+                priVars += 100.0*(step + 1);
+            gridVariables->update(x);
+            gridVariables->advanceTimeStep();
+        }
+
+        if (snapshots.size() != 3)
+            DUNE_THROW(Dune::Exception, "Expected three snapshots, got " << snapshots.size());
+
+        std::cout << "Snapshots (" << (paramGroup.empty() ? "uncompressed" : "compressed")
+                  << ") use " << snapshots.memoryUsage() << " bytes of compact buffers" << std::endl;
+
+        // roll back the last time step (twice, the snapshot is kept)
+        for (int i = 0; i < 2; ++i)
+        {
+            x = 0.0;
+            snapshots.restore(x, *gridVariables);
+            checkSolution(x, solutions[3]);
+            checkState(x, *gridVariables);
+        }
+
+        // roll back two more time steps
+        snapshots.restore(x, *gridVariables, 3);
+        checkSolution(x, solutions[1]);
+        checkState(x, *gridVariables);
+
+        if (snapshots.size() != 1)
+            DUNE_THROW(Dune::Exception, "Expected the newer snapshots to be discarded");
+
+        bool caught = false;
+        try { snapshots.restore(x, *gridVariables, 2); }
+        catch (const Dune::InvalidStateException&) { caught = true; }
+        if (!caught)
+            DUNE_THROW(Dune::Exception, "Expected rollback beyond the oldest snapshot to fail");
+    }
+
+    // runs longer than the maximum count are split (tested with 8-bit counts, i.e. runs of at most 255 bytes)
+    {
+        std::vector<double> values(1000, 1.0);
+        for (std::size_t i = 500; i < values.size(); ++i)
+            values[i] = 1.0 + 1e-3*i*i;
+
+        Detail::CompactArray<double, std::uint8_t> compactArray(values.data(), values.size(), true);
+        std::vector<double> extracted(values.size());
+        compactArray.extract(extracted.data());
+        if (extracted != values)
+            DUNE_THROW(Dune::Exception, "Compact array with runs above the maximum count does not match");
+    }
+
+    std::cout << "\nAll tests passed" << std::endl;
+    return 0;
+}
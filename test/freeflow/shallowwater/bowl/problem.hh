@@ -217,7 +217,7 @@ public:
                                          insideVolVars.velocity(0), boundaryStateVariables[1],
                                          insideVolVars.velocity(1), boundaryStateVariables[2],
                                          insideVolVars.bedSurface(), insideVolVars.bedSurface(),
-                                         gravity, nxy);
+                                         gravity, nxy, this->fluxLimiterLETParams());
 
         values[Indices::massBalanceIdx] = riemannFlux[0];
         values[Indices::velocityXIdx]   = riemannFlux[1];
@@ -0,0 +1,164 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup ShallowWaterTests
+ * \brief A test for the explicit shallow water solver (wet dam break).
+ */
+#include <config.h>
+
+#include <cmath>
+#include <iostream>
+#include <algorithm>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/exceptions.hh>
+
+#include <dumux/common/properties.hh>
+#include <dumux/common/parameters.hh>
+#include <dumux/common/dumuxmessage.hh>
+#include <dumux/common/timeloop.hh>
+#include <dumux/io/vtkoutputmodule.hh>
+#include <dumux/io/grid/gridmanager.hh>
+
+#include <dumux/timestepping/multistagemethods.hh>
+#include <dumux/timestepping/multistagetimestepper.hh>
+#include <dumux/freeflow/shallowwater/explicitsolver.hh>
+
+#include "properties.hh"
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+
+    using TypeTag = Properties::TTag::DamBreakWet;
+
+    // initialize MPI, finalize is done automatically on exit
+    const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
+    // print dumux start message
+    if (mpiHelper.rank() == 0)
+        DumuxMessage::print(/*firstCall=*/true);
+
+    // parse command line arguments and input file
+    Parameters::init(argc, argv);
+
+    // try to create a grid (from the given grid file or the input file)
+    GridManager<GetPropType<TypeTag, Properties::Grid>> gridManager;
+    gridManager.init();
+
+    // we compute on the leaf grid view
+    const auto& leafGridView = gridManager.grid().leafGridView();
+
+    // create the finite volume grid geometry
+    using GridGeometry = GetPropType<TypeTag, Properties::GridGeometry>;
+    auto gridGeometry = std::make_shared<GridGeometry>(leafGridView);
+
+    // the problem (initial and boundary conditions)
+    using Problem = GetPropType<TypeTag, Properties::Problem>;
+    auto problem = std::make_shared<Problem>(gridGeometry);
+
+    // the solution vector
+    using SolutionVector = GetPropType<TypeTag, Properties::SolutionVector>;
+    SolutionVector x(gridGeometry->numDofs());
+    problem->applyInitialSolution(x);
+
+    // the grid variables
+    using GridVariables = GetPropType<TypeTag, Properties::GridVariables>;
+    auto gridVariables = std::make_shared<GridVariables>(problem, gridGeometry);
+    gridVariables->init(x);
+
+    // get some time loop parameters
+    using Scalar = GetPropType<TypeTag, Properties::Scalar>;
+    const auto tEnd = getParam<Scalar>("TimeLoop.TEnd");
+    const auto maxDt = getParam<Scalar>("TimeLoop.MaxTimeStepSize");
+    const bool localTimeStepping = getParam<bool>("TimeLoop.LocalTimeStepping", false);
+
+    // the explicit matrix-free assembler and the time stepper
+    using Assembler = Experimental::ShallowWaterExplicitAssembler<TypeTag>;
+    using Solver = Experimental::ShallowWaterExplicitSolver<Assembler>;
+    auto assembler = std::make_shared<Assembler>(problem, gridGeometry, gridVariables);
+    auto solver = std::make_shared<Solver>(assembler);
+    auto method = std::make_shared<Experimental::MultiStage::ExplicitEuler<Scalar>>();
+    Experimental::MultiStageTimeStepper<Solver> timeStepper(solver, method);
+
+    // time loop
+    auto timeLoop = std::make_shared<TimeLoop<Scalar>>(0.0, maxDt, tEnd);
+    typename Assembler::Variables vars(x);
+    timeLoop->start(); do
+    {
+        if (localTimeStepping)
+        {
+            auto sol = vars.dofs();
+            const auto dt = assembler->localTimeStep(sol, std::min(maxDt, tEnd - timeLoop->time()));
+            vars.update(sol);
+            timeLoop->setTimeStepSize(dt);
+        }
+        else
+        {
+            const auto dt = std::min({assembler->stableTimeStepSize(vars.dofs()), maxDt, tEnd - timeLoop->time()});
+            timeLoop->setTimeStepSize(dt);
+            timeStepper.step(vars, timeLoop->time(), dt);
+        }
+
+        timeLoop->advanceTimeStep();
+        timeLoop->reportTimeStep();
+
+    } while (!timeLoop->finished());
+
+    timeLoop->finalize(leafGridView.comm());
+
+    // compare with the analytical solution
+    x = vars.dofs();
+    gridVariables->update(x);
+    problem->updateAnalyticalSolution(x, *gridVariables, timeLoop->time());
+
+    using IOFields = GetPropType<TypeTag, Properties::IOFields>;
+    VtkOutputModule<GridVariables, SolutionVector> vtkWriter(*gridVariables, x, problem->name());
+    vtkWriter.addField(problem->getExactWaterDepth(), "exactWaterDepth");
+    vtkWriter.addField(problem->getExactVelocityX(), "exactVelocityX");
+    IOFields::initOutputModule(vtkWriter);
+    vtkWriter.write(timeLoop->time());
+
+    Scalar error = 0.0, norm = 0.0;
+    for (const auto& element : elements(leafGridView, Dune::Partitions::interior))
+    {
+        const auto eIdx = gridGeometry->elementMapper().index(element);
+        const auto volume = element.geometry().volume();
+        using std::abs;
+        error += abs(x[eIdx][0] - problem->getExactWaterDepth()[eIdx])*volume;
+        norm += abs(problem->getExactWaterDepth()[eIdx])*volume;
+    }
+    const auto relativeError = leafGridView.comm().sum(error)/leafGridView.comm().sum(norm);
+
+    if (mpiHelper.rank() == 0)
+        std::cout << "Relative L1 error of the water depth: " << relativeError << std::endl;
+
+    if (relativeError > getParam<Scalar>("Problem.MaxRelativeError", 0.05))
+        DUNE_THROW(Dune::Exception, "Water depth deviates from the analytical solution (relative L1 error " << relativeError << ")");
+
+    // print dumux end message
+    if (mpiHelper.rank() == 0)
+    {
+        Parameters::print();
+        DumuxMessage::print(/*firstCall=*/false);
+    }
+
+    return 0;
+}
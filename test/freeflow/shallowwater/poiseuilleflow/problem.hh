@@ -288,7 +288,8 @@ public:
                                                         insideVolVars.bedSurface(),
                                                         insideVolVars.bedSurface(),
                                                         gravity,
-                                                        unitNormal);
+                                                        unitNormal,
+                                                        this->fluxLimiterLETParams());
 
         values[Indices::massBalanceIdx] = riemannFlux[0];
         values[Indices::velocityXIdx] = riemannFlux[1];
@@ -295,7 +295,8 @@ public:
                                                         insideVolVars.bedSurface(),
                                                         insideVolVars.bedSurface(),
                                                         gravity,
-                                                        nxy);
+                                                        nxy,
+                                                        this->fluxLimiterLETParams());
 
         values[Indices::massBalanceIdx] = riemannFlux[0];
         values[Indices::velocityXIdx]   = riemannFlux[1];
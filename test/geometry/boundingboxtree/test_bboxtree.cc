@@ -1,6 +1,7 @@
 #include <config.h>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 
 #include <dune/grid/utility/structuredgridfactory.hh>
 #include <dune/common/parallel/mpihelper.hh>
@@ -37,8 +38,40 @@ public:
     int build(const GridView& gv)
     {
         // build a bounding box tree
+        Dune::Timer timer;
         tree_ = std::make_shared<BoundingBoxTree>();
         tree_->build(std::make_shared<EntitySet>(gv));
+        std::cout << "Build throughput: " << gv.size(0)/timer.elapsed() << " entities/s" << std::endl;
+        return 0;
+    }
+
+    int intersectPoints(const std::vector<GlobalPosition>& points)
+    {
+        std::cout << "Intersect with " << points.size() << " points (batched)";
+
+        Dune::Timer timer;
+        const auto entities = intersectingEntities(points, *tree_);
+        const auto batchedTime = timer.elapsed();
+
+        timer.reset();
+        std::vector<std::vector<std::size_t>> expectedEntities(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+            expectedEntities[i] = intersectingEntities(points[i], *tree_);
+        const auto singleTime = timer.elapsed();
+
+        std::cout << " --> " << points.size()/batchedTime << " points/s (batched), "
+                  << points.size()/singleTime << " points/s (single point queries)\n";
+
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            if (entities[i] != expectedEntities[i])
+            {
+                std::cerr << "Batched point intersection failed for point (" << points[i] << "): Expected "
+                          << expectedEntities[i].size() << " and got "
+                          << entities[i].size() << " intersection(s)!\n";
+                return 1;
+            }
+        }
         return 0;
     }
 
@@ -222,6 +255,23 @@ int main (int argc, char *argv[])
             returns.push_back(test.intersectPoint(GlobalPosition(1.0*scaling/numCellsX), 1<<dimworld));
             returns.push_back(test.intersectPoint(GlobalPosition(1.0*scaling), 1));
 
+            // batched point queries on a lattice of points including element corners and faces
+            {
+                constexpr int numPointsX = dimworld == 3 ? 67 : (dimworld == 2 ? 331 : 10001);
+                const auto numPoints = static_cast<std::size_t>(std::pow(numPointsX, dimworld));
+                std::vector<GlobalPosition> points(numPoints);
+                for (std::size_t i = 0; i < numPoints; ++i)
+                {
+                    auto index = i;
+                    for (int d = 0; d < dimworld; ++d)
+                    {
+                        points[i][d] = scaling*(index % numPointsX)/(numPointsX - 1.0);
+                        index /= numPointsX;
+                    }
+                }
+                returns.push_back(test.intersectPoints(points));
+            }
+
             // bboxtree tests using one bboxtree and a geometry
             // TODO add more such tests
 #if WORLD_DIMENSION == 3
@@ -23,6 +23,7 @@
 
 #include <dumux/linear/istlsolverfactorybackend.hh>
 #include <dumux/linear/amgbackend.hh>
+#include <dumux/linear/compactbcrsmatrix.hh>
 
 namespace Dumux::Test {
 
@@ -87,5 +88,31 @@ int main(int argc, char* argv[])
     Test::solveWithFactory(A, x, b, "AMGCG");
     Test::solveWithFactory(A, x, b, "SSORCG");
 
+    // Jacobian stored in single precision with 32-bit indices and double precision vectors
+    {
+        using CompactMatrix = CompactBCRSMatrix<Dune::FieldMatrix<float, 2, 2>>;
+        static_assert(sizeof(CompactMatrix::size_type) == 4, "Expected 32-bit indices");
+
+        auto compactA = copyBCRSMatrix<CompactMatrix>(A);
+        if (copyBCRSMatrix<Matrix>(compactA).nonzeroes() != A.nonzeroes())
+            DUNE_THROW(Dune::Exception, "Matrix conversion changed the sparsity pattern");
+
+        // the iterative solvers overwrite the right hand side
+        Vector xRef(A.N()); xRef = 0;
+        Vector bTmp(A.M()); bTmp = 1;
+        Test::solveWithFactory(A, xRef, bTmp, "SSORCG");
+
+        for (const auto& paramGroup : {"AMGCG", "SSORCG"})
+        {
+            Vector xCompact(A.N()); xCompact = 0;
+            bTmp = 1;
+            Test::solveWithFactory(compactA, xCompact, bTmp, paramGroup);
+
+            xCompact -= xRef;
+            if (xCompact.two_norm() > 1e-4*xRef.two_norm())
+                DUNE_THROW(Dune::Exception, "Mixed precision solution deviates from the reference solution by " << xCompact.two_norm());
+        }
+    }
+
     return 0;
 }
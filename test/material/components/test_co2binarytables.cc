@@ -0,0 +1,134 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup MaterialTests
+ * \brief Test the runtime-loaded binary CO2 tables
+ */
+
+#include "config.h"
+
+#include <cmath>
+#include <iostream>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/float_cmp.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dumux/common/parameters.hh>
+#include <dumux/material/components/co2.hh>
+#include <dumux/material/components/co2binarytables.hh>
+
+#include <test/porousmediumflow/co2/co2tables.hh>
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+    Dune::MPIHelper::instance(argc, argv);
+
+    using CompiledTables = HeterogeneousCO2Tables::CO2Tables;
+    const auto& compiledDensity = CompiledTables::tabulatedDensity;
+    const auto& compiledEnthalpy = CompiledTables::tabulatedEnthalpy;
+
+    // convert the compiled-in tables to a binary file
+    const std::string fileName = "co2tables_test.bin";
+    CO2TableFile::write<CompiledTables>(fileName);
+
+    // bilinear interpolation reproduces the compiled-in tables (also outside of the range)
+    {
+        const CO2TableFile tables(fileName);
+        if (tables.density().numTempSteps() != compiledDensity.numTempSteps
+            || tables.density().numPressSteps() != compiledDensity.numPressSteps)
+            DUNE_THROW(Dune::Exception, "Wrong table size");
+
+        for (int i = 0; i <= 100; ++i)
+        {
+            for (int j = 0; j <= 100; ++j)
+            {
+                const double temperature = compiledDensity.minTemp() - 5.0 + i*(compiledDensity.maxTemp() - compiledDensity.minTemp() + 10.0)/100;
+                const double pressure = compiledDensity.minPress()*0.5 + j*(compiledDensity.maxPress() - compiledDensity.minPress()*0.5)/80;
+
+                const auto check = [&](double value, double expected, const std::string& name)
+                {
+                    if (std::abs(value - expected) > 1e-10*(1.0 + std::abs(expected)))
+                        DUNE_THROW(Dune::Exception, "Wrong " << name << " at T = " << temperature << ", p = " << pressure
+                                                     << ": " << value << " (expected " << expected << ")");
+                };
+
+                check(tables.density().at(temperature, pressure), compiledDensity.at(temperature, pressure), "density");
+                check(tables.enthalpy().at(temperature, pressure), compiledEnthalpy.at(temperature, pressure), "enthalpy");
+            }
+        }
+    }
+
+    // monotone cubic interpolation reproduces the sampling points and is monotone
+    // (the density increases with pressure) without overshoots
+    {
+        const CO2TableFile tables(fileName, CO2TableInterpolation::monotoneCubic);
+        const auto& density = tables.density();
+        const double dT = (density.maxTemp() - density.minTemp())/(density.numTempSteps() - 1);
+        const double dp = (density.maxPress() - density.minPress())/(density.numPressSteps() - 1);
+        for (int i = 0; i < density.numTempSteps(); ++i)
+        {
+            const double temperature = density.minTemp() + i*dT;
+            for (int j = 0; j < density.numPressSteps(); ++j)
+            {
+                const double pressure = density.minPress() + j*dp;
+                if (Dune::FloatCmp::ne(density.at(temperature, pressure), density.val(i, j), 1e-10))
+                    DUNE_THROW(Dune::Exception, "Monotone cubic interpolation does not reproduce the value at (" << i << ", " << j << ")");
+
+                if (j + 1 == density.numPressSteps())
+                    continue;
+
+                double previous = density.val(i, j);
+                for (int k = 1; k <= 10; ++k)
+                {
+                    const double value = density.at(temperature, pressure + 0.1*k*dp);
+                    if (value < previous - 1e-10*std::abs(previous) || value > density.val(i, j+1) + 1e-10*std::abs(value))
+                        DUNE_THROW(Dune::Exception, "Monotone cubic interpolation is not monotone at T = " << temperature
+                                                     << ", p = " << pressure + 0.1*k*dp);
+                    previous = value;
+                }
+            }
+        }
+    }
+
+    // the CO2 component with tables loaded from the file given by the parameter
+    {
+        Parameters::init([&](auto& params){ params["CO2Tables.File"] = fileName; });
+        using CO2Binary = Components::CO2<double, BinaryCO2Tables>;
+        using CO2Compiled = Components::CO2<double, CompiledTables>;
+
+        if (Dune::FloatCmp::ne(CO2Binary::maxTabulatedPressure(), CO2Compiled::maxTabulatedPressure()))
+            DUNE_THROW(Dune::Exception, "Wrong tabulated pressure range");
+
+        for (double temperature : {295.0, 310.0, 335.0})
+        {
+            for (double pressure : {2e5, 5e6, 1e7, 3e7})
+            {
+                if (Dune::FloatCmp::ne(CO2Binary::gasDensity(temperature, pressure), CO2Compiled::gasDensity(temperature, pressure), 1e-12)
+                    || Dune::FloatCmp::ne(CO2Binary::gasEnthalpy(temperature, pressure), CO2Compiled::gasEnthalpy(temperature, pressure), 1e-12))
+                    DUNE_THROW(Dune::Exception, "Wrong CO2 properties with BinaryCO2Tables at T = " << temperature << ", p = " << pressure);
+            }
+        }
+    }
+
+    std::cout << "Binary CO2 tables test passed" << std::endl;
+    return 0;
+}
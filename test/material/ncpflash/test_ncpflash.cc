@@ -119,6 +119,21 @@ void checkNcpFlash(const FluidState &fsRef,
 
     // compare the "flashed" fluid state with the reference one
     checkSame<Scalar>(fsRef, fsFlash);
+
+    // run the flash again, starting from the stored converged state of the first run
+    Dumux::FlashWarmStartStorage<FluidState> storage;
+    storage.resize(1);
+    storage.store(0, fsFlash);
+    const int numColdIterations = flash.numIterations();
+
+    FluidState fsWarm;
+    fsWarm.setTemperature(fsRef.temperature(/*phaseIdx=*/0));
+    flash.solve(fsWarm, paramCache, material, globalMolarities, storage, 0);
+    checkSame<Scalar>(fsRef, fsWarm);
+
+    if (flash.numIterations() >= numColdIterations)
+        DUNE_THROW(Dune::Exception, "Warm-started flash needed " << flash.numIterations()
+                                    << " iterations, cold start " << numColdIterations);
 }
 
 
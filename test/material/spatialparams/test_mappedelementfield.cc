@@ -0,0 +1,94 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \brief Test reading element fields from raw and compressed binary field files
+ */
+#include <config.h>
+
+#include <iostream>
+#include <vector>
+#include <array>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/float_cmp.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+
+#include <dumux/geometry/intersectingentities.hh>
+#include <dumux/material/spatialparams/mappedelementfield.hh>
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+
+    const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+
+    using Grid = Dune::YaspGrid<2>;
+    using GlobalPosition = Dune::FieldVector<double, 2>;
+    const GlobalPosition lowerLeft(0.0), upperRight(1.0);
+    const std::array<int, 2> cells{{40, 30}};
+    Grid grid(upperRight, cells);
+    const auto gridView = grid.leafGridView();
+
+    using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<Grid::LeafGridView>;
+    ElementMapper elementMapper(gridView, Dune::mcmgElementLayout());
+
+    // a tensor-valued field (2x2 entries per cell) on the global structured grid
+    const std::size_t numCells = cells[0]*cells[1];
+    std::vector<double> values(4*numCells);
+    for (std::size_t i = 0; i < numCells; ++i)
+        for (std::size_t j = 0; j < 4; ++j)
+            values[4*i + j] = 1e-12*(i+1) + j;
+
+    // the file index of each element is the lexicographic index of the structured grid cell
+    const auto globalIndex = [&](const auto& element)
+    { return intersectingEntityCartesianGrid(element.geometry().center(), lowerLeft, upperRight, cells); };
+
+    std::vector<std::pair<std::string, std::size_t>> files{{"field_raw.bin", 0}};
+#if HAVE_ZLIB
+    files.emplace_back("field_compressed.bin", 97);
+#endif
+
+    for (const auto& [fileName, chunkSize] : files)
+    {
+        if (mpiHelper.rank() == 0)
+            writeBinaryField(fileName, values, 4, chunkSize);
+        mpiHelper.getCommunication().barrier();
+
+        MappedElementField<Grid::LeafGridView> field(fileName, gridView, elementMapper, globalIndex);
+        if (field.numComponents() != 4)
+            DUNE_THROW(Dune::Exception, "Wrong number of components " << field.numComponents() << " in " << fileName);
+
+        for (const auto& element : elements(gridView))
+        {
+            const auto gIdx = globalIndex(element);
+            const auto k = field.values<4>(element);
+            for (int j = 0; j < 4; ++j)
+                if (Dune::FloatCmp::ne(k[j], values[4*gIdx + j]))
+                    DUNE_THROW(Dune::Exception, "Wrong value " << k[j] << " for element " << gIdx
+                                                << " in " << fileName << ", expected " << values[4*gIdx + j]);
+        }
+
+        std::cout << "Successfully read element field from " << fileName << std::endl;
+    }
+
+    return 0;
+}
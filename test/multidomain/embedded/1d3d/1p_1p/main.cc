@@ -27,9 +27,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <utility>
 
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/timer.hh>
+#include <dune/common/hybridutilities.hh>
 
 #include <dumux/common/properties.hh>
 #include <dumux/common/parameters.hh>
@@ -172,6 +175,36 @@ int main(int argc, char** argv)
     assembler->assembleJacobianAndResidual(sol);
     assembleTimer.stop();
 
+    // the multithreaded assembly has to reproduce the serial Jacobian and residual
+    if (assembler->isMultithreaded())
+    {
+        Parameters::init([](Dune::ParameterTree& params){ params["Assembly.Multithreading"] = "false"; });
+        auto serialAssembler = std::make_shared<Assembler>(std::make_tuple(bulkProblem, lowDimProblem),
+                                                           std::make_tuple(bulkFvGridGeometry, lowDimFvGridGeometry),
+                                                           std::make_tuple(bulkGridVariables, lowDimGridVariables),
+                                                           couplingManager);
+        serialAssembler->assembleJacobianAndResidual(sol);
+
+        using namespace Dune::Hybrid;
+        forEach(std::make_index_sequence<Traits::numSubDomains>(), [&](const auto i)
+        {
+            forEach(std::make_index_sequence<Traits::numSubDomains>(), [&](const auto j)
+            {
+                auto jacDiff = serialAssembler->jacobian()[i][j];
+                jacDiff -= assembler->jacobian()[i][j];
+                if (jacDiff.infinity_norm() > 1e-10*std::max(1.0, serialAssembler->jacobian()[i][j].infinity_norm()))
+                    DUNE_THROW(Dune::Exception, "Multithreaded assembly of Jacobian block (" << i << ", " << j << ") differs from the serial one");
+            });
+
+            auto resDiff = serialAssembler->residual()[i];
+            resDiff -= assembler->residual()[i];
+            if (resDiff.infinity_norm() > 1e-10*std::max(1.0, serialAssembler->residual()[i].infinity_norm()))
+                DUNE_THROW(Dune::Exception, "Multithreaded assembly of residual block " << i << " differs from the serial one");
+        });
+
+        std::cout << "Multithreaded assembly matches the serial assembly. " << std::flush;
+    }
+
     std::cout << "done.\n";
     std::cout << "Solving linear system ("
               << linearSolver->name() << ") ... " << std::flush;
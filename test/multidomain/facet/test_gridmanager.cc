@@ -24,6 +24,7 @@
 
 #include <config.h>
 #include <iostream>
+#include <string>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/float_cmp.hh>
@@ -265,13 +266,16 @@ int main (int argc, char *argv[])
     if (embeddings != 0) DUNE_THROW(Dune::InvalidStateException, "The grid with lowest dimension can't have embedded entities");
     if (embedments!= 2) DUNE_THROW(Dune::InvalidStateException, "Found " << edgeEmbedments.size() << " instead of 2 edge element embedments");
 
-    // write .vtk file for each grid
+    // write .vtk file for each grid (prefixed with the problem name if given)
+    const auto name = Dumux::getParam<std::string>("Problem.Name", "");
+    const auto prefix = name.empty() ? name : name + "_";
+
     using BulkWriter = Dune::VTKWriter<typename BulkGrid::LeafGridView>;
-    BulkWriter bulkWriter(bulkGridView); bulkWriter.write("bulkgrid");
+    BulkWriter bulkWriter(bulkGridView); bulkWriter.write(prefix + "bulkgrid");
 
     using FacetWriter = Dune::VTKWriter<typename FacetGrid::LeafGridView>;
-    FacetWriter facetWriter(facetGridView); facetWriter.write("facetgrid");
+    FacetWriter facetWriter(facetGridView); facetWriter.write(prefix + "facetgrid");
 
     using EdgeWriter = Dune::VTKWriter<typename EdgeGrid::LeafGridView>;
-    EdgeWriter edgeWriter(edgeGridView); edgeWriter.write("edgegrid");
+    EdgeWriter edgeWriter(edgeGridView); edgeWriter.write(prefix + "edgegrid");
 }
@@ -36,6 +36,12 @@
 #include <dumux/multidomain/fvassembler.hh>
 #include <dumux/multidomain/traits.hh>
 
+#if FIXEDSTRESS
+#include <dumux/linear/amgbackend.hh>
+#include <dumux/linear/linearsolvertraits.hh>
+#include <dumux/geomechanics/poroelastic/fixedstresssolver.hh>
+#endif
+
 #include <dumux/io/vtkoutputmodule.hh>
 #include <dumux/io/grid/gridmanager_yasp.hh>
 
@@ -140,6 +146,20 @@ int main(int argc, char** argv)
                                                   std::make_tuple(onePGridVariables, poroMechGridVariables),
                                                   couplingManager);
 
+#if FIXEDSTRESS
+    // the linear solvers for the two sub-problems
+    using OnePLinearSolver = AMGBiCGSTABBackend<LinearSolverTraits<OnePFVGridGeometry>>;
+    using PoroMechLinearSolver = AMGBiCGSTABBackend<LinearSolverTraits<PoroMechFVGridGeometry>>;
+    auto onePLinearSolver = std::make_shared<OnePLinearSolver>(leafGridView, onePFvGridGeometry->dofMapper(), "OneP");
+    auto poroMechLinearSolver = std::make_shared<PoroMechLinearSolver>(leafGridView, poroMechFvGridGeometry->dofMapper(), "PoroElastic");
+
+    // the sequential fixed-stress solver
+    using Solver = PoroMechanicsFixedStressSolver<Assembler, OnePLinearSolver, PoroMechLinearSolver, CouplingManager>;
+    auto solver = std::make_shared<Solver>(assembler, onePLinearSolver, poroMechLinearSolver, couplingManager);
+
+    // solve the coupled problem
+    solver->solve(x);
+#else
     // the linear solver
     using LinearSolver = ILU0BiCGSTABBackend;
     auto linearSolver = std::make_shared<LinearSolver>();
@@ -150,6 +170,7 @@ int main(int argc, char** argv)
 
     // linearize & solve
     newtonSolver->solve(x);
+#endif
 
     // update grid variables for output
     onePGridVariables->update(x[onePId]);
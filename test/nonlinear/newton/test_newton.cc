@@ -9,6 +9,7 @@
 #include <dune/common/float_cmp.hh>
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/istl/bvector.hh>
+#include <dumux/common/parameters.hh>
 #include <dumux/nonlinear/newtonsolver.hh>
 
 /*
@@ -81,6 +82,9 @@ int main(int argc, char* argv[])
     // maybe initialize MPI
     Dune::MPIHelper::instance(argc, argv);
 
+    // parse command line arguments
+    Parameters::init(argc, argv);
+
     // use the Newton solver to find a solution to a scalar equation
     using Assembler = MockScalarAssembler;
     using LinearSolver = MockScalarLinearSolver;
@@ -90,11 +94,12 @@ int main(int argc, char* argv[])
     auto linearSolver = std::make_shared<LinearSolver>();
     auto solver = std::make_shared<Solver>(assembler, linearSolver);
 
-    double initialGuess = 0.1;
+    const double initialGuess = getParam<double>("InitialGuess", 0.1);
     double x = initialGuess;
 
     std::cout << "Solving: x^2 - 5 = 0" << std::endl;
     solver->solve(x);
+    solver->report();
     std::cout << "Solution: " << std::setprecision(15) << x
               << ", exact: " << std::sqrt(5.0)
               << ", error: " << std::abs(x-std::sqrt(5.0))/std::sqrt(5.0)*100 << "%" << std::endl;
@@ -102,6 +107,11 @@ int main(int argc, char* argv[])
     if (Dune::FloatCmp::ne(x, std::sqrt(5.0), 1e-13))
         DUNE_THROW(Dune::Exception, "Didn't find correct root: " << std::setprecision(15) << x << ", exact: " << std::sqrt(5.0));
 
+    // in the frozen Jacobian mode, some Newton steps have to reuse the Jacobian
+    if (getParam<bool>("Newton.EnableFrozenJacobian", false) && solver->numFrozenJacobianIterations() == 0)
+        DUNE_THROW(Dune::Exception, "No Newton step reused the frozen Jacobian ("
+                                    << solver->numJacobianAssemblies() << " Jacobian assemblies)");
+
     return 0;
 
 }
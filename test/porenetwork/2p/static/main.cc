@@ -24,8 +24,10 @@
  #include <config.h>
 
  #include <ctime>
+ #include <memory>
  #include <iostream>
 
+ #include <dune/common/exceptions.hh>
  #include <dune/common/parallel/mpihelper.hh>
  #include <dune/common/timer.hh>
  #include <dune/grid/io/file/dgfparser/dgfexception.hh>
@@ -122,6 +124,7 @@ int main(int argc, char** argv)
     const Scalar initialPc = getParam<Scalar>("Problem.InitialPc");
     const Scalar finalPc = getParam<Scalar>("Problem.FinalPc");
     const bool allowDraingeOfOutlet = getParam<bool>("Problem.AllowDraingeOfOutlet", false);
+    const bool enableTrapping = getParam<bool>("Problem.EnableTrapping", false);
 
     // helper function to evalute the entry capillary pressure
     auto getPcEntry = [&](const std::size_t eIdx)
@@ -179,7 +182,15 @@ int main(int argc, char** argv)
     // get the drainage model
     PoreNetwork::TwoPStaticDrainage<GridGeometry, Scalar> drainageModel(*gridGeometry, pcEntry, throatLabel,
                                                                         inletThroatLabel, outletThroatLabel,
-                                                                        allowDraingeOfOutlet);
+                                                                        allowDraingeOfOutlet, enableTrapping);
+
+    // with trapping, the throats invaded without trapping minus the trapped ones are invaded (at the same pressures)
+    using InvasionPercolation = PoreNetwork::InvasionPercolation<GridGeometry, Scalar>;
+    std::unique_ptr<InvasionPercolation> invasionWithoutTrapping;
+    if (enableTrapping)
+        invasionWithoutTrapping = std::make_unique<InvasionPercolation>(*gridGeometry, pcEntry, throatLabel,
+                                                                        inletThroatLabel, outletThroatLabel,
+                                                                        allowDraingeOfOutlet, false);
 
     // prepare logfile
     std::ofstream logfile;
@@ -203,6 +214,21 @@ int main(int argc, char** argv)
         std::cout << "Step " << step << ": Applying global pc of " << pcGlobal << " --> ";
         drainageModel.updateInvasionState(elementIsInvaded, pcGlobal);
 
+        if (enableTrapping)
+        {
+            std::size_t numThroatsTrapped = 0;
+            for (std::size_t eIdx = 0; eIdx < elementIsInvaded.size(); ++eIdx)
+                if (drainageModel.invasionPercolation().isTrapped(eIdx) && invasionWithoutTrapping->isInvaded(eIdx, pcGlobal))
+                    ++numThroatsTrapped;
+
+            if (drainageModel.numThroatsInvaded() + numThroatsTrapped != invasionWithoutTrapping->numThroatsInvaded(pcGlobal))
+                DUNE_THROW(Dune::Exception, drainageModel.numThroatsInvaded() << " invaded and " << numThroatsTrapped
+                                            << " trapped throats, but " << invasionWithoutTrapping->numThroatsInvaded(pcGlobal)
+                                            << " throats are invaded without trapping");
+
+            std::cout << numThroatsTrapped << " throats trapped, ";
+        }
+
         // calculate the average saturation of the network
         averageSaturation = 0;
         auto fvGeometry = localView(*gridGeometry);
@@ -0,0 +1,147 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*****************************************************************************
+ *   See the file COPYING for full copying permissions.                      *
+ *                                                                           *
+ *   This program is free software: you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation, either version 3 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the            *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program.  If not, see <http://www.gnu.org/licenses/>.   *
+ *****************************************************************************/
+/*!
+ * \file
+ * \ingroup PNMTwoPModel
+ * \brief Test for the invasion percolation with and without trapping on a small network
+ *
+ * The network (throat: pores, entry pressure, label):
+ *   t0: 0-1, 1.0, inlet
+ *   t1: 1-2, 2.0
+ *   t2: 1-3, 2.5
+ *   t3: 3-2, 4.0
+ *   t4: 2-4, 3.0
+ *   t5: 4-5, 100.0, outlet
+ * The throats are invaded in the order t0, t1, t2, t4, t3. When t4 is invaded, the defending
+ * phase in t3 is surrounded by invaded throats, so t3 is trapped if trapping is enabled.
+ */
+#include <config.h>
+
+#include <array>
+#include <vector>
+#include <iostream>
+#include <limits>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/common/gridfactory.hh>
+#include <dune/foamgrid/foamgrid.hh>
+
+#include <dumux/porenetwork/2p/static/invasionpercolation.hh>
+
+namespace Dumux {
+
+//! the invasion percolation only uses the grid view of the grid geometry
+template<class GV>
+struct NetworkGeometry
+{
+    using GridView = GV;
+    const GridView& gridView() const { return gridView_; }
+    GridView gridView_;
+};
+
+} // end namespace Dumux
+
+int main(int argc, char** argv)
+{
+    using namespace Dumux;
+
+    Dune::MPIHelper::instance(argc, argv);
+
+    using Grid = Dune::FoamGrid<1, 3>;
+    Dune::GridFactory<Grid> factory;
+
+    const std::vector<Dune::FieldVector<double, 3>> pores{{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {2.0, 0.0, 0.0},
+                                                         {1.5, 1.0, 0.0}, {3.0, 0.0, 0.0}, {4.0, 0.0, 0.0}};
+    for (const auto& pos : pores)
+        factory.insertVertex(pos);
+
+    struct Throat { std::array<unsigned int, 2> pores; double pcEntry; int label; };
+    constexpr int inletLabel = 2;
+    constexpr int outletLabel = 3;
+    const std::vector<Throat> throats{{{0, 1}, 1.0, inletLabel},
+                                      {{1, 2}, 2.0, 1},
+                                      {{1, 3}, 2.5, 1},
+                                      {{3, 2}, 4.0, 1},
+                                      {{2, 4}, 3.0, 1},
+                                      {{4, 5}, 100.0, outletLabel}};
+    for (const auto& throat : throats)
+        factory.insertElement(Dune::GeometryTypes::line, {throat.pores[0], throat.pores[1]});
+
+    auto grid = std::shared_ptr<Grid>(factory.createGrid());
+    using GridGeometry = NetworkGeometry<typename Grid::LeafGridView>;
+    const GridGeometry gridGeometry{grid->leafGridView()};
+
+    // the throat data in the order of the element index set
+    const auto& gridView = gridGeometry.gridView();
+    std::vector<double> pcEntry(throats.size());
+    std::vector<int> throatLabel(throats.size());
+    std::vector<std::size_t> eIdx(throats.size());
+    for (const auto& element : elements(gridView))
+    {
+        const auto insertionIdx = factory.insertionIndex(element);
+        eIdx[insertionIdx] = gridView.indexSet().index(element);
+        pcEntry[eIdx[insertionIdx]] = throats[insertionIdx].pcEntry;
+        throatLabel[eIdx[insertionIdx]] = throats[insertionIdx].label;
+    }
+
+    using InvasionPercolation = PoreNetwork::InvasionPercolation<GridGeometry, double>;
+    const InvasionPercolation noTrapping(gridGeometry, pcEntry, throatLabel, inletLabel, outletLabel, false, false);
+    const InvasionPercolation trapping(gridGeometry, pcEntry, throatLabel, inletLabel, outletLabel, false, true);
+
+    // the invasion order and pressures without trapping
+    const std::vector<std::size_t> expectedOrder{0, 1, 2, 4, 3};
+    const std::vector<double> expectedPressure{1.0, 2.0, 2.5, 4.0, 3.0, std::numeric_limits<double>::infinity()};
+    if (noTrapping.invasionOrder().size() != expectedOrder.size())
+        DUNE_THROW(Dune::Exception, "Invaded " << noTrapping.invasionOrder().size() << " instead of " << expectedOrder.size() << " throats");
+    for (std::size_t i = 0; i < expectedOrder.size(); ++i)
+        if (noTrapping.invasionOrder()[i] != eIdx[expectedOrder[i]])
+            DUNE_THROW(Dune::Exception, "Throat t" << expectedOrder[i] << " is not invaded at position " << i);
+    for (std::size_t t = 0; t < throats.size(); ++t)
+        if (noTrapping.invasionPressure(eIdx[t]) != expectedPressure[t])
+            DUNE_THROW(Dune::Exception, "Throat t" << t << " is invaded at " << noTrapping.invasionPressure(eIdx[t])
+                                        << " instead of " << expectedPressure[t]);
+
+    // only t3 is trapped
+    for (std::size_t t = 0; t < throats.size(); ++t)
+    {
+        if (noTrapping.isTrapped(eIdx[t]))
+            DUNE_THROW(Dune::Exception, "Throat t" << t << " is trapped although trapping is disabled");
+        if (trapping.isTrapped(eIdx[t]) != (t == 3))
+            DUNE_THROW(Dune::Exception, "Wrong trapping state of throat t" << t);
+    }
+
+    // the number of invaded throats for increasing global capillary pressures
+    const std::vector<double> pcGlobal{0.5, 1.0, 2.2, 3.0, 5.0, 200.0};
+    const std::vector<std::size_t> expectedNoTrapping{0, 1, 2, 4, 5, 5};
+    const std::vector<std::size_t> expectedTrapping{0, 1, 2, 4, 4, 4};
+    for (std::size_t i = 0; i < pcGlobal.size(); ++i)
+    {
+        if (noTrapping.numThroatsInvaded(pcGlobal[i]) != expectedNoTrapping[i])
+            DUNE_THROW(Dune::Exception, "Without trapping, " << noTrapping.numThroatsInvaded(pcGlobal[i])
+                                        << " instead of " << expectedNoTrapping[i] << " throats are invaded at pc = " << pcGlobal[i]);
+        if (trapping.numThroatsInvaded(pcGlobal[i]) != expectedTrapping[i])
+            DUNE_THROW(Dune::Exception, "With trapping, " << trapping.numThroatsInvaded(pcGlobal[i])
+                                        << " instead of " << expectedTrapping[i] << " throats are invaded at pc = " << pcGlobal[i]);
+    }
+
+    std::cout << "All invasion percolation tests passed" << std::endl;
+    return 0;
+}
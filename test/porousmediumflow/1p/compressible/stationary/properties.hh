@@ -27,6 +27,7 @@
 
 #include <dune/grid/yaspgrid.hh>
 
+#include <dumux/common/arenaallocator.hh>
 #include <dumux/material/fluidsystems/1pliquid.hh>
 
 #include <dumux/discretization/cctpfa.hh>
@@ -44,7 +45,9 @@ namespace Dumux::Properties {
 namespace TTag {
 struct OnePCompressible { using InheritsFrom = std::tuple<OneP>; };
 struct OnePCompressibleTpfa { using InheritsFrom = std::tuple<OnePCompressible, CCTpfaModel>; };
+struct OnePCompressibleTpfaMixedPrecision { using InheritsFrom = std::tuple<OnePCompressibleTpfa>; };
 struct OnePCompressibleMpfa { using InheritsFrom = std::tuple<OnePCompressible, CCMpfaModel>; };
+struct OnePCompressibleMpfaArena { using InheritsFrom = std::tuple<OnePCompressibleMpfa>; };
 struct OnePCompressibleBox { using InheritsFrom = std::tuple<OnePCompressible, BoxModel>; };
 } // end namespace TTag
 
@@ -82,5 +85,45 @@ template<class TypeTag>
 struct EnableGridFluxVariablesCache<TypeTag, TTag::OnePCompressible> { static constexpr bool value = false; };
 template<class TypeTag>
 struct EnableGridGeometryCache<TypeTag, TTag::OnePCompressible> { static constexpr bool value = false; };
+
+// Store the Jacobian in single precision with 32-bit indices
+template<class TypeTag>
+struct JacobianScalar<TypeTag, TTag::OnePCompressibleTpfaMixedPrecision> { using type = float; };
+template<class TypeTag>
+struct EnableCompactJacobianIndices<TypeTag, TTag::OnePCompressibleTpfaMixedPrecision> { static constexpr bool value = true; };
+
+// Take the temporary storage of the mpfa local views from the arena during the assembly
+template<class TypeTag>
+struct GridVolumeVariables<TypeTag, TTag::OnePCompressibleMpfaArena>
+{
+private:
+    static constexpr bool enableCache = getPropValue<TypeTag, Properties::EnableGridVolumeVariablesCache>();
+    using Problem = GetPropType<TypeTag, Properties::Problem>;
+    using VolumeVariables = GetPropType<TypeTag, Properties::VolumeVariables>;
+
+    struct Traits : public CCMpfaDefaultGridVolumeVariablesTraits<Problem, VolumeVariables>
+    {
+        template<class T>
+        using LocalViewAllocator = ArenaAllocator<T>;
+    };
+public:
+    using type = CCMpfaGridVolumeVariables<Problem, VolumeVariables, enableCache, Traits>;
+};
+
+template<class TypeTag>
+struct GridFluxVariablesCache<TypeTag, TTag::OnePCompressibleMpfaArena>
+{
+private:
+    static constexpr bool enableCache = getPropValue<TypeTag, Properties::EnableGridFluxVariablesCache>();
+    using DefaultTraits = typename GridFluxVariablesCache<TypeTag, TTag::CCMpfaModel>::type::Traits;
+
+    struct Traits : public DefaultTraits
+    {
+        template<class T>
+        using LocalViewAllocator = ArenaAllocator<T>;
+    };
+public:
+    using type = CCMpfaGridFluxVariablesCache<Traits, enableCache>;
+};
 }
 #endif
@@ -52,6 +52,8 @@
 #include <dumux/adaptive/adapt.hh>
 #include <dumux/adaptive/markelements.hh>
 #include <dumux/adaptive/initializationindicator.hh>
+#include <dumux/adaptive/loadbalance.hh>
+#include <dumux/adaptive/gradientjumpindicator.hh>
 #include <dumux/porousmediumflow/2p/griddatatransfer.hh>
 #include <dumux/porousmediumflow/2p/gridadaptindicator.hh>
 
@@ -113,9 +115,18 @@ int main(int argc, char** argv)
     using Scalar = GetPropType<TypeTag, Properties::Scalar>;
     const Scalar refineTol = getParam<Scalar>("Adaptive.RefineTolerance");
     const Scalar coarsenTol = getParam<Scalar>("Adaptive.CoarsenTolerance");
+#if USE_GRADIENT_JUMP_INDICATOR
+    using Indicator = GradientJumpIndicator<GridVariables>;
+    Indicator indicator(gridGeometry, gridVariables);
+    indicator.addQuantity(Indicator::saturation(0));
+#else
     TwoPGridAdaptIndicator<TypeTag> indicator(gridGeometry);
+#endif
     TwoPGridDataTransfer<TypeTag> dataTransfer(problem, gridGeometry, gridVariables, x);
 
+    // repartitions the grid after adaption if the load is unbalanced (only in parallel runs)
+    LoadBalancer<GridGeometry> loadBalancer(gridGeometry);
+
     // Do initial refinement around sources/BCs
     GridAdaptInitializationIndicator<TypeTag> initIndicator(problem, gridGeometry, gridVariables);
 
@@ -148,6 +159,7 @@ int main(int argc, char** argv)
     // update grid data after adaption
     if (wasAdapted)
     {
+        loadBalancer.rebalance(gridManager.grid(), x); //!< Repartition the grid if the refinement unbalanced the load
         xOld = x; //!< Overwrite the old solution with the new (resized & interpolated) one
         gridVariables->updateAfterGridAdaption(x); //!< Initialize the secondary variables to the new (and "new old") solution
         problem->computePointSourceMap(); //!< Update the point source map
@@ -181,7 +193,7 @@ int main(int argc, char** argv)
 
     // the non-linear solver
     using NewtonSolver = Dumux::NewtonSolver<Assembler, LinearSolver>;
-    NewtonSolver nonLinearSolver(assembler, linearSolver);
+    auto nonLinearSolver = std::make_shared<NewtonSolver>(assembler, linearSolver);
 
     // time loop
     timeLoop->start(); do
@@ -200,16 +212,21 @@ int main(int argc, char** argv)
             if (wasAdapted)
             {
                 // Note that if we were using point sources, we would have to update the map here as well
+                loadBalancer.rebalance(gridManager.grid(), x); //!< Migrate the solution if the partitioning is changed
                 xOld = x; //!< Overwrite the old solution with the new (resized & interpolated) one
                 assembler->setJacobianPattern(); //!< Tell the assembler to resize the matrix and set pattern
                 assembler->setResidualSize(); //!< Tell the assembler to resize the residual
                 gridVariables->updateAfterGridAdaption(x); //!< Initialize the secondary variables to the new (and "new old") solution
                 problem->computePointSourceMap(); //!< Update the point source map
+
+                // the (parallel) linear solver stores the dof decomposition of the grid it was created with
+                linearSolver = std::make_shared<LinearSolver>(leafGridView, gridGeometry->dofMapper());
+                nonLinearSolver = std::make_shared<NewtonSolver>(assembler, linearSolver);
             }
         }
 
         // solve the non-linear system with time step control
-        nonLinearSolver.solve(x, *timeLoop);
+        nonLinearSolver->solve(x, *timeLoop);
 
         // make the new solution the old solution
         xOld = x;
@@ -225,7 +242,7 @@ int main(int argc, char** argv)
         timeLoop->reportTimeStep();
 
         // set new dt as suggested by the newton solver
-        timeLoop->setTimeStepSize(nonLinearSolver.suggestTimeStepSize(timeLoop->timeStepSize()));
+        timeLoop->setTimeStepSize(nonLinearSolver->suggestTimeStepSize(timeLoop->timeStepSize()));
 
     } while (!timeLoop->finished());
 
@@ -34,11 +34,16 @@
 #include <dumux/discretization/box.hh>
 
 #include <dumux/porousmediumflow/2p2c/model.hh>
+#include <dumux/porousmediumflow/soavolumevariables.hh>
 
 #ifndef ENABLECACHING
 #define ENABLECACHING 0
 #endif
 
+#ifndef SOAVOLUMEVARIABLES
+#define SOAVOLUMEVARIABLES 0
+#endif
+
 #include "spatialparams.hh"
 #include "problem.hh"
 
@@ -89,6 +94,13 @@ struct EnableGridVolumeVariablesCache<TypeTag, TTag::Injection> { static constex
 template<class TypeTag>
 struct EnableGridFluxVariablesCache<TypeTag, TTag::Injection> { static constexpr bool value = ENABLECACHING; };
 
+#if SOAVOLUMEVARIABLES
+// store the cached volume variables in structure-of-arrays layout
+template<class TypeTag>
+struct VolumeVariables<TypeTag, TTag::Injection>
+{ using type = SoAVolumeVariables<typename VolumeVariables<TypeTag, TTag::TwoPTwoC>::type>; };
+#endif
+
 // use the static interaction volume around interior vertices in the mpfa test
 template<class TypeTag>
 struct PrimaryInteractionVolume<TypeTag, TTag::InjectionCCMpfa>
@@ -2,6 +2,7 @@
 
 import sys
 
+import numpy as np
 from dune.grid import structuredGrid
 from dune.istl import blockVector, CGSolver, SeqSSOR
 
@@ -31,6 +32,11 @@ diffMethod = getParam("DiffMethod", default="numeric")
 if diffMethod not in ["analytic", "numeric"]:
     raise NotImplementedError(diffMethod + " must be analytic or numeric")
 
+batched = getParam("Batched", default="false")
+if batched not in ["true", "false"]:
+    raise NotImplementedError("Batched must be true or false")
+batched = batched == "true"
+
 
 # Set up the grid and the grid geometry
 gridView = structuredGrid([0, 0], [1, 1], [10, 10])
@@ -89,6 +95,8 @@ model["SpatialParams"] = Property.fromInstance(spatialParams)
 @PorousMediumFlowProblem(gridGeometry, spatialParams)
 class Problem:
     numEq = 1
+    # evaluate the *AtPos functions for all positions at once (positions have shape (n, dimWorld))
+    batchedAtPos = batched
 
     def boundaryTypesAtPos(self, globalPos):
         bTypes = BoundaryTypes(self.numEq)
@@ -103,10 +111,11 @@ class Problem:
 
     def dirichletAtPos(self, globalPos):
         dp_dy_ = -1.0e5
-        return 1.0e5 + dp_dy_ * (globalPos[1] - gridGeometry.bBoxMax[1])
+        y = globalPos[:, 1] if self.batchedAtPos else globalPos[1]
+        return 1.0e5 + dp_dy_ * (y - gridGeometry.bBoxMax[1])
 
     def sourceAtPos(self, globalPos):
-        return 0.0
+        return np.zeros(len(globalPos)) if self.batchedAtPos else 0.0
 
     def extrusionFactor(self, element, scv):
         return 1.0
@@ -142,6 +151,35 @@ print("Assembly done")
 res = assembler.residual
 jac = assembler.jacobian
 
+# The NumPy views share memory with the residual, the Jacobian and the solution
+resArray = assembler.residualArray()
+jacValues = assembler.jacobianValues()
+rowOffsets, columnIndices = assembler.jacobianPattern()
+if resArray.shape != (assembler.numDofs, 1):
+    raise Exception("Residual array does not match the residual")
+if jacValues.shape[0] != len(columnIndices) or rowOffsets[-1] != len(columnIndices):
+    raise Exception("Jacobian arrays do not match the Jacobian pattern")
+
+resValue = res[0][0]
+resArray[0, 0] = resValue + 1.0
+if res[0][0] != resValue + 1.0:
+    raise Exception("Residual array does not share memory with the residual")
+resArray[0, 0] = resValue
+
+jacValue = jac[0][columnIndices[0]][0][0]
+jacValues[0, 0, 0] = jacValue + 1.0
+if jac[0][columnIndices[0]][0][0] != jacValue + 1.0:
+    raise Exception("Jacobian values do not share memory with the Jacobian")
+jacValues[0, 0, 0] = jacValue
+
+solArray = assembler.asArray(sol)
+if solArray.shape != (assembler.numDofs, 1):
+    raise Exception("Solution array does not match the solution vector")
+solArray[0, 0] = 1.0
+if sol[0][0] != 1.0:
+    raise Exception("Solution array does not share memory with the solution vector")
+solArray[0, 0] = 0.0
+
 # Solve the linear system
 S = CGSolver(jac.asLinearOperator(), SeqSSOR(jac), 1e-10)
 res *= -1
@@ -151,7 +189,7 @@ if not converged:
     raise Exception("CGSolver has not converged")
 
 # Write to vtk
-testName = "test_1p_" + discMethod + "_" + diffMethod
+testName = "test_1p_" + ("batched_" if batched else "") + discMethod + "_" + diffMethod
 output = VtkOutputModule(gridVariables=gridVars, solutionVector=sol, name=testName)
 velocityoutput = PorousMediumFlowVelocityOutput(gridVariables=gridVars)
 output.addVelocityOutput(velocityoutput)
@@ -13,12 +13,14 @@
 #include <dune/common/parallel/mpihelper.hh>
 
 #include <dumux/io/format.hh>
+#include <dumux/common/parameters.hh>
 #include <dumux/common/variables.hh>
 #include <dumux/nonlinear/newtonsolver.hh>
 
 #include <dumux/timestepping/timelevel.hh>
 #include <dumux/timestepping/multistagemethods.hh>
 #include <dumux/timestepping/multistagetimestepper.hh>
+#include <dumux/timestepping/adaptivemultistagetimestepper.hh>
 
 /*
    This tests the time integration methods by solving the
@@ -126,6 +128,12 @@ int main(int argc, char* argv[])
     // maybe initialize MPI
     Dune::MPIHelper::instance(argc, argv);
 
+    // tolerances for the adaptive time stepping
+    Parameters::init([](auto& params){
+        params["TimeStepping.RelativeTolerance"] = "1e-6";
+        params["TimeStepping.AbsoluteTolerance"] = "1e-8";
+    });
+
     using Assembler = ScalarAssembler;
     using LinearSolver = ScalarLinearSolver;
     using NewtonSolver = NewtonSolver<Assembler, LinearSolver, DefaultPartialReassembler>;
@@ -186,6 +194,51 @@ int main(int argc, char* argv[])
     testIntegration(std::make_shared<ImplicitEuler<Scalar>>(), 5.0083e-03);
     testIntegration(std::make_shared<Theta<Scalar>>(0.5), 8.3333e-06);
     testIntegration(std::make_shared<RungeKuttaExplicitFourthOrder<Scalar>>(), 3.4829e-12);
+    testIntegration(std::make_shared<BogackiShampine<Scalar>>(), 3.4709e-09);
+    testIntegration(std::make_shared<SDIRKSecondOrder<Scalar>>(), 1.0161e-06);
+    testIntegration(std::make_shared<SDIRKThirdOrder<Scalar>>(), 7.9214e-09);
+
+    // integrate until tEnd with error-based time step size control
+    const auto testAdaptiveIntegration = [&] (auto method, std::size_t maxNumSteps)
+    {
+        std::cout << "\n-- Adaptive integration with " << method->name() << ":\n\n";
+        SolutionVector x = 0.0;
+        Variables vars(x);
+
+        using TimeStepper = Experimental::AdaptiveMultiStageTimeStepper<NewtonSolver>;
+        TimeStepper timeStepper(newtonSolver, method);
+
+        const Scalar tEnd = 1.0;
+        Scalar t = 0.0;
+        Scalar dt = 0.01;
+        while (t < tEnd - 1e-12)
+        {
+            using std::min;
+            t += timeStepper.step(vars, t, min(dt, tEnd - t));
+            dt = timeStepper.suggestTimeStepSize();
+        }
+
+        const auto [abs, rel] = computeError(vars);
+        std::cout << "\n"
+                  << "-- Summary\n"
+                  << "-- ===========================\n"
+                  << "-- Accepted steps:    " << timeStepper.numAcceptedSteps() << "\n"
+                  << "-- Rejected steps:    " << timeStepper.numRejectedSteps() << "\n"
+                  << "-- Absolute error:    " << Fmt::format("{:.4e}\n", abs)
+                  << "-- Relative error:    " << Fmt::format("{:.4e}", rel) << std::endl;
+
+        if (Dune::FloatCmp::ne(vars.timeLevel().current(), tEnd))
+            DUNE_THROW(Dune::InvalidStateException, "Final time not reached with " << method->name());
+        if (rel > 1e-6)
+            DUNE_THROW(Dune::InvalidStateException, "Error larger than the tolerance for " << method->name());
+        if (timeStepper.numAcceptedSteps() > maxNumSteps)
+            DUNE_THROW(Dune::InvalidStateException, "Too many time steps for " << method->name());
+    };
+
+    // the tolerances are met with fewer steps than the 100 steps of size 0.01 of a fixed step size
+    testAdaptiveIntegration(std::make_shared<BogackiShampine<Scalar>>(), 80);
+    testAdaptiveIntegration(std::make_shared<DormandPrince<Scalar>>(), 15);
+    testAdaptiveIntegration(std::make_shared<SDIRKThirdOrder<Scalar>>(), 80);
 
     return 0;
 }